@@ -0,0 +1,166 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "pw_allocator/chunk_pool.h"
+#include "pw_allocator/lock_free_chunk_pool.h"
+#include "pw_allocator/pool.h"
+#include "pw_chrono/system_clock.h"
+#include "pw_metric/metric.h"
+#include "pw_random/xor_shift.h"
+#include "pw_sync/mutex.h"
+#include "pw_tokenizer/tokenize.h"
+
+namespace pw::allocator {
+
+// Compares a `ChunkPool` protected by a mutex with a `LockFreeChunkPool` as
+// the number of threads using them grows.
+//
+// Each thread makes the same number of requests. The reported time is the
+// wall-clock time for all threads to finish, divided by the total number of
+// requests.
+
+constexpr size_t kRequestsPerThread = 200000;
+constexpr size_t kMaxThreads = 8;
+
+// Each thread holds up to this many chunks at once.
+constexpr size_t kSlots = 16;
+
+constexpr Layout kChunkLayout(64, alignof(uint64_t));
+constexpr size_t kNumChunks = kMaxThreads * kSlots;
+
+alignas(uint64_t) std::array<std::byte, kChunkLayout.size() * kNumChunks>
+    buffer;
+
+/// `ChunkPool` wrapped with a mutex, as a `SynchronizedAllocator` would wrap
+/// an allocator.
+class MutexChunkPool : public Pool {
+ public:
+  MutexChunkPool(ByteSpan region, const Layout& layout)
+      : Pool(ChunkPool::kCapabilities, layout), pool_(region, layout) {}
+
+ private:
+  void* DoAllocate() override {
+    std::lock_guard lock(mutex_);
+    return pool_.Allocate();
+  }
+
+  void DoDeallocate(void* ptr) override {
+    std::lock_guard lock(mutex_);
+    pool_.Deallocate(ptr);
+  }
+
+  sync::Mutex mutex_;
+  ChunkPool pool_;
+};
+
+/// Thread body that randomly allocates and frees chunks.
+void MakeRequests(Pool& pool, uint64_t seed) {
+  random::XorShiftStarRng64 prng(seed);
+  std::array<void*, kSlots> slots{};
+  for (size_t i = 0; i < kRequestsPerThread; ++i) {
+    uint64_t value;
+    prng.GetInt(value);
+    void*& slot = slots[value % kSlots];
+    if (slot != nullptr) {
+      pool.Deallocate(slot);
+      slot = nullptr;
+    } else {
+      slot = pool.Allocate();
+    }
+  }
+  for (void* slot : slots) {
+    if (slot != nullptr) {
+      pool.Deallocate(slot);
+    }
+  }
+}
+
+/// Returns the mean nanoseconds per request for `num_threads` threads.
+float RunThreads(Pool& pool, size_t num_threads) {
+  std::vector<std::thread> threads;
+  auto start = chrono::SystemClock::now();
+  for (size_t i = 0; i < num_threads; ++i) {
+    threads.emplace_back([&pool, i] { MakeRequests(pool, i + 1); });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  auto elapsed = chrono::SystemClock::now() - start;
+  auto nanoseconds =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+  return static_cast<float>(nanoseconds) /
+         static_cast<float>(num_threads * kRequestsPerThread);
+}
+
+/// Results for one pool.
+struct Results {
+  Results(metric::Token name) : group(name) {}
+
+  void Record(size_t num_threads, float nanoseconds) {
+    switch (num_threads) {
+      case 1:
+        one_thread.Set(nanoseconds);
+        break;
+      case 2:
+        two_threads.Set(nanoseconds);
+        break;
+      case 4:
+        four_threads.Set(nanoseconds);
+        break;
+      case 8:
+        eight_threads.Set(nanoseconds);
+        break;
+    }
+  }
+
+  metric::Group group;
+  PW_METRIC(group, one_thread, "1 thread (ns per request)", 0.f);
+  PW_METRIC(group, two_threads, "2 threads (ns per request)", 0.f);
+  PW_METRIC(group, four_threads, "4 threads (ns per request)", 0.f);
+  PW_METRIC(group, eight_threads, "8 threads (ns per request)", 0.f);
+};
+
+void DoChunkPoolBenchmark() {
+  Results mutex_results(PW_TOKENIZE_STRING_EXPR("ChunkPool with mutex"));
+  Results lock_free_results(PW_TOKENIZE_STRING_EXPR("LockFreeChunkPool"));
+
+  for (size_t num_threads = 1; num_threads <= kMaxThreads; num_threads *= 2) {
+    {
+      MutexChunkPool pool(buffer, kChunkLayout);
+      mutex_results.Record(num_threads, RunThreads(pool, num_threads));
+    }
+    {
+      LockFreeChunkPool pool(buffer, kChunkLayout);
+      lock_free_results.Record(num_threads, RunThreads(pool, num_threads));
+    }
+  }
+
+  mutex_results.group.Dump();
+  lock_free_results.group.Dump();
+}
+
+}  // namespace pw::allocator
+
+int main() {
+  pw::allocator::DoChunkPoolBenchmark();
+  return 0;
+}
@@ -40,6 +40,9 @@ class GenericBlockAllocatorBenchmark : public pw::allocator::test::TestHarness {
   metric::Group& metrics() { return measurements_.metrics(); }
   Measurements& measurements() { return measurements_; }
 
+  /// Returns the data sampled for the most recent request.
+  const BenchmarkSample& last_sample() const { return data_; }
+
  protected:
   constexpr explicit GenericBlockAllocatorBenchmark(Measurements& measurements)
       : measurements_(measurements) {}
@@ -151,9 +154,12 @@ template <typename AllocatorType>
 void BlockAllocatorBenchmark<AllocatorType>::IterateOverBlocks(
     internal::BenchmarkSample& data) const {
   data.largest = 0;
+  data.used = 0;
   for (const auto* block : allocator_.blocks()) {
     if (block->IsFree()) {
       data.largest = std::max(data.largest, block->InnerSize());
+    } else {
+      data.used += block->OuterSize();
     }
   }
 }
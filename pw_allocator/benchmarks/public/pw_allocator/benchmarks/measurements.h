@@ -36,6 +36,9 @@ struct BenchmarkSample {
   /// Current single largest allocation that could succeed.
   size_t largest = 0;
 
+  /// Current number of bytes in allocated blocks, including their overhead.
+  size_t used = 0;
+
   /// Result of the last allocator request.
   bool failed = false;
 };
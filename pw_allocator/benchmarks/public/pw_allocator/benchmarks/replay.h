@@ -0,0 +1,157 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_allocator/benchmarks/benchmark.h"
+#include "pw_allocator/tracing_allocator.h"
+#include "pw_bytes/span.h"
+#include "pw_containers/vector.h"
+#include "pw_metric/metric.h"
+#include "pw_status/status.h"
+
+namespace pw::allocator {
+namespace internal {
+
+/// Base class for replaying traces.
+///
+/// This class is not templated on the maximum number of outstanding
+/// allocations. Callers should not use this class directly, and instead use
+/// `TraceReplay`.
+class GenericTraceReplay {
+ public:
+  metric::Group& metrics() { return metrics_; }
+
+  /// Replays the requests recorded by a `TracingAllocator`.
+  ///
+  /// Each recorded request is issued to the given benchmark harness, which
+  /// records its `Measurements` as it would for generated requests. This
+  /// object additionally records the distribution of response times, the peak
+  /// number of bytes requested and used, and the fragmentation at peak usage.
+  ///
+  /// Requests are adapted to what the harness supports:
+  ///
+  /// * Requests that failed when recorded are skipped.
+  /// * Requests for memory that was not allocated by a replayed request, e.g.
+  ///   memory allocated before tracing started, are skipped.
+  /// * Resize requests are replayed as reallocations.
+  /// * Sizes and alignments are rounded up to those of
+  ///   `test::TestHarness::Allocation`, which the harness stores in each
+  ///   allocation.
+  ///
+  /// Any allocations that remain when the trace ends are freed.
+  ///
+  /// @returns @rst
+  ///
+  /// .. pw-status-codes::
+  ///
+  ///    OK: The trace was replayed.
+  ///
+  ///    DATA_LOSS: The trace is malformed. Requests before the malformed
+  ///    event were replayed.
+  ///
+  ///    RESOURCE_EXHAUSTED: The trace has more outstanding allocations than
+  ///    this object can track. Requests up to that point were replayed.
+  ///
+  /// @endrst
+  Status Replay(ConstByteSpan trace,
+                GenericBlockAllocatorBenchmark& benchmark);
+
+  /// Returns the response time, in nanoseconds, that the given percentage of
+  /// replayed requests did not exceed.
+  ///
+  /// Response times are collected into buckets that are each a quarter of a
+  /// power of two wide, and the upper limit of the bucket is returned.
+  uint64_t GetPercentile(uint32_t percent) const;
+
+  size_t num_replayed() const { return num_replayed_; }
+  size_t num_skipped() const { return skipped_.value(); }
+  size_t peak_requested() const { return peak_requested_.value(); }
+  size_t peak_used() const { return peak_used_.value(); }
+
+ protected:
+  GenericTraceReplay(metric::Token name, Vector<uintptr_t>& addrs);
+
+ private:
+  /// Number of response times that are counted exactly.
+  static constexpr size_t kNumExact = 16;
+
+  /// Number of buckets each power of two is divided into.
+  static constexpr size_t kBucketsPerPowerOf2 = 4;
+
+  static constexpr size_t kNumBuckets =
+      kNumExact + (64 - 4) * kBucketsPerPowerOf2;
+
+  /// Returns the histogram bucket for a response time.
+  static size_t GetBucket(uint64_t nanoseconds);
+
+  /// Returns the largest response time in a histogram bucket.
+  static uint64_t GetUpperLimit(size_t bucket);
+
+  /// Replays a single event. Returns false if the event was skipped.
+  bool ReplayEvent(const TraceEvent& event,
+                   GenericBlockAllocatorBenchmark& benchmark);
+
+  /// Returns the index of the harness allocation with the given recorded
+  /// address, or `addrs_.size()` if there is no such allocation.
+  size_t Find(uintptr_t addr) const;
+
+  /// Records the sample from the most recently replayed request.
+  void Update(const GenericBlockAllocatorBenchmark& benchmark);
+
+  /// Sets the metrics that summarize the replay.
+  void Summarize();
+
+  metric::Group metrics_;
+  PW_METRIC(metrics_, p50_, "median response time (ns)", 0u);
+  PW_METRIC(metrics_, p90_, "90th percentile response time (ns)", 0u);
+  PW_METRIC(metrics_, p99_, "99th percentile response time (ns)", 0u);
+  PW_METRIC(metrics_, max_, "max response time (ns)", 0u);
+  PW_METRIC(metrics_, peak_requested_, "peak bytes requested", 0u);
+  PW_METRIC(metrics_, peak_used_, "peak bytes used by blocks", 0u);
+  PW_METRIC(metrics_, fragmentation_, "fragmentation at peak usage", 0.f);
+  PW_METRIC(metrics_, skipped_, "number of requests skipped", 0u);
+
+  std::array<uint32_t, kNumBuckets> histogram_{};
+  size_t num_replayed_ = 0;
+  uint64_t max_nanoseconds_ = 0;
+
+  /// Recorded addresses of the harness's allocations, in the same order.
+  Vector<uintptr_t>& addrs_;
+};
+
+}  // namespace internal
+
+/// Replays traces recorded by a `TracingAllocator` using a block allocator
+/// benchmark harness.
+///
+/// This allows comparing allocators using the sequence of requests made by a
+/// real application, instead of generated ones.
+///
+/// @tparam   kMaxAllocations   Maximum number of allocations that may be
+///                             outstanding at any point in a trace.
+template <size_t kMaxAllocations>
+class TraceReplay : public internal::GenericTraceReplay {
+ public:
+  explicit TraceReplay(metric::Token name)
+      : internal::GenericTraceReplay(name, addrs_) {}
+
+ private:
+  Vector<uintptr_t, kMaxAllocations> addrs_;
+};
+
+}  // namespace pw::allocator
@@ -0,0 +1,174 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_allocator/benchmarks/replay.h"
+
+#include <algorithm>
+
+#include "lib/stdcompat/bit.h"
+#include "pw_assert/check.h"
+
+namespace pw::allocator::internal {
+
+using test::AllocationRequest;
+using test::DeallocationRequest;
+using test::ReallocationRequest;
+using test::TestHarness;
+
+GenericTraceReplay::GenericTraceReplay(metric::Token name,
+                                       Vector<uintptr_t>& addrs)
+    : metrics_(name), addrs_(addrs) {}
+
+Status GenericTraceReplay::Replay(ConstByteSpan trace,
+                                  GenericBlockAllocatorBenchmark& benchmark) {
+  PW_CHECK_UINT_EQ(benchmark.num_allocations(), 0);
+  addrs_.clear();
+  TraceReader reader(trace);
+  Status status;
+  while (true) {
+    Result<TraceEvent> event = reader.Next();
+    if (event.status().IsOutOfRange()) {
+      break;
+    }
+    if (!event.ok()) {
+      status = event.status();
+      break;
+    }
+    if (!ReplayEvent(*event, benchmark)) {
+      skipped_.Increment();
+      continue;
+    }
+    if (addrs_.size() != benchmark.num_allocations()) {
+      // The harness added an allocation that could not be tracked.
+      status = Status::ResourceExhausted();
+      break;
+    }
+    Update(benchmark);
+  }
+  benchmark.Reset();
+  addrs_.clear();
+  Summarize();
+  return status;
+}
+
+bool GenericTraceReplay::ReplayEvent(
+    const TraceEvent& event, GenericBlockAllocatorBenchmark& benchmark) {
+  constexpr Layout kMinLayout = Layout::Of<TestHarness::Allocation>();
+  if (event.type != TraceEventType::kDeallocate && event.result == 0) {
+    return false;
+  }
+  size_t size = std::max(event.layout.size(), kMinLayout.size());
+  size_t num_allocations = benchmark.num_allocations();
+
+  if (event.type == TraceEventType::kAllocate) {
+    size_t alignment =
+        std::max(event.layout.alignment(), kMinLayout.alignment());
+    benchmark.HandleRequest(AllocationRequest{size, alignment});
+    if (benchmark.num_allocations() != num_allocations && !addrs_.full()) {
+      addrs_.push_back(event.result);
+    }
+    return true;
+  }
+
+  size_t index = Find(event.ptr);
+  if (index == addrs_.size()) {
+    return false;
+  }
+  addrs_.erase(addrs_.begin() + static_cast<ptrdiff_t>(index));
+
+  if (event.type == TraceEventType::kDeallocate) {
+    benchmark.HandleRequest(DeallocationRequest{index});
+    return true;
+  }
+
+  // Resizes and reallocations both move the allocation to the back of the
+  // harness's list. If the replayed reallocation fails, the harness keeps the
+  // original allocation, which is still referred to by the recorded address.
+  benchmark.HandleRequest(ReallocationRequest{index, size});
+  if (benchmark.num_allocations() == num_allocations) {
+    addrs_.push_back(event.result);
+  }
+  return true;
+}
+
+size_t GenericTraceReplay::Find(uintptr_t addr) const {
+  // Recently allocated memory is the most likely to be freed, so search from
+  // the back.
+  for (size_t i = addrs_.size(); i != 0; --i) {
+    if (addrs_[i - 1] == addr) {
+      return i - 1;
+    }
+  }
+  return addrs_.size();
+}
+
+void GenericTraceReplay::Update(
+    const GenericBlockAllocatorBenchmark& benchmark) {
+  const BenchmarkSample& sample = benchmark.last_sample();
+  ++histogram_[GetBucket(sample.nanoseconds)];
+  ++num_replayed_;
+  max_nanoseconds_ = std::max(max_nanoseconds_, sample.nanoseconds);
+  peak_requested_.Set(std::max(peak_requested_.value(),
+                               static_cast<uint32_t>(benchmark.allocated())));
+  if (sample.used > peak_used_.value()) {
+    peak_used_.Set(static_cast<uint32_t>(sample.used));
+    fragmentation_.Set(sample.fragmentation);
+  }
+}
+
+void GenericTraceReplay::Summarize() {
+  p50_.Set(static_cast<uint32_t>(GetPercentile(50)));
+  p90_.Set(static_cast<uint32_t>(GetPercentile(90)));
+  p99_.Set(static_cast<uint32_t>(GetPercentile(99)));
+  max_.Set(static_cast<uint32_t>(max_nanoseconds_));
+}
+
+uint64_t GenericTraceReplay::GetPercentile(uint32_t percent) const {
+  if (num_replayed_ == 0) {
+    return 0;
+  }
+  // Find the bucket containing the ceil(N * percent / 100)-th response time.
+  uint64_t target = (uint64_t(num_replayed_) * percent + 99) / 100;
+  uint64_t count = 0;
+  for (size_t bucket = 0; bucket < kNumBuckets; ++bucket) {
+    count += histogram_[bucket];
+    if (count != 0 && count >= target) {
+      return std::min(GetUpperLimit(bucket), max_nanoseconds_);
+    }
+  }
+  return max_nanoseconds_;
+}
+
+size_t GenericTraceReplay::GetBucket(uint64_t nanoseconds) {
+  if (nanoseconds < kNumExact) {
+    return static_cast<size_t>(nanoseconds);
+  }
+  // Divide each power of two into `kBucketsPerPowerOf2` equal parts, using the
+  // two bits after the leading one.
+  auto exponent = static_cast<size_t>(cpp20::bit_width(nanoseconds) - 1);
+  auto fraction = static_cast<size_t>(nanoseconds >> (exponent - 2)) & 3;
+  return kNumExact + (exponent - 4) * kBucketsPerPowerOf2 + fraction;
+}
+
+uint64_t GenericTraceReplay::GetUpperLimit(size_t bucket) {
+  if (bucket < kNumExact) {
+    return bucket;
+  }
+  size_t exponent = 4 + (bucket - kNumExact) / kBucketsPerPowerOf2;
+  size_t fraction = (bucket - kNumExact) % kBucketsPerPowerOf2;
+  uint64_t width = uint64_t(1) << (exponent - 2);
+  return (kBucketsPerPowerOf2 + fraction) * width + (width - 1);
+}
+
+}  // namespace pw::allocator::internal
@@ -0,0 +1,110 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+#include "pw_allocator/benchmarks/benchmark.h"
+#include "pw_allocator/benchmarks/config.h"
+#include "pw_allocator/benchmarks/replay.h"
+#include "pw_allocator/best_fit.h"
+#include "pw_allocator/first_fit.h"
+#include "pw_allocator/test_harness.h"
+#include "pw_allocator/tlsf_allocator.h"
+#include "pw_allocator/tracing_allocator.h"
+#include "pw_allocator/worst_fit.h"
+#include "pw_log/log.h"
+#include "pw_tokenizer/tokenize.h"
+
+namespace pw::allocator {
+
+// Replays the same trace against several block allocators.
+//
+// If a path is given on the command line, the trace is read from that file.
+// Such a trace can be captured from an application by wrapping its allocator
+// in a `TracingAllocator` and saving the contents of `trace()`. Otherwise, a
+// trace is recorded from the same randomly generated requests used by the
+// other benchmarks.
+
+constexpr metric::Token kBestFitReplay = PW_TOKENIZE_STRING("best fit replay");
+constexpr metric::Token kFirstFitReplay =
+    PW_TOKENIZE_STRING("first fit replay");
+constexpr metric::Token kWorstFitReplay =
+    PW_TOKENIZE_STRING("worst fit replay");
+constexpr metric::Token kTlsfReplay =
+    PW_TOKENIZE_STRING("two-layer, segregated-fit replay");
+
+constexpr size_t kTraceSize = 0x100000;  // 1 MiB
+constexpr size_t kMaxAllocations = 0x4000;
+
+std::array<std::byte, benchmarks::kCapacity> buffer;
+std::array<std::byte, kTraceSize> trace_buffer;
+
+/// Records a trace of randomly generated requests.
+ConstByteSpan RecordTrace() {
+  TlsfAllocator<> allocator(buffer);
+  TracingAllocator tracer(allocator, trace_buffer);
+  test::TestHarness harness(tracer);
+  harness.set_prng_seed(1);
+  harness.set_available(benchmarks::kCapacity);
+  harness.GenerateRequests(benchmarks::kMaxSize, benchmarks::kNumRequests);
+  if (tracer.num_dropped() != 0) {
+    PW_LOG_WARN("Trace buffer is full; dropped %zu events",
+                tracer.num_dropped());
+  }
+  return tracer.trace();
+}
+
+/// Reads a trace from a file.
+ConstByteSpan ReadTrace(const char* path) {
+  std::FILE* file = std::fopen(path, "rb");
+  if (file == nullptr) {
+    PW_LOG_ERROR("Unable to open %s", path);
+    return ConstByteSpan();
+  }
+  size_t len = std::fread(trace_buffer.data(), 1, trace_buffer.size(), file);
+  std::fclose(file);
+  return ConstByteSpan(trace_buffer).first(len);
+}
+
+/// Replays a trace against a block allocator, and logs the results.
+template <typename AllocatorType>
+void Replay(metric::Token name, ConstByteSpan trace) {
+  static TraceReplay<kMaxAllocations> replay(name);
+  AllocatorType allocator(buffer);
+  DefaultBlockAllocatorBenchmark benchmark(name, allocator);
+  Status status = replay.Replay(trace, benchmark);
+  if (!status.ok()) {
+    PW_LOG_ERROR("Replay stopped early: %s", status.str());
+  }
+  benchmark.metrics().Add(replay.metrics());
+  benchmark.metrics().Dump();
+}
+
+void DoReplayBenchmark(int argc, char** argv) {
+  ConstByteSpan trace = argc > 1 ? ReadTrace(argv[1]) : RecordTrace();
+  Replay<BestFitAllocator<>>(kBestFitReplay, trace);
+  Replay<FirstFitAllocator<>>(kFirstFitReplay, trace);
+  Replay<WorstFitAllocator<>>(kWorstFitReplay, trace);
+  Replay<TlsfAllocator<>>(kTlsfReplay, trace);
+}
+
+}  // namespace pw::allocator
+
+int main(int argc, char** argv) {
+  pw::allocator::DoReplayBenchmark(argc, argv);
+  return 0;
+}
@@ -0,0 +1,171 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_allocator/benchmarks/replay.h"
+
+#include <array>
+#include <cstddef>
+
+#include "pw_allocator/benchmarks/benchmark.h"
+#include "pw_allocator/test_harness.h"
+#include "pw_allocator/testing.h"
+#include "pw_allocator/tracing_allocator.h"
+#include "pw_unit_test/framework.h"
+
+namespace {
+
+constexpr size_t kCapacity = 4096;
+constexpr size_t kMaxSize = 64;
+
+using AllocatorForTest = ::pw::allocator::test::AllocatorForTest<kCapacity>;
+using Benchmark =
+    ::pw::allocator::DefaultBlockAllocatorBenchmark<AllocatorForTest>;
+using TraceReplay = ::pw::allocator::TraceReplay<64>;
+using ::pw::allocator::Layout;
+using ::pw::allocator::TracingAllocator;
+using ::pw::allocator::test::kToken;
+using ::pw::allocator::test::TestHarness;
+
+class TraceReplayTest : public ::testing::Test {
+ protected:
+  TraceReplayTest()
+      : tracer_(recorded_, buffer_),
+        benchmark_(kToken, replayed_),
+        replay_(kToken) {}
+
+  AllocatorForTest recorded_;
+  std::array<std::byte, 2048> buffer_;
+  TracingAllocator tracer_;
+
+  AllocatorForTest replayed_;
+  Benchmark benchmark_;
+  TraceReplay replay_;
+};
+
+TEST_F(TraceReplayTest, EmptyTrace) {
+  EXPECT_EQ(replay_.Replay(tracer_.trace(), benchmark_), pw::OkStatus());
+  EXPECT_EQ(replay_.num_replayed(), 0u);
+  EXPECT_EQ(replay_.GetPercentile(50), 0u);
+}
+
+TEST_F(TraceReplayTest, ReplaysRequests) {
+  void* ptr1 = tracer_.Allocate(Layout(64, 8));
+  void* ptr2 = tracer_.Allocate(Layout(128, 8));
+  ASSERT_NE(ptr1, nullptr);
+  ASSERT_NE(ptr2, nullptr);
+  void* ptr3 = tracer_.Reallocate(ptr1, Layout(256, 8));
+  ASSERT_NE(ptr3, nullptr);
+  tracer_.Deallocate(ptr2);
+  tracer_.Deallocate(ptr3);
+
+  EXPECT_EQ(replay_.Replay(tracer_.trace(), benchmark_), pw::OkStatus());
+  EXPECT_EQ(replay_.num_replayed(), 5u);
+  EXPECT_EQ(replay_.num_skipped(), 0u);
+  EXPECT_EQ(replay_.peak_requested(), 128u + 256u);
+  EXPECT_GE(replay_.peak_used(), replay_.peak_requested());
+
+  // The replayed allocator has no outstanding allocations.
+  EXPECT_EQ(benchmark_.num_allocations(), 0u);
+  EXPECT_EQ(replayed_.GetAllocated(), 0u);
+}
+
+TEST_F(TraceReplayTest, ReplaysResizeAsReallocate) {
+  void* ptr = tracer_.Allocate(Layout(64, 8));
+  ASSERT_NE(ptr, nullptr);
+  ASSERT_TRUE(tracer_.Resize(ptr, 128));
+  tracer_.Deallocate(ptr);
+
+  EXPECT_EQ(replay_.Replay(tracer_.trace(), benchmark_), pw::OkStatus());
+  EXPECT_EQ(replay_.num_replayed(), 3u);
+  EXPECT_EQ(replay_.peak_requested(), 128u);
+}
+
+TEST_F(TraceReplayTest, SkipsFailedRequests) {
+  EXPECT_EQ(tracer_.Allocate(Layout(kCapacity * 2, 8)), nullptr);
+  void* ptr = tracer_.Allocate(Layout(64, 8));
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_FALSE(tracer_.Resize(ptr, kCapacity * 2));
+  tracer_.Deallocate(ptr);
+
+  EXPECT_EQ(replay_.Replay(tracer_.trace(), benchmark_), pw::OkStatus());
+  EXPECT_EQ(replay_.num_replayed(), 2u);
+  EXPECT_EQ(replay_.num_skipped(), 2u);
+}
+
+TEST_F(TraceReplayTest, SkipsUnknownPointers) {
+  void* ptr = recorded_.Allocate(Layout(64, 8));
+  ASSERT_NE(ptr, nullptr);
+  tracer_.Deallocate(ptr);
+
+  EXPECT_EQ(replay_.Replay(tracer_.trace(), benchmark_), pw::OkStatus());
+  EXPECT_EQ(replay_.num_replayed(), 0u);
+  EXPECT_EQ(replay_.num_skipped(), 1u);
+}
+
+TEST_F(TraceReplayTest, RoundsUpSmallRequests) {
+  void* ptr = tracer_.Allocate(Layout(1, 1));
+  ASSERT_NE(ptr, nullptr);
+  tracer_.Deallocate(ptr);
+
+  // The harness keeps the allocation, so the deallocation can be replayed.
+  EXPECT_EQ(replay_.Replay(tracer_.trace(), benchmark_), pw::OkStatus());
+  EXPECT_EQ(replay_.num_replayed(), 2u);
+  EXPECT_EQ(replay_.peak_requested(),
+            Layout::Of<TestHarness::Allocation>().size());
+}
+
+TEST_F(TraceReplayTest, MalformedTrace) {
+  void* ptr = tracer_.Allocate(Layout(64, 8));
+  ASSERT_NE(ptr, nullptr);
+  tracer_.Deallocate(ptr);
+  pw::ConstByteSpan trace = tracer_.trace();
+
+  EXPECT_EQ(replay_.Replay(trace.first(trace.size() - 1), benchmark_),
+            pw::Status::DataLoss());
+  EXPECT_EQ(replay_.num_replayed(), 1u);
+  EXPECT_EQ(benchmark_.num_allocations(), 0u);
+}
+
+TEST_F(TraceReplayTest, TooManyAllocations) {
+  pw::allocator::TraceReplay<2> replay(kToken);
+  std::array<void*, 3> ptrs;
+  for (void*& ptr : ptrs) {
+    ptr = tracer_.Allocate(Layout(64, 8));
+    ASSERT_NE(ptr, nullptr);
+  }
+  for (void* ptr : ptrs) {
+    tracer_.Deallocate(ptr);
+  }
+  EXPECT_EQ(replay.Replay(tracer_.trace(), benchmark_),
+            pw::Status::ResourceExhausted());
+  EXPECT_EQ(benchmark_.num_allocations(), 0u);
+}
+
+TEST_F(TraceReplayTest, ReplaysGeneratedRequests) {
+  // Record a random sequence of requests, and check they can all be replayed.
+  TestHarness harness(tracer_);
+  harness.set_prng_seed(1);
+  harness.set_available(kCapacity);
+  harness.GenerateRequests(kMaxSize, 100);
+  ASSERT_EQ(tracer_.num_dropped(), 0u);
+
+  EXPECT_EQ(replay_.Replay(tracer_.trace(), benchmark_), pw::OkStatus());
+  EXPECT_EQ(replay_.num_skipped(), 0u);
+  EXPECT_GE(replay_.num_replayed(), 100u);
+  EXPECT_LE(replay_.GetPercentile(50), replay_.GetPercentile(90));
+  EXPECT_LE(replay_.GetPercentile(90), replay_.GetPercentile(99));
+  EXPECT_LE(replay_.GetPercentile(99), replay_.GetPercentile(100));
+}
+
+}  // namespace
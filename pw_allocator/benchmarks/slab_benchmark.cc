@@ -0,0 +1,155 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_allocator/allocator.h"
+#include "pw_allocator/benchmarks/config.h"
+#include "pw_allocator/fragmentation.h"
+#include "pw_allocator/slab_allocator.h"
+#include "pw_allocator/tlsf_allocator.h"
+#include "pw_chrono/system_clock.h"
+#include "pw_metric/metric.h"
+#include "pw_random/xor_shift.h"
+#include "pw_tokenizer/tokenize.h"
+
+namespace pw::allocator {
+
+// Compares a `TlsfAllocator` with a `SlabAllocator` that allocates its slabs
+// from a `TlsfAllocator`, for a workload dominated by a few object sizes.
+//
+// Each benchmark runs the same sequence of requests twice. The first run
+// measures how much of the TLSF allocator's memory is used after every request,
+// including block headers and alignment padding, and compares the peak to the
+// peak number of bytes requested. The second run is timed.
+
+// Object sizes, and the size classes of the slab allocator.
+constexpr std::array<size_t, 4> kObjectSizes = {24, 48, 80, 136};
+
+// Number of allocations that may be outstanding at once.
+constexpr size_t kSlots = 1024;
+
+using Tlsf = TlsfAllocator<>;
+
+std::array<std::byte, benchmarks::kCapacity> buffer;
+
+/// Randomly allocates and frees objects, and returns the mean nanoseconds per
+/// request.
+///
+/// If `sample` is provided, it is called after each request with the number of
+/// bytes currently requested.
+template <typename Sample>
+float MakeRequests(Allocator& allocator, Sample&& sample) {
+  random::XorShiftStarRng64 prng(1);
+  std::array<void*, kSlots> slots{};
+  std::array<size_t, kSlots> sizes{};
+  size_t requested = 0;
+  auto start = chrono::SystemClock::now();
+  for (size_t i = 0; i < benchmarks::kNumRequests; ++i) {
+    uint64_t value;
+    prng.GetInt(value);
+    size_t index = value % kSlots;
+    if (slots[index] != nullptr) {
+      allocator.Deallocate(slots[index]);
+      slots[index] = nullptr;
+      requested -= sizes[index];
+    } else {
+      size_t size = kObjectSizes[(value >> 32) % kObjectSizes.size()];
+      slots[index] = allocator.Allocate(Layout(size, alignof(uint64_t)));
+      sizes[index] = size;
+      requested += size;
+    }
+    sample(requested);
+  }
+  auto elapsed = chrono::SystemClock::now() - start;
+  for (void* slot : slots) {
+    allocator.Deallocate(slot);
+  }
+  auto nanoseconds =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+  return static_cast<float>(nanoseconds) /
+         static_cast<float>(benchmarks::kNumRequests);
+}
+
+/// Returns the number of bytes used by allocated blocks, including overhead.
+size_t GetUsedBytes(const Tlsf& tlsf) {
+  size_t used = 0;
+  for (const auto* block : tlsf.blocks()) {
+    if (!block->IsFree()) {
+      used += block->OuterSize();
+    }
+  }
+  return used;
+}
+
+/// Results for one allocator.
+struct Results {
+  Results(metric::Token name) : group(name) {}
+
+  metric::Group group;
+  PW_METRIC(group, nanoseconds, "mean time per request (ns)", 0.f);
+  PW_METRIC(group, peak_requested, "peak bytes requested", 0u);
+  PW_METRIC(group, peak_used, "peak bytes used by TLSF blocks", 0u);
+  PW_METRIC(group, overhead, "peak overhead (%)", 0.f);
+  PW_METRIC(group, fragmentation, "TLSF fragmentation at peak", 0.f);
+};
+
+/// Runs the benchmark for `allocator`, which uses `tlsf` for its memory.
+void Run(Allocator& allocator, const Tlsf& tlsf, Results& results) {
+  size_t peak_requested = 0;
+  size_t peak_used = 0;
+  float fragmentation = 0.f;
+  MakeRequests(allocator, [&](size_t requested) {
+    peak_requested = std::max(peak_requested, requested);
+    size_t used = GetUsedBytes(tlsf);
+    if (used > peak_used) {
+      peak_used = used;
+      fragmentation = CalculateFragmentation(tlsf.MeasureFragmentation());
+    }
+  });
+  results.peak_requested.Set(static_cast<uint32_t>(peak_requested));
+  results.peak_used.Set(static_cast<uint32_t>(peak_used));
+  results.overhead.Set(100.f * static_cast<float>(peak_used - peak_requested) /
+                       static_cast<float>(peak_requested));
+  results.fragmentation.Set(fragmentation);
+
+  results.nanoseconds.Set(MakeRequests(allocator, [](size_t) {}));
+}
+
+void DoSlabBenchmark() {
+  Results tlsf_results(PW_TOKENIZE_STRING_EXPR("TlsfAllocator"));
+  Results slab_results(PW_TOKENIZE_STRING_EXPR("SlabAllocator"));
+  {
+    Tlsf tlsf(buffer);
+    Run(tlsf, tlsf, tlsf_results);
+  }
+  {
+    Tlsf tlsf(buffer);
+    SlabAllocator<kObjectSizes.size()> slab(tlsf, kObjectSizes);
+    Run(slab, tlsf, slab_results);
+  }
+  tlsf_results.group.Dump();
+  slab_results.group.Dump();
+}
+
+}  // namespace pw::allocator
+
+int main() {
+  pw::allocator::DoSlabBenchmark();
+  return 0;
+}
@@ -0,0 +1,150 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "pw_allocator/allocator.h"
+#include "pw_allocator/benchmarks/config.h"
+#include "pw_allocator/synchronized_allocator.h"
+#include "pw_allocator/thread_caching_allocator.h"
+#include "pw_allocator/tlsf_allocator.h"
+#include "pw_chrono/system_clock.h"
+#include "pw_metric/metric.h"
+#include "pw_random/xor_shift.h"
+#include "pw_sync/mutex.h"
+#include "pw_tokenizer/tokenize.h"
+
+namespace pw::allocator {
+
+// Compares a `SynchronizedAllocator` with a `ThreadCachingAllocator`, both
+// wrapping a `TlsfAllocator`, as the number of threads using them grows.
+//
+// Each thread makes the same number of requests. The reported time is the
+// wall-clock time for all threads to finish, divided by the total number of
+// requests.
+
+constexpr size_t kRequestsPerThread = 100000;
+constexpr size_t kMaxThreads = 8;
+
+// Each thread holds up to this many allocations at once.
+constexpr size_t kSlots = 64;
+
+// Most requests are small, which is what a thread cache is for.
+constexpr size_t kMaxRequestSize = 512;
+
+std::array<std::byte, benchmarks::kCapacity> buffer;
+
+/// Thread body that randomly allocates and frees memory.
+void MakeRequests(Allocator& allocator, uint64_t seed) {
+  random::XorShiftStarRng64 prng(seed);
+  std::array<void*, kSlots> slots{};
+  for (size_t i = 0; i < kRequestsPerThread; ++i) {
+    uint64_t value;
+    prng.GetInt(value);
+    void*& slot = slots[value % kSlots];
+    if (slot != nullptr) {
+      allocator.Deallocate(slot);
+      slot = nullptr;
+    } else {
+      size_t size = 1 + static_cast<size_t>(value >> 32) % kMaxRequestSize;
+      slot = allocator.Allocate(Layout(size, alignof(uint64_t)));
+    }
+  }
+  for (void* slot : slots) {
+    if (slot != nullptr) {
+      allocator.Deallocate(slot);
+    }
+  }
+}
+
+/// Returns the mean nanoseconds per request for `num_threads` threads.
+float RunThreads(Allocator& allocator, size_t num_threads) {
+  std::vector<std::thread> threads;
+  auto start = chrono::SystemClock::now();
+  for (size_t i = 0; i < num_threads; ++i) {
+    threads.emplace_back([&allocator, i] { MakeRequests(allocator, i + 1); });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  auto elapsed = chrono::SystemClock::now() - start;
+  auto nanoseconds =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+  return static_cast<float>(nanoseconds) /
+         static_cast<float>(num_threads * kRequestsPerThread);
+}
+
+/// Results for one allocator.
+struct Results {
+  Results(metric::Token name) : group(name) {}
+
+  void Record(size_t num_threads, float nanoseconds) {
+    switch (num_threads) {
+      case 1:
+        one_thread.Set(nanoseconds);
+        break;
+      case 2:
+        two_threads.Set(nanoseconds);
+        break;
+      case 4:
+        four_threads.Set(nanoseconds);
+        break;
+      case 8:
+        eight_threads.Set(nanoseconds);
+        break;
+    }
+  }
+
+  metric::Group group;
+  PW_METRIC(group, one_thread, "1 thread (ns per request)", 0.f);
+  PW_METRIC(group, two_threads, "2 threads (ns per request)", 0.f);
+  PW_METRIC(group, four_threads, "4 threads (ns per request)", 0.f);
+  PW_METRIC(group, eight_threads, "8 threads (ns per request)", 0.f);
+};
+
+void DoThreadCachingBenchmark() {
+  Results synchronized_results(
+      PW_TOKENIZE_STRING_EXPR("SynchronizedAllocator"));
+  Results caching_results(PW_TOKENIZE_STRING_EXPR("ThreadCachingAllocator"));
+
+  for (size_t num_threads = 1; num_threads <= kMaxThreads; num_threads *= 2) {
+    {
+      TlsfAllocator tlsf(buffer);
+      SynchronizedAllocator<sync::Mutex> allocator(tlsf);
+      synchronized_results.Record(num_threads,
+                                  RunThreads(allocator, num_threads));
+    }
+    {
+      TlsfAllocator tlsf(buffer);
+      ThreadCachingAllocator<sync::Mutex, kMaxThreads> allocator(
+          PW_TOKENIZE_STRING_EXPR("thread caching allocator"), tlsf);
+      caching_results.Record(num_threads, RunThreads(allocator, num_threads));
+    }
+  }
+
+  synchronized_results.group.Dump();
+  caching_results.group.Dump();
+}
+
+}  // namespace pw::allocator
+
+int main() {
+  pw::allocator::DoThreadCachingBenchmark();
+  return 0;
+}
@@ -14,17 +14,69 @@
 
 #include "pw_allocator/bump_allocator.h"
 
+#include <algorithm>
+#include <memory>
+#include <new>
+
 #include "pw_allocator/buffer.h"
+#include "pw_assert/assert.h"
 #include "pw_bytes/alignment.h"
+#include "pw_numeric/checked_arithmetic.h"
 
 namespace pw::allocator {
 
+/// Header at the start of each chunk allocated from the parent allocator.
+struct BumpAllocator::Chunk {
+  Chunk* next = nullptr;
+  size_t size = 0;
+};
+
 void BumpAllocator::Init(ByteSpan region) {
   Reset();
   remaining_ = region;
 }
 
+BumpAllocator::Mark BumpAllocator::GetMark() const {
+  Mark mark;
+  mark.remaining_ = remaining_;
+  mark.allocated_ = allocated_;
+  mark.owned_ = owned_;
+  mark.chunk_ = chunk_;
+  return mark;
+}
+
+void BumpAllocator::Rewind(const Mark& mark) {
+  PW_ASSERT(mark.allocated_ <= allocated_);
+  DestroyOwned(mark.owned_);
+  while (chunk_ != mark.chunk_) {
+    PW_ASSERT(chunk_ != nullptr);
+    Chunk* chunk = chunk_;
+    chunk_ = chunk->next;
+    chunk->next = unused_;
+    unused_ = chunk;
+  }
+  remaining_ = mark.remaining_;
+  allocated_ = mark.allocated_;
+}
+
+void BumpAllocator::ReleaseUnusedChunks() {
+  while (unused_ != nullptr) {
+    Chunk* chunk = unused_;
+    unused_ = chunk->next;
+    std::destroy_at(chunk);
+    parent_->Deallocate(chunk);
+  }
+}
+
 void* BumpAllocator::DoAllocate(Layout layout) {
+  void* ptr = AllocateFromRegion(layout);
+  if (ptr == nullptr && parent_ != nullptr && AddChunk(layout)) {
+    ptr = AllocateFromRegion(layout);
+  }
+  return ptr;
+}
+
+void* BumpAllocator::AllocateFromRegion(Layout layout) {
   size_t remaining = remaining_.size();
   ByteSpan region = GetAlignedSubspan(remaining_, layout.alignment());
   if (region.size() < layout.size()) {
@@ -35,13 +87,61 @@ void* BumpAllocator::DoAllocate(Layout layout) {
   return region.data();
 }
 
+bool BumpAllocator::AddChunk(Layout layout) {
+  constexpr size_t kHeaderSize = sizeof(Chunk);
+  size_t needed = kHeaderSize + layout.alignment() - 1;
+  if (!CheckedIncrement(needed, layout.size())) {
+    return false;
+  }
+
+  // Reuse a retained chunk if one is large enough.
+  Chunk* chunk = nullptr;
+  for (Chunk** prev = &unused_; *prev != nullptr; prev = &(*prev)->next) {
+    if ((*prev)->size >= needed) {
+      chunk = *prev;
+      *prev = chunk->next;
+      break;
+    }
+  }
+
+  if (chunk == nullptr) {
+    size_t size = std::max(chunk_size_, needed);
+    void* ptr = parent_->Allocate(Layout(size, alignof(Chunk)));
+    if (ptr == nullptr) {
+      return false;
+    }
+    chunk = new (ptr) Chunk();
+    chunk->size = size;
+  }
+  chunk->next = chunk_;
+  chunk_ = chunk;
+  auto* bytes = reinterpret_cast<std::byte*>(chunk);
+  remaining_ = ByteSpan(bytes + kHeaderSize, chunk->size - kHeaderSize);
+  return true;
+}
+
 void BumpAllocator::DoDeallocate(void*) {}
 
+void BumpAllocator::DestroyOwned(internal::GenericOwned* last) {
+  while (owned_ != last) {
+    PW_ASSERT(owned_ != nullptr);
+    internal::GenericOwned* owned = owned_;
+    owned_ = owned->next();
+    owned->Destroy();
+  }
+}
+
 void BumpAllocator::Reset() {
-  if (owned_ != nullptr) {
-    owned_->Destroy();
+  DestroyOwned(nullptr);
+  while (chunk_ != nullptr) {
+    Chunk* chunk = chunk_;
+    chunk_ = chunk->next;
+    chunk->next = unused_;
+    unused_ = chunk;
   }
+  ReleaseUnusedChunks();
   remaining_ = ByteSpan();
+  allocated_ = 0;
 }
 
 }  // namespace pw::allocator
@@ -15,8 +15,10 @@
 #include "pw_allocator/bump_allocator.h"
 
 #include <cstring>
+#include <limits>
 
 #include "lib/stdcompat/bit.h"
+#include "pw_allocator/testing.h"
 #include "pw_unit_test/framework.h"
 
 namespace {
@@ -25,6 +27,7 @@ namespace {
 
 using ::pw::allocator::BumpAllocator;
 using ::pw::allocator::Layout;
+using AllocatorForTest = ::pw::allocator::test::AllocatorForTest<1024>;
 
 class DestroyCounter final {
  public:
@@ -136,4 +139,168 @@ TEST(BumpAllocatorTest, MakeUniqueOwnedDestroys) {
   EXPECT_EQ(counter, 1U);
 }
 
+
+TEST(BumpAllocatorTest, NewOwnedDestroysAll) {
+  alignas(16) std::array<std::byte, 256> buffer;
+  size_t counter = 0;
+  {
+    BumpAllocator allocator(buffer);
+    allocator.NewOwned<DestroyCounter>(&counter);
+    allocator.NewOwned<DestroyCounter>(&counter);
+    allocator.NewOwned<DestroyCounter>(&counter);
+  }
+  EXPECT_EQ(counter, 3U);
+}
+
+TEST(BumpAllocatorTest, RewindFreesMemory) {
+  alignas(16) std::array<std::byte, 256> buffer;
+  BumpAllocator allocator(buffer);
+  ASSERT_NE(allocator.Allocate(Layout(64, 16)), nullptr);
+  BumpAllocator::Mark mark = allocator.GetMark();
+  EXPECT_EQ(allocator.GetAllocated(), 64U);
+
+  void* ptr = allocator.Allocate(Layout(192, 16));
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_EQ(allocator.Allocate(Layout(1, 1)), nullptr);
+  EXPECT_EQ(allocator.GetAllocated(), 256U);
+
+  allocator.Rewind(mark);
+  EXPECT_EQ(allocator.GetAllocated(), 64U);
+  EXPECT_EQ(allocator.Allocate(Layout(192, 16)), ptr);
+}
+
+TEST(BumpAllocatorTest, RewindDestroysOwnedObjectsAfterMark) {
+  alignas(16) std::array<std::byte, 256> buffer;
+  size_t before = 0;
+  size_t after = 0;
+  {
+    BumpAllocator allocator(buffer);
+    allocator.NewOwned<DestroyCounter>(&before);
+    BumpAllocator::Mark mark = allocator.GetMark();
+    allocator.NewOwned<DestroyCounter>(&after);
+    allocator.NewOwned<DestroyCounter>(&after);
+    allocator.Rewind(mark);
+    EXPECT_EQ(before, 0U);
+    EXPECT_EQ(after, 2U);
+  }
+  EXPECT_EQ(before, 1U);
+  EXPECT_EQ(after, 2U);
+}
+
+TEST(BumpAllocatorTest, NestedScopes) {
+  alignas(16) std::array<std::byte, 256> buffer;
+  size_t outer = 0;
+  size_t inner = 0;
+  BumpAllocator allocator(buffer);
+  {
+    BumpAllocator::Scope outer_scope(allocator);
+    allocator.NewOwned<DestroyCounter>(&outer);
+    size_t allocated = allocator.GetAllocated();
+    {
+      BumpAllocator::Scope inner_scope(allocator);
+      allocator.NewOwned<DestroyCounter>(&inner);
+      EXPECT_GT(allocator.GetAllocated(), allocated);
+    }
+    EXPECT_EQ(inner, 1U);
+    EXPECT_EQ(outer, 0U);
+    EXPECT_EQ(allocator.GetAllocated(), allocated);
+  }
+  EXPECT_EQ(outer, 1U);
+  EXPECT_EQ(allocator.GetAllocated(), 0U);
+}
+
+TEST(BumpAllocatorTest, AllocatesChunksFromParent) {
+  AllocatorForTest parent;
+  BumpAllocator allocator(parent, 128);
+  EXPECT_EQ(parent.GetAllocated(), 0U);
+
+  void* ptr1 = allocator.Allocate(Layout(64, 8));
+  ASSERT_NE(ptr1, nullptr);
+  size_t one_chunk = parent.GetAllocated();
+  EXPECT_GE(one_chunk, 128U);
+
+  // Fits in the first chunk.
+  void* ptr2 = allocator.Allocate(Layout(32, 8));
+  ASSERT_NE(ptr2, nullptr);
+  EXPECT_EQ(parent.GetAllocated(), one_chunk);
+
+  // Needs a second chunk.
+  void* ptr3 = allocator.Allocate(Layout(64, 8));
+  ASSERT_NE(ptr3, nullptr);
+  EXPECT_GT(parent.GetAllocated(), one_chunk);
+}
+
+TEST(BumpAllocatorTest, LargeRequestGetsItsOwnChunk) {
+  AllocatorForTest parent;
+  BumpAllocator allocator(parent, 128);
+  void* ptr = allocator.Allocate(Layout(512, 16));
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_EQ(cpp20::bit_cast<uintptr_t>(ptr) % 16, 0U);
+  EXPECT_GE(parent.GetAllocated(), 512U);
+}
+
+TEST(BumpAllocatorTest, RewindRetainsChunksForReuse) {
+  AllocatorForTest parent;
+  BumpAllocator allocator(parent, 128);
+  auto handle_request = [&allocator]() {
+    BumpAllocator::Scope scope(allocator);
+    for (size_t i = 0; i < 8; ++i) {
+      ASSERT_NE(allocator.Allocate(Layout(48, 8)), nullptr);
+    }
+  };
+  handle_request();
+  size_t allocated = parent.GetAllocated();
+  EXPECT_NE(allocated, 0U);
+
+  // In steady state, the parent allocator is not used.
+  parent.ResetParameters();
+  handle_request();
+  handle_request();
+  EXPECT_EQ(parent.allocate_size(), 0U);
+  EXPECT_EQ(parent.deallocate_ptr(), nullptr);
+  EXPECT_EQ(parent.GetAllocated(), allocated);
+
+  allocator.ReleaseUnusedChunks();
+  EXPECT_EQ(parent.GetAllocated(), 0U);
+}
+
+TEST(BumpAllocatorTest, DestructorReturnsChunksToParent) {
+  AllocatorForTest parent;
+  {
+    BumpAllocator allocator(parent, 128);
+    ASSERT_NE(allocator.Allocate(Layout(64, 8)), nullptr);
+    ASSERT_NE(allocator.Allocate(Layout(64, 8)), nullptr);
+    EXPECT_NE(parent.GetAllocated(), 0U);
+  }
+  EXPECT_EQ(parent.GetAllocated(), 0U);
+}
+
+TEST(BumpAllocatorTest, UsesRegionBeforeChunks) {
+  alignas(16) std::array<std::byte, 64> buffer;
+  AllocatorForTest parent;
+  BumpAllocator allocator(parent, 128);
+  allocator.Init(buffer);
+  void* ptr = allocator.Allocate(Layout(64, 16));
+  EXPECT_EQ(ptr, buffer.data());
+  EXPECT_EQ(parent.GetAllocated(), 0U);
+
+  ASSERT_NE(allocator.Allocate(Layout(16, 8)), nullptr);
+  EXPECT_NE(parent.GetAllocated(), 0U);
+}
+
+TEST(BumpAllocatorTest, AllocateFailsWhenParentIsExhausted) {
+  AllocatorForTest parent;
+  BumpAllocator allocator(parent, 128);
+  EXPECT_EQ(allocator.Allocate(Layout(2048, 8)), nullptr);
+}
+
+TEST(BumpAllocatorTest, AllocateFailsWhenChunkSizeOverflows) {
+  AllocatorForTest parent;
+  BumpAllocator allocator(parent, 128);
+  constexpr size_t kMaxSize = std::numeric_limits<size_t>::max();
+  EXPECT_EQ(allocator.Allocate(Layout(kMaxSize - 8, 8)), nullptr);
+  EXPECT_EQ(parent.allocate_size(), 0U);
+  EXPECT_EQ(parent.GetAllocated(), 0U);
+}
+
 }  // namespace
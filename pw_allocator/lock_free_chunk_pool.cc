@@ -0,0 +1,123 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_allocator/lock_free_chunk_pool.h"
+
+#include <algorithm>
+#include <new>
+
+#include "lib/stdcompat/bit.h"
+#include "pw_allocator/buffer.h"
+#include "pw_assert/check.h"
+#include "pw_bytes/alignment.h"
+
+namespace pw::allocator {
+
+static Layout EnsureLinkLayout(const Layout& layout) {
+  return Layout(std::max(layout.size(), LockFreeChunkPool::kMinSize),
+                std::max(layout.alignment(), LockFreeChunkPool::kMinAlignment));
+}
+
+LockFreeChunkPool::LockFreeChunkPool(ByteSpan region, const Layout& layout)
+    : Pool(kCapabilities, layout),
+      allocated_layout_(EnsureLinkLayout(layout)),
+      head_(0) {
+  Result<ByteSpan> result =
+      GetAlignedSubspan(region, allocated_layout_.alignment());
+  if constexpr (Hardening::kIncludesDebugChecks) {
+    PW_CHECK_OK(result.status());
+  }
+  region = result.value();
+  size_t num_chunks = region.size() / allocated_layout_.size();
+  PW_CHECK_UINT_LE(num_chunks, kMaxChunks);
+  start_ = cpp20::bit_cast<uintptr_t>(region.data());
+  end_ = start_ + num_chunks * allocated_layout_.size();
+
+  // Link the chunks in address order. No other thread can see the pool yet, so
+  // no ordering is needed.
+  for (uintptr_t index = 1; index <= num_chunks; ++index) {
+    uintptr_t next = index < num_chunks ? index + 1 : 0;
+    auto* addr = region.data() + (index - 1) * allocated_layout_.size();
+    new (addr) std::atomic<uintptr_t>(next);
+  }
+  head_.store(num_chunks == 0 ? 0 : 1, std::memory_order_relaxed);
+}
+
+std::atomic<uintptr_t>& LockFreeChunkPool::LinkAt(uintptr_t index) const {
+  uintptr_t addr = start_ + (index - 1) * allocated_layout_.size();
+  return *std::launder(reinterpret_cast<std::atomic<uintptr_t>*>(addr));
+}
+
+void* LockFreeChunkPool::DoAllocate() {
+  uintptr_t head = head_.load(std::memory_order_acquire);
+  uintptr_t index;
+  uintptr_t desired;
+  do {
+    index = head & kIndexMask;
+    if (index == 0) {
+      return nullptr;
+    }
+    // The chunk may be allocated and overwritten by another thread before this
+    // load. If so, the tag will have changed and the exchange below will fail.
+    uintptr_t next = LinkAt(index).load(std::memory_order_relaxed);
+    uintptr_t tag = (head >> kTagShift) + 1;
+    desired = (tag << kTagShift) | (next & kIndexMask);
+  } while (!head_.compare_exchange_weak(
+      head, desired, std::memory_order_acquire, std::memory_order_acquire));
+  return cpp20::bit_cast<void*>(start_ +
+                                (index - 1) * allocated_layout_.size());
+}
+
+void LockFreeChunkPool::DoDeallocate(void* ptr) {
+  if (ptr == nullptr) {
+    return;
+  }
+  uintptr_t addr = cpp20::bit_cast<uintptr_t>(ptr);
+  uintptr_t index = (addr - start_) / allocated_layout_.size() + 1;
+  auto* link = new (ptr) std::atomic<uintptr_t>(0);
+  uintptr_t head = head_.load(std::memory_order_relaxed);
+  uintptr_t desired;
+  do {
+    link->store(head & kIndexMask, std::memory_order_relaxed);
+    desired = (head & ~kIndexMask) | index;
+  } while (!head_.compare_exchange_weak(
+      head, desired, std::memory_order_release, std::memory_order_relaxed));
+}
+
+Result<Layout> LockFreeChunkPool::DoGetInfo(InfoType info_type,
+                                            const void* ptr) const {
+  if (info_type == InfoType::kCapacity) {
+    return Layout(end_ - start_, allocated_layout_.alignment());
+  }
+  auto addr = cpp20::bit_cast<uintptr_t>(ptr);
+  if (addr < start_ || end_ <= addr) {
+    return Status::OutOfRange();
+  }
+  if ((addr - start_) % allocated_layout_.size() != 0) {
+    return Status::OutOfRange();
+  }
+  switch (info_type) {
+    case InfoType::kRequestedLayoutOf:
+    case InfoType::kUsableLayoutOf:
+    case InfoType::kAllocatedLayoutOf:
+      return allocated_layout_;
+    case InfoType::kRecognizes:
+      return Layout();
+    case InfoType::kCapacity:
+    default:
+      return Status::Unimplemented();
+  }
+}
+
+}  // namespace pw::allocator
@@ -0,0 +1,302 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_allocator/lock_free_chunk_pool.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "pw_allocator/internal/counter.h"
+#include "pw_allocator/testing.h"
+#include "pw_thread/test_thread_context.h"
+#include "pw_thread/thread.h"
+#include "pw_unit_test/framework.h"
+
+namespace {
+
+// Test fixtures.
+
+using ::pw::allocator::Layout;
+using ::pw::allocator::LockFreeChunkPool;
+using ::pw::allocator::test::Counter;
+using LockFreeChunkPoolTest = pw::allocator::test::TestWithCounters;
+
+struct U64 {
+  std::byte bytes[8];
+};
+
+// Unit tests.
+
+TEST_F(LockFreeChunkPoolTest, Capabilities) {
+  std::array<std::byte, 256> buffer;
+  LockFreeChunkPool pool(buffer, Layout::Of<U64>());
+  EXPECT_EQ(pool.capabilities(), LockFreeChunkPool::kCapabilities);
+}
+
+TEST_F(LockFreeChunkPoolTest, AllocateDeallocate) {
+  std::array<std::byte, 256> buffer;
+  LockFreeChunkPool pool(buffer, Layout::Of<U64>());
+
+  void* ptr = pool.Allocate();
+  ASSERT_NE(ptr, nullptr);
+  pool.Deallocate(ptr);
+}
+
+TEST_F(LockFreeChunkPoolTest, ExhaustTwice) {
+  constexpr size_t kNumU64s = 32;
+  constexpr size_t kBufferSize = sizeof(U64) * kNumU64s;
+  std::array<std::byte, kBufferSize> buffer;
+  LockFreeChunkPool pool(buffer, Layout::Of<U64>());
+
+  // Allocate everything.
+  std::array<void*, kNumU64s> ptrs;
+  for (auto& ptr : ptrs) {
+    ptr = pool.Allocate();
+    ASSERT_NE(ptr, nullptr);
+  }
+
+  // At this point, the pool is empty.
+  EXPECT_EQ(pool.Allocate(), nullptr);
+
+  // Now refill the pool, and show it can be emptied again.
+  for (auto& ptr : ptrs) {
+    pool.Deallocate(ptr);
+    ptr = nullptr;
+  }
+  for (auto& ptr : ptrs) {
+    ptr = pool.Allocate();
+    ASSERT_NE(ptr, nullptr);
+  }
+
+  // Release everything.
+  for (auto& ptr : ptrs) {
+    pool.Deallocate(ptr);
+    ptr = nullptr;
+  }
+}
+
+TEST_F(LockFreeChunkPoolTest, NewDelete) {
+  std::array<std::byte, 256> buffer;
+  LockFreeChunkPool pool(buffer, Layout::Of<Counter>());
+
+  auto* counter = pool.New<Counter>(867u);
+  ASSERT_NE(counter, nullptr);
+  EXPECT_EQ(counter->value(), 867u);
+  pool.Delete(counter);
+  EXPECT_EQ(Counter::TakeNumDtorCalls(), 1u);
+}
+
+TEST_F(LockFreeChunkPoolTest, NewDeleteBoundedArray) {
+  std::array<std::byte, 256> buffer;
+  Layout layout(sizeof(Counter) * 3, alignof(Counter));
+  LockFreeChunkPool pool(buffer, layout);
+
+  auto* counters = pool.New<Counter[3]>();
+  ASSERT_NE(counters, nullptr);
+  for (size_t i = 0; i < 3; ++i) {
+    EXPECT_EQ(counters[i].value(), i);
+  }
+  pool.Delete<Counter[3]>(counters);
+  EXPECT_EQ(Counter::TakeNumDtorCalls(), 3u);
+}
+
+TEST_F(LockFreeChunkPoolTest, NewDeleteUnboundedArray) {
+  std::array<std::byte, 256> buffer;
+  Layout layout(sizeof(Counter) * 5, alignof(Counter));
+  LockFreeChunkPool pool(buffer, layout);
+
+  auto* counters = pool.New<Counter[]>();
+  ASSERT_NE(counters, nullptr);
+  for (size_t i = 0; i < 5; ++i) {
+    EXPECT_EQ(counters[i].value(), i);
+  }
+  pool.Delete<Counter[]>(counters, 5);
+  EXPECT_EQ(Counter::TakeNumDtorCalls(), 5u);
+}
+
+TEST_F(LockFreeChunkPoolTest, NewDeleteArray) {
+  std::array<std::byte, 256> buffer;
+  Layout layout(sizeof(Counter) * 3, alignof(Counter));
+  LockFreeChunkPool pool(buffer, layout);
+
+  auto* counters = pool.New<Counter[3]>();
+  ASSERT_NE(counters, nullptr);
+  for (size_t i = 0; i < 3; ++i) {
+    EXPECT_EQ(counters[i].value(), i);
+  }
+  pool.DeleteArray(counters, 3);
+  EXPECT_EQ(Counter::TakeNumDtorCalls(), 3u);
+}
+
+TEST_F(LockFreeChunkPoolTest, MakeUnique) {
+  std::array<std::byte, 256> buffer;
+  LockFreeChunkPool pool(buffer, Layout::Of<Counter>());
+  {
+    auto counter = pool.MakeUnique<Counter>(5309u);
+    ASSERT_NE(counter, nullptr);
+    EXPECT_EQ(counter->value(), 5309u);
+  }
+  EXPECT_EQ(Counter::TakeNumDtorCalls(), 1u);
+}
+
+TEST_F(LockFreeChunkPoolTest, MakeUniqueBoundedArray) {
+  std::array<std::byte, 256> buffer;
+  Layout layout(sizeof(Counter) * 7, alignof(Counter));
+  LockFreeChunkPool pool(buffer, layout);
+  {
+    auto counters = pool.MakeUnique<Counter[7]>();
+    ASSERT_NE(counters, nullptr);
+    for (size_t i = 0; i < 7; ++i) {
+      EXPECT_EQ(counters[i].value(), i);
+    }
+  }
+  EXPECT_EQ(Counter::TakeNumDtorCalls(), 7u);
+}
+
+TEST_F(LockFreeChunkPoolTest, MakeUniqueBoundedArrayDifferentType) {
+  std::array<std::byte, 256> buffer;
+  Layout layout(sizeof(Counter) * 7, alignof(Counter));
+  LockFreeChunkPool pool(buffer, layout);
+  auto bytes = pool.MakeUnique<std::byte[sizeof(Counter) * 7]>();
+  ASSERT_NE(bytes, nullptr);
+  EXPECT_EQ(bytes.size(), layout.size());
+}
+
+TEST_F(LockFreeChunkPoolTest, MakeUniqueUnboundedArray) {
+  std::array<std::byte, 256> buffer;
+  Layout layout(sizeof(Counter) * 9, alignof(Counter));
+  LockFreeChunkPool pool(buffer, layout);
+  {
+    auto counters = pool.MakeUnique<Counter[]>();
+    ASSERT_NE(counters, nullptr);
+    for (size_t i = 0; i < 9; ++i) {
+      EXPECT_EQ(counters[i].value(), i);
+    }
+  }
+  EXPECT_EQ(Counter::TakeNumDtorCalls(), 9u);
+}
+
+TEST_F(LockFreeChunkPoolTest, MakeUniqueUnboundedArrayDifferentType) {
+  std::array<std::byte, 256> buffer;
+  Layout layout(sizeof(Counter) * 9, alignof(Counter));
+  LockFreeChunkPool pool(buffer, layout);
+  auto bytes = pool.MakeUnique<std::byte[]>();
+  ASSERT_NE(bytes, nullptr);
+  EXPECT_EQ(bytes.size(), layout.size());
+}
+
+TEST_F(LockFreeChunkPoolTest, ReusesMostRecentlyFreedChunk) {
+  std::array<std::byte, 256> buffer;
+  LockFreeChunkPool pool(buffer, Layout::Of<U64>());
+
+  void* ptr1 = pool.Allocate();
+  void* ptr2 = pool.Allocate();
+  ASSERT_NE(ptr1, nullptr);
+  ASSERT_NE(ptr2, nullptr);
+  pool.Deallocate(ptr1);
+  pool.Deallocate(ptr2);
+  EXPECT_EQ(pool.Allocate(), ptr2);
+  EXPECT_EQ(pool.Allocate(), ptr1);
+  pool.Deallocate(ptr1);
+  pool.Deallocate(ptr2);
+}
+
+// TODO: https://pwbug.dev/365161669 - Express joinability as a build-system
+// constraint.
+#if PW_THREAD_JOINING_ENABLED
+
+/// Thread body that repeatedly allocates, fills, checks, and frees chunks.
+class Worker {
+ public:
+  Worker(pw::allocator::Pool& pool, uint8_t id) : pool_(pool), id_(id) {}
+
+  bool corrupted() const { return corrupted_; }
+
+  void Run() {
+    constexpr size_t kIterations = 10000;
+    std::array<void*, 4> ptrs{};
+    for (size_t i = 0; i < kIterations; ++i) {
+      void*& ptr = ptrs[i % ptrs.size()];
+      if (ptr != nullptr) {
+        Check(ptr);
+        pool_.Deallocate(ptr);
+      }
+      ptr = pool_.Allocate();
+      if (ptr != nullptr) {
+        std::memset(ptr, id_, sizeof(U64));
+      }
+    }
+    for (void* ptr : ptrs) {
+      if (ptr != nullptr) {
+        Check(ptr);
+        pool_.Deallocate(ptr);
+      }
+    }
+  }
+
+ private:
+  void Check(void* ptr) {
+    auto* bytes = static_cast<uint8_t*>(ptr);
+    for (size_t i = 0; i < sizeof(U64); ++i) {
+      if (bytes[i] != id_) {
+        corrupted_ = true;
+        return;
+      }
+    }
+  }
+
+  pw::allocator::Pool& pool_;
+  const uint8_t id_;
+  bool corrupted_ = false;
+};
+
+TEST_F(LockFreeChunkPoolTest, ManyThreads) {
+  // Fewer chunks than the workers can hold at once, so that the pool is
+  // frequently exhausted.
+  constexpr size_t kNumU64s = 8;
+  std::array<std::byte, sizeof(U64) * kNumU64s> buffer;
+  LockFreeChunkPool pool(buffer, Layout::Of<U64>());
+
+  Worker worker1(pool, 1);
+  Worker worker2(pool, 2);
+  Worker worker3(pool, 3);
+  pw::thread::test::TestThreadContext context1;
+  pw::thread::test::TestThreadContext context2;
+  pw::Thread thread1(context1.options(), [&worker1] { worker1.Run(); });
+  pw::Thread thread2(context2.options(), [&worker2] { worker2.Run(); });
+  worker3.Run();
+  thread1.join();
+  thread2.join();
+
+  EXPECT_FALSE(worker1.corrupted());
+  EXPECT_FALSE(worker2.corrupted());
+  EXPECT_FALSE(worker3.corrupted());
+
+  // Every chunk was returned.
+  std::array<void*, kNumU64s> ptrs;
+  for (auto& ptr : ptrs) {
+    ptr = pool.Allocate();
+    ASSERT_NE(ptr, nullptr);
+  }
+  EXPECT_EQ(pool.Allocate(), nullptr);
+  for (auto& ptr : ptrs) {
+    pool.Deallocate(ptr);
+  }
+}
+
+#endif  // PW_THREAD_JOINING_ENABLED
+
+}  // namespace
@@ -26,6 +26,7 @@ namespace internal {
 class GenericOwned {
  public:
   virtual ~GenericOwned() = default;
+  GenericOwned* next() const { return next_; }
   void set_next(GenericOwned* next) { next_ = next; }
   void Destroy() { DoDestroy(); }
 
@@ -73,21 +74,98 @@ class Owned : public GenericOwned {
 /// `MakeUnique` are NOT called. To have these destructors invoked, you can
 /// allocate "owned" objects using `NewOwned` and `MakeUniqueOwned`. This adds a
 /// small amount of overhead to the allocation.
+///
+/// Memory can also be freed in bulk before the allocator is destroyed.
+/// `GetMark` records the allocator's current position, and `Rewind` frees
+/// everything allocated since then, destroying any owned objects. `Scope` does
+/// both automatically, and scopes may be nested. For example, a handler can
+/// free all of the temporary objects it allocates for a request at once:
+///
+/// @code{.cpp}
+///   void HandleRequest(BumpAllocator& arena, ConstByteSpan request) {
+///     BumpAllocator::Scope scope(arena);
+///     auto* message = arena.New<Message>();
+///     ...
+///   }  // Everything allocated above is freed here.
+/// @endcode
+///
+/// Optionally, a bump allocator can be given a parent allocator. When its
+/// current region is exhausted, it allocates another region, or "chunk", from
+/// the parent. Chunks freed by rewinding are kept for reuse, so a workload that
+/// repeatedly allocates and rewinds does not use the parent allocator once it
+/// has allocated enough chunks for its largest scope.
 class BumpAllocator : public Allocator {
+ private:
+  struct Chunk;
+
  public:
   static constexpr Capabilities kCapabilities = kSkipsDestroy;
 
+  /// A position in a bump allocator's memory, returned by `GetMark`.
+  class Mark {
+   private:
+    friend class BumpAllocator;
+
+    ByteSpan remaining_;
+    size_t allocated_ = 0;
+    internal::GenericOwned* owned_ = nullptr;
+    Chunk* chunk_ = nullptr;
+  };
+
+  /// Frees everything allocated from a bump allocator while this object is in
+  /// scope.
+  class Scope {
+   public:
+    explicit Scope(BumpAllocator& allocator)
+        : allocator_(allocator), mark_(allocator.GetMark()) {}
+
+    ~Scope() { allocator_.Rewind(mark_); }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+   private:
+    BumpAllocator& allocator_;
+    Mark mark_;
+  };
+
   /// Constructs a BumpAllocator without initializing it.
   constexpr BumpAllocator() : Allocator(kCapabilities) {}
 
   /// Constructs a BumpAllocator and initializes it.
   explicit BumpAllocator(ByteSpan region) : BumpAllocator() { Init(region); }
 
+  /// Constructs a BumpAllocator that allocates chunks of memory as needed.
+  ///
+  /// @param[in]  parent      Allocator used to allocate chunks.
+  /// @param[in]  chunk_size  Size of each chunk, including a small header.
+  ///                         Requests too large to fit in a chunk of this size
+  ///                         are given a larger chunk of their own.
+  BumpAllocator(Allocator& parent, size_t chunk_size)
+      : Allocator(kCapabilities), parent_(&parent), chunk_size_(chunk_size) {}
+
   ~BumpAllocator() override { Reset(); }
 
   /// Sets the memory region to be used by the allocator.
+  ///
+  /// Any previously allocated memory is freed and any chunks are returned to
+  /// the parent allocator. If the allocator has a parent, it uses the region
+  /// before allocating chunks.
   void Init(ByteSpan region);
 
+  /// Returns the current position of the allocator.
+  Mark GetMark() const;
+
+  /// Frees all memory allocated since `mark` was returned by `GetMark`.
+  ///
+  /// The destructors of owned objects allocated since then are invoked, and
+  /// chunks allocated since then are retained for reuse. Rewinding to a mark
+  /// invalidates any marks obtained after it.
+  void Rewind(const Mark& mark);
+
+  /// Returns chunks that are retained for reuse to the parent allocator.
+  void ReleaseUnusedChunks();
+
   /// Constructs an "owned" object of type `T` from the given `args`
   ///
   /// Owned objects will have their destructors invoked when the allocator goes
@@ -135,12 +213,32 @@ class BumpAllocator : public Allocator {
   /// @copydoc Allocator::GetAllocated
   size_t DoGetAllocated() const override { return allocated_; }
 
-  /// Frees any owned objects and discards remaining memory.
+  /// Frees any owned objects, discards remaining memory, and returns any chunks
+  /// to the parent allocator.
   void Reset();
 
+  /// Allocates memory from the current region.
+  void* AllocateFromRegion(Layout layout);
+
+  /// Gets a chunk with room for the given layout, and makes it the current
+  /// region.
+  bool AddChunk(Layout layout);
+
+  /// Destroys owned objects until reaching the given one.
+  void DestroyOwned(internal::GenericOwned* last);
+
   size_t allocated_ = 0;
   ByteSpan remaining_;
   internal::GenericOwned* owned_ = nullptr;
+
+  Allocator* parent_ = nullptr;
+  size_t chunk_size_ = 0;
+
+  /// Chunks in use, from most to least recently allocated.
+  Chunk* chunk_ = nullptr;
+
+  /// Chunks retained for reuse.
+  Chunk* unused_ = nullptr;
 };
 
 }  // namespace pw::allocator
@@ -0,0 +1,90 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_allocator/capability.h"
+#include "pw_allocator/layout.h"
+#include "pw_allocator/pool.h"
+#include "pw_bytes/span.h"
+#include "pw_status/status.h"
+
+namespace pw::allocator {
+
+/// Implementation of ``Pool`` that may be used from multiple threads without
+/// a lock.
+///
+/// Like ``ChunkPool``, this pool keeps a list of free chunks. The list is a
+/// Treiber stack: allocating and deallocating each take a single
+/// compare-and-swap on the head of the list. This makes the pool suitable for
+/// passing fixed-size buffers between threads, or between threads and
+/// interrupt handlers, without a mutex.
+///
+/// To avoid the ABA problem, the head of the list is stored as a chunk index
+/// combined with a tag that changes every time a chunk is allocated. On targets
+/// where ``uintptr_t`` is 32 bits, this limits the pool to 65535 chunks.
+///
+/// The first ``sizeof(uintptr_t)`` bytes of each free chunk are used to store
+/// the index of the next free chunk.
+class LockFreeChunkPool : public Pool {
+ public:
+  static constexpr Capabilities kCapabilities =
+      kImplementsGetRequestedLayout | kImplementsGetUsableLayout |
+      kImplementsGetAllocatedLayout | kImplementsGetCapacity |
+      kImplementsRecognizes;
+  static constexpr size_t kMinSize = sizeof(std::atomic<uintptr_t>);
+  static constexpr size_t kMinAlignment = alignof(std::atomic<uintptr_t>);
+
+  /// Maximum number of chunks that a pool may contain.
+  static constexpr size_t kMaxChunks =
+      (uintptr_t(1) << (sizeof(uintptr_t) * 4)) - 1;
+
+  /// Construct a `Pool` that allocates from a region of memory.
+  ///
+  /// @param  region      The memory to allocate from. Must be large enough to
+  ///                     allocate at least one chunk with the given layout,
+  ///                     and must not hold more than `kMaxChunks` chunks.
+  /// @param  layout      The size and alignment of the memory to be returned
+  ///                     from this pool.
+  LockFreeChunkPool(ByteSpan region, const Layout& layout);
+
+ private:
+  static constexpr size_t kTagShift = sizeof(uintptr_t) * 4;
+  static constexpr uintptr_t kIndexMask = (uintptr_t(1) << kTagShift) - 1;
+
+  /// Returns the link stored in the chunk with the given 1-based index.
+  std::atomic<uintptr_t>& LinkAt(uintptr_t index) const;
+
+  /// @copydoc Pool::Allocate
+  void* DoAllocate() override;
+
+  /// @copydoc Deallocator::Deallocate
+  void DoDeallocate(void* ptr) override;
+
+  /// @copydoc Deallocator::GetInfo
+  Result<Layout> DoGetInfo(InfoType info_type, const void* ptr) const override;
+
+  const Layout allocated_layout_;
+  uintptr_t start_;
+  uintptr_t end_;
+
+  /// Tag in the upper half, and 1-based index of the first free chunk in the
+  /// lower half. An index of 0 means the pool is exhausted.
+  std::atomic<uintptr_t> head_;
+};
+
+}  // namespace pw::allocator
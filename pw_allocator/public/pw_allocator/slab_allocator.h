@@ -0,0 +1,238 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "lib/stdcompat/bit.h"
+#include "pw_allocator/allocator.h"
+#include "pw_allocator/capability.h"
+#include "pw_allocator/layout.h"
+#include "pw_containers/intrusive_list.h"
+#include "pw_result/result.h"
+#include "pw_span/span.h"
+#include "pw_status/try.h"
+
+namespace pw::allocator {
+namespace internal {
+
+/// Header at the start of each slab.
+///
+/// A slab is a region of memory allocated from a parent allocator that is
+/// divided into objects of a single size. Slabs are aligned to their size, so
+/// the slab containing an object can be found from the object's address.
+struct Slab : public containers::future::IntrusiveList<Slab>::Item {
+  /// Links freed objects. Stored in the memory of each free object.
+  struct FreeObject {
+    FreeObject* next;
+  };
+
+  /// Objects that have been freed and not reallocated.
+  FreeObject* free = nullptr;
+
+  /// Number of objects currently allocated from this slab.
+  uint16_t num_used = 0;
+
+  /// Number of objects that have been carved from this slab. Objects past this
+  /// have never been allocated, and are not on the free list.
+  uint16_t num_carved = 0;
+
+  /// Index of the size class that owns this slab.
+  uint16_t size_class = 0;
+};
+
+/// Slabs of a single object size.
+struct SlabSizeClass {
+  /// Distance between objects, and the usable size of each.
+  size_t object_size = 0;
+
+  /// Minimum alignment of each object.
+  size_t alignment = 0;
+
+  /// Number of objects that fit in each slab.
+  uint16_t objects_per_slab = 0;
+
+  /// Slabs with at least one allocated object and at least one free object.
+  containers::future::IntrusiveList<Slab> partial;
+
+  /// Slabs with no free objects.
+  containers::future::IntrusiveList<Slab> full;
+
+  /// A slab with no allocated objects, retained to avoid calling the parent
+  /// allocator each time a single object is allocated and freed.
+  Slab* empty = nullptr;
+};
+
+/// Size-independent slab allocator.
+///
+/// Compared to `SlabAllocator`, this implementation is agnostic with respect to
+/// the number of size classes.
+class GenericSlabAllocator final {
+ public:
+  static constexpr Capabilities kCapabilities = kImplementsGetUsableLayout |
+                                                kImplementsGetAllocatedLayout |
+                                                kImplementsRecognizes;
+
+  static constexpr size_t kDefaultSlabSize = 1024;
+
+  /// Alignment of the first object in each slab.
+  static constexpr size_t kMaxAlignment = alignof(std::max_align_t);
+
+  /// Constructs a slab allocator.
+  ///
+  /// @param[in] parent         Allocator used to allocate slabs.
+  /// @param[in] size_classes   Storage for the size classes.
+  /// @param[in] sizes          Object sizes of each size class, in increasing
+  ///                           order.
+  /// @param[in] slab_size      Size and alignment of each slab.
+  GenericSlabAllocator(Allocator& parent,
+                       span<SlabSizeClass> size_classes,
+                       span<const size_t> sizes,
+                       size_t slab_size);
+
+  /// @copydoc Allocator::Allocate
+  void* Allocate(Layout layout);
+
+  /// @copydoc Deallocator::Deallocate
+  void Deallocate(void* ptr);
+
+  /// @copydoc Allocator::Resize
+  bool Resize(void* ptr, size_t new_size);
+
+  /// Returns the layout of an object allocated by this object, or
+  /// `OUT_OF_RANGE` if the pointer was not allocated by it.
+  ///
+  /// Unlike the other methods, this takes time proportional to the number of
+  /// slabs, since it must check that the slab containing `ptr` exists.
+  Result<Layout> GetLayout(const void* ptr) const;
+
+  /// Returns retained empty slabs to the parent allocator.
+  void ReleaseEmptySlabs();
+
+  /// Ensures all allocations have been freed, and returns all slabs to the
+  /// parent allocator. Crashes with a diagnostic message if any allocations
+  /// remain outstanding.
+  void CrashIfAllocated();
+
+ private:
+  /// Returns the slab that contains the given object.
+  Slab& GetSlab(const void* ptr) const;
+
+  /// Returns the address of the object with the given index in a slab.
+  std::byte* GetObject(Slab& slab, size_t index) const;
+
+  /// Gets a slab with at least one free object for the given size class.
+  Slab* GetPartialSlab(SlabSizeClass& size_class, uint16_t index);
+
+  /// Destroys a slab and returns its memory to the parent allocator.
+  void ReleaseSlab(Slab* slab);
+
+  Allocator& parent_;
+  span<SlabSizeClass> size_classes_;
+  const size_t slab_size_;
+  const size_t objects_offset_;
+};
+
+}  // namespace internal
+
+/// Allocator that serves a few fixed object sizes from slabs.
+///
+/// This allocator allocates slabs of `kSlabSize` bytes from a parent
+/// allocator, and divides each slab into objects of a single size class. A
+/// request is served from the smallest size class that fits it, with O(1)
+/// allocation and deallocation. Objects have no per-object header; the only
+/// overhead is a small header per slab and the rounding up of requests to the
+/// next size class.
+///
+/// Use this allocator when most allocations have one of a small number of
+/// sizes that are known ahead of time, such as the sizes of a few object types.
+///
+/// * Requests larger than the largest size class fail. Use a
+///   `FallbackAllocator` to serve them from another allocator.
+/// * Each size class is rounded up to a multiple of `alignof(void*)`. Objects
+///   are aligned to the largest power of two that divides their rounded size,
+///   up to `alignof(std::max_align_t)`. Requests with larger alignments fail.
+/// * When all of the objects in a slab are freed, the slab is returned to the
+///   parent allocator, except for one empty slab per size class which is kept
+///   for reuse. `ReleaseEmptySlabs` returns these as well.
+///
+/// The parent allocator must support allocations aligned to `kSlabSize`.
+///
+/// @tparam   kNumSizeClasses Number of different object sizes.
+/// @tparam   kSlabSize       Size of each slab. Must be a power of two, and
+///                           large enough to hold at least one object of the
+///                           largest size class.
+template <size_t kNumSizeClasses,
+          size_t kSlabSize_ = internal::GenericSlabAllocator::kDefaultSlabSize>
+class SlabAllocator : public Allocator {
+ public:
+  static constexpr Capabilities kCapabilities =
+      internal::GenericSlabAllocator::kCapabilities;
+  static constexpr size_t kSlabSize = kSlabSize_;
+
+  static_assert(kNumSizeClasses > 0);
+  static_assert(cpp20::has_single_bit(kSlabSize),
+                "kSlabSize must be a power of 2");
+
+  /// Constructs a slab allocator.
+  ///
+  /// @param[in]  parent  Allocator used to allocate slabs.
+  /// @param[in]  sizes   Object sizes of each size class, in increasing order.
+  SlabAllocator(Allocator& parent,
+                const std::array<size_t, kNumSizeClasses>& sizes)
+      : Allocator(kCapabilities),
+        impl_(parent, size_classes_, sizes, kSlabSize) {}
+
+  ~SlabAllocator() override { impl_.CrashIfAllocated(); }
+
+  /// Returns slabs with no allocated objects to the parent allocator.
+  void ReleaseEmptySlabs() { impl_.ReleaseEmptySlabs(); }
+
+ private:
+  /// @copydoc Allocator::Allocate
+  void* DoAllocate(Layout layout) override { return impl_.Allocate(layout); }
+
+  /// @copydoc Deallocator::DoDeallocate
+  void DoDeallocate(void* ptr) override { impl_.Deallocate(ptr); }
+
+  /// @copydoc Allocator::Resize
+  bool DoResize(void* ptr, size_t new_size) override {
+    return impl_.Resize(ptr, new_size);
+  }
+
+  /// @copydoc Deallocator::GetInfo
+  Result<Layout> DoGetInfo(InfoType info_type, const void* ptr) const override {
+    switch (info_type) {
+      case InfoType::kUsableLayoutOf:
+      case InfoType::kAllocatedLayoutOf:
+        return impl_.GetLayout(ptr);
+      case InfoType::kRecognizes: {
+        Layout layout;
+        PW_TRY_ASSIGN(layout, impl_.GetLayout(ptr));
+        return Layout();
+      }
+      case InfoType::kRequestedLayoutOf:
+      case InfoType::kCapacity:
+      default:
+        return Status::Unimplemented();
+    }
+  }
+
+  std::array<internal::SlabSizeClass, kNumSizeClasses> size_classes_;
+  internal::GenericSlabAllocator impl_;
+};
+
+}  // namespace pw::allocator
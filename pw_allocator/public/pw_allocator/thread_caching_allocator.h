@@ -0,0 +1,442 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+
+#include "lib/stdcompat/bit.h"
+#include "pw_allocator/allocator.h"
+#include "pw_allocator/capability.h"
+#include "pw_allocator/layout.h"
+#include "pw_bytes/alignment.h"
+#include "pw_metric/metric.h"
+#include "pw_result/result.h"
+#include "pw_status/status.h"
+#include "pw_sync/lock_annotations.h"
+
+namespace pw::allocator {
+namespace internal {
+
+/// Returns a value that is fixed for the calling thread and differs between
+/// threads, used to pick a thread's preferred cache.
+size_t GetThreadCacheHint();
+
+}  // namespace internal
+
+/// Wraps an `Allocator` with per-thread caches of small, free allocations.
+///
+/// Wrapping an allocator with a `SynchronizedAllocator` makes every thread
+/// take the same lock on every request. This allocator instead keeps a fixed
+/// number of caches, each with its own lock. Each thread prefers one of the
+/// caches, and uses another if its preferred cache is busy. When there are no
+/// more threads than caches, threads rarely contend with each other.
+///
+/// Each cache holds lists of free chunks, one for each power-of-two size class
+/// from `kMinCachedSize` to `kMaxCachedSize`. Small requests are served from
+/// the calling thread's cache. Chunks move between caches and a shared depot
+/// in batches of `kBatchSize`, which is also how the wrapped allocator is
+/// called when the depot is empty. The wrapped allocator and depot are guarded
+/// by a single lock, which is held once per batch.
+///
+/// Requests that are larger than `kMaxCachedSize`, or more aligned than
+/// `kCacheAlignment`, are passed to the wrapped allocator directly.
+///
+/// Each allocation is preceded by a small header that records its size class.
+/// Freed chunks are not returned to the wrapped allocator until the depot is
+/// full, `Flush` is called, or the wrapped allocator fails a request.
+///
+/// @tparam LockType    The type of the locks used to synchronize access. Must
+///                     be default-constructible and provide `try_lock`.
+/// @tparam kNumCaches  The number of caches. Should be at least the number of
+///                     threads that allocate concurrently.
+template <typename LockType, size_t kNumCaches = 8>
+class ThreadCachingAllocator : public Allocator {
+ public:
+  static_assert(kNumCaches > 0);
+
+  /// Alignment of cached chunks.
+  static constexpr size_t kCacheAlignment = alignof(std::max_align_t);
+
+  /// Size of the smallest size class.
+  static constexpr size_t kMinCachedSize = 16;
+
+  /// Size of the largest size class.
+  static constexpr size_t kMaxCachedSize = 1024;
+
+  /// Maximum number of free chunks of each size class held by each cache.
+  static constexpr size_t kMagazineSize = 32;
+
+  /// Number of chunks moved between a cache and the depot at once.
+  static constexpr size_t kBatchSize = kMagazineSize / 2;
+
+  /// Maximum number of free chunks of each size class held by the depot.
+  static constexpr size_t kDepotSize = kNumCaches * kMagazineSize;
+
+  /// Constructor.
+  ///
+  /// @param[in]  token       Name of the metric group for this allocator.
+  /// @param[in]  allocator   Allocator to wrap. Only this object may use it.
+  ThreadCachingAllocator(metric::Token token, Allocator& allocator) noexcept
+      : Allocator(kImplementsGetUsableLayout),
+        allocator_(allocator),
+        group_(token) {}
+
+  ~ThreadCachingAllocator() override { Flush(); }
+
+  const metric::Group& metric_group() const { return group_; }
+  metric::Group& metric_group() { return group_; }
+
+  /// Returns all free chunks held by the caches and depot to the wrapped
+  /// allocator, and updates metrics.
+  void Flush();
+
+ private:
+  static constexpr size_t kNumSizeClasses =
+      cpp20::bit_width(kMaxCachedSize) - cpp20::bit_width(kMinCachedSize) + 1;
+  static_assert(cpp20::has_single_bit(kMinCachedSize));
+  static_assert(cpp20::has_single_bit(kMaxCachedSize));
+
+  /// Sentinel size class for allocations that bypass the caches.
+  static constexpr uint32_t kUncached = kNumSizeClasses;
+
+  /// Precedes each allocation.
+  struct Header {
+    /// Usable size: the size class for cached chunks, or the requested size.
+    size_t size;
+
+    /// Offset from the wrapped allocation to the usable memory.
+    uint32_t offset;
+
+    uint32_t size_class;
+  };
+
+  // This is a power of two, so any alignment either divides it or is a multiple
+  // of it.
+  static constexpr size_t kHeaderSpace =
+      AlignUp(sizeof(Header), kCacheAlignment);
+  static_assert(cpp20::has_single_bit(kHeaderSpace));
+
+  /// Links free chunks. Stored in the usable memory of each chunk.
+  struct FreeChunk {
+    FreeChunk* next;
+  };
+
+  struct FreeList {
+    FreeChunk* head = nullptr;
+    size_t count = 0;
+
+    void Push(void* ptr) {
+      auto* chunk = static_cast<FreeChunk*>(ptr);
+      chunk->next = head;
+      head = chunk;
+      ++count;
+    }
+
+    void* Pop() {
+      FreeChunk* chunk = head;
+      head = chunk->next;
+      --count;
+      return chunk;
+    }
+  };
+
+  // Caches are locked by `LockCache`, so their fields are not annotated as
+  // guarded by `lock`.
+  struct Cache {
+    LockType lock;
+    std::array<FreeList, kNumSizeClasses> free_lists;
+
+    // Requests served by this cache since the metrics were last updated.
+    uint32_t hits = 0;
+  };
+
+  static constexpr size_t SizeClassSize(size_t size_class) {
+    return kMinCachedSize << size_class;
+  }
+
+  static size_t GetSizeClass(size_t size) {
+    return size <= kMinCachedSize ? 0
+                                  : cpp20::bit_width(size - 1) -
+                                        cpp20::bit_width(kMinCachedSize - 1);
+  }
+
+  static Header& GetHeader(const void* ptr) {
+    return *reinterpret_cast<Header*>(
+        const_cast<std::byte*>(static_cast<const std::byte*>(ptr)) -
+        sizeof(Header));
+  }
+
+  /// @copydoc Allocator::Allocate
+  void* DoAllocate(Layout layout) override;
+
+  /// @copydoc Allocator::Deallocate
+  void DoDeallocate(void* ptr) override;
+
+  /// @copydoc Allocator::Deallocate
+  void DoDeallocate(void* ptr, Layout) override { DoDeallocate(ptr); }
+
+  /// @copydoc Allocator::Resize
+  bool DoResize(void* ptr, size_t new_size) override;
+
+  /// @copydoc Allocator::GetAllocated
+  size_t DoGetAllocated() const override {
+    std::lock_guard lock(lock_);
+    return allocator_.GetAllocated();
+  }
+
+  /// @copydoc Deallocator::GetInfo
+  Result<Layout> DoGetInfo(InfoType info_type, const void* ptr) const override;
+
+  /// Locks and returns the calling thread's preferred cache, or another cache
+  /// if that one is busy.
+  Cache& LockCache() PW_NO_LOCK_SAFETY_ANALYSIS;
+
+  /// Allocates memory from the wrapped allocator and writes a header.
+  void* AllocateChunk(size_t size, size_t alignment, uint32_t size_class)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  void DeallocateChunk(void* ptr) PW_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  /// Moves up to a batch of chunks from the depot, or the wrapped allocator,
+  /// to a cache. The cache must be locked.
+  void Refill(Cache& cache, size_t size_class);
+
+  /// Moves a batch of chunks from a cache to the depot, and returns chunks
+  /// that do not fit in the depot to the wrapped allocator. The cache must be
+  /// locked.
+  void Drain(Cache& cache, size_t size_class);
+
+  /// Returns all chunks held by the depot to the wrapped allocator.
+  void ReleaseDepot() PW_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  void UpdateHits(Cache& cache);
+
+  Allocator& allocator_ PW_GUARDED_BY(lock_);
+  mutable LockType lock_;
+  std::array<FreeList, kNumSizeClasses> depot_ PW_GUARDED_BY(lock_);
+  std::array<Cache, kNumCaches> caches_;
+
+  metric::Group group_;
+  PW_METRIC(group_, hits_, "hits", 0u);
+  PW_METRIC(group_, refills_, "refills", 0u);
+  PW_METRIC(group_, drains_, "drains", 0u);
+  PW_METRIC(group_, uncached_, "uncached", 0u);
+};
+
+// Template method implementations.
+
+template <typename LockType, size_t kNumCaches>
+void ThreadCachingAllocator<LockType, kNumCaches>::Flush() {
+  for (Cache& cache : caches_) {
+    std::lock_guard cache_lock(cache.lock);
+    std::lock_guard lock(lock_);
+    for (FreeList& free_list : cache.free_lists) {
+      while (free_list.count != 0) {
+        DeallocateChunk(free_list.Pop());
+      }
+    }
+    UpdateHits(cache);
+  }
+  std::lock_guard lock(lock_);
+  ReleaseDepot();
+}
+
+template <typename LockType, size_t kNumCaches>
+void* ThreadCachingAllocator<LockType, kNumCaches>::DoAllocate(Layout layout) {
+  if (layout.size() > kMaxCachedSize || layout.alignment() > kCacheAlignment) {
+    {
+      std::lock_guard lock(lock_);
+      uncached_.Increment();
+      void* ptr = AllocateChunk(layout.size(), layout.alignment(), kUncached);
+      if (ptr != nullptr) {
+        return ptr;
+      }
+    }
+
+    // The memory may be held by the caches.
+    Flush();
+    std::lock_guard lock(lock_);
+    return AllocateChunk(layout.size(), layout.alignment(), kUncached);
+  }
+
+  size_t size_class = GetSizeClass(layout.size());
+  Cache& cache = LockCache();
+  std::lock_guard cache_lock(cache.lock, std::adopt_lock);
+  FreeList& free_list = cache.free_lists[size_class];
+  if (free_list.count == 0) {
+    Refill(cache, size_class);
+    if (free_list.count == 0) {
+      return nullptr;
+    }
+  } else {
+    ++cache.hits;
+  }
+  return free_list.Pop();
+}
+
+template <typename LockType, size_t kNumCaches>
+void ThreadCachingAllocator<LockType, kNumCaches>::DoDeallocate(void* ptr) {
+  size_t size_class = GetHeader(ptr).size_class;
+  if (size_class == kUncached) {
+    std::lock_guard lock(lock_);
+    DeallocateChunk(ptr);
+    return;
+  }
+
+  Cache& cache = LockCache();
+  std::lock_guard cache_lock(cache.lock, std::adopt_lock);
+  FreeList& free_list = cache.free_lists[size_class];
+  free_list.Push(ptr);
+  if (free_list.count > kMagazineSize) {
+    Drain(cache, size_class);
+  }
+}
+
+template <typename LockType, size_t kNumCaches>
+bool ThreadCachingAllocator<LockType, kNumCaches>::DoResize(void* ptr,
+                                                            size_t new_size) {
+  Header& header = GetHeader(ptr);
+  if (header.size_class != kUncached) {
+    return new_size <= header.size;
+  }
+  std::lock_guard lock(lock_);
+  std::byte* chunk = static_cast<std::byte*>(ptr) - header.offset;
+  if (!allocator_.Resize(chunk, header.offset + new_size)) {
+    return false;
+  }
+  header.size = new_size;
+  return true;
+}
+
+template <typename LockType, size_t kNumCaches>
+Result<Layout> ThreadCachingAllocator<LockType, kNumCaches>::DoGetInfo(
+    InfoType info_type, const void* ptr) const {
+  if (info_type != InfoType::kUsableLayoutOf) {
+    return Status::Unimplemented();
+  }
+  // Chunks are aligned to `kCacheAlignment` unless more alignment was
+  // requested, in which case the offset is that alignment.
+  const Header& header = GetHeader(ptr);
+  return Layout(header.size,
+                header.offset > kHeaderSpace ? header.offset : kCacheAlignment);
+}
+
+template <typename LockType, size_t kNumCaches>
+typename ThreadCachingAllocator<LockType, kNumCaches>::Cache&
+ThreadCachingAllocator<LockType, kNumCaches>::LockCache() {
+  size_t preferred = internal::GetThreadCacheHint() % kNumCaches;
+  for (size_t i = 0; i < kNumCaches; ++i) {
+    Cache& cache = caches_[(preferred + i) % kNumCaches];
+    if (cache.lock.try_lock()) {
+      return cache;
+    }
+  }
+  Cache& cache = caches_[preferred];
+  cache.lock.lock();
+  return cache;
+}
+
+template <typename LockType, size_t kNumCaches>
+void* ThreadCachingAllocator<LockType, kNumCaches>::AllocateChunk(
+    size_t size, size_t alignment, uint32_t size_class) {
+  alignment = std::max(alignment, kCacheAlignment);
+  size_t offset = std::max(alignment, kHeaderSpace);
+  if (size > std::numeric_limits<size_t>::max() - offset) {
+    return nullptr;
+  }
+  void* chunk = allocator_.Allocate(Layout(offset + size, alignment));
+  if (chunk == nullptr) {
+    return nullptr;
+  }
+  void* ptr = static_cast<std::byte*>(chunk) + offset;
+  GetHeader(ptr) = Header{
+      .size = size,
+      .offset = static_cast<uint32_t>(offset),
+      .size_class = size_class,
+  };
+  return ptr;
+}
+
+template <typename LockType, size_t kNumCaches>
+void ThreadCachingAllocator<LockType, kNumCaches>::DeallocateChunk(void* ptr) {
+  allocator_.Deallocate(static_cast<std::byte*>(ptr) - GetHeader(ptr).offset);
+}
+
+template <typename LockType, size_t kNumCaches>
+void ThreadCachingAllocator<LockType, kNumCaches>::Refill(Cache& cache,
+                                                          size_t size_class) {
+  FreeList& free_list = cache.free_lists[size_class];
+  std::lock_guard lock(lock_);
+  FreeList& depot = depot_[size_class];
+  while (free_list.count < kBatchSize && depot.count != 0) {
+    free_list.Push(depot.Pop());
+  }
+  bool released = false;
+  while (free_list.count < kBatchSize) {
+    void* ptr = AllocateChunk(SizeClassSize(size_class),
+                              kCacheAlignment,
+                              static_cast<uint32_t>(size_class));
+    if (ptr != nullptr) {
+      free_list.Push(ptr);
+    } else if (free_list.count == 0 && !released) {
+      // The memory may be held by the depot as chunks of other sizes.
+      ReleaseDepot();
+      released = true;
+    } else {
+      break;
+    }
+  }
+  refills_.Increment();
+  UpdateHits(cache);
+}
+
+template <typename LockType, size_t kNumCaches>
+void ThreadCachingAllocator<LockType, kNumCaches>::Drain(Cache& cache,
+                                                         size_t size_class) {
+  FreeList& free_list = cache.free_lists[size_class];
+  std::lock_guard lock(lock_);
+  FreeList& depot = depot_[size_class];
+  for (size_t i = 0; i < kBatchSize; ++i) {
+    void* ptr = free_list.Pop();
+    if (depot.count < kDepotSize) {
+      depot.Push(ptr);
+    } else {
+      DeallocateChunk(ptr);
+    }
+  }
+  drains_.Increment();
+  UpdateHits(cache);
+}
+
+template <typename LockType, size_t kNumCaches>
+void ThreadCachingAllocator<LockType, kNumCaches>::ReleaseDepot() {
+  for (FreeList& free_list : depot_) {
+    while (free_list.count != 0) {
+      DeallocateChunk(free_list.Pop());
+    }
+  }
+}
+
+template <typename LockType, size_t kNumCaches>
+void ThreadCachingAllocator<LockType, kNumCaches>::UpdateHits(Cache& cache) {
+  hits_.Increment(cache.hits);
+  cache.hits = 0;
+}
+
+}  // namespace pw::allocator
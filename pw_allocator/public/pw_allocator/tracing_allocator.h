@@ -0,0 +1,159 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "pw_allocator/allocator.h"
+#include "pw_allocator/layout.h"
+#include "pw_bytes/span.h"
+#include "pw_chrono/system_clock.h"
+#include "pw_result/result.h"
+#include "pw_status/status.h"
+
+namespace pw::allocator {
+
+/// Kinds of allocator requests recorded by a `TracingAllocator`.
+enum class TraceEventType : uint8_t {
+  kAllocate = 0,
+  kDeallocate = 1,
+  kResize = 2,
+  kReallocate = 3,
+};
+
+/// An allocator request decoded from a trace.
+struct TraceEvent {
+  TraceEventType type = TraceEventType::kAllocate;
+
+  /// Time of the request, relative to the first event in the trace.
+  chrono::SystemClock::duration timestamp{0};
+
+  /// Address passed to a deallocate, resize, or reallocate request.
+  uintptr_t ptr = 0;
+
+  /// Address returned by an allocate or reallocate request. For a resize
+  /// request, this is `ptr` if the request succeeded. This is 0 for a
+  /// deallocate request, or for any request that failed.
+  uintptr_t result = 0;
+
+  /// Layout requested by an allocate or reallocate request. For a resize
+  /// request, this holds the new size with an alignment of 1. This is empty
+  /// for a deallocate request.
+  Layout layout;
+};
+
+/// Wraps an `Allocator` and records every request made of it.
+///
+/// Each request is appended to a caller-provided buffer as a compact binary
+/// event: a header byte followed by varint-encoded fields. Timestamps are
+/// stored as the number of system clock ticks since the previous event, and
+/// addresses are stored as the signed difference from the previous address,
+/// so most events take only a handful of bytes.
+///
+/// The recorded trace can be decoded with `TraceReader`, or replayed against
+/// other allocators to compare them using the same sequence of requests. See
+/// `pw::allocator::ReplayTrace` in the `pw_allocator/benchmarks` module.
+///
+/// Once the buffer is full, further events are counted but not recorded, so
+/// that the trace remains a valid prefix of the requests that were made.
+///
+/// This class is not thread safe. To trace an allocator used by multiple
+/// threads, wrap this object in a `SynchronizedAllocator`.
+class TracingAllocator : public Allocator {
+ public:
+  /// Size of the largest encoded event.
+  static constexpr size_t kMaxEventSize = 41;
+
+  /// Constructs a tracing allocator.
+  ///
+  /// @param[in]  allocator   Allocator to forward requests to.
+  /// @param[in]  buffer      Storage for the recorded trace.
+  TracingAllocator(Allocator& allocator, ByteSpan buffer)
+      : Allocator(allocator.capabilities()),
+        allocator_(allocator),
+        buffer_(buffer) {}
+
+  /// Returns the events recorded so far.
+  ConstByteSpan trace() const { return buffer_.first(size_); }
+
+  /// Returns the number of events that did not fit in the buffer.
+  size_t num_dropped() const { return num_dropped_; }
+
+  /// Discards all recorded events.
+  void Clear();
+
+ private:
+  /// @copydoc Allocator::Allocate
+  void* DoAllocate(Layout layout) override;
+
+  /// @copydoc Deallocator::Deallocate
+  void DoDeallocate(void* ptr) override;
+
+  /// @copydoc Deallocator::Deallocate
+  void DoDeallocate(void* ptr, Layout) override { DoDeallocate(ptr); }
+
+  /// @copydoc Allocator::Resize
+  bool DoResize(void* ptr, size_t new_size) override;
+
+  /// @copydoc Allocator::Reallocate
+  void* DoReallocate(void* ptr, Layout new_layout) override;
+
+  /// @copydoc Allocator::GetAllocated
+  size_t DoGetAllocated() const override { return allocator_.GetAllocated(); }
+
+  /// @copydoc Deallocator::GetInfo
+  Result<Layout> DoGetInfo(InfoType info_type, const void* ptr) const override {
+    return GetInfo(allocator_, info_type, ptr);
+  }
+
+  /// Encodes an event that started at `start` and appends it to the trace.
+  void Record(chrono::SystemClock::time_point start, const TraceEvent& event);
+
+  Allocator& allocator_;
+  ByteSpan buffer_;
+  size_t size_ = 0;
+  size_t num_dropped_ = 0;
+  std::optional<chrono::SystemClock::time_point> last_time_;
+  uintptr_t last_ptr_ = 0;
+};
+
+/// Decodes the events recorded by a `TracingAllocator`.
+class TraceReader {
+ public:
+  explicit constexpr TraceReader(ConstByteSpan trace) : trace_(trace) {}
+
+  /// Decodes the next event in the trace.
+  ///
+  /// @returns @rst
+  ///
+  /// .. pw-status-codes::
+  ///
+  ///    OK: Result contains the decoded event.
+  ///
+  ///    OUT_OF_RANGE: No events remain.
+  ///
+  ///    DATA_LOSS: The trace is malformed or truncated.
+  ///
+  /// @endrst
+  Result<TraceEvent> Next();
+
+ private:
+  ConstByteSpan trace_;
+  chrono::SystemClock::duration timestamp_{0};
+  uintptr_t last_ptr_ = 0;
+};
+
+}  // namespace pw::allocator
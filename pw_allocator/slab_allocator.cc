@@ -0,0 +1,213 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_allocator/slab_allocator.h"
+
+#include <algorithm>
+#include <limits>
+#include <new>
+#include <utility>
+
+#include "lib/stdcompat/bit.h"
+#include "pw_allocator/hardening.h"
+#include "pw_assert/check.h"
+#include "pw_bytes/alignment.h"
+
+namespace pw::allocator::internal {
+
+GenericSlabAllocator::GenericSlabAllocator(Allocator& parent,
+                                           span<SlabSizeClass> size_classes,
+                                           span<const size_t> sizes,
+                                           size_t slab_size)
+    : parent_(parent),
+      size_classes_(size_classes),
+      slab_size_(slab_size),
+      objects_offset_(AlignUp(sizeof(Slab), kMaxAlignment)) {
+  PW_CHECK_UINT_EQ(size_classes.size(), sizes.size());
+  PW_CHECK(cpp20::has_single_bit(slab_size));
+  PW_CHECK_UINT_LE(size_classes.size(), std::numeric_limits<uint16_t>::max());
+  size_t prev_size = 0;
+  for (size_t i = 0; i < sizes.size(); ++i) {
+    PW_CHECK_UINT_GT(sizes[i], prev_size, "Size classes must be increasing");
+    prev_size = sizes[i];
+
+    SlabSizeClass& size_class = size_classes[i];
+    size_class.object_size = AlignUp(sizes[i], alignof(Slab::FreeObject));
+    size_class.alignment = std::min(
+        size_t(1) << cpp20::countr_zero(size_class.object_size), kMaxAlignment);
+    PW_CHECK_UINT_GE(slab_size,
+                     objects_offset_ + size_class.object_size,
+                     "Slabs must fit at least one object of each size class");
+    size_t objects_per_slab =
+        (slab_size - objects_offset_) / size_class.object_size;
+    size_class.objects_per_slab = static_cast<uint16_t>(std::min(
+        objects_per_slab, size_t(std::numeric_limits<uint16_t>::max())));
+  }
+}
+
+Slab& GenericSlabAllocator::GetSlab(const void* ptr) const {
+  auto addr = cpp20::bit_cast<uintptr_t>(ptr);
+  auto* slab = cpp20::bit_cast<Slab*>(AlignDown(addr, slab_size_));
+  return *std::launder(slab);
+}
+
+std::byte* GenericSlabAllocator::GetObject(Slab& slab, size_t index) const {
+  const SlabSizeClass& size_class = size_classes_[slab.size_class];
+  return cpp20::bit_cast<std::byte*>(&slab) + objects_offset_ +
+         index * size_class.object_size;
+}
+
+void* GenericSlabAllocator::Allocate(Layout layout) {
+  auto iter = std::find_if(size_classes_.begin(),
+                           size_classes_.end(),
+                           [&layout](const SlabSizeClass& size_class) {
+                             return layout.size() <= size_class.object_size &&
+                                    layout.alignment() <= size_class.alignment;
+                           });
+  if (iter == size_classes_.end()) {
+    return nullptr;
+  }
+  SlabSizeClass& size_class = *iter;
+  auto index = static_cast<uint16_t>(iter - size_classes_.begin());
+  Slab* slab = GetPartialSlab(size_class, index);
+  if (slab == nullptr) {
+    return nullptr;
+  }
+
+  std::byte* ptr;
+  if (slab->free != nullptr) {
+    ptr = cpp20::bit_cast<std::byte*>(slab->free);
+    slab->free = slab->free->next;
+  } else {
+    ptr = GetObject(*slab, slab->num_carved);
+    ++slab->num_carved;
+  }
+  ++slab->num_used;
+  if (slab->num_used == size_class.objects_per_slab) {
+    size_class.partial.pop_front();
+    size_class.full.push_front(*slab);
+  }
+  return ptr;
+}
+
+Slab* GenericSlabAllocator::GetPartialSlab(SlabSizeClass& size_class,
+                                           uint16_t index) {
+  if (!size_class.partial.empty()) {
+    return &size_class.partial.front();
+  }
+  Slab* slab = std::exchange(size_class.empty, nullptr);
+  if (slab == nullptr) {
+    void* ptr = parent_.Allocate(Layout(slab_size_, slab_size_));
+    if (ptr == nullptr) {
+      return nullptr;
+    }
+    slab = new (ptr) Slab();
+    slab->size_class = index;
+  }
+  size_class.partial.push_front(*slab);
+  return slab;
+}
+
+void GenericSlabAllocator::Deallocate(void* ptr) {
+  Slab& slab = GetSlab(ptr);
+  SlabSizeClass& size_class = size_classes_[slab.size_class];
+  if (slab.num_used == size_class.objects_per_slab) {
+    size_class.full.erase(slab);
+    size_class.partial.push_front(slab);
+  }
+  auto* object = new (ptr) Slab::FreeObject{slab.free};
+  slab.free = object;
+  --slab.num_used;
+  if (slab.num_used != 0) {
+    return;
+  }
+
+  // Reset the empty slab so that its objects are carved in order when reused.
+  size_class.partial.erase(slab);
+  slab.free = nullptr;
+  slab.num_carved = 0;
+  if (size_class.empty == nullptr) {
+    size_class.empty = &slab;
+  } else {
+    ReleaseSlab(&slab);
+  }
+}
+
+bool GenericSlabAllocator::Resize(void* ptr, size_t new_size) {
+  const Slab& slab = GetSlab(ptr);
+  return new_size <= size_classes_[slab.size_class].object_size;
+}
+
+Result<Layout> GenericSlabAllocator::GetLayout(const void* ptr) const {
+  if (ptr == nullptr) {
+    return Status::OutOfRange();
+  }
+  const Slab* slab = &GetSlab(ptr);
+  auto has_slab = [slab](const containers::future::IntrusiveList<Slab>& list) {
+    return std::any_of(list.begin(), list.end(), [slab](const Slab& other) {
+      return &other == slab;
+    });
+  };
+  for (const SlabSizeClass& size_class : size_classes_) {
+    if (!has_slab(size_class.partial) && !has_slab(size_class.full)) {
+      continue;
+    }
+    auto offset = cpp20::bit_cast<uintptr_t>(ptr) -
+                  cpp20::bit_cast<uintptr_t>(slab) - objects_offset_;
+    if (offset % size_class.object_size != 0 ||
+        offset / size_class.object_size >= slab->num_carved) {
+      return Status::OutOfRange();
+    }
+    return Layout(size_class.object_size, size_class.alignment);
+  }
+  return Status::OutOfRange();
+}
+
+void GenericSlabAllocator::ReleaseEmptySlabs() {
+  for (SlabSizeClass& size_class : size_classes_) {
+    if (size_class.empty != nullptr) {
+      ReleaseSlab(std::exchange(size_class.empty, nullptr));
+    }
+  }
+}
+
+void GenericSlabAllocator::CrashIfAllocated() {
+  size_t num_used = 0;
+  for (SlabSizeClass& size_class : size_classes_) {
+    for (auto* list : {&size_class.partial, &size_class.full}) {
+      while (!list->empty()) {
+        Slab& slab = list->front();
+        list->pop_front();
+        num_used += slab.num_used;
+        ReleaseSlab(&slab);
+      }
+    }
+  }
+  ReleaseEmptySlabs();
+  if constexpr (Hardening::kIncludesRobustChecks) {
+    PW_CHECK_UINT_EQ(num_used,
+                     0,
+                     "%zu objects were still in use when an allocator was "
+                     "destroyed. All memory allocated by an allocator must be "
+                     "released before the allocator goes out of scope.",
+                     num_used);
+  }
+}
+
+void GenericSlabAllocator::ReleaseSlab(Slab* slab) {
+  slab->~Slab();
+  parent_.Deallocate(slab);
+}
+
+}  // namespace pw::allocator::internal
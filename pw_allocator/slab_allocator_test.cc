@@ -0,0 +1,237 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_allocator/slab_allocator.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_allocator/fallback_allocator.h"
+#include "pw_allocator/fuzzing.h"
+#include "pw_allocator/testing.h"
+#include "pw_bytes/alignment.h"
+#include "pw_containers/vector.h"
+#include "pw_unit_test/framework.h"
+
+namespace {
+
+// Test fixtures.
+
+using ::pw::allocator::Layout;
+using AllocatorForTest = ::pw::allocator::test::AllocatorForTest<8192>;
+
+constexpr size_t kSlabSize = 256;
+using SlabAllocator = ::pw::allocator::SlabAllocator<3, kSlabSize>;
+constexpr std::array<size_t, 3> kSizes = {12, 32, 96};
+
+class SlabAllocatorTest : public ::testing::Test {
+ protected:
+  SlabAllocatorTest() : allocator_(parent_, kSizes) {}
+
+  /// Returns the number of slabs allocated from the parent allocator.
+  size_t num_slabs() const { return parent_.GetAllocated() / kSlabSize; }
+
+  AllocatorForTest parent_;
+  SlabAllocator allocator_;
+};
+
+// Unit tests.
+
+TEST_F(SlabAllocatorTest, Capabilities) {
+  EXPECT_EQ(allocator_.capabilities(), SlabAllocator::kCapabilities);
+}
+
+TEST_F(SlabAllocatorTest, AllocateDeallocate) {
+  void* ptr = allocator_.Allocate(Layout(12, 4));
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_EQ(num_slabs(), 1u);
+  allocator_.Deallocate(ptr);
+}
+
+TEST_F(SlabAllocatorTest, AllocateFromSmallestSizeClass) {
+  void* ptr1 = allocator_.Allocate(Layout(8, 1));
+  void* ptr2 = allocator_.Allocate(Layout(20, 1));
+  void* ptr3 = allocator_.Allocate(Layout(96, 1));
+  ASSERT_NE(ptr1, nullptr);
+  ASSERT_NE(ptr2, nullptr);
+  ASSERT_NE(ptr3, nullptr);
+
+  // Each size class has its own slab.
+  EXPECT_EQ(num_slabs(), 3u);
+
+  // Sizes are rounded up to a multiple of `alignof(void*)`.
+  constexpr size_t kRoundedSize = pw::AlignUp(size_t(12), alignof(void*));
+  EXPECT_TRUE(allocator_.Resize(ptr1, kRoundedSize));
+  EXPECT_FALSE(allocator_.Resize(ptr1, kRoundedSize + 1));
+  EXPECT_TRUE(allocator_.Resize(ptr2, 32));
+  EXPECT_FALSE(allocator_.Resize(ptr2, 33));
+
+  allocator_.Deallocate(ptr1);
+  allocator_.Deallocate(ptr2);
+  allocator_.Deallocate(ptr3);
+}
+
+TEST_F(SlabAllocatorTest, AllocateExcessiveSize) {
+  EXPECT_EQ(allocator_.Allocate(Layout(97, 1)), nullptr);
+  EXPECT_EQ(num_slabs(), 0u);
+}
+
+TEST_F(SlabAllocatorTest, AllocateExcessiveAlignment) {
+  constexpr size_t kAlignment = alignof(std::max_align_t) * 2;
+  EXPECT_EQ(allocator_.Allocate(Layout(8, kAlignment)), nullptr);
+}
+
+TEST_F(SlabAllocatorTest, AllocateAlignedFromLargerSizeClass) {
+  // Objects of 32 bytes are aligned to 16 bytes, if the platform allows it.
+  constexpr size_t kAlignment = std::min(size_t(16), alignof(std::max_align_t));
+  std::array<void*, 4> ptrs;
+  for (void*& ptr : ptrs) {
+    ptr = allocator_.Allocate(Layout(4, kAlignment));
+    ASSERT_NE(ptr, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % kAlignment, 0u);
+  }
+  for (void* ptr : ptrs) {
+    allocator_.Deallocate(ptr);
+  }
+}
+
+TEST_F(SlabAllocatorTest, ReusesMostRecentlyFreedObject) {
+  void* ptr1 = allocator_.Allocate(Layout(32, 8));
+  void* ptr2 = allocator_.Allocate(Layout(32, 8));
+  ASSERT_NE(ptr1, nullptr);
+  ASSERT_NE(ptr2, nullptr);
+  allocator_.Deallocate(ptr1);
+  EXPECT_EQ(allocator_.Allocate(Layout(32, 8)), ptr1);
+  allocator_.Deallocate(ptr1);
+  allocator_.Deallocate(ptr2);
+}
+
+TEST_F(SlabAllocatorTest, AllocatesNewSlabWhenFull) {
+  pw::Vector<void*, kSlabSize / 8> ptrs;
+  void* ptr = allocator_.Allocate(Layout(96, 8));
+  ASSERT_NE(ptr, nullptr);
+  ptrs.push_back(ptr);
+  while (num_slabs() == 1) {
+    ptr = allocator_.Allocate(Layout(96, 8));
+    ASSERT_NE(ptr, nullptr);
+    ptrs.push_back(ptr);
+  }
+  EXPECT_EQ(num_slabs(), 2u);
+
+  // Freeing an object from a full slab makes it available again.
+  void* last = ptrs.back();
+  ptrs.pop_back();
+  allocator_.Deallocate(ptrs.front());
+  EXPECT_EQ(allocator_.Allocate(Layout(96, 8)), ptrs.front());
+  EXPECT_EQ(num_slabs(), 2u);
+
+  allocator_.Deallocate(last);
+  for (void* p : ptrs) {
+    allocator_.Deallocate(p);
+  }
+}
+
+TEST_F(SlabAllocatorTest, ReturnsEmptySlabsToParent) {
+  pw::Vector<void*, kSlabSize> ptrs;
+  while (num_slabs() < 4) {
+    void* ptr = allocator_.Allocate(Layout(12, 4));
+    ASSERT_NE(ptr, nullptr);
+    ptrs.push_back(ptr);
+  }
+  for (void* ptr : ptrs) {
+    allocator_.Deallocate(ptr);
+  }
+
+  // One empty slab is kept for reuse.
+  EXPECT_EQ(num_slabs(), 1u);
+  void* ptr = allocator_.Allocate(Layout(12, 4));
+  EXPECT_EQ(num_slabs(), 1u);
+  allocator_.Deallocate(ptr);
+
+  allocator_.ReleaseEmptySlabs();
+  EXPECT_EQ(num_slabs(), 0u);
+}
+
+TEST_F(SlabAllocatorTest, DestructorReturnsSlabsToParent) {
+  AllocatorForTest parent;
+  {
+    SlabAllocator allocator(parent, kSizes);
+    void* ptr = allocator.Allocate(Layout(32, 8));
+    ASSERT_NE(ptr, nullptr);
+    allocator.Deallocate(ptr);
+    EXPECT_NE(parent.GetAllocated(), 0u);
+  }
+  EXPECT_EQ(parent.GetAllocated(), 0u);
+}
+
+TEST_F(SlabAllocatorTest, FailsWhenParentIsExhausted) {
+  pw::Vector<void*, 8192 / 8> ptrs;
+  while (true) {
+    void* ptr = allocator_.Allocate(Layout(32, 8));
+    if (ptr == nullptr) {
+      break;
+    }
+    ptrs.push_back(ptr);
+  }
+  EXPECT_GT(num_slabs(), 0u);
+  for (void* ptr : ptrs) {
+    allocator_.Deallocate(ptr);
+  }
+}
+
+TEST_F(SlabAllocatorTest, Resize) {
+  void* ptr = allocator_.Allocate(Layout(20, 4));
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_TRUE(allocator_.Resize(ptr, 32));
+  EXPECT_TRUE(allocator_.Resize(ptr, 1));
+  EXPECT_FALSE(allocator_.Resize(ptr, 33));
+  allocator_.Deallocate(ptr);
+}
+
+TEST_F(SlabAllocatorTest, FallbackForLargeRequests) {
+  AllocatorForTest secondary;
+  pw::allocator::FallbackAllocator fallback(allocator_, secondary);
+
+  void* small = fallback.Allocate(Layout(32, 8));
+  void* large = fallback.Allocate(Layout(512, 8));
+  ASSERT_NE(small, nullptr);
+  ASSERT_NE(large, nullptr);
+  EXPECT_EQ(num_slabs(), 1u);
+  EXPECT_NE(secondary.GetAllocated(), 0u);
+
+  // Deallocation uses `Recognizes` to find the right allocator.
+  fallback.Deallocate(small);
+  fallback.Deallocate(large);
+  EXPECT_EQ(secondary.GetAllocated(), 0u);
+}
+
+// Fuzz tests.
+
+using ::pw::allocator::test::DefaultArbitraryRequests;
+using ::pw::allocator::test::Request;
+using ::pw::allocator::test::TestHarness;
+
+void NeverCrashes(const pw::Vector<Request>& requests) {
+  static AllocatorForTest parent;
+  static SlabAllocator allocator(parent, kSizes);
+  static TestHarness fuzzer(allocator);
+  fuzzer.HandleRequests(requests);
+}
+
+FUZZ_TEST(SlabAllocatorFuzzTest, NeverCrashes)
+    .WithDomains(DefaultArbitraryRequests());
+
+}  // namespace
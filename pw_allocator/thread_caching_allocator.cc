@@ -0,0 +1,29 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_allocator/thread_caching_allocator.h"
+
+#include <atomic>
+
+namespace pw::allocator::internal {
+
+size_t GetThreadCacheHint() {
+  // Threads are assigned hints in the order they first allocate, which spreads
+  // them evenly across caches.
+  static std::atomic<size_t> next_hint = 0;
+  thread_local size_t hint = next_hint.fetch_add(1, std::memory_order_relaxed);
+  return hint;
+}
+
+}  // namespace pw::allocator::internal
@@ -0,0 +1,301 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_allocator/thread_caching_allocator.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#include "pw_allocator/testing.h"
+#include "pw_metric/metric.h"
+#include "pw_sync/mutex.h"
+#include "pw_thread/test_thread_context.h"
+#include "pw_thread/thread.h"
+#include "pw_unit_test/framework.h"
+
+namespace {
+
+// Test fixtures.
+
+using ::pw::allocator::Layout;
+using AllocatorForTest = ::pw::allocator::test::AllocatorForTest<8192>;
+using ThreadCachingAllocator =
+    ::pw::allocator::ThreadCachingAllocator<pw::sync::Mutex, 4>;
+
+constexpr pw::metric::Token kToken = PW_TOKENIZE_STRING("test");
+constexpr pw::metric::Token kHits = PW_METRIC_TOKEN("hits");
+constexpr pw::metric::Token kRefills = PW_METRIC_TOKEN("refills");
+constexpr pw::metric::Token kDrains = PW_METRIC_TOKEN("drains");
+constexpr pw::metric::Token kUncached = PW_METRIC_TOKEN("uncached");
+
+uint32_t GetMetric(const pw::metric::Group& group, pw::metric::Token token) {
+  for (const auto& metric : group.metrics()) {
+    if (metric.name() == token) {
+      return metric.as_int();
+    }
+  }
+  return 0;
+}
+
+class ThreadCachingAllocatorTest : public ::testing::Test {
+ protected:
+  ThreadCachingAllocatorTest() : caching_(kToken, allocator_) {}
+
+  uint32_t hits() const { return GetMetric(caching_.metric_group(), kHits); }
+  uint32_t refills() const {
+    return GetMetric(caching_.metric_group(), kRefills);
+  }
+  uint32_t drains() const {
+    return GetMetric(caching_.metric_group(), kDrains);
+  }
+  uint32_t uncached() const {
+    return GetMetric(caching_.metric_group(), kUncached);
+  }
+
+  AllocatorForTest allocator_;
+  ThreadCachingAllocator caching_;
+};
+
+// Unit tests.
+
+TEST_F(ThreadCachingAllocatorTest, ReusesFreedChunks) {
+  void* ptr1 = caching_.Allocate(Layout(24, 8));
+  ASSERT_NE(ptr1, nullptr);
+  caching_.Deallocate(ptr1);
+
+  void* ptr2 = caching_.Allocate(Layout(32, 8));
+  EXPECT_EQ(ptr1, ptr2);
+  caching_.Deallocate(ptr2);
+
+  caching_.Flush();
+  EXPECT_EQ(refills(), 1u);
+  EXPECT_EQ(hits(), 1u);
+  EXPECT_EQ(uncached(), 0u);
+  EXPECT_EQ(allocator_.GetAllocated(), 0u);
+}
+
+TEST_F(ThreadCachingAllocatorTest, RefillsInBatches) {
+  const size_t allocated_before = allocator_.GetAllocated();
+  void* ptr = caching_.Allocate(Layout(64, 8));
+  ASSERT_NE(ptr, nullptr);
+
+  // A full batch of chunks was allocated from the wrapped allocator.
+  EXPECT_GE(allocator_.GetAllocated() - allocated_before,
+            ThreadCachingAllocator::kBatchSize * 64);
+  caching_.Deallocate(ptr);
+}
+
+TEST_F(ThreadCachingAllocatorTest, HonorsAlignment) {
+  constexpr std::array<size_t, 5> kSizes = {1, 16, 100, 400, 2000};
+  constexpr std::array<size_t, 5> kAlignments = {1, 8, 16, 64, 256};
+  for (size_t size : kSizes) {
+    for (size_t alignment : kAlignments) {
+      void* ptr = caching_.Allocate(Layout(size, alignment));
+      ASSERT_NE(ptr, nullptr);
+      EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % alignment, 0u);
+      std::memset(ptr, 0xA5, size);
+      caching_.Deallocate(ptr);
+    }
+
+    // Return cached chunks so that the next size class has room.
+    caching_.Flush();
+  }
+}
+
+TEST_F(ThreadCachingAllocatorTest, LargeRequestsBypassCaches) {
+  void* ptr =
+      caching_.Allocate(Layout(ThreadCachingAllocator::kMaxCachedSize + 1, 8));
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_EQ(uncached(), 1u);
+  caching_.Deallocate(ptr);
+  EXPECT_EQ(allocator_.GetAllocated(), 0u);
+}
+
+TEST_F(ThreadCachingAllocatorTest, OverflowingSizeFails) {
+  EXPECT_EQ(caching_.Allocate(Layout(std::numeric_limits<size_t>::max(), 8)),
+            nullptr);
+  EXPECT_EQ(caching_.Allocate(
+                Layout(std::numeric_limits<size_t>::max() -
+                           ThreadCachingAllocator::kCacheAlignment,
+                       ThreadCachingAllocator::kCacheAlignment * 2)),
+            nullptr);
+  EXPECT_EQ(allocator_.GetAllocated(), 0u);
+}
+
+TEST_F(ThreadCachingAllocatorTest, OverAlignedRequestsBypassCaches) {
+  void* ptr = caching_.Allocate(
+      Layout(16, ThreadCachingAllocator::kCacheAlignment * 2));
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_EQ(uncached(), 1u);
+  caching_.Deallocate(ptr);
+  EXPECT_EQ(allocator_.GetAllocated(), 0u);
+}
+
+TEST_F(ThreadCachingAllocatorTest, DrainsFullCaches) {
+  constexpr size_t kNumChunks = ThreadCachingAllocator::kMagazineSize * 2;
+  std::array<void*, kNumChunks> ptrs;
+  for (void*& ptr : ptrs) {
+    ptr = caching_.Allocate(Layout(16, 8));
+    ASSERT_NE(ptr, nullptr);
+  }
+  EXPECT_EQ(refills(), kNumChunks / ThreadCachingAllocator::kBatchSize);
+
+  for (void* ptr : ptrs) {
+    caching_.Deallocate(ptr);
+  }
+  EXPECT_GT(drains(), 0u);
+
+  // Chunks moved to the depot are reused by later refills.
+  for (void*& ptr : ptrs) {
+    ptr = caching_.Allocate(Layout(16, 8));
+    ASSERT_NE(ptr, nullptr);
+  }
+  for (void* ptr : ptrs) {
+    caching_.Deallocate(ptr);
+  }
+
+  caching_.Flush();
+  EXPECT_EQ(allocator_.GetAllocated(), 0u);
+}
+
+TEST_F(ThreadCachingAllocatorTest, ResizeWithinSizeClass) {
+  void* ptr = caching_.Allocate(Layout(40, 8));
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_TRUE(caching_.Resize(ptr, 64));
+  EXPECT_TRUE(caching_.Resize(ptr, 8));
+  EXPECT_FALSE(caching_.Resize(ptr, 65));
+  caching_.Deallocate(ptr);
+}
+
+TEST_F(ThreadCachingAllocatorTest, ResizeUncached) {
+  void* ptr = caching_.Allocate(Layout(4096, 8));
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_TRUE(caching_.Resize(ptr, 2048));
+  caching_.Deallocate(ptr);
+  EXPECT_EQ(allocator_.GetAllocated(), 0u);
+}
+
+TEST_F(ThreadCachingAllocatorTest, ReallocateCopiesData) {
+  auto* ptr = static_cast<uint8_t*>(caching_.Allocate(Layout(32, 8)));
+  ASSERT_NE(ptr, nullptr);
+  for (uint8_t i = 0; i < 32; ++i) {
+    ptr[i] = i;
+  }
+
+  auto* new_ptr =
+      static_cast<uint8_t*>(caching_.Reallocate(ptr, Layout(256, 8)));
+  ASSERT_NE(new_ptr, nullptr);
+  for (uint8_t i = 0; i < 32; ++i) {
+    EXPECT_EQ(new_ptr[i], i);
+  }
+  caching_.Deallocate(new_ptr);
+}
+
+TEST_F(ThreadCachingAllocatorTest, DestructorReturnsChunks) {
+  AllocatorForTest allocator;
+  {
+    ThreadCachingAllocator caching(kToken, allocator);
+    caching.Deallocate(caching.Allocate(Layout(16, 8)));
+    EXPECT_NE(allocator.GetAllocated(), 0u);
+  }
+  EXPECT_EQ(allocator.GetAllocated(), 0u);
+}
+
+// TODO: https://pwbug.dev/365161669 - Express joinability as a build-system
+// constraint.
+#if PW_THREAD_JOINING_ENABLED
+
+/// Allocations made on one thread, to be checked and freed on another.
+class Batch {
+ public:
+  Batch(pw::Allocator& allocator, uint8_t id)
+      : allocator_(allocator), id_(id) {}
+
+  bool corrupted() const { return corrupted_; }
+
+  void Allocate() {
+    for (size_t i = 0; i < ptrs_.size(); ++i) {
+      ptrs_[i] = allocator_.Allocate(Layout(Size(i), 8));
+      if (ptrs_[i] != nullptr) {
+        std::memset(ptrs_[i], id_, Size(i));
+      }
+    }
+  }
+
+  void Free() {
+    for (size_t i = 0; i < ptrs_.size(); ++i) {
+      if (ptrs_[i] == nullptr) {
+        continue;
+      }
+      const auto* bytes = static_cast<const uint8_t*>(ptrs_[i]);
+      for (size_t j = 0; j < Size(i); ++j) {
+        if (bytes[j] != id_) {
+          corrupted_ = true;
+        }
+      }
+      allocator_.Deallocate(ptrs_[i]);
+      ptrs_[i] = nullptr;
+    }
+  }
+
+ private:
+  // Sizes cover every size class.
+  static size_t Size(size_t i) { return 8 + (i * 37) % 120; }
+
+  pw::Allocator& allocator_;
+  const uint8_t id_;
+  std::array<void*, 8> ptrs_{};
+  bool corrupted_ = false;
+};
+
+TEST_F(ThreadCachingAllocatorTest, FreesFromOtherThreads) {
+  constexpr size_t kRounds = 50;
+  Batch batch1(caching_, 1);
+  Batch batch2(caching_, 2);
+  Batch batch3(caching_, 3);
+  pw::thread::test::TestThreadContext context1;
+  pw::thread::test::TestThreadContext context2;
+
+  for (size_t i = 0; i < kRounds; ++i) {
+    // Each thread allocates a batch...
+    pw::Thread thread1(context1.options(), [&batch1] { batch1.Allocate(); });
+    pw::Thread thread2(context2.options(), [&batch2] { batch2.Allocate(); });
+    batch3.Allocate();
+    thread1.join();
+    thread2.join();
+
+    // ...and then frees a batch allocated on another thread, so chunks move
+    // between caches and are drained back to the underlying allocator.
+    pw::Thread thread3(context1.options(), [&batch2] { batch2.Free(); });
+    pw::Thread thread4(context2.options(), [&batch3] { batch3.Free(); });
+    batch1.Free();
+    thread3.join();
+    thread4.join();
+  }
+
+  EXPECT_FALSE(batch1.corrupted());
+  EXPECT_FALSE(batch2.corrupted());
+  EXPECT_FALSE(batch3.corrupted());
+  EXPECT_GT(hits(), 0u);
+
+  caching_.Flush();
+  EXPECT_EQ(allocator_.GetAllocated(), 0u);
+}
+
+#endif  // PW_THREAD_JOINING_ENABLED
+
+}  // namespace
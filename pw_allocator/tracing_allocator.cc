@@ -0,0 +1,254 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_allocator/tracing_allocator.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#include "lib/stdcompat/bit.h"
+#include "pw_varint/varint.h"
+
+namespace pw::allocator {
+namespace {
+
+// Each event starts with a header byte:
+//
+//   bits 0-1: `TraceEventType`
+//   bit 2:    set if the request failed
+//   bits 3-7: log2 of the requested alignment, for allocate and reallocate
+//
+// and is followed by varint-encoded fields:
+//
+//   all:         clock ticks since the previous event
+//   allocate:    size, [address delta]
+//   deallocate:  address delta
+//   resize:      address delta, new size
+//   reallocate:  address delta, new size, [new address - old address]
+//
+// Address deltas are signed and relative to the previous address in the trace.
+// Fields in brackets are omitted if the request failed.
+constexpr uint8_t kTypeMask = 0x03;
+constexpr uint8_t kFailedFlag = 0x04;
+constexpr uint8_t kAlignmentShift = 3;
+constexpr size_t kMaxAlignmentLog2 = 0x1F;
+
+/// Appends a varint to an event, advancing `offset`.
+template <typename T>
+void Append(T value, ByteSpan event, size_t& offset) {
+  offset += varint::Encode(value, event.subspan(offset));
+}
+
+/// Reads a varint from the front of `trace`, advancing it.
+template <typename T>
+bool Consume(ConstByteSpan& trace, T& value) {
+  size_t bytes = varint::Decode(trace, &value);
+  trace = trace.subspan(bytes);
+  return bytes != 0;
+}
+
+}  // namespace
+
+void TracingAllocator::Clear() {
+  size_ = 0;
+  num_dropped_ = 0;
+  last_time_.reset();
+  last_ptr_ = 0;
+}
+
+void* TracingAllocator::DoAllocate(Layout layout) {
+  auto start = chrono::SystemClock::now();
+  void* ptr = allocator_.Allocate(layout);
+  TraceEvent event;
+  event.type = TraceEventType::kAllocate;
+  event.result = cpp20::bit_cast<uintptr_t>(ptr);
+  event.layout = layout;
+  Record(start, event);
+  return ptr;
+}
+
+void TracingAllocator::DoDeallocate(void* ptr) {
+  auto start = chrono::SystemClock::now();
+  allocator_.Deallocate(ptr);
+  TraceEvent event;
+  event.type = TraceEventType::kDeallocate;
+  event.ptr = cpp20::bit_cast<uintptr_t>(ptr);
+  Record(start, event);
+}
+
+bool TracingAllocator::DoResize(void* ptr, size_t new_size) {
+  auto start = chrono::SystemClock::now();
+  bool resized = allocator_.Resize(ptr, new_size);
+  TraceEvent event;
+  event.type = TraceEventType::kResize;
+  event.ptr = cpp20::bit_cast<uintptr_t>(ptr);
+  event.result = resized ? event.ptr : 0;
+  event.layout = Layout(new_size);
+  Record(start, event);
+  return resized;
+}
+
+void* TracingAllocator::DoReallocate(void* ptr, Layout new_layout) {
+  auto start = chrono::SystemClock::now();
+  void* new_ptr = allocator_.Reallocate(ptr, new_layout);
+  TraceEvent event;
+  event.type = TraceEventType::kReallocate;
+  event.ptr = cpp20::bit_cast<uintptr_t>(ptr);
+  event.result = cpp20::bit_cast<uintptr_t>(new_ptr);
+  event.layout = new_layout;
+  Record(start, event);
+  return new_ptr;
+}
+
+void TracingAllocator::Record(chrono::SystemClock::time_point start,
+                              const TraceEvent& event) {
+  if (num_dropped_ != 0) {
+    ++num_dropped_;
+    return;
+  }
+  std::array<std::byte, kMaxEventSize> encoded;
+  ByteSpan bytes(encoded);
+  bool failed = event.type != TraceEventType::kDeallocate && event.result == 0;
+  auto header = static_cast<uint8_t>(event.type);
+  if (failed) {
+    header |= kFailedFlag;
+  }
+  if (event.type == TraceEventType::kAllocate ||
+      event.type == TraceEventType::kReallocate) {
+    auto alignment_log2 = static_cast<size_t>(
+        cpp20::countr_zero(static_cast<size_t>(event.layout.alignment())));
+    header |= static_cast<uint8_t>(std::min(alignment_log2, kMaxAlignmentLog2)
+                                   << kAlignmentShift);
+  }
+  bytes[0] = static_cast<std::byte>(header);
+  size_t offset = 1;
+
+  uint64_t ticks = 0;
+  if (last_time_.has_value()) {
+    ticks = static_cast<uint64_t>((start - *last_time_).count());
+  }
+  Append(ticks, bytes, offset);
+
+  auto append_ptr = [this, &bytes, &offset](uintptr_t ptr) {
+    Append(static_cast<intptr_t>(ptr - last_ptr_), bytes, offset);
+    last_ptr_ = ptr;
+  };
+  switch (event.type) {
+    case TraceEventType::kAllocate:
+      Append(event.layout.size(), bytes, offset);
+      if (!failed) {
+        append_ptr(event.result);
+      }
+      break;
+    case TraceEventType::kDeallocate:
+      append_ptr(event.ptr);
+      break;
+    case TraceEventType::kResize:
+      append_ptr(event.ptr);
+      Append(event.layout.size(), bytes, offset);
+      break;
+    case TraceEventType::kReallocate:
+      append_ptr(event.ptr);
+      Append(event.layout.size(), bytes, offset);
+      if (!failed) {
+        Append(static_cast<intptr_t>(event.result - event.ptr), bytes, offset);
+      }
+      break;
+  }
+
+  if (buffer_.size() - size_ < offset) {
+    num_dropped_ = 1;
+    return;
+  }
+  std::memcpy(buffer_.data() + size_, encoded.data(), offset);
+  size_ += offset;
+  last_time_ = start;
+}
+
+Result<TraceEvent> TraceReader::Next() {
+  if (trace_.empty()) {
+    return Status::OutOfRange();
+  }
+  auto header = static_cast<uint8_t>(trace_[0]);
+  trace_ = trace_.subspan(1);
+
+  TraceEvent event;
+  event.type = static_cast<TraceEventType>(header & kTypeMask);
+  bool failed = (header & kFailedFlag) != 0;
+  size_t alignment = size_t(1) << (header >> kAlignmentShift);
+
+  uint64_t ticks;
+  if (!Consume(trace_, ticks)) {
+    return Status::DataLoss();
+  }
+  timestamp_ += chrono::SystemClock::duration(
+      static_cast<chrono::SystemClock::duration::rep>(ticks));
+  event.timestamp = timestamp_;
+
+  auto consume_ptr = [this](uintptr_t& ptr) {
+    int64_t delta;
+    if (!Consume(trace_, delta)) {
+      return false;
+    }
+    last_ptr_ += static_cast<uintptr_t>(delta);
+    ptr = last_ptr_;
+    return true;
+  };
+  auto consume_size = [this](size_t& size) {
+    uint64_t value;
+    if (!Consume(trace_, value)) {
+      return false;
+    }
+    size = static_cast<size_t>(value);
+    return true;
+  };
+
+  size_t size = 0;
+  switch (event.type) {
+    case TraceEventType::kAllocate:
+      if (!consume_size(size) || (!failed && !consume_ptr(event.result))) {
+        return Status::DataLoss();
+      }
+      event.layout = Layout(size, alignment);
+      break;
+    case TraceEventType::kDeallocate:
+      if (failed || !consume_ptr(event.ptr)) {
+        return Status::DataLoss();
+      }
+      break;
+    case TraceEventType::kResize:
+      if (!consume_ptr(event.ptr) || !consume_size(size)) {
+        return Status::DataLoss();
+      }
+      event.result = failed ? 0 : event.ptr;
+      event.layout = Layout(size);
+      break;
+    case TraceEventType::kReallocate: {
+      if (!consume_ptr(event.ptr) || !consume_size(size)) {
+        return Status::DataLoss();
+      }
+      int64_t delta = 0;
+      if (!failed && !Consume(trace_, delta)) {
+        return Status::DataLoss();
+      }
+      event.result = failed ? 0 : event.ptr + static_cast<uintptr_t>(delta);
+      event.layout = Layout(size, alignment);
+      break;
+    }
+  }
+  return event;
+}
+
+}  // namespace pw::allocator
@@ -0,0 +1,234 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_allocator/tracing_allocator.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "lib/stdcompat/bit.h"
+#include "pw_allocator/testing.h"
+#include "pw_unit_test/framework.h"
+
+namespace {
+
+// Test fixtures.
+
+using ::pw::allocator::Layout;
+using ::pw::allocator::TraceEvent;
+using ::pw::allocator::TraceEventType;
+using ::pw::allocator::TraceReader;
+using ::pw::allocator::TracingAllocator;
+using AllocatorForTest = ::pw::allocator::test::AllocatorForTest<1024>;
+
+constexpr size_t kBufferSize = 256;
+
+class TracingAllocatorTest : public ::testing::Test {
+ protected:
+  TracingAllocatorTest() : tracer_(allocator_, buffer_) {}
+
+  /// Decodes the next event, and checks that it has the given type.
+  TraceEvent NextEvent(TraceReader& reader, TraceEventType type) {
+    auto result = reader.Next();
+    EXPECT_EQ(result.status(), pw::OkStatus());
+    if (!result.ok()) {
+      return TraceEvent();
+    }
+    EXPECT_EQ(result->type, type);
+    return *result;
+  }
+
+  AllocatorForTest allocator_;
+  std::array<std::byte, kBufferSize> buffer_;
+  TracingAllocator tracer_;
+};
+
+uintptr_t ToAddr(const void* ptr) { return cpp20::bit_cast<uintptr_t>(ptr); }
+
+// Unit tests.
+
+TEST_F(TracingAllocatorTest, ForwardsCapabilities) {
+  EXPECT_EQ(tracer_.capabilities(), allocator_.capabilities());
+}
+
+TEST_F(TracingAllocatorTest, TraceIsInitiallyEmpty) {
+  EXPECT_TRUE(tracer_.trace().empty());
+  TraceReader reader(tracer_.trace());
+  EXPECT_EQ(reader.Next().status(), pw::Status::OutOfRange());
+}
+
+TEST_F(TracingAllocatorTest, RecordsAllocateAndDeallocate) {
+  void* ptr = tracer_.Allocate(Layout(48, 16));
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_EQ(allocator_.allocate_size(), 48u);
+  tracer_.Deallocate(ptr);
+  EXPECT_EQ(allocator_.deallocate_ptr(), ptr);
+
+  TraceReader reader(tracer_.trace());
+  TraceEvent event = NextEvent(reader, TraceEventType::kAllocate);
+  EXPECT_EQ(event.result, ToAddr(ptr));
+  EXPECT_EQ(event.layout, Layout(48, 16));
+  EXPECT_EQ(event.timestamp.count(), 0);
+
+  event = NextEvent(reader, TraceEventType::kDeallocate);
+  EXPECT_EQ(event.ptr, ToAddr(ptr));
+  EXPECT_EQ(event.result, 0u);
+  EXPECT_GE(event.timestamp.count(), 0);
+
+  EXPECT_EQ(reader.Next().status(), pw::Status::OutOfRange());
+}
+
+TEST_F(TracingAllocatorTest, RecordsFailedAllocate) {
+  EXPECT_EQ(tracer_.Allocate(Layout(4096, 8)), nullptr);
+
+  TraceReader reader(tracer_.trace());
+  TraceEvent event = NextEvent(reader, TraceEventType::kAllocate);
+  EXPECT_EQ(event.result, 0u);
+  EXPECT_EQ(event.layout, Layout(4096, 8));
+}
+
+TEST_F(TracingAllocatorTest, RecordsResize) {
+  void* ptr = tracer_.Allocate(Layout(64, 8));
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_TRUE(tracer_.Resize(ptr, 32));
+  EXPECT_FALSE(tracer_.Resize(ptr, 4096));
+  tracer_.Deallocate(ptr);
+
+  TraceReader reader(tracer_.trace());
+  NextEvent(reader, TraceEventType::kAllocate);
+
+  TraceEvent event = NextEvent(reader, TraceEventType::kResize);
+  EXPECT_EQ(event.ptr, ToAddr(ptr));
+  EXPECT_EQ(event.result, ToAddr(ptr));
+  EXPECT_EQ(event.layout.size(), 32u);
+
+  event = NextEvent(reader, TraceEventType::kResize);
+  EXPECT_EQ(event.ptr, ToAddr(ptr));
+  EXPECT_EQ(event.result, 0u);
+  EXPECT_EQ(event.layout.size(), 4096u);
+
+  NextEvent(reader, TraceEventType::kDeallocate);
+}
+
+TEST_F(TracingAllocatorTest, RecordsReallocate) {
+  void* ptr1 = tracer_.Allocate(Layout(32, 8));
+  void* ptr2 = tracer_.Allocate(Layout(32, 8));
+  ASSERT_NE(ptr1, nullptr);
+  ASSERT_NE(ptr2, nullptr);
+
+  // The neighboring allocation prevents resizing in place.
+  void* ptr3 = tracer_.Reallocate(ptr1, Layout(128, 8));
+  ASSERT_NE(ptr3, nullptr);
+  EXPECT_EQ(tracer_.Reallocate(ptr3, Layout(4096, 8)), nullptr);
+  tracer_.Deallocate(ptr2);
+  tracer_.Deallocate(ptr3);
+
+  TraceReader reader(tracer_.trace());
+  NextEvent(reader, TraceEventType::kAllocate);
+  NextEvent(reader, TraceEventType::kAllocate);
+
+  TraceEvent event = NextEvent(reader, TraceEventType::kReallocate);
+  EXPECT_EQ(event.ptr, ToAddr(ptr1));
+  EXPECT_EQ(event.result, ToAddr(ptr3));
+  EXPECT_EQ(event.layout, Layout(128, 8));
+
+  event = NextEvent(reader, TraceEventType::kReallocate);
+  EXPECT_EQ(event.ptr, ToAddr(ptr3));
+  EXPECT_EQ(event.result, 0u);
+  EXPECT_EQ(event.layout, Layout(4096, 8));
+
+  EXPECT_EQ(NextEvent(reader, TraceEventType::kDeallocate).ptr, ToAddr(ptr2));
+  EXPECT_EQ(NextEvent(reader, TraceEventType::kDeallocate).ptr, ToAddr(ptr3));
+}
+
+TEST_F(TracingAllocatorTest, TimestampsIncrease) {
+  for (size_t i = 0; i < 4; ++i) {
+    void* ptr = tracer_.Allocate(Layout(16, 8));
+    ASSERT_NE(ptr, nullptr);
+    tracer_.Deallocate(ptr);
+  }
+  TraceReader reader(tracer_.trace());
+  pw::chrono::SystemClock::duration prev(0);
+  for (auto event = reader.Next(); event.ok(); event = reader.Next()) {
+    EXPECT_GE(event->timestamp, prev);
+    prev = event->timestamp;
+  }
+}
+
+TEST_F(TracingAllocatorTest, EventsAreCompact) {
+  void* ptr = tracer_.Allocate(Layout(16, 8));
+  ASSERT_NE(ptr, nullptr);
+  size_t size = tracer_.trace().size();
+  tracer_.Deallocate(ptr);
+
+  // A deallocation of the most recent address needs a header byte, a few bytes
+  // for the timestamp delta, and a single byte for the address delta.
+  EXPECT_LE(tracer_.trace().size() - size, 8u);
+}
+
+TEST_F(TracingAllocatorTest, DropsEventsWhenFull) {
+  std::array<std::byte, 16> buffer;
+  TracingAllocator tracer(allocator_, buffer);
+  size_t num_events = 0;
+  while (tracer.num_dropped() == 0) {
+    void* ptr = tracer.Allocate(Layout(16, 8));
+    ASSERT_NE(ptr, nullptr);
+    tracer.Deallocate(ptr);
+    num_events += 2;
+  }
+  size_t size = tracer.trace().size();
+  void* ptr = tracer.Allocate(Layout(1, 1));
+  tracer.Deallocate(ptr);
+
+  // Later events are dropped, even if they would fit.
+  EXPECT_EQ(tracer.trace().size(), size);
+  EXPECT_GE(tracer.num_dropped(), 2u);
+
+  // The recorded events remain decodable.
+  TraceReader reader(tracer.trace());
+  size_t num_recorded = 0;
+  auto event = reader.Next();
+  for (; event.ok(); event = reader.Next()) {
+    ++num_recorded;
+  }
+  EXPECT_EQ(event.status(), pw::Status::OutOfRange());
+  EXPECT_EQ(num_recorded + tracer.num_dropped(), num_events + 2);
+}
+
+TEST_F(TracingAllocatorTest, Clear) {
+  void* ptr = tracer_.Allocate(Layout(16, 8));
+  ASSERT_NE(ptr, nullptr);
+  tracer_.Clear();
+  EXPECT_TRUE(tracer_.trace().empty());
+
+  tracer_.Deallocate(ptr);
+  TraceReader reader(tracer_.trace());
+  TraceEvent event = NextEvent(reader, TraceEventType::kDeallocate);
+  EXPECT_EQ(event.ptr, ToAddr(ptr));
+  EXPECT_EQ(event.timestamp.count(), 0);
+}
+
+TEST_F(TracingAllocatorTest, ReaderDetectsTruncatedTrace) {
+  void* ptr = tracer_.Allocate(Layout(16, 8));
+  ASSERT_NE(ptr, nullptr);
+  tracer_.Deallocate(ptr);
+  pw::ConstByteSpan trace = tracer_.trace();
+
+  TraceReader reader(trace.first(trace.size() - 1));
+  EXPECT_EQ(reader.Next().status(), pw::OkStatus());
+  EXPECT_EQ(reader.Next().status(), pw::Status::DataLoss());
+}
+
+}  // namespace
@@ -43,7 +43,7 @@ void NativeDispatcherBase::Post(Task& task) {
     PW_DASSERT(task.dispatcher_ == nullptr);
     task.state_ = Task::State::kWoken;
     task.dispatcher_ = this;
-    woken_.push_back(task);
+    PushWokenTaskLocked(task);
     if (wants_wake_) {
       wake_dispatcher = true;
       wants_wake_ = false;
@@ -61,7 +61,7 @@ NativeDispatcherBase::SleepInfo NativeDispatcherBase::AttemptRequestWake(
     bool allow_empty) {
   std::lock_guard lock(impl::dispatcher_lock());
   // Don't allow sleeping if there are already tasks waiting to be run.
-  if (!woken_.empty()) {
+  if (HasWokenTasksLocked()) {
     PW_LOG_DEBUG("Dispatcher will not sleep due to nonempty task queue");
     return SleepInfo::DontSleep();
   }
@@ -86,75 +86,89 @@ NativeDispatcherBase::RunOneTaskResult NativeDispatcherBase::RunOneTask(
     task = PopWokenTask();
     if (task == nullptr) {
       PW_LOG_DEBUG("Dispatcher has no woken tasks to run");
-      bool all_complete = woken_.empty() && sleeping_.empty();
+      bool all_complete = !HasWokenTasksLocked() && sleeping_.empty();
       return RunOneTaskResult(
           /*completed_all_tasks=*/all_complete,
           /*completed_main_task=*/false,
           /*ran_a_task=*/false);
     }
-    task->state_ = Task::State::kRunning;
+    StartRunningTaskLocked(*task);
   }
+  return RunTask(dispatcher, *task, task_to_look_for);
+}
+
+void NativeDispatcherBase::StartRunningTaskLocked(Task& task) {
+  PW_DASSERT(task.state_ == Task::State::kWoken);
+  PW_DASSERT(task.dispatcher_ == this);
+  task.state_ = Task::State::kRunning;
+  tasks_polled_.Increment();
+}
 
+NativeDispatcherBase::RunOneTaskResult NativeDispatcherBase::RunTask(
+    Dispatcher& dispatcher, Task& task, Task* task_to_look_for) {
   bool complete;
   bool requires_waker;
   {
-    Waker waker(*task);
+    Waker waker(task);
     Context context(dispatcher, waker);
-    tasks_polled_.Increment();
-    complete = task->Pend(context).IsReady();
+    complete = task.Pend(context).IsReady();
     requires_waker = context.requires_waker_;
   }
 
   if (complete) {
-    tasks_completed_.Increment();
     bool all_complete;
     {
       std::lock_guard lock(impl::dispatcher_lock());
-      switch (task->state_) {
+      switch (task.state_) {
         case Task::State::kUnposted:
+        case Task::State::kWoken:
         case Task::State::kSleeping:
           PW_DASSERT(false);
           PW_UNREACHABLE;
         case Task::State::kRunning:
-          break;
-        case Task::State::kWoken:
-          RemoveWokenTaskLocked(*task);
+        case Task::State::kWokenWhileRunning:
           break;
       }
-      task->state_ = Task::State::kUnposted;
-      task->dispatcher_ = nullptr;
-      task->RemoveAllWakersLocked();
-      all_complete = woken_.empty() && sleeping_.empty();
+      tasks_completed_.Increment();
+      task.state_ = Task::State::kUnposted;
+      task.dispatcher_ = nullptr;
+      task.RemoveAllWakersLocked();
+      all_complete = !HasWokenTasksLocked() && sleeping_.empty();
     }
-    task->DoDestroy();
+    task.DoDestroy();
     return RunOneTaskResult(
         /*completed_all_tasks=*/all_complete,
-        /*completed_main_task=*/task == task_to_look_for,
+        /*completed_main_task=*/&task == task_to_look_for,
         /*ran_a_task=*/true);
   }
 
   std::lock_guard lock(impl::dispatcher_lock());
-  if (task->state_ == Task::State::kRunning) {
-    if (task->name_ != log::kDefaultToken) {
+  if (task.state_ == Task::State::kWokenWhileRunning) {
+    // The task was woken while it ran. It was not added to the run queue
+    // then, since it must not run again until this call returns.
+    task.state_ = Task::State::kWoken;
+    PushWokenTaskLocked(task);
+  } else if (task.state_ == Task::State::kRunning) {
+    if (task.name_ != log::kDefaultToken) {
       PW_LOG_DEBUG(
           "Dispatcher adding task " PW_LOG_TOKEN_FMT() ":%p to sleep queue",
-          task->name_,
-          static_cast<const void*>(task));
+          task.name_,
+          static_cast<const void*>(&task));
     } else {
       PW_LOG_DEBUG("Dispatcher adding task (anonymous):%p to sleep queue",
-                   static_cast<const void*>(task));
+                   static_cast<const void*>(&task));
     }
 
     if (requires_waker) {
-      PW_CHECK(!task->wakers_.empty(),
+      PW_CHECK(!task.wakers_.empty(),
                "Task %p returned Pending() without registering a waker",
-               static_cast<const void*>(task));
-      task->state_ = Task::State::kSleeping;
-      sleeping_.push_front(*task);
+               static_cast<const void*>(&task));
+      task.state_ = Task::State::kSleeping;
+      sleeping_.push_front(task);
     } else {
       // Require the task to be manually re-posted.
-      task->state_ = Task::State::kUnposted;
-      task->dispatcher_ = nullptr;
+      task.state_ = Task::State::kUnposted;
+      task.dispatcher_ = nullptr;
     }
   }
   return RunOneTaskResult(
@@ -173,10 +187,6 @@ void NativeDispatcherBase::UnpostTaskList(IntrusiveList<Task>& list) {
   }
 }
 
-void NativeDispatcherBase::RemoveWokenTaskLocked(Task& task) {
-  woken_.remove(task);
-}
-
 void NativeDispatcherBase::RemoveSleepingTaskLocked(Task& task) {
   sleeping_.remove(task);
 }
@@ -193,23 +203,26 @@ void NativeDispatcherBase::WakeTask(Task& task) {
 
   switch (task.state_) {
     case Task::State::kWoken:
+    case Task::State::kWokenWhileRunning:
       // Do nothing-- this has already been woken.
       return;
     case Task::State::kUnposted:
       // This should be unreachable.
       PW_CHECK(false);
     case Task::State::kRunning:
-      // Wake again to indicate that this task should be run once more,
-      // as the state of the world may have changed since the task
-      // started running.
-      break;
+      // Mark the task to be run once more, as the state of the world may have
+      // changed since the task started running. It is added to the run queue
+      // once it returns from ``Pend``, so that it never runs concurrently with
+      // itself.
+      task.state_ = Task::State::kWokenWhileRunning;
+      return;
     case Task::State::kSleeping:
       RemoveSleepingTaskLocked(task);
       // Wake away!
       break;
   }
   task.state_ = Task::State::kWoken;
-  woken_.push_back(task);
+  PushWokenTaskLocked(task);
   if (wants_wake_) {
     // Note: it's quite annoying to make this call under the lock, as it can
     // result in extra thread wakeup/sleep cycles.
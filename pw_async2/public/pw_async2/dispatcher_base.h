@@ -134,6 +134,70 @@ class NativeDispatcherBase {
   [[nodiscard]] RunOneTaskResult RunOneTask(Dispatcher& dispatcher,
                                             Task* task_to_look_for);
 
+  /// Marks a task that was removed from the run queue as running.
+  ///
+  /// ``RunOneTask`` does this itself. This and ``RunTask`` should only be used
+  /// by ``Dispatcher`` implementations that manage their own run queues, such
+  /// as those that run tasks on multiple threads.
+  void StartRunningTaskLocked(Task& task)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(impl::dispatcher_lock());
+
+  /// Runs a task passed to ``StartRunningTaskLocked``, then completes it,
+  /// puts it to sleep, or returns it to the run queue.
+  ///
+  /// The caller must hold the lock returned by ``TaskExecutionLockLocked``
+  /// for this task.
+  ///
+  /// ``completed_all_tasks`` in the result only accounts for tasks in the run
+  /// queue and the sleep queue, not for tasks running on other threads.
+  [[nodiscard]] RunOneTaskResult RunTask(Dispatcher& dispatcher,
+                                         Task& task,
+                                         Task* task_to_look_for)
+      PW_LOCKS_EXCLUDED(impl::dispatcher_lock());
+
+  /// Removes and returns the first task in the shared run queue, or
+  /// ``nullptr`` if it is empty.
+  Task* PopWokenTask() PW_EXCLUSIVE_LOCKS_REQUIRED(impl::dispatcher_lock());
+
+  bool HasSleepingTasksLocked() const
+      PW_EXCLUSIVE_LOCKS_REQUIRED(impl::dispatcher_lock()) {
+    return !sleeping_.empty();
+  }
+
+  static void UnpostTaskList(IntrusiveList<Task>& list)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(impl::dispatcher_lock());
+
+  // Run queue hooks.
+  //
+  // By default, woken tasks are kept in a single shared run queue. A
+  // ``Dispatcher`` that keeps woken tasks elsewhere, such as in per-thread
+  // queues, overrides all of these.
+
+  /// Adds a woken task to the run queue.
+  virtual void PushWokenTaskLocked(Task& task)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(impl::dispatcher_lock()) {
+    woken_.push_back(task);
+  }
+
+  /// Removes a woken task from the run queue.
+  virtual void RemoveWokenTaskLocked(Task& task)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(impl::dispatcher_lock()) {
+    woken_.remove(task);
+  }
+
+  /// Returns whether any tasks are in the run queue.
+  virtual bool HasWokenTasksLocked() const
+      PW_EXCLUSIVE_LOCKS_REQUIRED(impl::dispatcher_lock()) {
+    return !woken_.empty();
+  }
+
+  /// Returns the lock that is held while ``task`` runs. ``Task::Deregister``
+  /// acquires it to wait for a running task to return from ``Pend``.
+  virtual pw::sync::Mutex& TaskExecutionLockLocked([[maybe_unused]] Task& task)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(impl::dispatcher_lock()) {
+    return task_execution_lock_;
+  }
+
   uint32_t tasks_polled() const { return tasks_polled_.value(); }
   uint32_t tasks_completed() const { return tasks_completed_.value(); }
   uint32_t sleep_count() const { return sleep_count_.value(); }
@@ -159,19 +223,12 @@ class NativeDispatcherBase {
   /// been acquired.
   virtual void DoWake() = 0;
 
-  static void UnpostTaskList(IntrusiveList<Task>& list)
-      PW_EXCLUSIVE_LOCKS_REQUIRED(impl::dispatcher_lock());
-  void RemoveWokenTaskLocked(Task&)
-      PW_EXCLUSIVE_LOCKS_REQUIRED(impl::dispatcher_lock());
   void RemoveSleepingTaskLocked(Task&)
       PW_EXCLUSIVE_LOCKS_REQUIRED(impl::dispatcher_lock());
 
   // For use by ``Waker``.
   void WakeTask(Task&) PW_EXCLUSIVE_LOCKS_REQUIRED(impl::dispatcher_lock());
 
-  // For use by ``RunOneTask``.
-  Task* PopWokenTask() PW_EXCLUSIVE_LOCKS_REQUIRED(impl::dispatcher_lock());
-
   void LogRegisteredTasks();
 
 #if PW_ASYNC2_DEBUG_WAIT_REASON
@@ -125,7 +125,10 @@ class Task : public IntrusiveList<Task>::Item {
   /// this will result in a deadlock.
   ///
   /// NOTE: If this task's ``Pend`` method is currently being run on the
-  /// dispatcher, this method will block until ``Pend`` completes.
+  /// dispatcher, this method will block until ``Pend`` completes. On a
+  /// dispatcher that runs tasks on multiple threads, a task must not
+  /// deregister another task while that task is running, since the two tasks
+  /// could wait for each other forever.
   ///
   /// NOTE: This method sadly cannot guard against the dispatcher itself being
   /// destroyed, so this method must not be called concurrently with
@@ -197,6 +200,9 @@ class Task : public IntrusiveList<Task>::Item {
   enum class State {
     kUnposted,
     kRunning,
+    // The task was woken while it was running. It is added to the run queue
+    // when it returns from ``Pend``.
+    kWokenWhileRunning,
     kWoken,
     kSleeping,
   };
@@ -57,16 +57,23 @@ void Task::Deregister() {
     }
     // The task was running, so we have to wait for the task to stop being
     // run by acquiring the `task_lock`.
-    task_execution_lock = &dispatcher_->task_execution_lock_;
+    task_execution_lock = &dispatcher_->TaskExecutionLockLocked(*this);
   }
 
   // NOTE: there is a race here where `task_execution_lock_` may be
   // invalidated by concurrent destruction of the dispatcher.
   //
   // This restriction is documented above, but is still fairly footgun-y.
-  std::lock_guard task_lock(*task_execution_lock);
-  std::lock_guard lock(impl::dispatcher_lock());
-  PW_CHECK(TryDeregister());
+  while (true) {
+    std::lock_guard task_lock(*task_execution_lock);
+    std::lock_guard lock(impl::dispatcher_lock());
+    if (TryDeregister()) {
+      return;
+    }
+    // A dispatcher that runs tasks on multiple threads may have started
+    // running the task again on another thread before the lock was acquired.
+    task_execution_lock = &dispatcher_->TaskExecutionLockLocked(*this);
+  }
 }
 
 bool Task::TryDeregister() {
@@ -77,6 +84,7 @@ bool Task::TryDeregister() {
       dispatcher_->RemoveSleepingTaskLocked(*this);
       break;
     case Task::State::kRunning:
+    case Task::State::kWokenWhileRunning:
       return false;
     case Task::State::kWoken:
       dispatcher_->RemoveWokenTaskLocked(*this);
@@ -87,7 +95,7 @@ bool Task::TryDeregister() {
 
   // Wake the dispatcher up if this was the last task so that it can see that
   // all tasks have completed.
-  if (dispatcher_->woken_.empty() && dispatcher_->sleeping_.empty() &&
+  if (!dispatcher_->HasWokenTasksLocked() && dispatcher_->sleeping_.empty() &&
       dispatcher_->wants_wake_) {
     dispatcher_->Wake();
   }
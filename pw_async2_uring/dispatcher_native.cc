@@ -0,0 +1,470 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_async2/dispatcher_native.h"
+
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <mutex>
+
+#include "pw_assert/check.h"
+#include "pw_log/log.h"
+#include "pw_status/status.h"
+
+namespace pw::async2::backend {
+namespace {
+
+// user_data values that do not refer to a NativeOperation. Operations are
+// identified by their address, so these never collide with one.
+constexpr uint64_t kIgnoredUserData = 0;
+constexpr uint64_t kWakeUserData = 1;
+
+// liburing is not required; the three io_uring syscalls are used directly.
+int io_uring_setup(uint32_t entries, io_uring_params& params) {
+  return static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+}
+
+int io_uring_enter(int ring_fd,
+                   uint32_t to_submit,
+                   uint32_t min_complete,
+                   uint32_t flags) {
+  return static_cast<int>(syscall(__NR_io_uring_enter,
+                                  ring_fd,
+                                  to_submit,
+                                  min_complete,
+                                  flags,
+                                  nullptr,
+                                  size_t{0}));
+}
+
+int io_uring_register(int ring_fd,
+                      uint32_t opcode,
+                      const void* arg,
+                      uint32_t nr_args) {
+  return static_cast<int>(
+      syscall(__NR_io_uring_register, ring_fd, opcode, arg, nr_args));
+}
+
+// The ring indices are shared with the kernel.
+uint32_t LoadAcquire(const uint32_t* index) {
+  return __atomic_load_n(index, __ATOMIC_ACQUIRE);
+}
+
+void StoreRelease(uint32_t* index, uint32_t value) {
+  __atomic_store_n(index, value, __ATOMIC_RELEASE);
+}
+
+template <typename T>
+T* RingField(void* ring, uint32_t offset) {
+  return reinterpret_cast<T*>(static_cast<std::byte*>(ring) + offset);
+}
+
+void* MapRing(int ring_fd, size_t size, off_t offset) {
+  void* ring = mmap(nullptr,
+                    size,
+                    PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE,
+                    ring_fd,
+                    offset);
+  return ring == MAP_FAILED ? nullptr : ring;
+}
+
+}  // namespace
+
+Status NativeDispatcher::NativeInit() {
+  io_uring_params params;
+  std::memset(&params, 0, sizeof(params));
+  // Completions are only collected by the dispatcher thread, from within
+  // io_uring_enter, so the kernel need not interrupt it to post them.
+  params.flags = IORING_SETUP_CLAMP | IORING_SETUP_COOP_TASKRUN;
+
+  ring_fd_ = io_uring_setup(kQueueDepth, params);
+  if (ring_fd_ == -1 && errno == EINVAL) {
+    // IORING_SETUP_COOP_TASKRUN requires Linux 5.19.
+    std::memset(&params, 0, sizeof(params));
+    params.flags = IORING_SETUP_CLAMP;
+    ring_fd_ = io_uring_setup(kQueueDepth, params);
+  }
+  if (ring_fd_ == -1) {
+    PW_LOG_ERROR("Failed to create io_uring: %s", std::strerror(errno));
+    return Status::Internal();
+  }
+
+  sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+  cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  if (single_mmap) {
+    sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+  }
+
+  sq_ring_ = MapRing(ring_fd_, sq_ring_size_, IORING_OFF_SQ_RING);
+  cq_ring_ = single_mmap ? sq_ring_
+                         : MapRing(ring_fd_, cq_ring_size_, IORING_OFF_CQ_RING);
+  sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+  sqes_ = static_cast<io_uring_sqe*>(
+      MapRing(ring_fd_, sqes_size_, IORING_OFF_SQES));
+  if (sq_ring_ == nullptr || cq_ring_ == nullptr || sqes_ == nullptr) {
+    PW_LOG_ERROR("Failed to map io_uring: %s", std::strerror(errno));
+    return Status::Internal();
+  }
+
+  sq_head_ = RingField<uint32_t>(sq_ring_, params.sq_off.head);
+  sq_tail_ = RingField<uint32_t>(sq_ring_, params.sq_off.tail);
+  sq_array_ = RingField<uint32_t>(sq_ring_, params.sq_off.array);
+  sq_mask_ = *RingField<uint32_t>(sq_ring_, params.sq_off.ring_mask);
+  sq_entries_ = params.sq_entries;
+
+  cq_head_ = RingField<uint32_t>(cq_ring_, params.cq_off.head);
+  cq_tail_ = RingField<uint32_t>(cq_ring_, params.cq_off.tail);
+  cq_mask_ = *RingField<uint32_t>(cq_ring_, params.cq_off.ring_mask);
+  cqes_ = RingField<io_uring_cqe>(cq_ring_, params.cq_off.cqes);
+
+  // Submission queue entries are always used in order, so the indirection
+  // array is filled once.
+  for (uint32_t i = 0; i < sq_entries_; ++i) {
+    sq_array_[i] = i;
+  }
+
+  wake_fd_ = eventfd(0, EFD_CLOEXEC);
+  if (wake_fd_ == -1) {
+    PW_LOG_ERROR("Failed to create eventfd: %s", std::strerror(errno));
+    return Status::Internal();
+  }
+
+  // A read of the eventfd is always in flight so that DoWake can interrupt a
+  // wait for completions.
+  return SubmitWakeRead();
+}
+
+NativeDispatcher::~NativeDispatcher() {
+  // Closing the ring does not wait for operations still in flight, which may
+  // write to their buffers or wake_value_ after they are released. Cancel them
+  // and wait for their completions first.
+  if (sq_ring_ != nullptr && cq_ring_ != nullptr && sqes_ != nullptr) {
+    closing_ = true;
+    while (!in_flight_.empty()) {
+      NativeCancelOperation(in_flight_.front());
+    }
+    if (wake_read_in_progress_) {
+      QueueCancel(kWakeUserData);
+      while (wake_read_in_progress_) {
+        PW_CHECK_OK(Submit(/*wait=*/true));
+        ProcessCompletions();
+      }
+    }
+  }
+
+  if (ring_fd_ != -1) {
+    close(ring_fd_);
+  }
+  if (wake_fd_ != -1) {
+    close(wake_fd_);
+  }
+  if (sqes_ != nullptr) {
+    munmap(sqes_, sqes_size_);
+  }
+  if (cq_ring_ != nullptr && cq_ring_ != sq_ring_) {
+    munmap(cq_ring_, cq_ring_size_);
+  }
+  if (sq_ring_ != nullptr) {
+    munmap(sq_ring_, sq_ring_size_);
+  }
+}
+
+Poll<> NativeDispatcher::DoRunUntilStalled(Dispatcher& dispatcher, Task* task) {
+  {
+    std::lock_guard lock(impl::dispatcher_lock());
+    PW_CHECK(task == nullptr || HasPostedTask(*task),
+             "Attempted to run a dispatcher until a task was stalled, "
+             "but that task has not been `Post`ed to that `Dispatcher`.");
+  }
+  while (true) {
+    RunOneTaskResult result = RunOneTask(dispatcher, task);
+    if (result.completed_main_task() || result.completed_all_tasks()) {
+      return Ready();
+    }
+    if (!result.ran_a_task()) {
+      // Submit everything queued by the tasks that just ran and collect any
+      // operations which have already completed, without blocking.
+      if (!Submit(/*wait=*/false).ok() || ProcessCompletions() == 0) {
+        return Pending();
+      }
+    }
+  }
+}
+
+void NativeDispatcher::DoRunToCompletion(Dispatcher& dispatcher, Task* task) {
+  {
+    std::lock_guard lock(impl::dispatcher_lock());
+    PW_CHECK(task == nullptr || HasPostedTask(*task),
+             "Attempted to run a dispatcher until a task was complete, "
+             "but that task has not been `Post`ed to that `Dispatcher`.");
+  }
+  while (true) {
+    RunOneTaskResult result = RunOneTask(dispatcher, task);
+    if (result.completed_main_task() || result.completed_all_tasks()) {
+      return;
+    }
+    if (!result.ran_a_task()) {
+      // Submissions queued since the last iteration are passed to the kernel
+      // in the same io_uring_enter call that waits for completions.
+      waiting_.store(true);
+      SleepInfo sleep_info = AttemptRequestWake(/*allow_empty=*/false);
+      Status status;
+      if (sleep_info.should_sleep() || unsubmitted_ > 0) {
+        status = Submit(/*wait=*/sleep_info.should_sleep());
+      }
+      waiting_.store(false);
+      if (!status.ok()) {
+        break;
+      }
+      ProcessCompletions();
+    }
+  }
+}
+
+Status NativeDispatcher::NativeRegisterBuffers(span<const ByteSpan> regions) {
+  if (registered_buffer_count_ != 0) {
+    return Status::FailedPrecondition();
+  }
+  if (regions.empty() || regions.size() > kMaxRegisteredBuffers) {
+    return Status::InvalidArgument();
+  }
+
+  std::array<iovec, kMaxRegisteredBuffers> iovecs;
+  for (size_t i = 0; i < regions.size(); ++i) {
+    iovecs[i].iov_base = regions[i].data();
+    iovecs[i].iov_len = regions[i].size();
+  }
+  if (io_uring_register(ring_fd_,
+                        IORING_REGISTER_BUFFERS,
+                        iovecs.data(),
+                        static_cast<uint32_t>(regions.size())) == -1) {
+    PW_LOG_ERROR("Failed to register buffers: %s", std::strerror(errno));
+    return Status::Internal();
+  }
+
+  std::copy(regions.begin(), regions.end(), registered_buffers_.begin());
+  registered_buffer_count_ = regions.size();
+  return OkStatus();
+}
+
+Status NativeDispatcher::NativeSubmitRead(int fd,
+                                          ByteSpan buffer,
+                                          NativeOperation& operation) {
+  return SubmitOperation(/*write=*/false, fd, buffer, operation);
+}
+
+Status NativeDispatcher::NativeSubmitWrite(int fd,
+                                           ConstByteSpan buffer,
+                                           NativeOperation& operation) {
+  return SubmitOperation(/*write=*/true, fd, buffer, operation);
+}
+
+void NativeDispatcher::NativeCancelOperation(NativeOperation& operation) {
+  if (!operation.in_progress()) {
+    return;
+  }
+
+  QueueCancel(reinterpret_cast<uintptr_t>(&operation));
+
+  // The kernel may still write to the operation's buffer until its completion
+  // is reported, whether or not the cancellation succeeds.
+  while (operation.in_progress()) {
+    PW_CHECK_OK(Submit(/*wait=*/true));
+    ProcessCompletions();
+  }
+}
+
+void NativeDispatcher::QueueCancel(uint64_t user_data) {
+  // NextSubmissionEntry has already passed the pending entries to the kernel
+  // if it fails. If the kernel cannot take them yet, wait for completions to
+  // make room rather than failing the cancellation.
+  io_uring_sqe* sqe;
+  while ((sqe = NextSubmissionEntry()) == nullptr) {
+    PW_CHECK_OK(Submit(/*wait=*/true));
+    ProcessCompletions();
+  }
+  sqe->opcode = IORING_OP_ASYNC_CANCEL;
+  sqe->fd = -1;
+  sqe->addr = user_data;
+  sqe->user_data = kIgnoredUserData;
+  CommitSubmissionEntry();
+}
+
+io_uring_sqe* NativeDispatcher::NextSubmissionEntry() {
+  if (*sq_tail_ - LoadAcquire(sq_head_) == sq_entries_) {
+    Submit(/*wait=*/false).IgnoreError();  // Errors are logged by Submit.
+    if (*sq_tail_ - LoadAcquire(sq_head_) == sq_entries_) {
+      return nullptr;
+    }
+  }
+  io_uring_sqe* sqe = &sqes_[*sq_tail_ & sq_mask_];
+  std::memset(sqe, 0, sizeof(*sqe));
+  return sqe;
+}
+
+void NativeDispatcher::CommitSubmissionEntry() {
+  StoreRelease(sq_tail_, *sq_tail_ + 1);
+  unsubmitted_ += 1;
+}
+
+Status NativeDispatcher::SubmitOperation(bool write,
+                                         int fd,
+                                         ConstByteSpan buffer,
+                                         NativeOperation& operation) {
+  if (operation.in_progress()) {
+    return Status::FailedPrecondition();
+  }
+
+  io_uring_sqe* sqe = NextSubmissionEntry();
+  if (sqe == nullptr) {
+    return Status::Unavailable();
+  }
+
+  const int buffer_index = RegisteredBufferIndex(buffer);
+  if (buffer_index < 0) {
+    sqe->opcode = write ? IORING_OP_WRITE : IORING_OP_READ;
+  } else {
+    sqe->opcode = write ? IORING_OP_WRITE_FIXED : IORING_OP_READ_FIXED;
+    sqe->buf_index = static_cast<uint16_t>(buffer_index);
+  }
+  sqe->fd = fd;
+  sqe->off = std::numeric_limits<uint64_t>::max();  // Use the file position.
+  sqe->addr = reinterpret_cast<uintptr_t>(buffer.data());
+  sqe->len = static_cast<uint32_t>(
+      std::min<size_t>(buffer.size(), std::numeric_limits<uint32_t>::max()));
+  sqe->user_data = reinterpret_cast<uintptr_t>(&operation);
+  CommitSubmissionEntry();
+
+  operation.in_progress_ = true;
+  in_flight_.push_back(operation);
+  return OkStatus();
+}
+
+Status NativeDispatcher::SubmitWakeRead() {
+  io_uring_sqe* sqe = NextSubmissionEntry();
+  if (sqe == nullptr) {
+    return Status::Unavailable();
+  }
+  sqe->opcode = IORING_OP_READ;
+  sqe->fd = wake_fd_;
+  sqe->addr = reinterpret_cast<uintptr_t>(&wake_value_);
+  sqe->len = sizeof(wake_value_);
+  sqe->user_data = kWakeUserData;
+  CommitSubmissionEntry();
+  wake_read_in_progress_ = true;
+  return OkStatus();
+}
+
+Status NativeDispatcher::Submit(bool wait) {
+  while (true) {
+    // IORING_ENTER_GETEVENTS also posts any completions the kernel has
+    // deferred, even when not waiting.
+    const int submitted = io_uring_enter(ring_fd_,
+                                         unsubmitted_,
+                                         /*min_complete=*/wait ? 1 : 0,
+                                         IORING_ENTER_GETEVENTS);
+    if (submitted >= 0) {
+      unsubmitted_ -= static_cast<uint32_t>(submitted);
+      return OkStatus();
+    }
+
+    switch (errno) {
+      case EINTR:
+        if (wait) {
+          return OkStatus();
+        }
+        break;
+      case EAGAIN:
+      case EBUSY:
+        // The completion queue is full. Make room and try again.
+        ProcessCompletions();
+        break;
+      default:
+        PW_LOG_ERROR("Dispatcher failed to submit to io_uring: %s",
+                     std::strerror(errno));
+        return Status::Internal();
+    }
+  }
+}
+
+size_t NativeDispatcher::ProcessCompletions() {
+  uint32_t head = *cq_head_;
+  const uint32_t tail = LoadAcquire(cq_tail_);
+  bool rearm_wake_read = false;
+
+  for (uint32_t i = head; i != tail; ++i) {
+    const io_uring_cqe& cqe = cqes_[i & cq_mask_];
+    if (cqe.user_data == kWakeUserData) {
+      wake_read_in_progress_ = false;
+      if (cqe.res < 0 && cqe.res != -ECANCELED) {
+        PW_LOG_ERROR("Dispatcher failed to read wake notification: %s",
+                     std::strerror(-cqe.res));
+      }
+      rearm_wake_read = true;
+      continue;
+    }
+    if (cqe.user_data == kIgnoredUserData) {
+      continue;
+    }
+
+    auto& operation = *reinterpret_cast<NativeOperation*>(
+        static_cast<uintptr_t>(cqe.user_data));
+    operation.result_ = cqe.res;
+    operation.in_progress_ = false;
+    in_flight_.remove(operation);
+    std::move(operation.waker_).Wake();
+  }
+  StoreRelease(cq_head_, tail);
+
+  // Queued after the completion queue is released, since queueing may need to
+  // flush submissions.
+  if (rearm_wake_read && !closing_) {
+    PW_CHECK_OK(SubmitWakeRead());
+  }
+  return tail - head;
+}
+
+int NativeDispatcher::RegisteredBufferIndex(ConstByteSpan buffer) const {
+  for (size_t i = 0; i < registered_buffer_count_; ++i) {
+    const ConstByteSpan& region = registered_buffers_[i];
+    if (buffer.data() >= region.data() &&
+        buffer.data() + buffer.size() <= region.data() + region.size()) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+void NativeDispatcher::DoWake() {
+  // Only signal the eventfd if the dispatcher thread may be blocked in
+  // io_uring_enter. The result is ignored, as in the epoll backend: a failed
+  // write means the counter is already nonzero and a wake is pending.
+  if (waiting_.load()) {
+    uint64_t value = 1;
+    write(wake_fd_, &value, sizeof(value));
+  }
+}
+
+}  // namespace pw::async2::backend
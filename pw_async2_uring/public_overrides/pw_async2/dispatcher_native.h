@@ -0,0 +1,187 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_assert/assert.h"
+#include "pw_async2/dispatcher_base.h"
+#include "pw_bytes/span.h"
+#include "pw_containers/intrusive_list.h"
+#include "pw_preprocessor/compiler.h"
+#include "pw_span/span.h"
+#include "pw_status/status.h"
+
+struct io_uring_cqe;
+struct io_uring_sqe;
+
+namespace pw::async2::backend {
+
+// Windows GCC doesn't realize the nonvirtual destructor is protected and that
+// the class is final.
+PW_MODIFY_DIAGNOSTICS_PUSH();
+PW_MODIFY_DIAGNOSTIC_GCC(ignored, "-Wnon-virtual-dtor");
+
+// A Dispatcher backend which performs I/O through a Linux io_uring.
+//
+// Rather than waiting for a file descriptor to become ready and then issuing a
+// read or write syscall, tasks submit the read or write itself with
+// NativeSubmitRead or NativeSubmitWrite and are woken when it has completed.
+// Submissions are queued in memory shared with the kernel and passed to it in a
+// single io_uring_enter call when the dispatcher runs out of tasks to run. The
+// same call waits for completions.
+//
+// Operations must be submitted and cancelled from the thread running the
+// dispatcher, typically from within a task's DoPend.
+class NativeDispatcher final : public NativeDispatcherBase {
+ public:
+  NativeDispatcher() { PW_ASSERT_OK(NativeInit()); }
+
+  ~NativeDispatcher();
+
+  Status NativeInit();
+
+  // An I/O operation submitted to the dispatcher.
+  //
+  // An operation must not be moved or destroyed while it is in progress. Use
+  // NativeCancelOperation to end it early.
+  class NativeOperation : public IntrusiveList<NativeOperation>::Item {
+   public:
+    constexpr NativeOperation() = default;
+
+    NativeOperation(const NativeOperation&) = delete;
+    NativeOperation& operator=(const NativeOperation&) = delete;
+
+    // True from submission until the kernel reports that the operation has
+    // completed.
+    bool in_progress() const { return in_progress_; }
+
+    // The result of the most recently completed operation: the number of bytes
+    // transferred, or a negated errno value.
+    int32_t result() const { return result_; }
+
+    // Waker to wake when the operation completes.
+    Waker& waker() { return waker_; }
+
+   private:
+    friend class NativeDispatcher;
+
+    Waker waker_;
+    int32_t result_ = 0;
+    bool in_progress_ = false;
+  };
+
+  // Registers regions of memory with the kernel, such as the data area of a
+  // MultiBufAllocator. Reads and writes to buffers within a registered region
+  // avoid mapping the buffer's pages into the kernel for each operation.
+  //
+  // Regions may only be registered once, and must outlive the dispatcher.
+  Status NativeRegisterBuffers(span<const ByteSpan> regions);
+
+  // Submits a read from fd into buffer. operation is woken with its result once
+  // the read completes.
+  Status NativeSubmitRead(int fd, ByteSpan buffer, NativeOperation& operation);
+
+  // Submits a write of buffer to fd. As with write(), the operation may
+  // complete after writing only part of the buffer.
+  Status NativeSubmitWrite(int fd,
+                           ConstByteSpan buffer,
+                           NativeOperation& operation);
+
+  // Cancels an operation if it is in progress, blocking until the kernel
+  // reports its completion. Once this returns, the operation's buffer may be
+  // released.
+  void NativeCancelOperation(NativeOperation& operation);
+
+ private:
+  friend class ::pw::async2::Dispatcher;
+
+  static constexpr uint32_t kQueueDepth = 256;
+  static constexpr size_t kMaxRegisteredBuffers = 8;
+
+  void DoWake() final;
+  Poll<> DoRunUntilStalled(Dispatcher&, Task* task);
+  void DoRunToCompletion(Dispatcher&, Task* task);
+
+  // Returns the next free submission queue entry, first flushing the queue to
+  // the kernel if it is full. Returns nullptr if no entry could be freed.
+  // Entries are passed to the kernel on the next Submit once committed.
+  io_uring_sqe* NextSubmissionEntry();
+  void CommitSubmissionEntry();
+
+  Status SubmitOperation(bool write,
+                         int fd,
+                         ConstByteSpan buffer,
+                         NativeOperation& operation);
+  Status SubmitWakeRead();
+
+  // Queues a cancellation of the operation with the given user_data, flushing
+  // the submission queue and waiting for completions until there is room.
+  void QueueCancel(uint64_t user_data);
+
+  // Passes committed submissions to the kernel and, if wait is true, blocks
+  // until at least one operation has completed.
+  Status Submit(bool wait);
+
+  // Records the results of completed operations and wakes their tasks. Returns
+  // the number of completions processed.
+  size_t ProcessCompletions();
+
+  // Returns the index of the registered region containing buffer, or -1.
+  int RegisteredBufferIndex(ConstByteSpan buffer) const;
+
+  int ring_fd_ = -1;
+  int wake_fd_ = -1;
+  uint64_t wake_value_ = 0;
+  bool wake_read_in_progress_ = false;
+
+  // Set by the destructor so that the wake read is not resubmitted.
+  bool closing_ = false;
+
+  // Operations submitted to the kernel whose completions have not been
+  // processed. They are cancelled before the ring is closed.
+  IntrusiveList<NativeOperation> in_flight_;
+
+  // Set while the dispatcher thread may be blocked waiting for completions,
+  // so that DoWake only signals wake_fd_ when it is needed.
+  std::atomic<bool> waiting_ = false;
+
+  void* sq_ring_ = nullptr;
+  size_t sq_ring_size_ = 0;
+  uint32_t* sq_head_ = nullptr;
+  uint32_t* sq_tail_ = nullptr;
+  uint32_t* sq_array_ = nullptr;
+  uint32_t sq_mask_ = 0;
+  uint32_t sq_entries_ = 0;
+  io_uring_sqe* sqes_ = nullptr;
+  size_t sqes_size_ = 0;
+  uint32_t unsubmitted_ = 0;
+
+  void* cq_ring_ = nullptr;
+  size_t cq_ring_size_ = 0;
+  uint32_t* cq_head_ = nullptr;
+  uint32_t* cq_tail_ = nullptr;
+  uint32_t cq_mask_ = 0;
+  io_uring_cqe* cqes_ = nullptr;
+
+  std::array<ConstByteSpan, kMaxRegisteredBuffers> registered_buffers_;
+  size_t registered_buffer_count_ = 0;
+};
+
+PW_MODIFY_DIAGNOSTICS_POP();
+
+}  // namespace pw::async2::backend
@@ -0,0 +1,352 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_async2/dispatcher_native.h"
+
+#include <algorithm>
+#include <iterator>
+#include <mutex>
+
+#include "pw_assert/check.h"
+
+namespace pw::async2::backend {
+
+thread_local NativeDispatcher::Worker* NativeDispatcher::current_worker_ =
+    nullptr;
+
+NativeDispatcher::NativeDispatcher()
+    : thread_count_(std::max(std::thread::hardware_concurrency(), 1u)),
+      caller_(*this, 0) {
+  std::lock_guard lock(impl::dispatcher_lock());
+  workers_.push_back(&caller_);
+}
+
+NativeDispatcher::~NativeDispatcher() {
+  {
+    std::lock_guard lock(impl::dispatcher_lock());
+    shutdown_ = true;
+    for (Worker* worker : workers_) {
+      WakeWorkerLocked(*worker);
+    }
+  }
+  for (std::unique_ptr<Worker>& worker : threads_) {
+    worker->thread.join();
+  }
+}
+
+void NativeDispatcher::NativeSetThreadCount(size_t thread_count) {
+  PW_CHECK_UINT_GT(thread_count, 0);
+  PW_CHECK(threads_.empty(),
+           "The thread count must be set before the dispatcher first runs");
+  thread_count_ = thread_count;
+}
+
+void NativeDispatcher::DoWake() {
+  // The thread in `Run` requested a wake with `AttemptRequestWake`. A spurious
+  // release is harmless, since `Run` checks for work after every wake.
+  caller_.notification.release();
+}
+
+Poll<> NativeDispatcher::DoRunUntilStalled(Dispatcher& dispatcher, Task* task) {
+  return Run(dispatcher, task, /*until_stalled=*/true);
+}
+
+void NativeDispatcher::DoRunToCompletion(Dispatcher& dispatcher, Task* task) {
+  Run(dispatcher, task, /*until_stalled=*/false).IgnorePoll();
+}
+
+Poll<> NativeDispatcher::Run(Dispatcher& dispatcher,
+                             Task* task,
+                             bool until_stalled) {
+  {
+    std::lock_guard lock(impl::dispatcher_lock());
+    PW_CHECK(task == nullptr || HasPostedTask(*task),
+             "Attempted to run a dispatcher until a task was complete, "
+             "but that task has not been `Post`ed to that `Dispatcher`.");
+    PW_CHECK(!active_, "The dispatcher is already running on another thread");
+  }
+  if (threads_.size() + 1 < thread_count_) {
+    StartWorkers();
+  }
+
+  {
+    std::lock_guard lock(impl::dispatcher_lock());
+    dispatcher_ = &dispatcher;
+    main_task_ = task;
+    main_task_completed_ = false;
+    active_ = true;
+    if (HasWokenTasksLocked()) {
+      for (Worker* worker : workers_) {
+        WakeWorkerLocked(*worker);
+      }
+    }
+  }
+  current_worker_ = &caller_;
+
+  Poll<> result = Pending();
+  while (true) {
+    std::unique_lock task_lock(caller_.execution_lock);
+    Task* task_to_run;
+    bool request_wake = false;
+    {
+      std::lock_guard lock(impl::dispatcher_lock());
+      caller_.idle = false;
+      if (main_task_completed_) {
+        result = Ready();
+        break;
+      }
+      task_to_run = StartTaskLocked(caller_);
+      if (task_to_run == nullptr) {
+        // Tasks running on other workers may wake more tasks, so only stop
+        // once every worker is idle.
+        if (running_ == 0) {
+          if (!HasSleepingTasksLocked()) {
+            result = Ready();
+            break;
+          }
+          if (until_stalled) {
+            break;
+          }
+          request_wake = true;
+        }
+        caller_.idle = true;
+      }
+    }
+
+    if (task_to_run != nullptr) {
+      RunTaskOnWorker(dispatcher, caller_, *task_to_run, task);
+      continue;
+    }
+    task_lock.unlock();
+
+    // Wait for another worker to finish a task or for a task to be woken. If
+    // all tasks are asleep, only a wake from outside the dispatcher can make
+    // progress, so ask `NativeDispatcherBase` for one.
+    if (!request_wake ||
+        AttemptRequestWake(/*allow_empty=*/false).should_sleep()) {
+      caller_.notification.acquire();
+    }
+  }
+
+  // Wait for the other workers to finish the tasks they are running.
+  while (true) {
+    {
+      std::lock_guard lock(impl::dispatcher_lock());
+      active_ = false;
+      if (running_ == 0) {
+        caller_.idle = false;
+        ReturnQueuedTasksLocked();
+        dispatcher_ = nullptr;
+        main_task_ = nullptr;
+        break;
+      }
+      caller_.idle = true;
+    }
+    caller_.notification.acquire();
+  }
+  current_worker_ = nullptr;
+  return result;
+}
+
+void NativeDispatcher::StartWorkers() {
+  std::vector<Worker*> workers = {&caller_};
+  while (threads_.size() + 1 < thread_count_) {
+    threads_.push_back(std::make_unique<Worker>(*this, threads_.size() + 1));
+    workers.push_back(threads_.back().get());
+  }
+  {
+    std::lock_guard lock(impl::dispatcher_lock());
+    workers_ = std::move(workers);
+  }
+  for (std::unique_ptr<Worker>& thread : threads_) {
+    thread->thread = std::thread([this, &worker = *thread] {
+      current_worker_ = &worker;
+      WorkerLoop(worker);
+    });
+  }
+}
+
+void NativeDispatcher::WorkerLoop(Worker& worker) {
+  while (true) {
+    std::unique_lock task_lock(worker.execution_lock);
+    Dispatcher* dispatcher = nullptr;
+    Task* task = nullptr;
+    Task* main_task = nullptr;
+    {
+      std::lock_guard lock(impl::dispatcher_lock());
+      if (shutdown_) {
+        return;
+      }
+      if (active_) {
+        dispatcher = dispatcher_;
+        main_task = main_task_;
+        task = StartTaskLocked(worker);
+      }
+      worker.idle = task == nullptr;
+    }
+
+    if (task != nullptr) {
+      RunTaskOnWorker(*dispatcher, worker, *task, main_task);
+    } else {
+      task_lock.unlock();
+      worker.notification.acquire();
+    }
+  }
+}
+
+void NativeDispatcher::RunTaskOnWorker(Dispatcher& dispatcher,
+                                       Worker& worker,
+                                       Task& task,
+                                       Task* main_task) {
+  const RunOneTaskResult result = RunTask(dispatcher, task, main_task);
+
+  std::lock_guard lock(impl::dispatcher_lock());
+  worker.running = nullptr;
+  running_ -= 1;
+  if (result.completed_main_task()) {
+    main_task_completed_ = true;
+  }
+  if (main_task_completed_ || running_ == 0) {
+    WakeWorkerLocked(caller_);
+  }
+}
+
+Task* NativeDispatcher::StartTaskLocked(Worker& worker) {
+  Task* task = nullptr;
+  if (!worker.queue.empty()) {
+    task = &worker.queue.front();
+    worker.queue.pop_front();
+    worker.queued -= 1;
+    queued_ -= 1;
+  } else {
+    task = PopWokenTask();
+    if (task == nullptr) {
+      task = StealTaskLocked(worker);
+    }
+  }
+
+  if (task != nullptr) {
+    StartRunningTaskLocked(*task);
+    worker.running = task;
+    running_ += 1;
+  }
+  return task;
+}
+
+Task* NativeDispatcher::StealTaskLocked(Worker& thief) {
+  if (queued_ == 0) {
+    return nullptr;
+  }
+  for (size_t i = 1; i < workers_.size(); ++i) {
+    Worker& victim = *workers_[(thief.index + i) % workers_.size()];
+    if (victim.queued == 0) {
+      continue;
+    }
+
+    // The victim runs tasks from the front of its queue, so take the half at
+    // the back. Run the first of them and move the rest to the thief's queue,
+    // keeping their order.
+    const size_t count = (victim.queued + 1) / 2;
+    auto before = victim.queue.before_begin();
+    std::advance(before, victim.queued - count);
+    Task& task = *std::next(before);
+    victim.queue.erase_after(before);
+    thief.queue.splice_after(
+        thief.queue.before_begin(), victim.queue, before, victim.queue.end());
+
+    victim.queued -= count;
+    thief.queued += count - 1;
+    queued_ -= 1;
+    return &task;
+  }
+  return nullptr;
+}
+
+void NativeDispatcher::WakeIdleWorkerLocked() {
+  for (Worker* worker : workers_) {
+    if (worker->idle) {
+      WakeWorkerLocked(*worker);
+      return;
+    }
+  }
+}
+
+void NativeDispatcher::WakeWorkerLocked(Worker& worker) {
+  if (worker.idle) {
+    worker.idle = false;
+    worker.notification.release();
+  }
+}
+
+void NativeDispatcher::ReturnQueuedTasksLocked() {
+  for (Worker* worker : workers_) {
+    while (!worker->queue.empty()) {
+      Task& task = worker->queue.front();
+      worker->queue.pop_front();
+      NativeDispatcherBase::PushWokenTaskLocked(task);
+    }
+    worker->queued = 0;
+  }
+  queued_ = 0;
+}
+
+void NativeDispatcher::PushWokenTaskLocked(Task& task) {
+  Worker* worker = current_worker_;
+  if (worker != nullptr && &worker->dispatcher == this) {
+    worker->queue.push_back(task);
+    worker->queued += 1;
+    queued_ += 1;
+  } else {
+    NativeDispatcherBase::PushWokenTaskLocked(task);
+  }
+
+  // Let an idle worker run or steal the task.
+  if (active_) {
+    WakeIdleWorkerLocked();
+  }
+}
+
+void NativeDispatcher::RemoveWokenTaskLocked(Task& task) {
+  if (queued_ != 0) {
+    for (Worker* worker : workers_) {
+      if (worker->queue.remove(task)) {
+        worker->queued -= 1;
+        queued_ -= 1;
+        return;
+      }
+    }
+  }
+  NativeDispatcherBase::RemoveWokenTaskLocked(task);
+}
+
+bool NativeDispatcher::HasWokenTasksLocked() const {
+  return queued_ != 0 || NativeDispatcherBase::HasWokenTasksLocked();
+}
+
+pw::sync::Mutex& NativeDispatcher::TaskExecutionLockLocked(Task& task) {
+  // The caller waits for this lock while this thread's worker holds its own
+  // execution lock. If the other task is waiting for this thread's task in the
+  // same way, neither worker can proceed.
+  PW_CHECK(current_worker_ == nullptr || current_worker_->running == nullptr,
+           "A running task must not deregister another running task");
+
+  for (Worker* worker : workers_) {
+    if (worker->running == &task) {
+      return worker->execution_lock;
+    }
+  }
+  PW_CRASH("Task %p is not running on any worker", static_cast<void*>(&task));
+}
+
+}  // namespace pw::async2::backend
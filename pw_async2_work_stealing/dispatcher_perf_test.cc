@@ -0,0 +1,99 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_async2/dispatcher.h"
+#include "pw_perf_test/perf_test.h"
+
+namespace pw::async2 {
+namespace {
+
+// Measures how the time to run a batch of tasks scales with the number of
+// worker threads. Each iteration posts kTasks tasks, each of which wakes
+// itself kPollsPerTask times, and runs the dispatcher until they complete.
+//
+// The Compute benchmarks do some work in each poll, like a task that parses
+// or encodes a message. The Schedule benchmarks do almost none, so they
+// measure the cost of waking and running tasks, which is serialized by the
+// dispatcher lock.
+
+constexpr size_t kTasks = 64;
+constexpr int kPollsPerTask = 16;
+
+class WorkTask : public Task {
+ public:
+  void Start(uint32_t work_per_poll) {
+    work_per_poll_ = work_per_poll;
+    remaining_ = kPollsPerTask;
+  }
+
+  uint32_t state() const { return state_; }
+
+ private:
+  Poll<> DoPend(Context& cx) override {
+    for (uint32_t i = 0; i < work_per_poll_; ++i) {
+      state_ ^= state_ << 13;
+      state_ ^= state_ >> 17;
+      state_ ^= state_ << 5;
+    }
+    if (--remaining_ == 0) {
+      return Ready();
+    }
+    cx.ReEnqueue();
+    return Pending();
+  }
+
+  uint32_t work_per_poll_ = 0;
+  int remaining_ = 0;
+  uint32_t state_ = 1;
+};
+
+template <size_t kThreads, uint32_t kWorkPerPoll>
+void RunTasks(perf_test::State& state) {
+  // Each configuration keeps its dispatcher and threads across iterations.
+  static Dispatcher dispatcher;
+  static std::array<WorkTask, kTasks> tasks;
+  if (dispatcher.native().NativeThreadCount() != kThreads) {
+    dispatcher.native().NativeSetThreadCount(kThreads);
+  }
+
+  volatile uint32_t checksum = 0;
+  while (state.KeepRunning()) {
+    for (WorkTask& task : tasks) {
+      task.Start(kWorkPerPoll);
+      dispatcher.Post(task);
+    }
+    dispatcher.RunToCompletion();
+    checksum = checksum + tasks[0].state();
+  }
+}
+
+constexpr uint32_t kComputeWork = 2000;
+constexpr uint32_t kScheduleWork = 1;
+
+PW_PERF_TEST(Compute_1Thread, (RunTasks<1, kComputeWork>));
+PW_PERF_TEST(Compute_2Threads, (RunTasks<2, kComputeWork>));
+PW_PERF_TEST(Compute_4Threads, (RunTasks<4, kComputeWork>));
+PW_PERF_TEST(Compute_8Threads, (RunTasks<8, kComputeWork>));
+
+PW_PERF_TEST(Schedule_1Thread, (RunTasks<1, kScheduleWork>));
+PW_PERF_TEST(Schedule_2Threads, (RunTasks<2, kScheduleWork>));
+PW_PERF_TEST(Schedule_4Threads, (RunTasks<4, kScheduleWork>));
+PW_PERF_TEST(Schedule_8Threads, (RunTasks<8, kScheduleWork>));
+
+}  // namespace
+}  // namespace pw::async2
@@ -0,0 +1,390 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <thread>
+
+#include "pw_async2/dispatcher.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::async2 {
+namespace {
+
+using namespace std::chrono_literals;
+
+constexpr size_t kThreads = 4;
+
+// Waits until `condition` is true, or gives up after a few seconds so that a
+// broken dispatcher fails the test instead of hanging it.
+template <typename Condition>
+bool WaitFor(Condition condition) {
+  const auto deadline = std::chrono::steady_clock::now() + 5s;
+  while (!condition()) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::yield();
+  }
+  return true;
+}
+
+class WorkStealingDispatcherTest : public ::testing::Test {
+ protected:
+  WorkStealingDispatcherTest() {
+    dispatcher_.native().NativeSetThreadCount(kThreads);
+  }
+
+  Dispatcher dispatcher_;
+};
+
+// Records the threads it runs on and waits for `count` tasks to be running at
+// once.
+class BarrierTask : public Task {
+ public:
+  BarrierTask(std::atomic<size_t>& arrived, size_t count)
+      : arrived_(arrived), count_(count) {}
+
+  bool reached_barrier() const { return reached_barrier_; }
+
+ private:
+  Poll<> DoPend(Context&) override {
+    arrived_.fetch_add(1);
+    reached_barrier_ = WaitFor([this] { return arrived_.load() >= count_; });
+    return Ready();
+  }
+
+  std::atomic<size_t>& arrived_;
+  const size_t count_;
+  bool reached_barrier_ = false;
+};
+
+TEST_F(WorkStealingDispatcherTest, RunsTasksInParallel) {
+  std::atomic<size_t> arrived = 0;
+  std::array<BarrierTask, kThreads> tasks = {
+      BarrierTask(arrived, kThreads),
+      BarrierTask(arrived, kThreads),
+      BarrierTask(arrived, kThreads),
+      BarrierTask(arrived, kThreads),
+  };
+  for (BarrierTask& task : tasks) {
+    dispatcher_.Post(task);
+  }
+
+  EXPECT_EQ(dispatcher_.RunUntilStalled(), Ready());
+  for (BarrierTask& task : tasks) {
+    EXPECT_TRUE(task.reached_barrier());
+    EXPECT_FALSE(task.IsRegistered());
+  }
+  EXPECT_EQ(dispatcher_.tasks_polled(), kThreads);
+  EXPECT_EQ(dispatcher_.tasks_completed(), kThreads);
+}
+
+// Wakes itself `polls` times. Checks that it is never pended on two threads at
+// once.
+class YieldingTask : public Task {
+ public:
+  explicit YieldingTask(int polls) : remaining_(polls) {}
+
+  bool overlapped() const { return overlapped_; }
+  int polled() const { return polled_; }
+
+ private:
+  Poll<> DoPend(Context& cx) override {
+    if (running_.exchange(true)) {
+      overlapped_ = true;
+    }
+    polled_ += 1;
+
+    // Wake the task while it is running, then give other workers a chance to
+    // pick it up before returning.
+    const bool done = --remaining_ == 0;
+    if (!done) {
+      cx.ReEnqueue();
+    }
+    std::this_thread::yield();
+
+    running_ = false;
+    return done ? Ready() : Pending();
+  }
+
+  std::atomic<bool> running_ = false;
+  std::atomic<bool> overlapped_ = false;
+  int remaining_;
+  int polled_ = 0;
+};
+
+TEST_F(WorkStealingDispatcherTest, TaskNeverRunsConcurrentlyWithItself) {
+  constexpr int kPolls = 1000;
+  std::array<YieldingTask, 2 * kThreads> tasks = {
+      YieldingTask(kPolls),
+      YieldingTask(kPolls),
+      YieldingTask(kPolls),
+      YieldingTask(kPolls),
+      YieldingTask(kPolls),
+      YieldingTask(kPolls),
+      YieldingTask(kPolls),
+      YieldingTask(kPolls),
+  };
+  for (YieldingTask& task : tasks) {
+    dispatcher_.Post(task);
+  }
+
+  dispatcher_.RunToCompletion();
+
+  for (YieldingTask& task : tasks) {
+    EXPECT_FALSE(task.overlapped());
+    EXPECT_EQ(task.polled(), kPolls);
+  }
+  EXPECT_EQ(dispatcher_.tasks_polled(), tasks.size() * kPolls);
+}
+
+// Records the thread that runs it.
+class ThreadRecordingTask : public Task {
+ public:
+  ThreadRecordingTask() = default;
+
+  void Start(std::mutex& mutex, std::set<std::thread::id>& threads) {
+    mutex_ = &mutex;
+    threads_ = &threads;
+  }
+
+ private:
+  Poll<> DoPend(Context&) override {
+    {
+      std::lock_guard lock(*mutex_);
+      threads_->insert(std::this_thread::get_id());
+    }
+    // Take long enough that other workers steal the remaining tasks.
+    std::this_thread::sleep_for(1ms);
+    return Ready();
+  }
+
+  std::mutex* mutex_ = nullptr;
+  std::set<std::thread::id>* threads_ = nullptr;
+};
+
+// Posts its children from inside `Pend`, which puts them all in the run queue
+// of the worker that runs it.
+class SpawningTask : public Task {
+ public:
+  explicit SpawningTask(span<ThreadRecordingTask> children)
+      : children_(children) {}
+
+ private:
+  Poll<> DoPend(Context& cx) override {
+    for (ThreadRecordingTask& child : children_) {
+      cx.dispatcher().Post(child);
+    }
+    return Ready();
+  }
+
+  span<ThreadRecordingTask> children_;
+};
+
+TEST_F(WorkStealingDispatcherTest, IdleWorkersStealWokenTasks) {
+  std::mutex mutex;
+  std::set<std::thread::id> threads;
+  std::array<ThreadRecordingTask, 64> children;
+  for (ThreadRecordingTask& child : children) {
+    child.Start(mutex, threads);
+  }
+  SpawningTask parent(children);
+  dispatcher_.Post(parent);
+
+  EXPECT_EQ(dispatcher_.RunUntilStalled(), Ready());
+  EXPECT_EQ(dispatcher_.tasks_completed(), children.size() + 1);
+  EXPECT_GT(threads.size(), 1u);
+}
+
+// Passes a token around a ring of tasks. Each task wakes the next one, which
+// is usually asleep on another worker.
+class RingTask : public Task {
+ public:
+  RingTask() = default;
+
+  void Connect(RingTask& next, std::atomic<int>& hops) {
+    next_ = &next;
+    hops_ = &hops;
+  }
+
+  void GiveToken() {
+    has_token_ = true;
+    std::move(waker_).Wake();
+  }
+
+ private:
+  Poll<> DoPend(Context& cx) override {
+    if (!has_token_.exchange(false)) {
+      PW_ASYNC_STORE_WAKER(cx, waker_, "RingTask is waiting for the token");
+      return Pending();
+    }
+    if (hops_->fetch_sub(1) <= 1) {
+      return Ready();
+    }
+    next_->GiveToken();
+    PW_ASYNC_STORE_WAKER(cx, waker_, "RingTask is waiting for the token");
+    return Pending();
+  }
+
+  RingTask* next_ = nullptr;
+  std::atomic<int>* hops_ = nullptr;
+  std::atomic<bool> has_token_ = false;
+  Waker waker_;
+};
+
+TEST_F(WorkStealingDispatcherTest, WakesAcrossWorkers) {
+  constexpr int kHops = 10000;
+  std::atomic<int> hops = kHops;
+  std::array<RingTask, 8> ring;
+  for (size_t i = 0; i < ring.size(); ++i) {
+    ring[i].Connect(ring[(i + 1) % ring.size()], hops);
+    dispatcher_.Post(ring[i]);
+  }
+  EXPECT_EQ(dispatcher_.RunUntilStalled(), Pending());
+
+  // The task that takes the last hop completes, and the others go back to
+  // sleep.
+  ring[0].GiveToken();
+  EXPECT_EQ(dispatcher_.RunUntilStalled(), Pending());
+  EXPECT_EQ(hops.load(), 0);
+  EXPECT_FALSE(ring[(kHops - 1) % ring.size()].IsRegistered());
+  EXPECT_EQ(dispatcher_.tasks_polled(), ring.size() + kHops);
+
+  for (RingTask& task : ring) {
+    task.Deregister();
+  }
+}
+
+// Blocks in `Pend` until released, and wakes itself while it is blocked.
+class BlockingTask : public Task {
+ public:
+  std::atomic<bool> started = false;
+  std::atomic<bool> release = false;
+  std::atomic<bool> returned = false;
+  Waker waker;
+
+ private:
+  Poll<> DoPend(Context& cx) override {
+    if (!started.exchange(true)) {
+      cx.ReEnqueue();
+    }
+    WaitFor([this] { return release.load(); });
+    returned = true;
+    PW_ASYNC_STORE_WAKER(cx, waker, "BlockingTask is waiting to be woken");
+    return Pending();
+  }
+};
+
+TEST_F(WorkStealingDispatcherTest, DeregisterWaitsForRunningTask) {
+  BlockingTask task;
+  dispatcher_.Post(task);
+
+  std::thread runner([this] { dispatcher_.RunToCompletion(); });
+  ASSERT_TRUE(WaitFor([&task] { return task.started.load(); }));
+
+  std::thread releaser([&task] {
+    std::this_thread::sleep_for(10ms);
+    task.release = true;
+  });
+  task.Deregister();
+  EXPECT_TRUE(task.returned);
+  EXPECT_FALSE(task.IsRegistered());
+
+  releaser.join();
+  runner.join();
+}
+
+// Completes once woken from outside the dispatcher.
+class WaitingTask : public Task {
+ public:
+  std::atomic<bool> should_complete = false;
+  Waker waker;
+
+ private:
+  Poll<> DoPend(Context& cx) override {
+    if (should_complete) {
+      return Ready();
+    }
+    PW_ASYNC_STORE_WAKER(cx, waker, "WaitingTask is waiting to be woken");
+    return Pending();
+  }
+};
+
+TEST_F(WorkStealingDispatcherTest, RunToCompletion_SleepsUntilWoken) {
+  WaitingTask task;
+  dispatcher_.Post(task);
+
+  std::thread waker([&task] {
+    std::this_thread::sleep_for(50ms);
+    task.should_complete = true;
+    std::move(task.waker).Wake();
+  });
+  dispatcher_.RunToCompletion(task);
+  waker.join();
+
+  EXPECT_FALSE(task.IsRegistered());
+  EXPECT_EQ(dispatcher_.tasks_polled(), 2u);
+}
+
+TEST_F(WorkStealingDispatcherTest, RunToCompletion_WakesOnDeregister) {
+  WaitingTask task;
+  dispatcher_.Post(task);
+
+  std::thread deregisterer([&task] {
+    std::this_thread::sleep_for(50ms);
+    task.Deregister();
+  });
+  dispatcher_.RunToCompletion();
+  deregisterer.join();
+
+  EXPECT_FALSE(task.IsRegistered());
+}
+
+TEST_F(WorkStealingDispatcherTest, QueuedTasksRemainPostedAfterStalling) {
+  constexpr int kPolls = 100;
+  std::array<YieldingTask, 2> tasks = {YieldingTask(kPolls),
+                                       YieldingTask(kPolls)};
+  dispatcher_.Post(tasks[0]);
+  dispatcher_.Post(tasks[1]);
+
+  // Stop as soon as the first task completes, possibly leaving the second in a
+  // worker's run queue.
+  EXPECT_EQ(dispatcher_.RunUntilStalled(tasks[0]), Ready());
+  EXPECT_FALSE(tasks[0].IsRegistered());
+
+  if (tasks[1].IsRegistered()) {
+    EXPECT_EQ(dispatcher_.RunUntilStalled(tasks[1]), Ready());
+  }
+  EXPECT_EQ(tasks[1].polled(), kPolls);
+}
+
+TEST_F(WorkStealingDispatcherTest, DestroyWithQueuedTasks) {
+  std::array<YieldingTask, 2> tasks = {YieldingTask(100), YieldingTask(100)};
+  {
+    Dispatcher dispatcher;
+    dispatcher.native().NativeSetThreadCount(kThreads);
+    dispatcher.Post(tasks[0]);
+    dispatcher.Post(tasks[1]);
+    EXPECT_EQ(dispatcher.RunUntilStalled(tasks[0]), Ready());
+  }
+  EXPECT_FALSE(tasks[0].IsRegistered());
+  EXPECT_FALSE(tasks[1].IsRegistered());
+}
+
+}  // namespace
+}  // namespace pw::async2
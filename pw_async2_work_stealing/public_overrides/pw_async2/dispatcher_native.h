@@ -0,0 +1,164 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "pw_async2/dispatcher_base.h"
+#include "pw_sync/mutex.h"
+#include "pw_sync/thread_notification.h"
+
+namespace pw::async2::backend {
+
+// Windows GCC doesn't realize the nonvirtual destructor is protected and that
+// the class is final.
+PW_MODIFY_DIAGNOSTICS_PUSH();
+PW_MODIFY_DIAGNOSTIC_GCC(ignored, "-Wnon-virtual-dtor");
+
+// A ``Dispatcher`` backend that runs tasks on a pool of threads.
+//
+// Each thread, or worker, has its own run queue. A task woken by a worker is
+// added to that worker's queue, so it tends to run on the same thread as the
+// task that woke it. Tasks posted or woken from other threads go to a shared
+// queue. A worker with nothing to run takes tasks from the shared queue, then
+// steals half of another worker's queue.
+//
+// Tasks only run while a thread is in one of the ``Dispatcher::Run*``
+// methods. That thread is one of the workers, and the others are started when
+// the dispatcher first runs. The ``Run*`` methods return once no task is
+// running on any worker.
+//
+// A task never runs on two workers at once. If a task is woken while it runs,
+// it is added to a run queue when its ``Pend`` returns.
+class NativeDispatcher final : public NativeDispatcherBase {
+ public:
+  NativeDispatcher();
+  ~NativeDispatcher();
+
+  // Sets the number of workers, including the thread that runs the
+  // dispatcher. Must be called before the dispatcher first runs. By default,
+  // there is one worker per hardware thread.
+  void NativeSetThreadCount(size_t thread_count);
+
+  size_t NativeThreadCount() const { return thread_count_; }
+
+ private:
+  friend class ::pw::async2::Dispatcher;
+
+  struct Worker {
+    Worker(NativeDispatcher& owner, size_t worker_index)
+        : dispatcher(owner), index(worker_index) {}
+
+    NativeDispatcher& dispatcher;
+    const size_t index;
+
+    // Tasks woken by this worker.
+    IntrusiveList<Task> queue PW_GUARDED_BY(impl::dispatcher_lock());
+    size_t queued PW_GUARDED_BY(impl::dispatcher_lock()) = 0;
+
+    // The task that this worker is running, if any.
+    Task* running PW_GUARDED_BY(impl::dispatcher_lock()) = nullptr;
+
+    // Whether the worker is waiting for `notification`.
+    bool idle PW_GUARDED_BY(impl::dispatcher_lock()) = false;
+
+    // Held while the worker runs a task. See `TaskExecutionLockLocked`.
+    pw::sync::Mutex execution_lock;
+
+    pw::sync::ThreadNotification notification;
+    std::thread thread;
+  };
+
+  void DoWake() final;
+  Poll<> DoRunUntilStalled(Dispatcher& dispatcher, Task* task);
+  void DoRunToCompletion(Dispatcher& dispatcher, Task* task);
+
+  // Runs tasks on the calling thread and the other workers.
+  Poll<> Run(Dispatcher& dispatcher, Task* task, bool until_stalled);
+
+  void StartWorkers();
+  void WorkerLoop(Worker& worker);
+
+  // Runs a task that `worker` started with `StartTaskLocked`. The worker's
+  // `execution_lock` must be held.
+  void RunTaskOnWorker(Dispatcher& dispatcher,
+                       Worker& worker,
+                       Task& task,
+                       Task* main_task);
+
+  // Removes a task from `worker`'s queue, the shared queue, or another
+  // worker's queue, and marks it as running on `worker`.
+  Task* StartTaskLocked(Worker& worker)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(impl::dispatcher_lock());
+  Task* StealTaskLocked(Worker& thief)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(impl::dispatcher_lock());
+
+  void WakeIdleWorkerLocked()
+      PW_EXCLUSIVE_LOCKS_REQUIRED(impl::dispatcher_lock());
+  static void WakeWorkerLocked(Worker& worker)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(impl::dispatcher_lock());
+
+  // Moves tasks from the per-worker queues to the shared queue, so that they
+  // are visible to `NativeDispatcherBase` while the dispatcher is not running.
+  void ReturnQueuedTasksLocked()
+      PW_EXCLUSIVE_LOCKS_REQUIRED(impl::dispatcher_lock());
+
+  // Run queue hooks.
+  void PushWokenTaskLocked(Task& task) final
+      PW_EXCLUSIVE_LOCKS_REQUIRED(impl::dispatcher_lock());
+  void RemoveWokenTaskLocked(Task& task) final
+      PW_EXCLUSIVE_LOCKS_REQUIRED(impl::dispatcher_lock());
+  bool HasWokenTasksLocked() const final
+      PW_EXCLUSIVE_LOCKS_REQUIRED(impl::dispatcher_lock());
+  pw::sync::Mutex& TaskExecutionLockLocked(Task& task) final
+      PW_EXCLUSIVE_LOCKS_REQUIRED(impl::dispatcher_lock());
+
+  // The worker that runs on the current thread, if any.
+  static thread_local Worker* current_worker_;
+
+  size_t thread_count_;
+
+  // The worker for the thread that calls the `Run*` methods.
+  Worker caller_;
+
+  // The other workers, each of which has its own thread.
+  std::vector<std::unique_ptr<Worker>> threads_;
+
+  // All workers, starting with `caller_`.
+  std::vector<Worker*> workers_ PW_GUARDED_BY(impl::dispatcher_lock());
+
+  // The dispatcher that owns this backend, set while it is running.
+  Dispatcher* dispatcher_ PW_GUARDED_BY(impl::dispatcher_lock()) = nullptr;
+
+  // The task that the dispatcher is running until, if any.
+  Task* main_task_ PW_GUARDED_BY(impl::dispatcher_lock()) = nullptr;
+  bool main_task_completed_ PW_GUARDED_BY(impl::dispatcher_lock()) = false;
+
+  // Whether workers may start tasks.
+  bool active_ PW_GUARDED_BY(impl::dispatcher_lock()) = false;
+  bool shutdown_ PW_GUARDED_BY(impl::dispatcher_lock()) = false;
+
+  // Number of tasks in per-worker queues.
+  size_t queued_ PW_GUARDED_BY(impl::dispatcher_lock()) = 0;
+
+  // Number of workers running a task.
+  size_t running_ PW_GUARDED_BY(impl::dispatcher_lock()) = 0;
+};
+
+PW_MODIFY_DIAGNOSTICS_POP();
+
+}  // namespace pw::async2::backend
@@ -14,10 +14,34 @@
 
 #include "pw_base64/base64.h"
 
+#include <array>
 #include <cstdint>
+#include <cstring>
 
 #include "pw_assert/check.h"
 
+// Every vectorized implementation processes whole blocks and leaves the
+// remainder, including any padding, to the scalar code.
+//
+// On x86, the SSSE3 and AVX2 implementations are always compiled, using target
+// attributes rather than compiler flags, and are selected at runtime from the
+// CPU's features. NEON is part of the AArch64 baseline.
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#include <immintrin.h>
+#define _PW_BASE64_HAS_X86 1
+#define _PW_BASE64_SSSE3 __attribute__((target("ssse3")))
+#define _PW_BASE64_AVX2 __attribute__((target("avx2")))
+#else
+#define _PW_BASE64_HAS_X86 0
+#endif  // (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define _PW_BASE64_HAS_NEON 1
+#else
+#define _PW_BASE64_HAS_NEON 0
+#endif  // defined(__aarch64__) && defined(__ARM_NEON)
+
 namespace pw::base64 {
 namespace {
 
@@ -84,6 +108,389 @@ constexpr uint8_t Byte2(uint8_t bits2, uint8_t bits3) {
   return static_cast<uint8_t>((bits2 & 0b000011) << 6) | bits3;
 }
 
+#if _PW_BASE64_HAS_X86
+
+// The x86 implementations follow "Faster Base64 Encoding and Decoding Using
+// AVX2 Instructions" by Muła and Lemire (2018). Each 32-bit lane holds one
+// 3-byte group when encoding, or one 4-character group when decoding.
+
+// Offsets added to 6-bit values to produce characters, indexed by the value
+// class computed in IndicesToChars: 0 for a-z, 1-10 for 0-9, 11 for char 62,
+// 12 for char 63, and 13 for A-Z.
+#define _PW_BASE64_ENCODE_OFFSETS                                              \
+  'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,        \
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, kChar62 - 62, kChar63 - 63, 'A', \
+      0, 0
+
+bool CpuHasSsse3() {
+#if defined(__SSSE3__)
+  return true;
+#else
+  return __builtin_cpu_supports("ssse3");
+#endif  // defined(__SSSE3__)
+}
+
+bool CpuHasAvx2() {
+#if defined(__AVX2__)
+  return true;
+#else
+  return __builtin_cpu_supports("avx2");
+#endif  // defined(__AVX2__)
+}
+
+// Splits the 3-byte groups in the low 12 bytes of input into 6-bit indices,
+// one per byte.
+_PW_BASE64_SSSE3 inline __m128i SplitIndices(__m128i input) {
+  // Arrange each group's bytes as [b1, b0, b2, b1] within its 32-bit lane.
+  const __m128i in = _mm_shuffle_epi8(
+      input, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+  const __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+  const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+  const __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+  const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+  return _mm_or_si128(t1, t3);
+}
+
+_PW_BASE64_SSSE3 inline __m128i IndicesToChars(__m128i indices) {
+  __m128i offset_index = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+  const __m128i upper = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+  offset_index =
+      _mm_or_si128(offset_index, _mm_and_si128(upper, _mm_set1_epi8(13)));
+  const __m128i offsets = _mm_setr_epi8(_PW_BASE64_ENCODE_OFFSETS);
+  return _mm_add_epi8(_mm_shuffle_epi8(offsets, offset_index), indices);
+}
+
+_PW_BASE64_SSSE3 inline __m128i InRange(__m128i chars, char first, char last) {
+  return _mm_and_si128(
+      _mm_cmpgt_epi8(chars, _mm_set1_epi8(static_cast<char>(first - 1))),
+      _mm_cmpgt_epi8(_mm_set1_epi8(static_cast<char>(last + 1)), chars));
+}
+
+_PW_BASE64_SSSE3 inline __m128i IsEither(__m128i chars, char a, char b) {
+  return _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8(a)),
+                      _mm_cmpeq_epi8(chars, _mm_set1_epi8(b)));
+}
+
+// Translates 16 characters from either alphabet to their 6-bit values. Returns
+// false if any character is not a valid Base64 character.
+_PW_BASE64_SSSE3 inline bool CharsToBits(__m128i chars, __m128i& bits) {
+  const __m128i upper = InRange(chars, 'A', 'Z');
+  const __m128i lower = InRange(chars, 'a', 'z');
+  const __m128i digit = InRange(chars, '0', '9');
+  const __m128i char62 = IsEither(chars, '+', '-');
+  const __m128i char63 = IsEither(chars, '/', '_');
+
+  const __m128i valid =
+      _mm_or_si128(_mm_or_si128(upper, lower),
+                   _mm_or_si128(digit, _mm_or_si128(char62, char63)));
+  if (_mm_movemask_epi8(valid) != 0xFFFF) {
+    return false;
+  }
+
+  bits = _mm_or_si128(
+      _mm_or_si128(
+          _mm_and_si128(upper, _mm_sub_epi8(chars, _mm_set1_epi8('A'))),
+          _mm_and_si128(lower, _mm_sub_epi8(chars, _mm_set1_epi8('a' - 26)))),
+      _mm_or_si128(
+          _mm_and_si128(digit, _mm_add_epi8(chars, _mm_set1_epi8(52 - '0'))),
+          _mm_or_si128(_mm_and_si128(char62, _mm_set1_epi8(62)),
+                       _mm_and_si128(char63, _mm_set1_epi8(63)))));
+  return true;
+}
+
+// Packs the 6-bit values of four 4-character groups into the low 12 bytes.
+_PW_BASE64_SSSE3 inline __m128i PackBits(__m128i bits) {
+  const __m128i pairs = _mm_maddubs_epi16(bits, _mm_set1_epi32(0x01400140));
+  const __m128i groups = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+  return _mm_shuffle_epi8(
+      groups,
+      _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+}
+
+_PW_BASE64_SSSE3 inline void Store12(uint8_t* output, __m128i value) {
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(output), value);
+  const uint32_t high = static_cast<uint32_t>(
+      _mm_cvtsi128_si32(_mm_srli_si128(value, sizeof(uint64_t))));
+  std::memcpy(output + sizeof(uint64_t), &high, sizeof(high));
+}
+
+_PW_BASE64_AVX2 inline __m256i SplitIndices(__m256i input) {
+  const __m256i in = _mm256_shuffle_epi8(
+      input,
+      _mm256_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1,
+                      10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+  const __m256i t0 = _mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00));
+  const __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+  const __m256i t2 = _mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0));
+  const __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+  return _mm256_or_si256(t1, t3);
+}
+
+_PW_BASE64_AVX2 inline __m256i IndicesToChars(__m256i indices) {
+  __m256i offset_index = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+  const __m256i upper = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+  offset_index = _mm256_or_si256(offset_index,
+                                 _mm256_and_si256(upper, _mm256_set1_epi8(13)));
+  const __m256i offsets = _mm256_setr_epi8(_PW_BASE64_ENCODE_OFFSETS,
+                                           _PW_BASE64_ENCODE_OFFSETS);
+  return _mm256_add_epi8(_mm256_shuffle_epi8(offsets, offset_index), indices);
+}
+
+_PW_BASE64_AVX2 inline __m256i InRange(__m256i chars, char first, char last) {
+  return _mm256_and_si256(
+      _mm256_cmpgt_epi8(chars, _mm256_set1_epi8(static_cast<char>(first - 1))),
+      _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(last + 1)), chars));
+}
+
+_PW_BASE64_AVX2 inline __m256i IsEither(__m256i chars, char a, char b) {
+  return _mm256_or_si256(_mm256_cmpeq_epi8(chars, _mm256_set1_epi8(a)),
+                         _mm256_cmpeq_epi8(chars, _mm256_set1_epi8(b)));
+}
+
+_PW_BASE64_AVX2 inline bool CharsToBits(__m256i chars, __m256i& bits) {
+  const __m256i upper = InRange(chars, 'A', 'Z');
+  const __m256i lower = InRange(chars, 'a', 'z');
+  const __m256i digit = InRange(chars, '0', '9');
+  const __m256i char62 = IsEither(chars, '+', '-');
+  const __m256i char63 = IsEither(chars, '/', '_');
+
+  const __m256i valid =
+      _mm256_or_si256(_mm256_or_si256(upper, lower),
+                      _mm256_or_si256(digit, _mm256_or_si256(char62, char63)));
+  if (_mm256_movemask_epi8(valid) != -1) {
+    return false;
+  }
+
+  bits = _mm256_or_si256(
+      _mm256_or_si256(
+          _mm256_and_si256(upper,
+                           _mm256_sub_epi8(chars, _mm256_set1_epi8('A'))),
+          _mm256_and_si256(lower,
+                           _mm256_sub_epi8(chars, _mm256_set1_epi8('a' - 26)))),
+      _mm256_or_si256(
+          _mm256_and_si256(digit,
+                           _mm256_add_epi8(chars, _mm256_set1_epi8(52 - '0'))),
+          _mm256_or_si256(_mm256_and_si256(char62, _mm256_set1_epi8(62)),
+                          _mm256_and_si256(char63, _mm256_set1_epi8(63)))));
+  return true;
+}
+
+// Packs each 128-bit lane's 6-bit values into the low 12 bytes of the lane.
+_PW_BASE64_AVX2 inline __m256i PackBits(__m256i bits) {
+  const __m256i pairs =
+      _mm256_maddubs_epi16(bits, _mm256_set1_epi32(0x01400140));
+  const __m256i groups =
+      _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+  return _mm256_shuffle_epi8(
+      groups,
+      _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                       2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+}
+
+#undef _PW_BASE64_ENCODE_OFFSETS
+
+_PW_BASE64_AVX2 size_t EncodeBlocksAvx2(const uint8_t* bytes,
+                                        size_t size_bytes,
+                                        char* output) {
+  size_t consumed = 0;
+  // Each 128-bit lane encodes 12 bytes. Both lanes load 16 bytes, so 28 bytes
+  // must be readable.
+  for (; size_bytes - consumed >= 28; consumed += 24, output += 32) {
+    const __m128i low =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + consumed));
+    const __m128i high = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(bytes + consumed + 12));
+    const __m256i lanes =
+        _mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(output),
+                        IndicesToChars(SplitIndices(lanes)));
+  }
+  return consumed;
+}
+
+_PW_BASE64_SSSE3 size_t EncodeBlocksSsse3(const uint8_t* bytes,
+                                          size_t size_bytes,
+                                          char* output) {
+  size_t consumed = 0;
+  // Encode 12 bytes at a time. Loads read 16 bytes.
+  for (; size_bytes - consumed >= 16; consumed += 12, output += 16) {
+    const __m128i input =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + consumed));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output),
+                     IndicesToChars(SplitIndices(input)));
+  }
+  return consumed;
+}
+
+_PW_BASE64_AVX2 size_t DecodeBlocksAvx2(const char* base64,
+                                        size_t size_bytes,
+                                        uint8_t* binary) {
+  size_t consumed = 0;
+  for (; size_bytes - consumed >= 32; consumed += 32, binary += 24) {
+    const __m256i chars = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(base64 + consumed));
+    __m256i bits;
+    if (!CharsToBits(chars, bits)) {
+      break;
+    }
+    const __m256i packed = PackBits(bits);
+    Store12(binary, _mm256_castsi256_si128(packed));
+    Store12(binary + 12, _mm256_extracti128_si256(packed, 1));
+  }
+  return consumed;
+}
+
+_PW_BASE64_SSSE3 size_t DecodeBlocksSsse3(const char* base64,
+                                          size_t size_bytes,
+                                          uint8_t* binary) {
+  size_t consumed = 0;
+  for (; size_bytes - consumed >= 16; consumed += 16, binary += 12) {
+    const __m128i chars =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(base64 + consumed));
+    __m128i bits;
+    if (!CharsToBits(chars, bits)) {
+      break;
+    }
+    Store12(binary, PackBits(bits));
+  }
+  return consumed;
+}
+
+#undef _PW_BASE64_SSSE3
+#undef _PW_BASE64_AVX2
+
+#endif  // _PW_BASE64_HAS_X86
+
+#if _PW_BASE64_HAS_NEON
+
+// Table that decodes all 7-bit characters, with kX for invalid characters.
+constexpr std::array<uint8_t, 128> kNeonDecodeTable = [] {
+  std::array<uint8_t, 128> table{};
+  for (size_t i = 0; i < table.size(); ++i) {
+    const bool in_range = i >= static_cast<size_t>(kMinValidChar) &&
+                          i <= static_cast<size_t>(kMaxValidChar);
+    table[i] = in_range ? CharToBits(static_cast<char>(i)) : kX;
+  }
+  return table;
+}();
+
+inline uint8x16x4_t LoadTable64(const uint8_t* table) {
+  return {{vld1q_u8(table),
+           vld1q_u8(table + 16),
+           vld1q_u8(table + 32),
+           vld1q_u8(table + 48)}};
+}
+
+#endif  // _PW_BASE64_HAS_NEON
+
+// Encodes as many whole blocks as the available vector instructions support.
+// Returns the number of bytes consumed, which is always a multiple of 3; the
+// corresponding characters are written to output.
+size_t EncodeBlocks([[maybe_unused]] const uint8_t* bytes,
+                    [[maybe_unused]] size_t size_bytes,
+                    [[maybe_unused]] char* output) {
+  size_t consumed = 0;
+
+#if _PW_BASE64_HAS_X86
+  // Blocks too short for AVX2 are finished with SSSE3.
+  if (CpuHasAvx2()) {
+    consumed = EncodeBlocksAvx2(bytes, size_bytes, output);
+  }
+  if (CpuHasSsse3()) {
+    consumed += EncodeBlocksSsse3(bytes + consumed,
+                                  size_bytes - consumed,
+                                  output + consumed / 3 * kEncodedGroupSize);
+  }
+#endif  // _PW_BASE64_HAS_X86
+
+#if _PW_BASE64_HAS_NEON
+  const uint8x16x4_t table =
+      LoadTable64(reinterpret_cast<const uint8_t*>(kEncodeTable));
+  const uint8x16_t mask_30 = vdupq_n_u8(0x30);
+  const uint8x16_t mask_3c = vdupq_n_u8(0x3C);
+  const uint8x16_t mask_3f = vdupq_n_u8(0x3F);
+
+  // Encode 48 bytes at a time, de-interleaved into the bytes of 16 groups.
+  for (; size_bytes - consumed >= 48; consumed += 48, output += 64) {
+    const uint8x16x3_t in = vld3q_u8(bytes + consumed);
+    uint8x16x4_t out;
+    out.val[0] = vshrq_n_u8(in.val[0], 2);
+    out.val[1] = vorrq_u8(vandq_u8(vshlq_n_u8(in.val[0], 4), mask_30),
+                          vshrq_n_u8(in.val[1], 4));
+    out.val[2] = vorrq_u8(vandq_u8(vshlq_n_u8(in.val[1], 2), mask_3c),
+                          vshrq_n_u8(in.val[2], 6));
+    out.val[3] = vandq_u8(in.val[2], mask_3f);
+    for (uint8x16_t& value : out.val) {
+      value = vqtbl4q_u8(table, value);
+    }
+    vst4q_u8(reinterpret_cast<uint8_t*>(output), out);
+  }
+#endif  // _PW_BASE64_HAS_NEON
+
+  return consumed;
+}
+
+// Decodes as many whole blocks as the available vector instructions support.
+// Returns the number of characters consumed, which is always a multiple of 4;
+// the corresponding bytes are written to binary. Stops early at a block that
+// contains invalid characters, which the scalar code then handles.
+size_t DecodeBlocks([[maybe_unused]] const char* base64,
+                    [[maybe_unused]] size_t size_bytes,
+                    [[maybe_unused]] uint8_t* binary) {
+  size_t consumed = 0;
+
+#if _PW_BASE64_HAS_X86
+  // Stop at the first block that contains an invalid character, even if it
+  // could be retried with SSSE3.
+  if (CpuHasAvx2()) {
+    consumed = DecodeBlocksAvx2(base64, size_bytes, binary);
+    if (size_bytes - consumed >= 32) {
+      return consumed;
+    }
+  }
+  if (CpuHasSsse3()) {
+    consumed += DecodeBlocksSsse3(base64 + consumed,
+                                  size_bytes - consumed,
+                                  binary + consumed / kEncodedGroupSize * 3);
+  }
+#endif  // _PW_BASE64_HAS_X86
+
+#if _PW_BASE64_HAS_NEON
+  const uint8x16x4_t table_low = LoadTable64(kNeonDecodeTable.data());
+  const uint8x16x4_t table_high = LoadTable64(kNeonDecodeTable.data() + 64);
+  const uint8x16_t high_offset = vdupq_n_u8(64);
+
+  // Decode 64 characters at a time, de-interleaved into the characters of 16
+  // groups.
+  for (; size_bytes - consumed >= 64; consumed += 64, binary += 48) {
+    uint8x16x4_t in =
+        vld4q_u8(reinterpret_cast<const uint8_t*>(base64 + consumed));
+    uint8x16_t invalid = vdupq_n_u8(0);
+    for (uint8x16_t& value : in.val) {
+      // Characters 0-63 come from the low table and 64-127 from the high
+      // table; characters with the high bit set match neither.
+      const uint8x16_t low = vqtbl4q_u8(table_low, value);
+      const uint8x16_t bits =
+          vqtbx4q_u8(low, table_high, vsubq_u8(value, high_offset));
+      invalid = vorrq_u8(invalid, vcgeq_u8(value, vdupq_n_u8(0x80)));
+      invalid = vorrq_u8(invalid, vceqq_u8(bits, vdupq_n_u8(kX)));
+      value = bits;
+    }
+    if (vmaxvq_u8(invalid) != 0) {
+      return consumed;
+    }
+
+    uint8x16x3_t out;
+    out.val[0] = vorrq_u8(vshlq_n_u8(in.val[0], 2), vshrq_n_u8(in.val[1], 4));
+    out.val[1] = vorrq_u8(vshlq_n_u8(in.val[1], 4), vshrq_n_u8(in.val[2], 2));
+    out.val[2] = vorrq_u8(vshlq_n_u8(in.val[2], 6), in.val[3]);
+    vst3q_u8(binary, out);
+  }
+#endif  // _PW_BASE64_HAS_NEON
+
+  return consumed;
+}
+
 }  // namespace
 
 extern "C" void pw_Base64Encode(const void* binary_data,
@@ -91,8 +498,12 @@ extern "C" void pw_Base64Encode(const void* binary_data,
                                 char* output) {
   const uint8_t* bytes = static_cast<const uint8_t*>(binary_data);
 
+  const size_t vector_bytes = EncodeBlocks(bytes, binary_size_bytes, output);
+  bytes += vector_bytes;
+  output += vector_bytes / 3 * kEncodedGroupSize;
+
   // Encode groups of 3 source bytes into 4 output characters.
-  size_t remaining = binary_size_bytes;
+  size_t remaining = binary_size_bytes - vector_bytes;
   for (; remaining >= 3u; remaining -= 3u, bytes += 3) {
     *output++ = BitGroup0Char(bytes[0]);
     *output++ = BitGroup1Char(bytes[0], bytes[1]);
@@ -124,7 +535,11 @@ extern "C" size_t pw_Base64Decode(const char* base64,
   }
 
   uint8_t* binary = static_cast<uint8_t*>(output);
-  size_t ch = 0;
+
+  // The final group may include padding, so leave it to the scalar code.
+  size_t ch =
+      DecodeBlocks(base64, base64_size_bytes - kEncodedGroupSize, binary);
+  binary += ch / kEncodedGroupSize * 3;
   for (; ch < base64_size_bytes - kEncodedGroupSize; ch += kEncodedGroupSize) {
     const uint8_t char0 = CharToBits(base64[ch + 0]);
     const uint8_t char1 = CharToBits(base64[ch + 1]);
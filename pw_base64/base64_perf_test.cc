@@ -0,0 +1,65 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+#include "pw_base64/base64.h"
+#include "pw_perf_test/perf_test.h"
+#include "pw_span/span.h"
+
+namespace pw::base64 {
+namespace {
+
+constexpr size_t kMaxBinarySize = 64 * 1024;
+
+std::array<std::byte, kMaxBinarySize> binary_buffer;
+std::array<char, EncodedSize(kMaxBinarySize)> base64_buffer;
+
+span<const std::byte> Binary(size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    binary_buffer[i] = static_cast<std::byte>(i * 131 + 17);
+  }
+  return span(binary_buffer).first(size);
+}
+
+void EncodeTest(perf_test::State& state, size_t size) {
+  const span<const std::byte> binary = Binary(size);
+  while (state.KeepRunning()) {
+    Encode(binary, base64_buffer.data());
+  }
+}
+
+void DecodeTest(perf_test::State& state, size_t size) {
+  const span<const std::byte> binary = Binary(size);
+  Encode(binary, base64_buffer.data());
+  const std::string_view base64(base64_buffer.data(), EncodedSize(size));
+  while (state.KeepRunning()) {
+    Decode(base64, binary_buffer.data());
+  }
+}
+
+PW_PERF_TEST(Encode_8Bytes, EncodeTest, 8);
+PW_PERF_TEST(Encode_64Bytes, EncodeTest, 64);
+PW_PERF_TEST(Encode_1KiB, EncodeTest, 1024);
+PW_PERF_TEST(Encode_64KiB, EncodeTest, 64 * 1024);
+
+PW_PERF_TEST(Decode_8Bytes, DecodeTest, 8);
+PW_PERF_TEST(Decode_64Bytes, DecodeTest, 64);
+PW_PERF_TEST(Decode_1KiB, DecodeTest, 1024);
+PW_PERF_TEST(Decode_64KiB, DecodeTest, 64 * 1024);
+
+}  // namespace
+}  // namespace pw::base64
@@ -309,6 +309,108 @@ TEST(Base64, Decode_UrlSafeDecode) {
   EXPECT_STREQ("\xf9\xff\xffYo!", output);
 }
 
+// Straightforward bit-at-a-time encoder used to check the optimized
+// implementations, which process data in blocks of up to 64 characters.
+void ReferenceEncode(const uint8_t* data, size_t size, char* output) {
+  constexpr char kAlphabet[] =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  for (size_t i = 0; i < size; i += 3) {
+    uint32_t group = static_cast<uint32_t>(data[i]) << 16;
+    if (i + 1 < size) {
+      group |= static_cast<uint32_t>(data[i + 1]) << 8;
+    }
+    if (i + 2 < size) {
+      group |= data[i + 2];
+    }
+    *output++ = kAlphabet[(group >> 18) & 0x3f];
+    *output++ = kAlphabet[(group >> 12) & 0x3f];
+    *output++ = i + 1 < size ? kAlphabet[(group >> 6) & 0x3f] : '=';
+    *output++ = i + 2 < size ? kAlphabet[group & 0x3f] : '=';
+  }
+}
+
+constexpr size_t kMaxLongDataSize = 300;
+
+struct LongData {
+  LongData() {
+    uint32_t value = 0xfeedface;
+    for (uint8_t& b : binary) {
+      value = value * 1103515245u + 12345u;
+      b = static_cast<uint8_t>(value >> 24);
+    }
+  }
+
+  uint8_t binary[kMaxLongDataSize];
+};
+
+TEST(Base64, Encode_LongData_AllSizes) {
+  const LongData data;
+  char expected[EncodedSize(kMaxLongDataSize)];
+  char encoded[EncodedSize(kMaxLongDataSize)];
+
+  for (size_t size = 0; size <= kMaxLongDataSize; ++size) {
+    ReferenceEncode(data.binary, size, expected);
+    Encode(as_bytes(span(data.binary, size)), encoded);
+    ASSERT_EQ(0, std::memcmp(expected, encoded, EncodedSize(size)))
+        << "size " << size;
+  }
+}
+
+TEST(Base64, Decode_LongData_AllSizes) {
+  const LongData data;
+  char encoded[EncodedSize(kMaxLongDataSize)];
+  std::byte decoded[kMaxLongDataSize];
+
+  for (size_t size = 0; size <= kMaxLongDataSize; ++size) {
+    ReferenceEncode(data.binary, size, encoded);
+    const std::string_view base64(encoded, EncodedSize(size));
+    ASSERT_EQ(size, Decode(base64, span(decoded)));
+    ASSERT_EQ(0, std::memcmp(data.binary, decoded, size)) << "size " << size;
+  }
+}
+
+TEST(Base64, Decode_LongData_UrlSafe) {
+  const LongData data;
+  char encoded[EncodedSize(kMaxLongDataSize)];
+  std::byte decoded[kMaxLongDataSize];
+
+  for (size_t size = 0; size <= kMaxLongDataSize; ++size) {
+    ReferenceEncode(data.binary, size, encoded);
+    for (char& c : encoded) {
+      c = c == '+' ? '-' : c == '/' ? '_' : c;
+    }
+    const std::string_view base64(encoded, EncodedSize(size));
+    ASSERT_EQ(size, Decode(base64, span(decoded)));
+    ASSERT_EQ(0, std::memcmp(data.binary, decoded, size)) << "size " << size;
+  }
+}
+
+TEST(Base64, Decode_LongData_InPlace) {
+  const LongData data;
+  char buffer[EncodedSize(kMaxLongDataSize)];
+  ReferenceEncode(data.binary, kMaxLongDataSize, buffer);
+
+  EXPECT_EQ(kMaxLongDataSize,
+            Decode(std::string_view(buffer, sizeof(buffer)), buffer));
+  EXPECT_EQ(0, std::memcmp(data.binary, buffer, kMaxLongDataSize));
+}
+
+TEST(Base64, IsValid_LongDataInvalidCharacter) {
+  const LongData data;
+  char encoded[EncodedSize(kMaxLongDataSize)];
+  ReferenceEncode(data.binary, kMaxLongDataSize, encoded);
+  const std::string_view base64(encoded, sizeof(encoded));
+  std::byte decoded[kMaxLongDataSize];
+
+  for (size_t i = 0; i < sizeof(encoded) - 2; i += 7) {
+    const char original = encoded[i];
+    encoded[i] = '*';
+    EXPECT_FALSE(IsValid(base64));
+    EXPECT_EQ(0u, Decode(base64, span(decoded)));
+    encoded[i] = original;
+  }
+}
+
 TEST(Base64, Empty) {
   char buffer[] = "DO NOT TOUCH";
   EXPECT_EQ(0u, EncodedSize(0));
@@ -0,0 +1,39 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <array>
+#include <cstddef>
+
+#include "pw_async2/dispatcher.h"
+#include "pw_channel/epoll_channel.h"
+#include "pw_channel_private/loopback_perf_test.h"
+#include "pw_perf_test/perf_test.h"
+
+namespace pw::channel {
+namespace {
+
+std::array<std::byte, kLoopbackDataAreaSize> data_area;
+
+void EpollLoopbackTest(perf_test::State& state, size_t num_pairs) {
+  async2::Dispatcher dispatcher;
+  MeasureLoopbackThroughput<EpollChannel>(
+      state, dispatcher, data_area, num_pairs);
+}
+
+PW_PERF_TEST(EpollLoopback_1Pair, EpollLoopbackTest, 1);
+PW_PERF_TEST(EpollLoopback_16Pairs, EpollLoopbackTest, 16);
+PW_PERF_TEST(EpollLoopback_64Pairs, EpollLoopbackTest, 64);
+
+}  // namespace
+}  // namespace pw::channel
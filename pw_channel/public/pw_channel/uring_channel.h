@@ -0,0 +1,125 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+#include "pw_async2/dispatcher.h"
+#include "pw_async2/poll.h"
+#include "pw_channel/channel.h"
+#include "pw_multibuf/allocator.h"
+#include "pw_multibuf/allocator_async.h"
+#include "pw_multibuf/multibuf.h"
+
+namespace pw::channel {
+
+/// @defgroup pw_channel_uring
+/// @{
+
+/// Channel implementation which writes to and reads from a file descriptor,
+/// backed by a Linux io_uring.
+///
+/// Reads and writes are submitted to the kernel as a whole rather than issued
+/// once the file descriptor is ready, so each operation costs no syscalls of
+/// its own. The dispatcher submits the operations of all channels in a single
+/// call.
+///
+/// This channel depends on APIs provided by the `pw_async2_uring` dispatcher
+/// backend and cannot be used with any other dispatcher backend. Reads and
+/// writes use registered buffers if the allocator's memory has been passed to
+/// the dispatcher's `NativeRegisterBuffers`.
+///
+/// An instantiated UringChannel takes ownership of the file descriptor it is
+/// given, and will close it if the channel is closed or destroyed. Users should
+/// not close a channel's file descriptor from outside. Since the kernel refers
+/// to the channel while operations are in progress, it cannot be moved, and
+/// must be closed or destroyed on the dispatcher's thread.
+class UringChannel : public Implement<ByteReaderWriter> {
+ public:
+  UringChannel(int channel_fd,
+               async2::Dispatcher& dispatcher,
+               multibuf::MultiBufAllocator& allocator)
+      : channel_fd_(channel_fd),
+        dispatcher_(&dispatcher),
+        read_alloc_future_(allocator),
+        write_alloc_future_(allocator) {}
+
+  ~UringChannel() override { Cleanup(); }
+
+  UringChannel(const UringChannel&) = delete;
+  UringChannel& operator=(const UringChannel&) = delete;
+
+  UringChannel(UringChannel&&) = delete;
+  UringChannel& operator=(UringChannel&&) = delete;
+
+ private:
+  using Operation = async2::backend::NativeDispatcher::NativeOperation;
+
+  static constexpr size_t kMinimumReadSize = 64;
+  static constexpr size_t kDesiredReadSize = 1024;
+
+  async2::Poll<Result<multibuf::MultiBuf>> DoPendRead(
+      async2::Context& cx) override;
+
+  async2::Poll<Status> DoPendReadyToWrite(async2::Context& cx) final {
+    return PendWriteCompletion(cx);
+  }
+
+  async2::Poll<std::optional<multibuf::MultiBuf>> DoPendAllocateWriteBuffer(
+      async2::Context& cx, size_t min_bytes) final {
+    write_alloc_future_.SetDesiredSize(min_bytes);
+    return write_alloc_future_.Pend(cx);
+  }
+
+  Status DoStageWrite(multibuf::MultiBuf&& data) final;
+
+  async2::Poll<Status> DoPendWrite(async2::Context& cx) final {
+    return PendWriteCompletion(cx);
+  }
+
+  async2::Poll<Status> DoPendClose(async2::Context&) final {
+    Cleanup();
+    return async2::Ready(OkStatus());
+  }
+
+  void set_closed() {
+    set_read_closed();
+    set_write_closed();
+  }
+
+  // Submits a write of the first nonempty chunk of the staged data, or
+  // releases the data if it has all been written.
+  Status SubmitNextWrite();
+
+  // Waits for the staged data to be written.
+  async2::Poll<Status> PendWriteCompletion(async2::Context& cx);
+
+  void Cleanup();
+
+  int channel_fd_;
+  async2::Dispatcher* dispatcher_;
+
+  multibuf::MultiBufAllocationFuture read_alloc_future_;
+  std::optional<multibuf::MultiBuf> read_buffer_;
+  Operation read_operation_;
+
+  multibuf::MultiBufAllocationFuture write_alloc_future_;
+  std::optional<multibuf::MultiBuf> write_buffer_;
+  Operation write_operation_;
+};
+
+/// @}
+
+}  // namespace pw::channel
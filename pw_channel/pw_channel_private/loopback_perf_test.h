@@ -0,0 +1,158 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <sys/socket.h>
+
+#include <array>
+#include <cstddef>
+#include <optional>
+
+#include "pw_allocator/libc_allocator.h"
+#include "pw_assert/check.h"
+#include "pw_async2/dispatcher.h"
+#include "pw_bytes/span.h"
+#include "pw_channel/channel.h"
+#include "pw_multibuf/simple_allocator.h"
+#include "pw_perf_test/perf_test.h"
+
+namespace pw::channel {
+
+// Loopback throughput benchmark shared by the file descriptor channels. Each
+// iteration writes a fixed amount of data through every one of a number of
+// socket pairs and reads it back out, all on one dispatcher.
+//
+// Only one dispatcher backend can be linked into a binary, so each channel has
+// its own perf test which calls MeasureLoopbackThroughput.
+
+inline constexpr size_t kLoopbackMaxPairs = 64;
+inline constexpr size_t kLoopbackWriteSize = 1024;
+
+// Small enough to fit in a socket's send buffer, so that the writer never
+// needs to wait for the reader.
+inline constexpr size_t kLoopbackBytesPerIteration = 16 * kLoopbackWriteSize;
+
+// Each pair allocates from its own slice of the data area, with room for a
+// read and a write buffer and space to spare. SimpleAllocator's cost grows with
+// the number of outstanding buffers, so sharing one between all of the pairs
+// would measure the allocator rather than the channels.
+inline constexpr size_t kLoopbackDataAreaSizePerPair = 4 * kLoopbackWriteSize;
+inline constexpr size_t kLoopbackDataAreaSize =
+    kLoopbackMaxPairs * kLoopbackDataAreaSizePerPair;
+
+class LoopbackWriterTask : public async2::Task {
+ public:
+  explicit LoopbackWriterTask(ByteWriter& channel) : channel_(channel) {}
+
+  void Reset() { remaining_ = kLoopbackBytesPerIteration; }
+
+ private:
+  async2::Poll<> DoPend(async2::Context& cx) final {
+    while (remaining_ > 0) {
+      async2::Poll<Status> ready = channel_.PendReadyToWrite(cx);
+      if (ready.IsPending()) {
+        return async2::Pending();
+      }
+      PW_CHECK_OK(*ready);
+
+      async2::Poll<std::optional<multibuf::MultiBuf>> buffer =
+          channel_.PendAllocateWriteBuffer(cx, kLoopbackWriteSize);
+      if (buffer.IsPending()) {
+        return async2::Pending();
+      }
+      PW_CHECK(buffer->has_value());
+      PW_CHECK_OK(channel_.StageWrite(std::move(**buffer)));
+      remaining_ -= kLoopbackWriteSize;
+    }
+
+    async2::Poll<Status> written = channel_.PendWrite(cx);
+    if (written.IsPending()) {
+      return async2::Pending();
+    }
+    PW_CHECK_OK(*written);
+    return async2::Ready();
+  }
+
+  ByteWriter& channel_;
+  size_t remaining_ = 0;
+};
+
+class LoopbackReaderTask : public async2::Task {
+ public:
+  explicit LoopbackReaderTask(ByteReader& channel) : channel_(channel) {}
+
+  void Reset() { remaining_ = kLoopbackBytesPerIteration; }
+
+ private:
+  async2::Poll<> DoPend(async2::Context& cx) final {
+    while (remaining_ > 0) {
+      async2::Poll<Result<multibuf::MultiBuf>> result = channel_.PendRead(cx);
+      if (result.IsPending()) {
+        return async2::Pending();
+      }
+      PW_CHECK_OK(result->status());
+      PW_CHECK_UINT_LE((*result)->size(), remaining_);
+      remaining_ -= (*result)->size();
+    }
+    return async2::Ready();
+  }
+
+  ByteReader& channel_;
+  size_t remaining_ = 0;
+};
+
+// ChannelType must be constructible from a file descriptor, dispatcher, and
+// allocator, and take ownership of the file descriptor. Buffers are allocated
+// from data_area.
+template <typename ChannelType>
+void MeasureLoopbackThroughput(perf_test::State& state,
+                               async2::Dispatcher& dispatcher,
+                               ByteSpan data_area,
+                               size_t num_pairs) {
+  PW_CHECK_UINT_LE(num_pairs, kLoopbackMaxPairs);
+  PW_CHECK_UINT_GE(data_area.size(), kLoopbackDataAreaSize);
+
+  std::array<std::optional<multibuf::SimpleAllocator>, kLoopbackMaxPairs>
+      allocators;
+  std::array<std::optional<ChannelType>, kLoopbackMaxPairs> writers;
+  std::array<std::optional<ChannelType>, kLoopbackMaxPairs> readers;
+  std::array<std::optional<LoopbackWriterTask>, kLoopbackMaxPairs>
+      writer_tasks;
+  std::array<std::optional<LoopbackReaderTask>, kLoopbackMaxPairs>
+      reader_tasks;
+
+  for (size_t i = 0; i < num_pairs; ++i) {
+    int fds[2];
+    PW_CHECK_INT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    allocators[i].emplace(data_area.subspan(i * kLoopbackDataAreaSizePerPair,
+                                            kLoopbackDataAreaSizePerPair),
+                          allocator::GetLibCAllocator());
+    writers[i].emplace(fds[0], dispatcher, *allocators[i]);
+    readers[i].emplace(fds[1], dispatcher, *allocators[i]);
+    writer_tasks[i].emplace(writers[i]->channel());
+    reader_tasks[i].emplace(readers[i]->channel());
+  }
+
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < num_pairs; ++i) {
+      writer_tasks[i]->Reset();
+      reader_tasks[i]->Reset();
+      dispatcher.Post(*writer_tasks[i]);
+      dispatcher.Post(*reader_tasks[i]);
+    }
+    dispatcher.RunToCompletion();
+  }
+}
+
+}  // namespace pw::channel
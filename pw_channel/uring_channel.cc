@@ -0,0 +1,139 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_channel/uring_channel.h"
+
+#include <unistd.h>
+
+#include <cstring>
+
+#include "pw_log/log.h"
+#include "pw_status/try.h"
+
+namespace pw::channel {
+
+async2::Poll<Result<multibuf::MultiBuf>> UringChannel::DoPendRead(
+    async2::Context& cx) {
+  if (!read_buffer_.has_value()) {
+    read_alloc_future_.SetDesiredSizes(
+        kMinimumReadSize, kDesiredReadSize, pw::multibuf::kNeedsContiguous);
+    async2::Poll<std::optional<multibuf::MultiBuf>> maybe_multibuf =
+        read_alloc_future_.Pend(cx);
+    if (maybe_multibuf.IsPending()) {
+      return async2::Pending();
+    }
+
+    if (!maybe_multibuf->has_value()) {
+      PW_LOG_ERROR("Failed to allocate multibuf for reading");
+      return Status::ResourceExhausted();
+    }
+
+    read_buffer_ = std::move(**maybe_multibuf);
+    multibuf::Chunk& chunk = *read_buffer_->Chunks().begin();
+    Status status = dispatcher_->native().NativeSubmitRead(
+        channel_fd_, ByteSpan(chunk.data(), chunk.size()), read_operation_);
+    if (!status.ok()) {
+      read_buffer_.reset();
+      return status;
+    }
+  }
+
+  if (read_operation_.in_progress()) {
+    PW_ASYNC_STORE_WAKER(cx,
+                         read_operation_.waker(),
+                         "UringChannel is waiting on a file descriptor read");
+    return async2::Pending();
+  }
+
+  multibuf::MultiBuf buf = std::move(*read_buffer_);
+  read_buffer_.reset();
+
+  const int result = read_operation_.result();
+  if (result < 0) {
+    PW_LOG_ERROR("Uring channel read failed: %s", std::strerror(-result));
+    return Status::Internal();
+  }
+
+  buf.Truncate(static_cast<size_t>(result));
+  return async2::Ready(std::move(buf));
+}
+
+Status UringChannel::DoStageWrite(multibuf::MultiBuf&& data) {
+  if (write_buffer_.has_value()) {
+    // The previous write has not completed. `PendReadyToWrite` waits for it.
+    return Status::Unavailable();
+  }
+  write_buffer_ = std::move(data);
+  return SubmitNextWrite();
+}
+
+Status UringChannel::SubmitNextWrite() {
+  for (multibuf::Chunk& chunk : write_buffer_->Chunks()) {
+    if (chunk.empty()) {
+      continue;
+    }
+    Status status = dispatcher_->native().NativeSubmitWrite(
+        channel_fd_,
+        ConstByteSpan(chunk.data(), chunk.size()),
+        write_operation_);
+    if (!status.ok()) {
+      write_buffer_.reset();
+    }
+    return status;
+  }
+
+  write_buffer_.reset();
+  return OkStatus();
+}
+
+async2::Poll<Status> UringChannel::PendWriteCompletion(async2::Context& cx) {
+  while (write_buffer_.has_value()) {
+    if (write_operation_.in_progress()) {
+      PW_ASYNC_STORE_WAKER(
+          cx,
+          write_operation_.waker(),
+          "UringChannel is waiting on a file descriptor write");
+      return async2::Pending();
+    }
+
+    const int result = write_operation_.result();
+    if (result < 0) {
+      PW_LOG_ERROR("Uring channel write failed: %s", std::strerror(-result));
+      write_buffer_.reset();
+      return Status::Internal();
+    }
+
+    // Writes may be partial, so continue from wherever this one stopped.
+    write_buffer_->DiscardPrefix(static_cast<size_t>(result));
+    PW_TRY(SubmitNextWrite());
+  }
+  return OkStatus();
+}
+
+void UringChannel::Cleanup() {
+  if (is_read_or_write_open()) {
+    // The buffers may not be released until the kernel is done with them.
+    dispatcher_->native().NativeCancelOperation(read_operation_);
+    dispatcher_->native().NativeCancelOperation(write_operation_);
+    read_buffer_.reset();
+    write_buffer_.reset();
+    set_closed();
+  }
+  if (channel_fd_ != -1) {
+    close(channel_fd_);
+    channel_fd_ = -1;
+  }
+}
+
+}  // namespace pw::channel
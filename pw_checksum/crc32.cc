@@ -15,6 +15,21 @@
 #include "pw_checksum/crc32.h"
 
 #include <array>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define _PW_CHECKSUM_CRC32_HAS_PCLMUL 1
+#else
+#define _PW_CHECKSUM_CRC32_HAS_PCLMUL 0
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#define _PW_CHECKSUM_CRC32_HAS_ARM_CRC32 1
+#else
+#define _PW_CHECKSUM_CRC32_HAS_ARM_CRC32 0
+#endif
 
 namespace pw::checksum {
 namespace {
@@ -53,8 +68,196 @@ constexpr std::array<uint32_t, (1 << kBits)> GenerateCrc32Table() {
 // https://en.wikipedia.org/wiki/Cyclic_redundancy_check#Polynomial_representations_of_cyclic_redundancy_checks
 constexpr uint32_t kCrc32Polynomial = 0xEDB88320;
 
+// Generates kSlices lookup tables for a slice-by-N CRC32 implementation.
+// Table 0 is the regular 8-bit table. Table k holds the CRC of a byte followed
+// by k zero bytes, which allows kSlices bytes to be folded into the state with
+// independent lookups rather than a serial chain of kSlices table accesses.
+template <std::size_t kSlices, uint32_t kPolynomial>
+constexpr std::array<std::array<uint32_t, 256>, kSlices>
+GenerateCrc32SliceTables() {
+  std::array<std::array<uint32_t, 256>, kSlices> tables{};
+  tables[0] = GenerateCrc32Table<8, kPolynomial>();
+  for (std::size_t k = 1; k < kSlices; ++k) {
+    for (std::size_t i = 0; i < 256; ++i) {
+      const uint32_t previous = tables[k - 1][i];
+      tables[k][i] = (previous >> 8) ^ tables[0][previous & 0xFFu];
+    }
+  }
+  return tables;
+}
+
+// Reads a little-endian 32-bit word. The byte-wise assembly is portable across
+// endianness and alignment, and compiles to a single load on little-endian
+// targets.
+constexpr uint32_t ReadLittleEndian32(const uint8_t* data) {
+  return static_cast<uint32_t>(data[0]) |
+         (static_cast<uint32_t>(data[1]) << 8) |
+         (static_cast<uint32_t>(data[2]) << 16) |
+         (static_cast<uint32_t>(data[3]) << 24);
+}
+
+// Slice-by-N CRC32. Processes kSlices bytes per iteration using kSlices
+// 256-entry tables, then finishes any remaining bytes one at a time.
+template <std::size_t kSlices>
+uint32_t Crc32SliceBy(const uint8_t* data, size_t size_bytes, uint32_t state) {
+  static_assert(kSlices % 4 == 0, "Slices must be a multiple of 4 bytes");
+  static constexpr std::array<std::array<uint32_t, 256>, kSlices> kTables =
+      GenerateCrc32SliceTables<kSlices, kCrc32Polynomial>();
+
+  for (; size_bytes >= kSlices; size_bytes -= kSlices, data += kSlices) {
+    uint32_t next = 0;
+    for (std::size_t word = 0; word < kSlices / 4; ++word) {
+      uint32_t value = ReadLittleEndian32(data + word * 4);
+      if (word == 0) {
+        value ^= state;
+      }
+      // The first word's bytes are furthest from the end of the block, so they
+      // use the highest numbered tables.
+      const std::size_t table = kSlices - 1 - word * 4;
+      next ^= kTables[table][value & 0xFFu] ^
+              kTables[table - 1][(value >> 8) & 0xFFu] ^
+              kTables[table - 2][(value >> 16) & 0xFFu] ^
+              kTables[table - 3][value >> 24];
+    }
+    state = next;
+  }
+
+  for (; size_bytes > 0; --size_bytes, ++data) {
+    state = kTables[0][(state ^ *data) & 0xFFu] ^ (state >> 8);
+  }
+  return state;
+}
+
+#if _PW_CHECKSUM_CRC32_HAS_PCLMUL
+
+#define _PW_CHECKSUM_CRC32_PCLMUL_TARGET gnu::target("pclmul,sse4.1")
+
+[[_PW_CHECKSUM_CRC32_PCLMUL_TARGET]] inline __m128i Load128(
+    const uint8_t* data) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+}
+
+// Multiplies each half of value by the matching fold constant, combines the
+// products, and XORs in the next block of data.
+[[_PW_CHECKSUM_CRC32_PCLMUL_TARGET]] inline __m128i Fold128(__m128i value,
+                                                            __m128i next,
+                                                            __m128i constants) {
+  const __m128i low = _mm_clmulepi64_si128(value, constants, 0x00);
+  const __m128i high = _mm_clmulepi64_si128(value, constants, 0x11);
+  return _mm_xor_si128(_mm_xor_si128(high, low), next);
+}
+
+// Folds the CRC32 of size_bytes of data using carry-less multiplication, as
+// described in "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ
+// Instruction" by Gopal et al. (Intel, 2009). size_bytes must be at least 64
+// and a multiple of 16. The constants are the bit-reflected fold constants and
+// Barrett reduction values for the CRC32 polynomial given in the paper.
+[[_PW_CHECKSUM_CRC32_PCLMUL_TARGET]] uint32_t Crc32Pclmul(const uint8_t* data,
+                                                        size_t size_bytes,
+                                                        uint32_t state) {
+  const __m128i k1k2 = _mm_set_epi64x(0x01c6e41596, 0x0154442bd4);
+  const __m128i k3k4 = _mm_set_epi64x(0x00ccaa009e, 0x01751997d0);
+  const __m128i k5k0 = _mm_set_epi64x(0x0000000000, 0x0163cd6124);
+  const __m128i poly = _mm_set_epi64x(0x01f7011641, 0x01db710641);
+  const __m128i low_32_mask = _mm_setr_epi32(~0, 0, ~0, 0);
+
+  __m128i x1 = _mm_xor_si128(Load128(data),
+                             _mm_cvtsi32_si128(static_cast<int>(state)));
+  __m128i x2 = Load128(data + 16);
+  __m128i x3 = Load128(data + 32);
+  __m128i x4 = Load128(data + 48);
+  data += 64;
+  size_bytes -= 64;
+
+  // Fold four 128-bit lanes in parallel, 64 bytes at a time.
+  for (; size_bytes >= 64; size_bytes -= 64, data += 64) {
+    x1 = Fold128(x1, Load128(data), k1k2);
+    x2 = Fold128(x2, Load128(data + 16), k1k2);
+    x3 = Fold128(x3, Load128(data + 32), k1k2);
+    x4 = Fold128(x4, Load128(data + 48), k1k2);
+  }
+
+  // Fold the four lanes into one, then fold in any remaining 16-byte blocks.
+  x1 = Fold128(x1, x2, k3k4);
+  x1 = Fold128(x1, x3, k3k4);
+  x1 = Fold128(x1, x4, k3k4);
+  for (; size_bytes >= 16; size_bytes -= 16, data += 16) {
+    x1 = Fold128(x1, Load128(data), k3k4);
+  }
+
+  // Fold 128 bits to 64 bits.
+  x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+  x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+  x2 = _mm_srli_si128(x1, 4);
+  x1 = _mm_and_si128(x1, low_32_mask);
+  x1 = _mm_clmulepi64_si128(x1, k5k0, 0x00);
+  x1 = _mm_xor_si128(x1, x2);
+
+  // Barrett reduction to 32 bits.
+  x2 = _mm_and_si128(x1, low_32_mask);
+  x2 = _mm_clmulepi64_si128(x2, poly, 0x10);
+  x2 = _mm_and_si128(x2, low_32_mask);
+  x2 = _mm_clmulepi64_si128(x2, poly, 0x00);
+  x1 = _mm_xor_si128(x1, x2);
+
+  return static_cast<uint32_t>(_mm_extract_epi32(x1, 1));
+}
+
+bool CpuSupportsPclmul() {
+  static const bool supported =
+      __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1");
+  return supported;
+}
+
+#undef _PW_CHECKSUM_CRC32_PCLMUL_TARGET
+
+#endif  // _PW_CHECKSUM_CRC32_HAS_PCLMUL
+
 }  // namespace
 
+extern "C" uint32_t _pw_checksum_InternalCrc32Hardware(const void* data,
+                                                       size_t size_bytes,
+                                                       uint32_t state) {
+  const uint8_t* data_bytes = static_cast<const uint8_t*>(data);
+
+#if _PW_CHECKSUM_CRC32_HAS_ARM_CRC32
+  for (; size_bytes >= sizeof(uint64_t); size_bytes -= sizeof(uint64_t)) {
+    uint64_t word;
+    std::memcpy(&word, data_bytes, sizeof(word));
+    state = __crc32d(state, word);
+    data_bytes += sizeof(word);
+  }
+  for (; size_bytes > 0; --size_bytes) {
+    state = __crc32b(state, *data_bytes++);
+  }
+  return state;
+#else
+#if _PW_CHECKSUM_CRC32_HAS_PCLMUL
+  // Short buffers are faster with tables than with the fold setup and final
+  // reduction.
+  if (size_bytes >= 64 && CpuSupportsPclmul()) {
+    const size_t folded_bytes = size_bytes & ~size_t{15};
+    state = Crc32Pclmul(data_bytes, folded_bytes, state);
+    data_bytes += folded_bytes;
+    size_bytes -= folded_bytes;
+  }
+#endif  // _PW_CHECKSUM_CRC32_HAS_PCLMUL
+  return Crc32SliceBy<8>(data_bytes, size_bytes, state);
+#endif  // _PW_CHECKSUM_CRC32_HAS_ARM_CRC32
+}
+
+extern "C" uint32_t _pw_checksum_InternalCrc32SliceBy16(const void* data,
+                                                        size_t size_bytes,
+                                                        uint32_t state) {
+  return Crc32SliceBy<16>(static_cast<const uint8_t*>(data), size_bytes, state);
+}
+
+extern "C" uint32_t _pw_checksum_InternalCrc32SliceBy8(const void* data,
+                                                       size_t size_bytes,
+                                                       uint32_t state) {
+  return Crc32SliceBy<8>(static_cast<const uint8_t*>(data), size_bytes, state);
+}
+
 extern "C" uint32_t _pw_checksum_InternalCrc32EightBit(const void* data,
                                                        size_t size_bytes,
                                                        uint32_t state) {
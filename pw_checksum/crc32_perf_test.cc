@@ -12,6 +12,8 @@
 // License for the specific language governing permissions and limitations under
 // the License.
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <string_view>
 
@@ -46,13 +48,77 @@ void Crc32EightBitTest(perf_test::State& state, span<const std::byte> data) {
   }
 }
 
+void Crc32SliceBy8Test(perf_test::State& state, span<const std::byte> data) {
+  while (state.KeepRunning()) {
+    Crc32SliceBy8::Calculate(data);
+  }
+}
+
+void Crc32SliceBy16Test(perf_test::State& state, span<const std::byte> data) {
+  while (state.KeepRunning()) {
+    Crc32SliceBy16::Calculate(data);
+  }
+}
+
+void Crc32HardwareTest(perf_test::State& state, span<const std::byte> data) {
+  while (state.KeepRunning()) {
+    Crc32Hardware::Calculate(data);
+  }
+}
+
+// Larger buffers, representative of HDLC frames and KVS entries, show where
+// the multi-byte kernels overtake the byte-at-a-time ones.
+const std::array<std::byte, 4096> kLargeBuffer = [] {
+  std::array<std::byte, 4096> buffer{};
+  for (size_t i = 0; i < buffer.size(); ++i) {
+    buffer[i] = static_cast<std::byte>(i * 31 + 7);
+  }
+  return buffer;
+}();
+
+span<const std::byte> Buffer(size_t size) {
+  return span<const std::byte>(kLargeBuffer).first(size);
+}
+
 PW_PERF_TEST(CrcOneBitStringTest, Crc32OneBitTest, as_bytes(span(kString)));
 PW_PERF_TEST(CrcFourBitStringTest, Crc32FourBitTest, as_bytes(span(kString)));
 PW_PERF_TEST(CrcEightBitStringTest, Crc32EightBitTest, as_bytes(span(kString)));
+PW_PERF_TEST(CrcSliceBy8StringTest, Crc32SliceBy8Test, as_bytes(span(kString)));
+PW_PERF_TEST(CrcSliceBy16StringTest,
+             Crc32SliceBy16Test,
+             as_bytes(span(kString)));
+PW_PERF_TEST(CrcHardwareStringTest, Crc32HardwareTest, as_bytes(span(kString)));
 
 PW_PERF_TEST(CrcOneBitBytesTest, Crc32OneBitTest, kBytes);
 PW_PERF_TEST(CrcFourBitBytesTest, Crc32FourBitTest, kBytes);
 PW_PERF_TEST(CrcEightBitBytesTest, Crc32EightBitTest, kBytes);
+PW_PERF_TEST(CrcSliceBy8BytesTest, Crc32SliceBy8Test, kBytes);
+PW_PERF_TEST(CrcSliceBy16BytesTest, Crc32SliceBy16Test, kBytes);
+PW_PERF_TEST(CrcHardwareBytesTest, Crc32HardwareTest, kBytes);
+
+PW_PERF_TEST(CrcFourBit64BytesTest, Crc32FourBitTest, Buffer(64));
+PW_PERF_TEST(CrcEightBit64BytesTest, Crc32EightBitTest, Buffer(64));
+PW_PERF_TEST(CrcSliceBy8_64BytesTest, Crc32SliceBy8Test, Buffer(64));
+PW_PERF_TEST(CrcSliceBy16_64BytesTest, Crc32SliceBy16Test, Buffer(64));
+PW_PERF_TEST(CrcHardware64BytesTest, Crc32HardwareTest, Buffer(64));
+
+PW_PERF_TEST(CrcFourBit256BytesTest, Crc32FourBitTest, Buffer(256));
+PW_PERF_TEST(CrcEightBit256BytesTest, Crc32EightBitTest, Buffer(256));
+PW_PERF_TEST(CrcSliceBy8_256BytesTest, Crc32SliceBy8Test, Buffer(256));
+PW_PERF_TEST(CrcSliceBy16_256BytesTest, Crc32SliceBy16Test, Buffer(256));
+PW_PERF_TEST(CrcHardware256BytesTest, Crc32HardwareTest, Buffer(256));
+
+PW_PERF_TEST(CrcFourBit1KiBTest, Crc32FourBitTest, Buffer(1024));
+PW_PERF_TEST(CrcEightBit1KiBTest, Crc32EightBitTest, Buffer(1024));
+PW_PERF_TEST(CrcSliceBy8_1KiBTest, Crc32SliceBy8Test, Buffer(1024));
+PW_PERF_TEST(CrcSliceBy16_1KiBTest, Crc32SliceBy16Test, Buffer(1024));
+PW_PERF_TEST(CrcHardware1KiBTest, Crc32HardwareTest, Buffer(1024));
+
+PW_PERF_TEST(CrcFourBit4KiBTest, Crc32FourBitTest, Buffer(4096));
+PW_PERF_TEST(CrcEightBit4KiBTest, Crc32EightBitTest, Buffer(4096));
+PW_PERF_TEST(CrcSliceBy8_4KiBTest, Crc32SliceBy8Test, Buffer(4096));
+PW_PERF_TEST(CrcSliceBy16_4KiBTest, Crc32SliceBy16Test, Buffer(4096));
+PW_PERF_TEST(CrcHardware4KiBTest, Crc32HardwareTest, Buffer(4096));
 
 }  // namespace
 }  // namespace pw::checksum
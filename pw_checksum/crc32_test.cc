@@ -13,6 +13,8 @@
 // the License.
 #include "pw_checksum/crc32.h"
 
+#include <algorithm>
+#include <array>
 #include <string_view>
 
 #include "pw_bytes/array.h"
@@ -46,6 +48,12 @@ TEST(Crc32, Empty) {
   EXPECT_EQ(Crc32FourBit::Calculate(span<std::byte>()),
             PW_CHECKSUM_EMPTY_CRC32);
   EXPECT_EQ(Crc32OneBit::Calculate(span<std::byte>()), PW_CHECKSUM_EMPTY_CRC32);
+  EXPECT_EQ(Crc32SliceBy8::Calculate(span<std::byte>()),
+            PW_CHECKSUM_EMPTY_CRC32);
+  EXPECT_EQ(Crc32SliceBy16::Calculate(span<std::byte>()),
+            PW_CHECKSUM_EMPTY_CRC32);
+  EXPECT_EQ(Crc32Hardware::Calculate(span<std::byte>()),
+            PW_CHECKSUM_EMPTY_CRC32);
 }
 
 TEST(Crc32, Buffer) {
@@ -53,6 +61,9 @@ TEST(Crc32, Buffer) {
   EXPECT_EQ(Crc32EightBit::Calculate(as_bytes(span(kBytes))), kBufferCrc);
   EXPECT_EQ(Crc32FourBit::Calculate(as_bytes(span(kBytes))), kBufferCrc);
   EXPECT_EQ(Crc32OneBit::Calculate(as_bytes(span(kBytes))), kBufferCrc);
+  EXPECT_EQ(Crc32SliceBy8::Calculate(as_bytes(span(kBytes))), kBufferCrc);
+  EXPECT_EQ(Crc32SliceBy16::Calculate(as_bytes(span(kBytes))), kBufferCrc);
+  EXPECT_EQ(Crc32Hardware::Calculate(as_bytes(span(kBytes))), kBufferCrc);
 }
 
 TEST(Crc32, String) {
@@ -60,6 +71,9 @@ TEST(Crc32, String) {
   EXPECT_EQ(Crc32EightBit::Calculate(as_bytes(span(kString))), kStringCrc);
   EXPECT_EQ(Crc32FourBit::Calculate(as_bytes(span(kString))), kStringCrc);
   EXPECT_EQ(Crc32OneBit::Calculate(as_bytes(span(kString))), kStringCrc);
+  EXPECT_EQ(Crc32SliceBy8::Calculate(as_bytes(span(kString))), kStringCrc);
+  EXPECT_EQ(Crc32SliceBy16::Calculate(as_bytes(span(kString))), kStringCrc);
+  EXPECT_EQ(Crc32Hardware::Calculate(as_bytes(span(kString))), kStringCrc);
 }
 
 template <typename CrcVariant>
@@ -76,6 +90,9 @@ TEST(Crc32Class, ByteByByte) {
   TestByByte<Crc32EightBit>();
   TestByByte<Crc32FourBit>();
   TestByByte<Crc32OneBit>();
+  TestByByte<Crc32SliceBy8>();
+  TestByByte<Crc32SliceBy16>();
+  TestByByte<Crc32Hardware>();
 }
 
 template <typename CrcVariant>
@@ -90,6 +107,9 @@ TEST(Crc32Class, Buffer) {
   TestBuffer<Crc32EightBit>();
   TestBuffer<Crc32FourBit>();
   TestBuffer<Crc32OneBit>();
+  TestBuffer<Crc32SliceBy8>();
+  TestBuffer<Crc32SliceBy16>();
+  TestBuffer<Crc32Hardware>();
 }
 
 template <typename CrcVariant>
@@ -105,6 +125,9 @@ TEST(Crc32Class, BufferAppend) {
   TestBufferAppend<Crc32EightBit>();
   TestBufferAppend<Crc32FourBit>();
   TestBufferAppend<Crc32OneBit>();
+  TestBufferAppend<Crc32SliceBy8>();
+  TestBufferAppend<Crc32SliceBy16>();
+  TestBufferAppend<Crc32Hardware>();
 }
 
 template <typename CrcVariant>
@@ -119,6 +142,65 @@ TEST(Crc32Class, String) {
   TestString<Crc32EightBit>();
   TestString<Crc32FourBit>();
   TestString<Crc32OneBit>();
+  TestString<Crc32SliceBy8>();
+  TestString<Crc32SliceBy16>();
+  TestString<Crc32Hardware>();
+}
+
+// Fills a buffer with a deterministic, non-repeating byte pattern. The
+// multi-byte kernels must match the byte-at-a-time kernel for every length and
+// alignment, including buffers that do not fill a whole block.
+template <size_t kSize>
+std::array<std::byte, kSize> MakePattern() {
+  std::array<std::byte, kSize> data;
+  uint32_t value = 0x12345678;
+  for (std::byte& b : data) {
+    value = value * 1103515245u + 12345u;
+    b = static_cast<std::byte>(value >> 24);
+  }
+  return data;
+}
+
+template <typename CrcVariant>
+void TestMatchesEightBit() {
+  const auto data = MakePattern<4096 + 64>();
+  for (size_t offset = 0; offset < 16; ++offset) {
+    for (size_t size = 0; size < 300; ++size) {
+      const auto chunk = span(data).subspan(offset, size);
+      ASSERT_EQ(CrcVariant::Calculate(chunk), Crc32EightBit::Calculate(chunk))
+          << "offset " << offset << ", size " << size;
+    }
+  }
+  const auto large = span(data).subspan(3, 4096 + 13);
+  EXPECT_EQ(CrcVariant::Calculate(large), Crc32EightBit::Calculate(large));
+}
+
+template <typename CrcVariant>
+void TestMatchesEightBitInPieces() {
+  const auto data = MakePattern<4096>();
+  CrcVariant crc32;
+  size_t piece = 1;
+  for (size_t offset = 0; offset < data.size(); offset += piece, piece += 7) {
+    crc32.Update(span(data).subspan(offset,
+                                    std::min(piece, data.size() - offset)));
+  }
+  EXPECT_EQ(crc32.value(), Crc32EightBit::Calculate(data));
+}
+
+TEST(Crc32Class, MatchesEightBit) {
+  TestMatchesEightBit<Crc32>();
+  TestMatchesEightBit<Crc32FourBit>();
+  TestMatchesEightBit<Crc32SliceBy8>();
+  TestMatchesEightBit<Crc32SliceBy16>();
+  TestMatchesEightBit<Crc32Hardware>();
+}
+
+TEST(Crc32Class, MatchesEightBitInPieces) {
+  TestMatchesEightBitInPieces<Crc32>();
+  TestMatchesEightBitInPieces<Crc32FourBit>();
+  TestMatchesEightBitInPieces<Crc32SliceBy8>();
+  TestMatchesEightBitInPieces<Crc32SliceBy16>();
+  TestMatchesEightBitInPieces<Crc32Hardware>();
 }
 
 extern "C" uint32_t CallChecksumCrc32(const void* data, size_t size_bytes);
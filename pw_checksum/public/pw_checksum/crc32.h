@@ -45,6 +45,15 @@ uint32_t _pw_checksum_InternalCrc32FourBit(const void* data,
 uint32_t _pw_checksum_InternalCrc32OneBit(const void* data,
                                           size_t size_bytes,
                                           uint32_t state);
+uint32_t _pw_checksum_InternalCrc32SliceBy8(const void* data,
+                                            size_t size_bytes,
+                                            uint32_t state);
+uint32_t _pw_checksum_InternalCrc32SliceBy16(const void* data,
+                                             size_t size_bytes,
+                                             uint32_t state);
+uint32_t _pw_checksum_InternalCrc32Hardware(const void* data,
+                                            size_t size_bytes,
+                                            uint32_t state);
 
 #if PW_CHECKSUM_CRC32_DEFAULT_IMPL == PW_CHECKSUM_CRC32_8BITS
 #define _pw_checksum_InternalCrc32 _pw_checksum_InternalCrc32EightBit
@@ -52,6 +61,12 @@ uint32_t _pw_checksum_InternalCrc32OneBit(const void* data,
 #define _pw_checksum_InternalCrc32 _pw_checksum_InternalCrc32FourBit
 #elif PW_CHECKSUM_CRC32_DEFAULT_IMPL == PW_CHECKSUM_CRC32_1BITS
 #define _pw_checksum_InternalCrc32 _pw_checksum_InternalCrc32OneBit
+#elif PW_CHECKSUM_CRC32_DEFAULT_IMPL == PW_CHECKSUM_CRC32_SLICE_BY_8
+#define _pw_checksum_InternalCrc32 _pw_checksum_InternalCrc32SliceBy8
+#elif PW_CHECKSUM_CRC32_DEFAULT_IMPL == PW_CHECKSUM_CRC32_SLICE_BY_16
+#define _pw_checksum_InternalCrc32 _pw_checksum_InternalCrc32SliceBy16
+#elif PW_CHECKSUM_CRC32_DEFAULT_IMPL == PW_CHECKSUM_CRC32_HARDWARE
+#define _pw_checksum_InternalCrc32 _pw_checksum_InternalCrc32Hardware
 #endif
 
 // Calculates the CRC32 for the provided data.
@@ -117,6 +132,9 @@ using Crc32 = Crc32Impl<_pw_checksum_InternalCrc32>;
 using Crc32EightBit = Crc32Impl<_pw_checksum_InternalCrc32EightBit>;
 using Crc32FourBit = Crc32Impl<_pw_checksum_InternalCrc32FourBit>;
 using Crc32OneBit = Crc32Impl<_pw_checksum_InternalCrc32OneBit>;
+using Crc32SliceBy8 = Crc32Impl<_pw_checksum_InternalCrc32SliceBy8>;
+using Crc32SliceBy16 = Crc32Impl<_pw_checksum_InternalCrc32SliceBy16>;
+using Crc32Hardware = Crc32Impl<_pw_checksum_InternalCrc32Hardware>;
 
 }  // namespace pw::checksum
 
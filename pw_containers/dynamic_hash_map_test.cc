@@ -0,0 +1,335 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_containers/dynamic_hash_map.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_allocator/fault_injecting_allocator.h"
+#include "pw_allocator/null_allocator.h"
+#include "pw_allocator/testing.h"
+#include "pw_containers/internal/test_helpers.h"
+#include "pw_polyfill/language_feature_macros.h"
+#include "pw_unit_test/framework.h"
+
+namespace {
+
+using pw::containers::test::Counter;
+using pw::containers::test::MoveOnly;
+
+PW_CONSTINIT pw::allocator::NullAllocator null_allocator;
+PW_CONSTINIT const pw::DynamicHashMap<int, int> kEmpty(null_allocator);
+
+/// Hashes every key to the same value, so that every lookup must compare keys.
+struct CollidingHash {
+  size_t operator()(int) const { return 42; }
+};
+
+class DynamicHashMapTest : public ::testing::Test {
+ protected:
+  DynamicHashMapTest() : allocator_(allocator_for_test_) {}
+
+  pw::allocator::test::AllocatorForTest<2048> allocator_for_test_;
+  pw::allocator::test::FaultInjectingAllocator allocator_;
+};
+
+TEST(DynamicHashMap, Constinit) {
+  EXPECT_TRUE(kEmpty.empty());
+  EXPECT_EQ(kEmpty.size(), 0u);
+  EXPECT_EQ(kEmpty.capacity(), 0u);
+  EXPECT_EQ(kEmpty.find(1), kEmpty.end());
+  EXPECT_FALSE(kEmpty.contains(1));
+
+  for (const auto& unused : kEmpty) {
+    ADD_FAILURE() << unused.first;
+  }
+}
+
+TEST_F(DynamicHashMapTest, Construct_DoesNotAllocate) {
+  pw::DynamicHashMap<int, int> map(allocator_);
+  EXPECT_EQ(allocator_for_test_.GetAllocated(), 0u);
+  EXPECT_EQ(map.begin(), map.end());
+}
+
+TEST_F(DynamicHashMapTest, Insert_Find) {
+  pw::DynamicHashMap<int, int> map(allocator_);
+  for (int i = 0; i < 50; ++i) {
+    auto [iter, inserted] = map.insert({i, i * 2});
+    EXPECT_TRUE(inserted);
+    EXPECT_EQ(iter->first, i);
+    EXPECT_EQ(iter->second, i * 2);
+  }
+  EXPECT_EQ(map.size(), 50u);
+  EXPECT_GE(map.capacity(), 50u);
+
+  for (int i = 0; i < 50; ++i) {
+    auto iter = map.find(i);
+    ASSERT_NE(iter, map.end());
+    EXPECT_EQ(iter->second, i * 2);
+    EXPECT_EQ(map.at(i), i * 2);
+    EXPECT_EQ(map.count(i), 1u);
+  }
+  EXPECT_EQ(map.find(50), map.end());
+  EXPECT_FALSE(map.contains(-1));
+}
+
+TEST_F(DynamicHashMapTest, Insert_ExistingKey) {
+  pw::DynamicHashMap<int, int> map(allocator_);
+  EXPECT_TRUE(map.insert({1, 10}).second);
+
+  auto [iter, inserted] = map.insert({1, 20});
+  EXPECT_FALSE(inserted);
+  EXPECT_EQ(iter->second, 10);
+  EXPECT_EQ(map.size(), 1u);
+}
+
+TEST_F(DynamicHashMapTest, Emplace_DoesNotConstructIfPresent) {
+  pw::DynamicHashMap<int, Counter> map(allocator_);
+  map.emplace(1, 10);
+  Counter::Reset();
+
+  auto [iter, inserted] = map.emplace(1, 20);
+  EXPECT_FALSE(inserted);
+  EXPECT_EQ(iter->second, 10);
+  EXPECT_EQ(Counter::created, 0);
+}
+
+TEST_F(DynamicHashMapTest, Emplace_MoveOnly) {
+  pw::DynamicHashMap<int, MoveOnly> map(allocator_);
+  for (int i = 0; i < 20; ++i) {
+    map.emplace(i, MoveOnly(i));
+  }
+  for (int i = 0; i < 20; ++i) {
+    EXPECT_EQ(map.at(i).value, i);
+  }
+}
+
+TEST_F(DynamicHashMapTest, OperatorBrackets) {
+  pw::DynamicHashMap<int, int> map(allocator_);
+  map[1] = 10;
+  map[2] += 5;
+  map[1] += 1;
+  EXPECT_EQ(map.size(), 2u);
+  EXPECT_EQ(map.at(1), 11);
+  EXPECT_EQ(map.at(2), 5);
+}
+
+TEST_F(DynamicHashMapTest, Iterate_VisitsEachElementOnce) {
+  pw::DynamicHashMap<int, int> map(allocator_);
+  for (int i = 0; i < 50; ++i) {
+    map[i] = i;
+  }
+  int sum = 0;
+  size_t count = 0;
+  for (const auto& [key, value] : map) {
+    EXPECT_EQ(key, value);
+    sum += key;
+    ++count;
+  }
+  EXPECT_EQ(count, 50u);
+  EXPECT_EQ(sum, 49 * 50 / 2);
+}
+
+TEST_F(DynamicHashMapTest, Erase_ByKey) {
+  pw::DynamicHashMap<int, int> map(allocator_);
+  for (int i = 0; i < 20; ++i) {
+    map[i] = i;
+  }
+  EXPECT_EQ(map.erase(5), 1u);
+  EXPECT_EQ(map.erase(5), 0u);
+  EXPECT_EQ(map.size(), 19u);
+  EXPECT_FALSE(map.contains(5));
+  for (int i = 0; i < 20; ++i) {
+    EXPECT_EQ(map.contains(i), i != 5);
+  }
+}
+
+TEST_F(DynamicHashMapTest, Erase_WhileIterating) {
+  pw::DynamicHashMap<int, int> map(allocator_);
+  for (int i = 0; i < 40; ++i) {
+    map[i] = i;
+  }
+  for (auto iter = map.begin(); iter != map.end();) {
+    if (iter->first % 2 == 0) {
+      iter = map.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+  EXPECT_EQ(map.size(), 20u);
+  for (const auto& item : map) {
+    EXPECT_EQ(item.first % 2, 1);
+  }
+}
+
+TEST_F(DynamicHashMapTest, Erase_ReusesSlots) {
+  pw::DynamicHashMap<int, int> map(allocator_);
+  for (int i = 0; i < 16; ++i) {
+    map[i] = i;
+  }
+  size_t capacity = map.capacity();
+
+  // Repeatedly replacing elements with new keys must not grow the map.
+  for (int i = 16; i < 1000; ++i) {
+    EXPECT_EQ(map.erase(i - 16), 1u);
+    map[i] = i;
+    ASSERT_EQ(map.capacity(), capacity);
+  }
+  EXPECT_EQ(map.size(), 16u);
+  for (int i = 1000 - 16; i < 1000; ++i) {
+    EXPECT_EQ(map.at(i), i);
+  }
+}
+
+TEST_F(DynamicHashMapTest, Collisions) {
+  pw::DynamicHashMap<int, int, CollidingHash> map(allocator_);
+  for (int i = 0; i < 30; ++i) {
+    map[i] = -i;
+  }
+  for (int i = 0; i < 30; i += 3) {
+    EXPECT_EQ(map.erase(i), 1u);
+  }
+  for (int i = 0; i < 30; ++i) {
+    auto iter = map.find(i);
+    if (i % 3 == 0) {
+      EXPECT_EQ(iter, map.end());
+    } else {
+      ASSERT_NE(iter, map.end());
+      EXPECT_EQ(iter->second, -i);
+    }
+  }
+}
+
+TEST_F(DynamicHashMapTest, Clear) {
+  pw::DynamicHashMap<int, Counter> map(allocator_);
+  for (int i = 0; i < 10; ++i) {
+    map.emplace(i, i);
+  }
+  size_t capacity = map.capacity();
+  Counter::Reset();
+  map.clear();
+  EXPECT_EQ(Counter::destroyed, 10);
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.capacity(), capacity);
+  EXPECT_EQ(map.begin(), map.end());
+}
+
+TEST_F(DynamicHashMapTest, Destructor_DestroysElementsAndFreesMemory) {
+  {
+    pw::DynamicHashMap<int, Counter> map(allocator_);
+    for (int i = 0; i < 10; ++i) {
+      map.emplace(i, i);
+    }
+    EXPECT_NE(allocator_for_test_.GetAllocated(), 0u);
+    Counter::Reset();
+  }
+  EXPECT_EQ(Counter::destroyed, 10);
+  EXPECT_EQ(allocator_for_test_.GetAllocated(), 0u);
+}
+
+TEST_F(DynamicHashMapTest, AllocationFailure) {
+  allocator_.DisableAll();
+  pw::DynamicHashMap<int, int> map(allocator_);
+
+  auto [iter, inserted] = map.try_insert({1, 1});
+  EXPECT_EQ(iter, map.end());
+  EXPECT_FALSE(inserted);
+  EXPECT_FALSE(map.try_reserve(10));
+
+  allocator_.EnableAll();
+  EXPECT_TRUE(map.try_emplace(1, 1).second);
+
+  // Fill to capacity, then fail to grow.
+  allocator_.DisableAll();
+  for (int i = 2; map.size() < map.capacity(); ++i) {
+    ASSERT_TRUE(map.try_emplace(i, i).second);
+  }
+  size_t size = map.size();
+  EXPECT_EQ(map.try_emplace(-1, -1).first, map.end());
+  EXPECT_EQ(map.size(), size);
+
+  allocator_.EnableAll();
+  EXPECT_TRUE(map.try_emplace(-1, -1).second);
+  for (int i = 1; i < static_cast<int>(size); ++i) {
+    EXPECT_EQ(map.at(i), i);
+  }
+}
+
+TEST_F(DynamicHashMapTest, Reserve) {
+  pw::DynamicHashMap<int, int> map(allocator_);
+  map.reserve(20);
+  EXPECT_GE(map.capacity(), 20u);
+  size_t allocated = allocator_for_test_.GetAllocated();
+
+  for (int i = 0; i < 20; ++i) {
+    map[i] = i;
+  }
+  EXPECT_EQ(allocator_for_test_.GetAllocated(), allocated);
+}
+
+TEST_F(DynamicHashMapTest, ShrinkToFit) {
+  pw::DynamicHashMap<int, int> map(allocator_);
+  for (int i = 0; i < 50; ++i) {
+    map[i] = i;
+  }
+  for (int i = 4; i < 50; ++i) {
+    map.erase(i);
+  }
+  size_t capacity = map.capacity();
+  map.shrink_to_fit();
+  EXPECT_LT(map.capacity(), capacity);
+  EXPECT_GE(map.capacity(), 4u);
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_EQ(map.at(i), i);
+  }
+
+  map.clear();
+  map.shrink_to_fit();
+  EXPECT_EQ(map.capacity(), 0u);
+  EXPECT_EQ(allocator_for_test_.GetAllocated(), 0u);
+}
+
+TEST_F(DynamicHashMapTest, Move) {
+  pw::DynamicHashMap<int, int> map1(allocator_);
+  map1[1] = 1;
+  map1[2] = 2;
+
+  pw::DynamicHashMap<int, int> map2(std::move(map1));
+  EXPECT_EQ(map2.size(), 2u);
+  EXPECT_EQ(map2.at(2), 2);
+
+  pw::DynamicHashMap<int, int> map3(allocator_);
+  map3[3] = 3;
+  map3 = std::move(map2);
+  EXPECT_EQ(map3.size(), 2u);
+  EXPECT_FALSE(map3.contains(3));
+  EXPECT_EQ(map3.at(1), 1);
+}
+
+TEST_F(DynamicHashMapTest, Swap) {
+  pw::DynamicHashMap<int, int> map1(allocator_);
+  pw::DynamicHashMap<int, int> map2(allocator_);
+  map1[1] = 1;
+  map2[2] = 2;
+  map2[3] = 3;
+
+  map1.swap(map2);
+  EXPECT_EQ(map1.size(), 2u);
+  EXPECT_EQ(map2.size(), 1u);
+  EXPECT_EQ(map1.at(3), 3);
+  EXPECT_EQ(map2.at(1), 1);
+}
+
+}  // namespace
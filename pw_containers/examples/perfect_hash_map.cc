@@ -0,0 +1,62 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_containers/perfect_hash_map.h"
+
+#include <string_view>
+
+#include "pw_unit_test/framework.h"
+
+namespace examples {
+
+// DOCSTAG: [pw_containers-perfect_hash_map]
+
+using pw::containers::Pair;
+using pw::containers::PerfectHashMap;
+
+// Initialized by an initializer list.
+constexpr PerfectHashMap<int, char, 2> kPerfectHashMap1({{
+    {1, 'a'},
+    {-3, 'b'},
+}});
+
+// Initialized by a std::array of Pair<K, V> objects.
+constexpr std::array<Pair<int, char>, 2> kArray{{
+    {1, 'a'},
+    {-3, 'b'},
+}};
+constexpr PerfectHashMap kPerfectHashMap2(kArray);
+
+// Initialized by Pair<K, V> objects.
+constexpr PerfectHashMap kPerfectHashMap3 = {
+    Pair<std::string_view, char>{"one", 'a'},
+    Pair<std::string_view, char>{"minus three", 'b'},
+};
+
+// DOCSTAG: [pw_containers-perfect_hash_map]
+
+}  // namespace examples
+
+namespace {
+
+TEST(PerfectHashMapExampleTest, CheckValues) {
+  EXPECT_EQ(examples::kPerfectHashMap1.at(1), 'a');
+  EXPECT_EQ(examples::kPerfectHashMap1.at(-3), 'b');
+  EXPECT_EQ(examples::kPerfectHashMap2.at(1), 'a');
+  EXPECT_EQ(examples::kPerfectHashMap2.at(-3), 'b');
+  EXPECT_EQ(examples::kPerfectHashMap3.at("one"), 'a');
+  EXPECT_EQ(examples::kPerfectHashMap3.at("minus three"), 'b');
+}
+
+}  // namespace
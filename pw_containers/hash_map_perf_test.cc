@@ -0,0 +1,174 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <unordered_map>
+
+#include "pw_allocator/libc_allocator.h"
+#include "pw_containers/dynamic_hash_map.h"
+#include "pw_containers/inline_hash_map.h"
+#include "pw_containers/intrusive_map.h"
+#include "pw_perf_test/perf_test.h"
+
+namespace pw::containers {
+namespace {
+
+// Compares inserting and finding keys using the open-addressing hash maps, a
+// tree-based intrusive map, and `std::unordered_map`, which allocates a node
+// per element.
+
+constexpr size_t kMaxKeys = 4096;
+
+struct Item : public IntrusiveMap<uint32_t, Item>::Pair {
+  using Pair = IntrusiveMap<uint32_t, Item>::Pair;
+  constexpr Item() : Pair(0) {}
+  explicit Item(uint32_t key) : Pair(key) {}
+};
+
+const std::array<uint32_t, kMaxKeys> kKeys = [] {
+  std::array<uint32_t, kMaxKeys> keys{};
+  uint32_t state = 1;
+  for (uint32_t& key : keys) {
+    state = state * 1664525u + 1013904223u;
+    key = state;
+  }
+  return keys;
+}();
+
+std::array<Item, kMaxKeys> items;
+
+void InitItems(size_t num_keys) {
+  for (size_t i = 0; i < num_keys; ++i) {
+    new (&items[i]) Item(kKeys[i]);
+  }
+}
+
+// Insertion benchmarks.
+
+void DynamicHashMapInsert(perf_test::State& state, size_t num_keys) {
+  DynamicHashMap<uint32_t, uint32_t> map(allocator::GetLibCAllocator());
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < num_keys; ++i) {
+      map.emplace(kKeys[i], static_cast<uint32_t>(i));
+    }
+    map.clear();
+  }
+}
+
+void InlineHashMapInsert(perf_test::State& state, size_t num_keys) {
+  static InlineHashMap<uint32_t, uint32_t, kMaxKeys> map;
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < num_keys; ++i) {
+      map.emplace(kKeys[i], static_cast<uint32_t>(i));
+    }
+    map.clear();
+  }
+}
+
+void IntrusiveMapInsert(perf_test::State& state, size_t num_keys) {
+  InitItems(num_keys);
+  IntrusiveMap<uint32_t, Item> map;
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < num_keys; ++i) {
+      map.insert(items[i]);
+    }
+    map.clear();
+  }
+}
+
+void UnorderedMapInsert(perf_test::State& state, size_t num_keys) {
+  std::unordered_map<uint32_t, uint32_t> map;
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < num_keys; ++i) {
+      map.emplace(kKeys[i], static_cast<uint32_t>(i));
+    }
+    map.clear();
+  }
+}
+
+// Lookup benchmarks. Half of the lookups are for keys that are not present.
+
+template <typename Map>
+void FindKeys(perf_test::State& state, const Map& map, size_t num_keys) {
+  volatile size_t found = 0;
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < num_keys; ++i) {
+      found = found + map.count(kKeys[i]) + map.count(kKeys[i] + 1);
+    }
+  }
+}
+
+void DynamicHashMapFind(perf_test::State& state, size_t num_keys) {
+  DynamicHashMap<uint32_t, uint32_t> map(allocator::GetLibCAllocator());
+  for (size_t i = 0; i < num_keys; ++i) {
+    map.emplace(kKeys[i], static_cast<uint32_t>(i));
+  }
+  FindKeys(state, map, num_keys);
+}
+
+void InlineHashMapFind(perf_test::State& state, size_t num_keys) {
+  static InlineHashMap<uint32_t, uint32_t, kMaxKeys> map;
+  map.clear();
+  for (size_t i = 0; i < num_keys; ++i) {
+    map.emplace(kKeys[i], static_cast<uint32_t>(i));
+  }
+  FindKeys(state, map, num_keys);
+}
+
+void IntrusiveMapFind(perf_test::State& state, size_t num_keys) {
+  InitItems(num_keys);
+  IntrusiveMap<uint32_t, Item> map(items.begin(), items.begin() + num_keys);
+  FindKeys(state, map, num_keys);
+  map.clear();
+}
+
+void UnorderedMapFind(perf_test::State& state, size_t num_keys) {
+  std::unordered_map<uint32_t, uint32_t> map;
+  for (size_t i = 0; i < num_keys; ++i) {
+    map.emplace(kKeys[i], static_cast<uint32_t>(i));
+  }
+  FindKeys(state, map, num_keys);
+}
+
+PW_PERF_TEST(DynamicHashMapInsert16, DynamicHashMapInsert, 16);
+PW_PERF_TEST(DynamicHashMapInsert256, DynamicHashMapInsert, 256);
+PW_PERF_TEST(DynamicHashMapInsert4096, DynamicHashMapInsert, 4096);
+PW_PERF_TEST(InlineHashMapInsert16, InlineHashMapInsert, 16);
+PW_PERF_TEST(InlineHashMapInsert256, InlineHashMapInsert, 256);
+PW_PERF_TEST(InlineHashMapInsert4096, InlineHashMapInsert, 4096);
+PW_PERF_TEST(IntrusiveMapInsert16, IntrusiveMapInsert, 16);
+PW_PERF_TEST(IntrusiveMapInsert256, IntrusiveMapInsert, 256);
+PW_PERF_TEST(IntrusiveMapInsert4096, IntrusiveMapInsert, 4096);
+PW_PERF_TEST(UnorderedMapInsert16, UnorderedMapInsert, 16);
+PW_PERF_TEST(UnorderedMapInsert256, UnorderedMapInsert, 256);
+PW_PERF_TEST(UnorderedMapInsert4096, UnorderedMapInsert, 4096);
+
+PW_PERF_TEST(DynamicHashMapFind16, DynamicHashMapFind, 16);
+PW_PERF_TEST(DynamicHashMapFind256, DynamicHashMapFind, 256);
+PW_PERF_TEST(DynamicHashMapFind4096, DynamicHashMapFind, 4096);
+PW_PERF_TEST(InlineHashMapFind16, InlineHashMapFind, 16);
+PW_PERF_TEST(InlineHashMapFind256, InlineHashMapFind, 256);
+PW_PERF_TEST(InlineHashMapFind4096, InlineHashMapFind, 4096);
+PW_PERF_TEST(IntrusiveMapFind16, IntrusiveMapFind, 16);
+PW_PERF_TEST(IntrusiveMapFind256, IntrusiveMapFind, 256);
+PW_PERF_TEST(IntrusiveMapFind4096, IntrusiveMapFind, 4096);
+PW_PERF_TEST(UnorderedMapFind16, UnorderedMapFind, 16);
+PW_PERF_TEST(UnorderedMapFind256, UnorderedMapFind, 256);
+PW_PERF_TEST(UnorderedMapFind4096, UnorderedMapFind, 4096);
+
+}  // namespace
+}  // namespace pw::containers
@@ -0,0 +1,155 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_containers/inline_hash_map.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "pw_containers/internal/test_helpers.h"
+#include "pw_unit_test/framework.h"
+
+namespace {
+
+using pw::containers::test::Counter;
+
+TEST(InlineHashMap, Construct_Empty) {
+  pw::InlineHashMap<int, int, 10> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.capacity(), 10u);
+  EXPECT_EQ(map.max_size(), 10u);
+  EXPECT_EQ(map.begin(), map.end());
+  EXPECT_FALSE(map.contains(0));
+}
+
+TEST(InlineHashMap, Construct_InitializerList) {
+  pw::InlineHashMap<std::string_view, int, 4> map = {
+      {"one", 1}, {"two", 2}, {"three", 3}};
+  EXPECT_EQ(map.size(), 3u);
+  EXPECT_EQ(map.at("one"), 1);
+  EXPECT_EQ(map.at("two"), 2);
+  EXPECT_EQ(map.at("three"), 3);
+  EXPECT_FALSE(map.contains("four"));
+}
+
+TEST(InlineHashMap, FillToCapacity) {
+  pw::InlineHashMap<int, int, 20> map;
+  for (int i = 0; i < 20; ++i) {
+    ASSERT_TRUE(map.try_emplace(i, i).second);
+  }
+  EXPECT_EQ(map.size(), 20u);
+
+  auto [iter, inserted] = map.try_emplace(20, 20);
+  EXPECT_EQ(iter, map.end());
+  EXPECT_FALSE(inserted);
+
+  // Existing keys can still be found.
+  auto result = map.try_emplace(19, 0);
+  ASSERT_NE(result.first, map.end());
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ(result.first->second, 19);
+}
+
+TEST(InlineHashMap, SmallCapacities) {
+  pw::InlineHashMap<int, int, 1> map1;
+  EXPECT_TRUE(map1.try_emplace(1, 1).second);
+  EXPECT_FALSE(map1.try_emplace(2, 2).second);
+  EXPECT_EQ(map1.erase(1), 1u);
+  EXPECT_TRUE(map1.try_emplace(2, 2).second);
+
+  pw::InlineHashMap<int, int, 3> map3;
+  for (int i = 0; i < 100; ++i) {
+    map3.erase(i - 3);
+    ASSERT_TRUE(map3.try_emplace(i, i).second);
+  }
+  EXPECT_EQ(map3.size(), 3u);
+}
+
+TEST(InlineHashMap, Erase_ReclaimsTombstones) {
+  pw::InlineHashMap<int, int, 50> map;
+  for (int i = 0; i < 50; ++i) {
+    map[i] = i;
+  }
+
+  // Erasing from a full table leaves tombstones, which must be reclaimed to
+  // keep inserting new keys.
+  for (int i = 50; i < 2000; ++i) {
+    ASSERT_EQ(map.erase(i - 50), 1u);
+    ASSERT_TRUE(map.try_emplace(i, i).second);
+  }
+  EXPECT_EQ(map.size(), 50u);
+  for (int i = 2000 - 50; i < 2000; ++i) {
+    EXPECT_EQ(map.at(i), i);
+  }
+  size_t count = 0;
+  for (const auto& item : map) {
+    EXPECT_EQ(item.first, item.second);
+    ++count;
+  }
+  EXPECT_EQ(count, 50u);
+}
+
+TEST(InlineHashMap, Erase_WhileIterating) {
+  pw::InlineHashMap<int, int, 16> map;
+  for (int i = 0; i < 16; ++i) {
+    map[i] = i;
+  }
+  for (auto iter = map.begin(); iter != map.end();) {
+    iter = iter->first < 8 ? map.erase(iter) : std::next(iter);
+  }
+  EXPECT_EQ(map.size(), 8u);
+  for (int i = 0; i < 16; ++i) {
+    EXPECT_EQ(map.contains(i), i >= 8);
+  }
+}
+
+TEST(InlineHashMap, Copy) {
+  pw::InlineHashMap<int, int, 8> map1 = {{1, 1}, {2, 2}};
+  pw::InlineHashMap<int, int, 8> map2(map1);
+  EXPECT_EQ(map2.size(), 2u);
+  EXPECT_EQ(map2.at(2), 2);
+
+  pw::InlineHashMap<int, int, 8> map3 = {{3, 3}};
+  map3 = map1;
+  EXPECT_EQ(map3.size(), 2u);
+  EXPECT_FALSE(map3.contains(3));
+  EXPECT_EQ(map1.size(), 2u);
+}
+
+TEST(InlineHashMap, Move) {
+  pw::InlineHashMap<int, Counter, 8> map1;
+  map1.emplace(1, 1);
+  map1.emplace(2, 2);
+
+  pw::InlineHashMap<int, Counter, 8> map2(std::move(map1));
+  EXPECT_TRUE(map1.empty());  // NOLINT(bugprone-use-after-move)
+  EXPECT_EQ(map2.size(), 2u);
+  EXPECT_EQ(map2.at(1), 1);
+  EXPECT_EQ(map2.at(2), 2);
+}
+
+TEST(InlineHashMap, Destructor_DestroysElements) {
+  Counter::Reset();
+  {
+    pw::InlineHashMap<int, Counter, 8> map;
+    for (int i = 0; i < 8; ++i) {
+      map.emplace(i, i);
+    }
+    map.erase(3);
+  }
+  EXPECT_EQ(Counter::created, Counter::destroyed);
+}
+
+}  // namespace
@@ -126,13 +126,17 @@ static void AppendEntryKnownToFit(pw_InlineVarLenEntryQueue_Handle queue,
   TAIL(queue) = CopyAndWrap(queue, tail, data, size);
 }
 
-static inline uint32_t AvailableBytes(
-    pw_InlineVarLenEntryQueue_ConstHandle queue) {
-  uint32_t tail = TAIL(queue);
-  if (tail < HEAD(queue)) {
+static inline uint32_t AvailableBytesBetween(
+    pw_InlineVarLenEntryQueue_ConstHandle queue, uint32_t head, uint32_t tail) {
+  if (tail < head) {
     tail += BufferSize(queue);
   }
-  return Capacity(queue) - (tail - HEAD(queue));
+  return Capacity(queue) - (tail - head);
+}
+
+static inline uint32_t AvailableBytes(
+    pw_InlineVarLenEntryQueue_ConstHandle queue) {
+  return AvailableBytesBetween(queue, HEAD(queue), TAIL(queue));
 }
 
 void pw_InlineVarLenEntryQueue_Push(pw_InlineVarLenEntryQueue_Handle queue,
@@ -161,6 +165,25 @@ bool pw_InlineVarLenEntryQueue_TryPush(pw_InlineVarLenEntryQueue_Handle queue,
   return true;
 }
 
+bool _pw_InlineVarLenEntryQueue_TryPushAt(
+    pw_InlineVarLenEntryQueue_Handle queue,
+    uint32_t head,
+    uint32_t* tail,
+    const void* data,
+    uint32_t data_size_bytes) {
+  uint8_t prefix[PW_VARINT_MAX_INT32_SIZE_BYTES];
+  uint32_t prefix_size = EncodePrefix(queue, prefix, data_size_bytes);
+
+  if (prefix_size + data_size_bytes >
+      AvailableBytesBetween(queue, head, *tail)) {
+    return false;
+  }
+
+  const uint32_t offset = CopyAndWrap(queue, *tail, prefix, prefix_size);
+  *tail = CopyAndWrap(queue, offset, data, data_size_bytes);
+  return true;
+}
+
 void pw_InlineVarLenEntryQueue_PushOverwrite(
     pw_InlineVarLenEntryQueue_Handle queue,
     const void* data,
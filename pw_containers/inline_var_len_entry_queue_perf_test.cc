@@ -0,0 +1,82 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+#include "pw_containers/inline_var_len_entry_queue.h"
+#include "pw_perf_test/perf_test.h"
+#include "pw_sync/interrupt_spin_lock.h"
+
+namespace pw {
+namespace {
+
+// Compares pushing and popping entries with a lock-free
+// `SpscInlineVarLenEntryQueue` and with an `InlineVarLenEntryQueue` guarded by
+// an `InterruptSpinLock`, as is required when sharing it between a producer
+// and a consumer.
+
+constexpr size_t kQueueSizeBytes = 256;
+constexpr size_t kEntriesPerBatch = 8;
+constexpr uint32_t kMaxEntrySize = 64;
+
+std::array<std::byte, kMaxEntrySize> entry_data{};
+
+void SpscPushPop(perf_test::State& state, size_t entry_size) {
+  static SpscInlineVarLenEntryQueue<kQueueSizeBytes> queue;
+  std::array<std::byte, kMaxEntrySize> buffer;
+  span<const std::byte> entry(entry_data.data(), entry_size);
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < kEntriesPerBatch; ++i) {
+      static_cast<void>(queue.try_push(entry));
+    }
+    while (!queue.empty()) {
+      queue.front().copy(buffer.data(), kMaxEntrySize);
+      queue.pop();
+    }
+  }
+}
+
+void LockedPushPop(perf_test::State& state, size_t entry_size) {
+  static InlineVarLenEntryQueue<kQueueSizeBytes> queue;
+  static sync::InterruptSpinLock lock;
+  std::array<std::byte, kMaxEntrySize> buffer;
+  span<const std::byte> entry(entry_data.data(), entry_size);
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < kEntriesPerBatch; ++i) {
+      std::lock_guard guard(lock);
+      static_cast<void>(queue.try_push(entry));
+    }
+    while (true) {
+      std::lock_guard guard(lock);
+      if (queue.empty()) {
+        break;
+      }
+      queue.front().copy(buffer.data(), kMaxEntrySize);
+      queue.pop();
+    }
+  }
+}
+
+PW_PERF_TEST(SpscPushPop4, SpscPushPop, 4);
+PW_PERF_TEST(SpscPushPop16, SpscPushPop, 16);
+PW_PERF_TEST(SpscPushPop64, SpscPushPop, 64);
+PW_PERF_TEST(LockedPushPop4, LockedPushPop, 4);
+PW_PERF_TEST(LockedPushPop16, LockedPushPop, 16);
+PW_PERF_TEST(LockedPushPop64, LockedPushPop, 64);
+
+}  // namespace
+}  // namespace pw
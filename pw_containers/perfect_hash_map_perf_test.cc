@@ -0,0 +1,85 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_containers/flat_map.h"
+#include "pw_containers/perfect_hash_map.h"
+#include "pw_perf_test/perf_test.h"
+
+namespace pw::containers {
+namespace {
+
+// Compares looking up keys in constant maps, using a binary search for
+// `FlatMap` and a perfect hash for `PerfectHashMap`.
+
+// Returns items whose keys are in ascending order with pseudorandom gaps, so
+// that `FlatMap` does not need to reorder them when sorting.
+template <size_t kNumKeys>
+constexpr std::array<Pair<uint32_t, uint32_t>, kNumKeys> MakeItems() {
+  std::array<Pair<uint32_t, uint32_t>, kNumKeys> items{};
+  uint32_t state = 1;
+  uint32_t key = 0;
+  for (size_t i = 0; i < kNumKeys; ++i) {
+    state = state * 1664525u + 1013904223u;
+    key += 2 + (state >> 20);
+    items[i] = {key, static_cast<uint32_t>(i)};
+  }
+  return items;
+}
+
+constexpr auto kItems16 = MakeItems<16>();
+constexpr auto kItems256 = MakeItems<256>();
+constexpr auto kItems4096 = MakeItems<4096>();
+
+constexpr FlatMap kFlatMap16(kItems16);
+constexpr FlatMap kFlatMap256(kItems256);
+constexpr FlatMap kFlatMap4096(kItems4096);
+
+constexpr PerfectHashMap kPerfectHashMap16(kItems16);
+constexpr PerfectHashMap kPerfectHashMap256(kItems256);
+
+// Building the perfect hash function for 4096 keys takes more steps than
+// clang's default -fconstexpr-steps limit allows, so this map is built at run
+// time, before the tests start. This does not affect the cost of lookups.
+const PerfectHashMap kPerfectHashMap4096(kItems4096);
+
+// Half of the lookups are for keys that are not present.
+template <typename Map, size_t kNumKeys>
+void FindKeys(perf_test::State& state,
+              const Map& map,
+              const std::array<Pair<uint32_t, uint32_t>, kNumKeys>& items) {
+  volatile size_t found = 0;
+  while (state.KeepRunning()) {
+    for (const auto& item : items) {
+      found = found + static_cast<size_t>(map.contains(item.first)) +
+              static_cast<size_t>(map.contains(item.first + 1));
+    }
+  }
+}
+
+PW_PERF_TEST(FlatMapFind16, FindKeys, kFlatMap16, kItems16);
+PW_PERF_TEST(FlatMapFind256, FindKeys, kFlatMap256, kItems256);
+PW_PERF_TEST(FlatMapFind4096, FindKeys, kFlatMap4096, kItems4096);
+PW_PERF_TEST(PerfectHashMapFind16, FindKeys, kPerfectHashMap16, kItems16);
+PW_PERF_TEST(PerfectHashMapFind256, FindKeys, kPerfectHashMap256, kItems256);
+PW_PERF_TEST(PerfectHashMapFind4096,
+             FindKeys,
+             kPerfectHashMap4096,
+             kItems4096);
+
+}  // namespace
+}  // namespace pw::containers
@@ -0,0 +1,163 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_containers/perfect_hash_map.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+
+#include "pw_unit_test/framework.h"
+
+namespace pw::containers {
+namespace {
+
+constexpr PerfectHashMap<int, char, 5> kOddMap({{
+    {-3, 'a'},
+    {0, 'b'},
+    {1, 'c'},
+    {50, 'd'},
+    {100, 'e'},
+}});
+
+enum class Color : uint8_t { kRed, kGreen, kBlue, kCyan };
+
+constexpr PerfectHashMap kColors = {
+    Pair<Color, uint32_t>{Color::kRed, 0xff0000},
+    Pair<Color, uint32_t>{Color::kGreen, 0x00ff00},
+    Pair<Color, uint32_t>{Color::kBlue, 0x0000ff},
+};
+
+constexpr PerfectHashMap<std::string_view, int, 4> kWords({{
+    {"zero", 0},
+    {"one", 1},
+    {"two", 2},
+    {"three", 3},
+}});
+
+constexpr size_t kLargeSize = 500;
+
+constexpr std::array<Pair<uint32_t, size_t>, kLargeSize> kLargeItems = [] {
+  std::array<Pair<uint32_t, size_t>, kLargeSize> items{};
+  for (size_t i = 0; i < kLargeSize; ++i) {
+    items[i] = {static_cast<uint32_t>(i * 7919u), i};
+  }
+  return items;
+}();
+
+constexpr PerfectHashMap kLargeMap(kLargeItems);
+
+// Lookups may be evaluated at compile time.
+static_assert(kOddMap.at(50) == 'd');
+static_assert(kOddMap.contains(-3));
+static_assert(!kOddMap.contains(2));
+static_assert(kWords.at("three") == 3);
+static_assert(kLargeMap.at(499 * 7919u) == 499u);
+
+}  // namespace
+
+TEST(PerfectHashMap, Size) {
+  EXPECT_EQ(kOddMap.size(), 5u);
+  EXPECT_EQ(kOddMap.max_size(), 5u);
+  EXPECT_FALSE(kOddMap.empty());
+  EXPECT_EQ(kColors.size(), 3u);
+}
+
+TEST(PerfectHashMap, Empty) {
+  constexpr PerfectHashMap<int, char, 0> kEmpty({{}});
+  EXPECT_TRUE(kEmpty.empty());
+  EXPECT_EQ(kEmpty.size(), 0u);
+  EXPECT_EQ(kEmpty.begin(), kEmpty.end());
+  EXPECT_EQ(kEmpty.find(0), kEmpty.end());
+  EXPECT_FALSE(kEmpty.contains(0));
+}
+
+TEST(PerfectHashMap, Single) {
+  constexpr PerfectHashMap kSingle = {Pair<int, char>{42, 'x'}};
+  EXPECT_EQ(kSingle.at(42), 'x');
+  EXPECT_FALSE(kSingle.contains(0));
+  EXPECT_EQ(kSingle.find(41), kSingle.end());
+}
+
+TEST(PerfectHashMap, Find) {
+  auto it = kOddMap.find(1);
+  ASSERT_NE(it, kOddMap.end());
+  EXPECT_EQ(it->first, 1);
+  EXPECT_EQ(it->second, 'c');
+
+  EXPECT_EQ(kOddMap.find(2), kOddMap.end());
+  EXPECT_EQ(kOddMap.find(std::numeric_limits<int>::min()), kOddMap.end());
+}
+
+TEST(PerfectHashMap, At) {
+  EXPECT_EQ(kOddMap.at(-3), 'a');
+  EXPECT_EQ(kOddMap.at(0), 'b');
+  EXPECT_EQ(kOddMap.at(1), 'c');
+  EXPECT_EQ(kOddMap.at(50), 'd');
+  EXPECT_EQ(kOddMap.at(100), 'e');
+}
+
+TEST(PerfectHashMap, Count) {
+  EXPECT_EQ(kOddMap.count(50), 1u);
+  EXPECT_EQ(kOddMap.count(51), 0u);
+}
+
+TEST(PerfectHashMap, EnumKeys) {
+  EXPECT_EQ(kColors.at(Color::kRed), 0xff0000u);
+  EXPECT_EQ(kColors.at(Color::kGreen), 0x00ff00u);
+  EXPECT_EQ(kColors.at(Color::kBlue), 0x0000ffu);
+  EXPECT_FALSE(kColors.contains(Color::kCyan));
+}
+
+TEST(PerfectHashMap, StringKeys) {
+  EXPECT_EQ(kWords.at("zero"), 0);
+  EXPECT_EQ(kWords.at("one"), 1);
+  EXPECT_EQ(kWords.at("two"), 2);
+  EXPECT_EQ(kWords.at("three"), 3);
+  EXPECT_FALSE(kWords.contains("four"));
+  EXPECT_FALSE(kWords.contains(""));
+  EXPECT_FALSE(kWords.contains("thre"));
+}
+
+TEST(PerfectHashMap, Iterate_VisitsEachItemOnce) {
+  size_t count = 0;
+  size_t sum = 0;
+  for (const auto& [key, value] : kLargeMap) {
+    EXPECT_EQ(key, value * 7919u);
+    sum += value;
+    ++count;
+  }
+  EXPECT_EQ(count, kLargeSize);
+  EXPECT_EQ(sum, kLargeSize * (kLargeSize - 1) / 2);
+}
+
+TEST(PerfectHashMap, LargeMap) {
+  for (size_t i = 0; i < kLargeSize; ++i) {
+    uint32_t key = static_cast<uint32_t>(i * 7919u);
+    ASSERT_EQ(kLargeMap.at(key), i);
+    EXPECT_FALSE(kLargeMap.contains(key + 1));
+  }
+}
+
+TEST(PerfectHashMap, MutableValues) {
+  PerfectHashMap<int, int, 3> map({{{1, 10}, {2, 20}, {3, 30}}});
+  map.at(2) = 25;
+  EXPECT_EQ(map.at(1), 10);
+  EXPECT_EQ(map.at(2), 25);
+  EXPECT_EQ(map.at(3), 30);
+}
+
+}  // namespace pw::containers
@@ -0,0 +1,201 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <utility>
+
+#include "pw_allocator/allocator.h"
+#include "pw_assert/assert.h"
+#include "pw_containers/internal/generic_hash_map.h"
+
+namespace pw {
+
+/// Unordered associative container, similar to `std::unordered_map`, but
+/// optimized for embedded.
+///
+/// Key features of `pw::DynamicHashMap`.
+///
+/// - Uses a `pw::Allocator` for memory operations.
+/// - Stores all elements in a single allocation using open addressing, rather
+///   than allocating a node per element.
+/// - Finds elements by examining a group of 8 control bytes at a time, and
+///   only compares keys whose hashes likely match. See
+///   `containers::internal::GenericHashMap` for details.
+/// - Provides much of the `std::unordered_map` API, but adds `try_*` versions
+///   of operations that crash on allocation failure.
+///   - `insert()` & `try_insert()`.
+///   - `emplace()` & `try_emplace()`.
+/// - Offers `reserve()`/`try_reserve()` and `shrink_to_fit()` to manage memory
+///   usage.
+/// - Never allocates in the constructor. `constexpr` constructible.
+///
+/// Unlike `std::unordered_map`, inserting an element may invalidate all
+/// iterators and references, and the hash and key equality functions must be
+/// stateless.
+template <typename Key,
+          typename Value,
+          typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
+class DynamicHashMap
+    : public containers::internal::GenericHashMap<
+          DynamicHashMap<Key, Value, Hash, KeyEqual>,
+          Key,
+          Value,
+          Hash,
+          KeyEqual> {
+ private:
+  using Base = containers::internal::GenericHashMap<
+      DynamicHashMap<Key, Value, Hash, KeyEqual>,
+      Key,
+      Value,
+      Hash,
+      KeyEqual>;
+
+ public:
+  using typename Base::const_iterator;
+  using typename Base::const_pointer;
+  using typename Base::const_reference;
+  using typename Base::difference_type;
+  using typename Base::hasher;
+  using typename Base::iterator;
+  using typename Base::key_equal;
+  using typename Base::key_type;
+  using typename Base::mapped_type;
+  using typename Base::pointer;
+  using typename Base::reference;
+  using typename Base::size_type;
+  using typename Base::value_type;
+
+  using allocator_type = Allocator;
+
+  /// Constructs an empty `DynamicHashMap`. No memory is allocated.
+  ///
+  /// Since allocations can fail, initialization in the constructor is not
+  /// supported.
+  constexpr DynamicHashMap(Allocator& allocator) noexcept
+      : allocator_(&allocator) {}
+
+  DynamicHashMap(const DynamicHashMap&) = delete;
+  DynamicHashMap& operator=(const DynamicHashMap&) = delete;
+
+  /// Move construction/assignment is supported since it cannot fail. Copy
+  /// construction/assignment is not supported.
+  DynamicHashMap(DynamicHashMap&& other) noexcept
+      : allocator_(other.allocator_) {
+    Base::MoveFrom(other);
+  }
+
+  DynamicHashMap& operator=(DynamicHashMap&& other) noexcept {
+    Release();
+    allocator_ = other.allocator_;  // The other map keeps its allocator
+    Base::MoveFrom(other);
+    return *this;
+  }
+
+  ~DynamicHashMap() { Release(); }
+
+  /// Attempts to increase `capacity()` to at least `new_capacity`, allocating
+  /// memory if needed. Does nothing if `new_capacity` is less than or equal to
+  /// `capacity()`. Iterators are invalidated if allocation occurs.
+  ///
+  /// @returns true if allocation succeeded or `capacity()` was already large
+  /// enough; false if allocation failed
+  [[nodiscard]] bool try_reserve(size_type new_capacity) {
+    return new_capacity <= Base::capacity() ||
+           Resize(Base::NumSlotsFor(new_capacity));
+  }
+
+  /// Increases `capacity()` to at least `new_capacity`. Crashes on failure.
+  void reserve(size_type new_capacity) { PW_ASSERT(try_reserve(new_capacity)); }
+
+  /// Attempts to reduce `capacity()` to the smallest value that can hold
+  /// `size()` elements. Not guaranteed to succeed.
+  void shrink_to_fit() {
+    if (Base::empty()) {
+      Release();
+      return;
+    }
+    size_t num_slots = Base::NumSlotsFor(Base::size());
+    if (num_slots < Base::num_slots()) {
+      static_cast<void>(Resize(num_slots));
+    }
+  }
+
+  constexpr size_type max_size() const noexcept {
+    return std::numeric_limits<size_type>::max() / (sizeof(value_type) + 1);
+  }
+
+  /// Returns the map's allocator.
+  constexpr allocator_type& get_allocator() const { return *allocator_; }
+
+  /// Swaps the contents of two maps. No allocations occur.
+  void swap(DynamicHashMap& other) noexcept {
+    Base::Swap(other);
+    std::swap(allocator_, other.allocator_);
+  }
+
+ private:
+  friend Base;
+
+  /// Makes room for at least one more element.
+  ///
+  /// If a significant fraction of the slots are tombstones, they are reclaimed
+  /// in place. Otherwise, the number of slots is doubled.
+  bool Grow() {
+    size_t num_slots = Base::num_slots();
+    if (num_slots > Base::kWidth && Base::size() * 32 <= num_slots * 25) {
+      Base::DropDeletes();
+      return true;
+    }
+    return Resize(num_slots == 0 ? Base::kWidth : num_slots * 2);
+  }
+
+  /// Moves the elements to a new allocation with the given number of slots.
+  ///
+  /// The slots are stored at the start of the allocation, followed by the
+  /// control bytes.
+  bool Resize(size_t num_slots) {
+    if (num_slots > max_size()) {
+      return false;
+    }
+    size_t slots_size = num_slots * sizeof(value_type);
+    void* ptr = allocator_->Allocate(allocator::Layout(
+        slots_size + Base::NumCtrlBytes(num_slots), alignof(value_type)));
+    if (ptr == nullptr) {
+      return false;
+    }
+    std::byte* old_slots = Base::slot_storage();
+    auto* slots = static_cast<std::byte*>(ptr);
+    Base::MoveTo(reinterpret_cast<int8_t*>(slots + slots_size),
+                 slots,
+                 num_slots);
+    allocator_->Deallocate(old_slots);
+    return true;
+  }
+
+  /// Destroys all elements and frees the allocation.
+  void Release() {
+    Base::DestroyAll();
+    allocator_->Deallocate(Base::slot_storage());
+    Base::Init(nullptr, nullptr, 0, 0);
+  }
+
+  Allocator* allocator_;
+};
+
+}  // namespace pw
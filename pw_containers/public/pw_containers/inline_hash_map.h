@@ -0,0 +1,144 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <utility>
+
+#include "pw_containers/internal/generic_hash_map.h"
+
+namespace pw {
+
+/// Unordered associative container with a fixed capacity, similar to
+/// `std::unordered_map`.
+///
+/// `pw::InlineHashMap` has the same features and API as `pw::DynamicHashMap`,
+/// except that its slots are stored inline and it never allocates. Insertions
+/// fail once the map holds `kCapacity` elements. Erased elements may leave
+/// behind "tombstones", which are reclaimed in place when needed.
+///
+/// Unlike `std::unordered_map`, inserting an element may invalidate all
+/// iterators and references, and the hash and key equality functions must be
+/// stateless.
+///
+/// @tparam  Key        Type of the keys. Must be copy constructible.
+/// @tparam  Value      Type of the mapped values.
+/// @tparam  kCapacity  Maximum number of elements.
+/// @tparam  Hash       Stateless function object used to hash keys.
+/// @tparam  KeyEqual   Stateless function object used to compare keys.
+template <typename Key,
+          typename Value,
+          size_t kCapacity,
+          typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
+class InlineHashMap
+    : public containers::internal::GenericHashMap<
+          InlineHashMap<Key, Value, kCapacity, Hash, KeyEqual>,
+          Key,
+          Value,
+          Hash,
+          KeyEqual> {
+ private:
+  using Base = containers::internal::GenericHashMap<
+      InlineHashMap<Key, Value, kCapacity, Hash, KeyEqual>,
+      Key,
+      Value,
+      Hash,
+      KeyEqual>;
+
+  static_assert(kCapacity > 0);
+
+ public:
+  using typename Base::const_iterator;
+  using typename Base::const_pointer;
+  using typename Base::const_reference;
+  using typename Base::difference_type;
+  using typename Base::hasher;
+  using typename Base::iterator;
+  using typename Base::key_equal;
+  using typename Base::key_type;
+  using typename Base::mapped_type;
+  using typename Base::pointer;
+  using typename Base::reference;
+  using typename Base::size_type;
+  using typename Base::value_type;
+
+  /// Constructs an empty map.
+  InlineHashMap() { Base::Init(ctrl_.data(), slots_, kNumSlots, kCapacity); }
+
+  /// Constructs a map from a list of key-value pairs. Crashes if the list has
+  /// more than `kCapacity` distinct keys.
+  InlineHashMap(std::initializer_list<value_type> list) : InlineHashMap() {
+    for (const value_type& value : list) {
+      Base::insert(value);
+    }
+  }
+
+  InlineHashMap(const InlineHashMap& other) : InlineHashMap() {
+    *this = other;
+  }
+
+  InlineHashMap(InlineHashMap&& other) : InlineHashMap() {
+    *this = std::move(other);
+  }
+
+  InlineHashMap& operator=(const InlineHashMap& other) {
+    if (&other != this) {
+      Base::clear();
+      for (const value_type& value : other) {
+        Base::insert(value);
+      }
+    }
+    return *this;
+  }
+
+  /// Moves the elements of another map. The other map is left empty.
+  InlineHashMap& operator=(InlineHashMap&& other) {
+    if (&other != this) {
+      Base::clear();
+      for (value_type& value : other) {
+        Base::emplace(value.first, std::move(value.second));
+      }
+      other.clear();
+    }
+    return *this;
+  }
+
+  ~InlineHashMap() { Base::DestroyAll(); }
+
+  static constexpr size_type max_size() noexcept { return kCapacity; }
+
+ private:
+  friend Base;
+
+  static constexpr size_t kNumSlots = Base::NumSlotsFor(kCapacity);
+
+  /// Reclaims tombstones, if any. The number of slots never changes.
+  bool Grow() {
+    if (Base::num_deleted() == 0) {
+      return false;
+    }
+    Base::DropDeletes();
+    return true;
+  }
+
+  std::array<int8_t, Base::NumCtrlBytes(kNumSlots)> ctrl_;
+  alignas(value_type) std::byte slots_[kNumSlots * sizeof(value_type)];
+};
+
+}  // namespace pw
@@ -59,6 +59,10 @@
 /// `InlineVarLenEntryQueue` is implemented in C and provides complete C and C++
 /// APIs. The `InlineVarLenEntryQueue` C++ class is structured similarly to
 /// `pw::InlineQueue` and `pw::Vector`.
+///
+/// `InlineVarLenEntryQueue` is not thread safe. `SpscInlineVarLenEntryQueue`
+/// uses the same in-memory layout, but allows one producer and one consumer to
+/// access the queue concurrently without a lock.
 
 #ifdef __cplusplus
 extern "C" {
@@ -284,6 +288,16 @@ static inline const uint8_t* _pw_InlineVarLenEntryQueue_Entry_GetPointer(
 const uint8_t* _pw_InlineVarLenEntryQueue_Entry_GetPointerChecked(
     const pw_InlineVarLenEntryQueue_Entry* entry, size_t index);
 
+// Private function used by `pw::SpscInlineVarLenEntryQueue`. Appends an entry
+// at `*tail` if it fits in the space before `head`, and updates `*tail`. Does
+// not read or write the queue's head and tail offsets.
+bool _pw_InlineVarLenEntryQueue_TryPushAt(
+    pw_InlineVarLenEntryQueue_Handle queue,
+    uint32_t head,
+    uint32_t* tail,
+    const void* data,
+    uint32_t data_size_bytes);
+
 static inline uint8_t pw_InlineVarLenEntryQueue_Entry_At(
     const pw_InlineVarLenEntryQueue_Entry* entry, size_t index) {
   return *_pw_InlineVarLenEntryQueue_Entry_GetPointerChecked(entry, index);
@@ -321,6 +335,7 @@ static inline bool pw_InlineVarLenEntryQueue_Empty(
 #ifdef __cplusplus
 }  // extern "C"
 
+#include <atomic>
 #include <cstddef>
 #include <limits>
 #include <type_traits>
@@ -331,6 +346,10 @@ static inline bool pw_InlineVarLenEntryQueue_Empty(
 
 namespace pw {
 
+template <typename T,
+          size_t kMaxSizeBytes = containers::internal::kGenericSized>
+class BasicSpscInlineVarLenEntryQueue;
+
 // A`BasicInlineVarLenEntryQueue` with a known maximum size of a single entry.
 // The member functions are immplemented in the generic-capacity base.
 // TODO: b/303056683 - Add helper for calculating kMaxSizeBytes for N entries of
@@ -607,6 +626,9 @@ class BasicInlineVarLenEntryQueue<T>::Entry {
  private:
   friend class BasicInlineVarLenEntryQueue;
 
+  template <typename, size_t>
+  friend class BasicSpscInlineVarLenEntryQueue;
+
   static const T* GetIndex(const pw_InlineVarLenEntryQueue_Entry& entry,
                            size_t index) {
     return reinterpret_cast<const T*>(
@@ -685,6 +707,159 @@ template <size_t kMaxSizeBytes = containers::internal::kGenericSized>
 using InlineVarLenEntryQueue =
     BasicInlineVarLenEntryQueue<std::byte, kMaxSizeBytes>;
 
+// A `BasicSpscInlineVarLenEntryQueue` with a known maximum size of a single
+// entry. The member functions are implemented in the generic-capacity base.
+template <typename T, size_t kMaxSizeBytes>
+class BasicSpscInlineVarLenEntryQueue
+    : public BasicSpscInlineVarLenEntryQueue<
+          T,
+          containers::internal::kGenericSized> {
+ private:
+  using Base =
+      BasicSpscInlineVarLenEntryQueue<T, containers::internal::kGenericSized>;
+
+ public:
+  BasicSpscInlineVarLenEntryQueue() : Base(kMaxSizeBytes) {}
+
+  // Explicit zero element constexpr constructor. Using this constructor will
+  // place the entire object in .data, which will increase ROM size. Use with
+  // caution if working with large capacity sizes.
+  constexpr BasicSpscInlineVarLenEntryQueue(ConstexprTag)
+      : Base(kMaxSizeBytes), data_{} {}
+
+ private:
+  static_assert(kMaxSizeBytes <=
+                std::numeric_limits<typename Base::size_type>::max());
+
+  uint32_t data_[_PW_VAR_QUEUE_DATA_SIZE_UINT32(kMaxSizeBytes)];
+};
+
+/// Single-producer, single-consumer variant of `BasicInlineVarLenEntryQueue`.
+///
+/// One thread or interrupt handler may push entries while another reads and
+/// pops them, without a lock. The producer only writes the tail offset and the
+/// consumer only writes the head offset. Each publishes its changes with a
+/// single release store, after the entry data has been written or read.
+///
+/// The in-memory layout is identical to `BasicInlineVarLenEntryQueue`, so
+/// `raw_storage()` may be decoded with the C API or the Python
+/// `pw_containers.inline_var_len_entry_queue` module.
+///
+/// The producer may only call `try_push()`. Since the producer cannot remove
+/// entries, there is no `push_overwrite()`. All other functions may only be
+/// called by the consumer.
+template <typename T>
+class BasicSpscInlineVarLenEntryQueue<T, containers::internal::kGenericSized> {
+ public:
+  using Entry = typename BasicInlineVarLenEntryQueue<T>::Entry;
+
+  using value_type = Entry;
+  using size_type = std::uint32_t;
+
+  BasicSpscInlineVarLenEntryQueue(const BasicSpscInlineVarLenEntryQueue&) =
+      delete;
+  BasicSpscInlineVarLenEntryQueue& operator=(
+      const BasicSpscInlineVarLenEntryQueue&) = delete;
+
+  /// Appends an entry to the end of the queue, but only if there is sufficient
+  /// space for it. Producer only.
+  ///
+  /// @returns true if the data was added to the queue; false if it did not fit
+  /// @pre The entry MUST NOT be larger than `max_size_bytes()`.
+  [[nodiscard]] bool try_push(span<const T> value) {
+    uint32_t tail = tail_.load(std::memory_order_relaxed);
+    if (!_pw_InlineVarLenEntryQueue_TryPushAt(
+            queue(),
+            head_.load(std::memory_order_acquire),
+            &tail,
+            value.data(),
+            static_cast<size_type>(value.size()))) {
+      return false;
+    }
+    tail_.store(tail, std::memory_order_release);
+    return true;
+  }
+
+  /// Returns true if the queue has no entries. Consumer only.
+  [[nodiscard]] bool empty() const {
+    return head_.load(std::memory_order_relaxed) ==
+           tail_.load(std::memory_order_acquire);
+  }
+
+  /// Returns the first entry in the queue. The entry remains valid until it is
+  /// popped. Consumer only.
+  ///
+  /// @pre `empty()` MUST have returned false.
+  Entry front() const {
+    pw_InlineVarLenEntryQueue_Iterator it = {
+        queue(), head_.load(std::memory_order_relaxed)};
+    return Entry(pw_InlineVarLenEntryQueue_GetEntry(&it));
+  }
+
+  /// Removes the first entry from the queue. Consumer only.
+  ///
+  /// @pre `empty()` MUST have returned false.
+  void pop() {
+    pw_InlineVarLenEntryQueue_Iterator it = {
+        queue(), head_.load(std::memory_order_relaxed)};
+    pw_InlineVarLenEntryQueue_Iterator_Advance(&it);
+    head_.store(it._pw_offset, std::memory_order_release);
+  }
+
+  /// Removes all entries that have been pushed so far. Consumer only.
+  void clear() {
+    head_.store(tail_.load(std::memory_order_relaxed),
+                std::memory_order_release);
+  }
+
+  /// @copydoc pw_InlineVarLenEntryQueue_MaxSizeBytes
+  size_type max_size_bytes() const {
+    return pw_InlineVarLenEntryQueue_MaxSizeBytes(queue());
+  }
+
+  /// Underlying storage of the variable-length entry queue. Only consistent
+  /// if the producer is not pushing, e.g. when capturing a crash snapshot.
+  span<const T> raw_storage() const {
+    return span<const T>(
+        reinterpret_cast<const T*>(queue()),
+        pw_InlineVarLenEntryQueue_RawStorageSizeBytes(queue()));
+  }
+
+ protected:
+  constexpr BasicSpscInlineVarLenEntryQueue(uint32_t max_size_bytes)
+      : buffer_size_(_PW_VAR_QUEUE_DATA_SIZE_BYTES(max_size_bytes)),
+        head_(0),
+        tail_(0) {}
+
+  // Polymorphic-sized queues cannot be destroyed directly due to the lack of a
+  // virtual destructor.
+  ~BasicSpscInlineVarLenEntryQueue() = default;
+
+ private:
+  static_assert(std::is_integral_v<T> || std::is_same_v<T, std::byte>);
+  static_assert(sizeof(T) == sizeof(std::byte));
+
+  // The head and tail are accessed as `uint32_t`s by C functions and decoders.
+  static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t));
+  static_assert(alignof(std::atomic<uint32_t>) == alignof(uint32_t));
+  static_assert(std::atomic<uint32_t>::is_always_lock_free);
+
+  // The C functions called here only access the buffer size and data, never
+  // the head and tail offsets.
+  uint32_t* queue() { return &buffer_size_; }
+  const uint32_t* queue() const { return &buffer_size_; }
+
+  uint32_t buffer_size_;
+  std::atomic<uint32_t> head_;
+  std::atomic<uint32_t> tail_;
+};
+
+/// Single-producer, single-consumer variable-length entry queue that uses
+/// ``std::byte`` for the byte type.
+template <size_t kMaxSizeBytes = containers::internal::kGenericSized>
+using SpscInlineVarLenEntryQueue =
+    BasicSpscInlineVarLenEntryQueue<std::byte, kMaxSizeBytes>;
+
 /// @}
 
 }  // namespace pw
@@ -0,0 +1,692 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "lib/stdcompat/bit.h"
+#include "pw_assert/assert.h"
+
+namespace pw::containers::internal {
+
+// Each slot of a hash map has a control byte that describes its state. Full
+// slots store the low 7 bits of the hash of their key, so that most slots with
+// different keys can be skipped without comparing keys.
+inline constexpr int8_t kHashMapEmpty = -128;  // 0b10000000
+inline constexpr int8_t kHashMapDeleted = -2;  // 0b11111110
+
+constexpr bool IsHashMapFull(int8_t ctrl) { return ctrl >= 0; }
+
+/// A group of consecutive control bytes that are examined together.
+///
+/// The bytes are packed into a single word, and all bytes are compared at once
+/// using bitwise arithmetic. This does not require any SIMD instructions, and
+/// is portable to every target.
+///
+/// Each method returns a mask with the most significant bit of each matching
+/// byte set, and all other bits cleared. The position of a byte within the
+/// group can be recovered with `LowestIndex`.
+class HashMapGroup {
+ public:
+  static constexpr size_t kWidth = 8;
+
+  explicit HashMapGroup(const int8_t* ctrl) {
+    for (size_t i = 0; i < kWidth; ++i) {
+      ctrl_ |= uint64_t{static_cast<uint8_t>(ctrl[i])} << (i * 8);
+    }
+  }
+
+  /// Returns the full slots whose stored hash bits match `h2`.
+  ///
+  /// This may rarely include a false positive for a byte adjacent to a true
+  /// match. Callers always compare the keys of matching slots.
+  uint64_t Match(uint8_t h2) const {
+    uint64_t x = ctrl_ ^ (kLsbs * h2);
+    return (x - kLsbs) & ~x & kMsbs;
+  }
+
+  /// Returns the empty slots.
+  uint64_t MaskEmpty() const { return ctrl_ & ~(ctrl_ << 6) & kMsbs; }
+
+  /// Returns the empty and deleted slots.
+  uint64_t MaskEmptyOrDeleted() const { return ctrl_ & ~(ctrl_ << 7) & kMsbs; }
+
+  /// Returns the position of the first byte set in a non-zero mask.
+  static size_t LowestIndex(uint64_t mask) {
+    return static_cast<size_t>(cpp20::countr_zero(mask)) / 8;
+  }
+
+  /// Returns the position of the last byte set in a non-zero mask.
+  static size_t HighestIndex(uint64_t mask) {
+    return kWidth - 1 - static_cast<size_t>(cpp20::countl_zero(mask)) / 8;
+  }
+
+ private:
+  static constexpr uint64_t kLsbs = 0x0101010101010101ull;
+  static constexpr uint64_t kMsbs = 0x8080808080808080ull;
+
+  uint64_t ctrl_ = 0;
+};
+
+/// Sequence of groups to examine when looking up a key.
+///
+/// The groups are visited using triangular probing, which visits every group
+/// in a table whose number of slots is a power of two.
+class HashMapProbe {
+ public:
+  HashMapProbe(size_t hash, size_t mask) : mask_(mask), offset_(hash & mask) {}
+
+  /// Returns the index of the first slot of the current group.
+  size_t offset() const { return offset_; }
+
+  /// Returns the index of the i-th slot of the current group.
+  size_t offset(size_t i) const { return (offset_ + i) & mask_; }
+
+  void Next() {
+    index_ += HashMapGroup::kWidth;
+    offset_ = (offset_ + index_) & mask_;
+  }
+
+ private:
+  size_t mask_;
+  size_t offset_;
+  size_t index_ = 0;
+};
+
+/// Forward iterator over the full slots of a hash map.
+template <typename T>
+class HashMapIterator {
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = std::remove_cv_t<T>;
+  using difference_type = std::ptrdiff_t;
+  using pointer = T*;
+  using reference = T&;
+
+  constexpr HashMapIterator() = default;
+
+  // Allow conversion from iterator to const_iterator.
+  template <typename U,
+            typename = std::enable_if_t<std::is_same_v<const U, T>>>
+  constexpr HashMapIterator(const HashMapIterator<U>& other)
+      : ctrl_(other.ctrl_), slot_(other.slot_), end_(other.end_) {}
+
+  reference operator*() const { return *slot_; }
+  pointer operator->() const { return slot_; }
+
+  HashMapIterator& operator++() {
+    ++ctrl_;
+    ++slot_;
+    SkipUnused();
+    return *this;
+  }
+
+  HashMapIterator operator++(int) {
+    HashMapIterator previous = *this;
+    operator++();
+    return previous;
+  }
+
+  friend bool operator==(const HashMapIterator& lhs,
+                         const HashMapIterator& rhs) {
+    return lhs.ctrl_ == rhs.ctrl_;
+  }
+
+  friend bool operator!=(const HashMapIterator& lhs,
+                         const HashMapIterator& rhs) {
+    return lhs.ctrl_ != rhs.ctrl_;
+  }
+
+ private:
+  template <typename, typename, typename, typename, typename>
+  friend class GenericHashMap;
+
+  template <typename>
+  friend class HashMapIterator;
+
+  HashMapIterator(const int8_t* ctrl, T* slot, const int8_t* end)
+      : ctrl_(ctrl), slot_(slot), end_(end) {
+    SkipUnused();
+  }
+
+  void SkipUnused() {
+    while (ctrl_ != end_ && !IsHashMapFull(*ctrl_)) {
+      ++ctrl_;
+      ++slot_;
+    }
+  }
+
+  const int8_t* ctrl_ = nullptr;
+  T* slot_ = nullptr;
+  const int8_t* end_ = nullptr;
+};
+
+/// Generic array of slots with open addressing, used to implement hash maps.
+///
+/// This class follows the design of "SwissTable": each slot has a control byte
+/// that is either empty, deleted, or holds 7 bits of the hash of the slot's
+/// key. Lookups hash the key once, and then examine a group of control bytes
+/// at a time. Only slots whose control bytes match are compared, and the
+/// search ends at the first group with an empty slot.
+///
+/// The number of slots is always a power of two. Erased slots become
+/// "tombstones" unless no lookup could have passed through them. When no slots
+/// can be filled without exceeding the maximum load, the derived class's
+/// `Grow()` is called. It may either allocate more slots, or call
+/// `DropDeletes()` to reclaim tombstones in place.
+///
+/// The storage itself is provided by the derived class using `Init()`.
+///
+/// @tparam  Derived    Type of the derived class, which must provide
+///                     `bool Grow()`.
+/// @tparam  Key        Type of the keys. Must be copy constructible.
+/// @tparam  Value      Type of the mapped values.
+/// @tparam  Hash       Stateless function object used to hash keys.
+/// @tparam  KeyEqual   Stateless function object used to compare keys.
+template <typename Derived,
+          typename Key,
+          typename Value,
+          typename Hash,
+          typename KeyEqual>
+class GenericHashMap {
+ public:
+  using key_type = Key;
+  using mapped_type = Value;
+  using value_type = std::pair<const Key, Value>;
+  using size_type = size_t;
+  using difference_type = std::ptrdiff_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using pointer = value_type*;
+  using const_pointer = const value_type*;
+  using iterator = HashMapIterator<value_type>;
+  using const_iterator = HashMapIterator<const value_type>;
+
+  GenericHashMap(const GenericHashMap&) = delete;
+  GenericHashMap& operator=(const GenericHashMap&) = delete;
+
+  // Iterators
+
+  iterator begin() noexcept { return MakeIterator(0); }
+  const_iterator begin() const noexcept { return cbegin(); }
+  const_iterator cbegin() const noexcept { return MakeIterator(0); }
+
+  iterator end() noexcept { return MakeIterator(num_slots_); }
+  const_iterator end() const noexcept { return cend(); }
+  const_iterator cend() const noexcept { return MakeIterator(num_slots_); }
+
+  // Capacity
+
+  [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+  size_type size() const noexcept { return size_; }
+
+  /// Returns the number of elements the map can hold without allocating, or
+  /// for fixed-size maps, at all.
+  size_type capacity() const noexcept { return capacity_; }
+
+  // Lookup
+
+  iterator find(const key_type& key) {
+    return MakeIterator(FindIndex(key, HashOf(key)));
+  }
+
+  const_iterator find(const key_type& key) const {
+    return MakeIterator(FindIndex(key, HashOf(key)));
+  }
+
+  bool contains(const key_type& key) const { return find(key) != end(); }
+
+  size_type count(const key_type& key) const { return contains(key) ? 1 : 0; }
+
+  /// Returns a reference to the value mapped to the given key. Crashes if the
+  /// key is not present.
+  mapped_type& at(const key_type& key) {
+    iterator iter = find(key);
+    PW_ASSERT(iter != end());
+    return iter->second;
+  }
+
+  const mapped_type& at(const key_type& key) const {
+    const_iterator iter = find(key);
+    PW_ASSERT(iter != end());
+    return iter->second;
+  }
+
+  /// Returns a reference to the value mapped to the given key, inserting a
+  /// default-constructed value if needed. Crashes if the insertion fails.
+  mapped_type& operator[](const key_type& key) {
+    return emplace(key).first->second;
+  }
+
+  // Modifiers
+
+  /// Inserts a copy of the given key-value pair, unless the key is already
+  /// present. Crashes if the insertion fails.
+  ///
+  /// @returns  An iterator to the element with the key, and whether the
+  ///           element was inserted.
+  std::pair<iterator, bool> insert(const value_type& value) {
+    return CheckInserted(try_insert(value));
+  }
+
+  std::pair<iterator, bool> insert(value_type&& value) {
+    return CheckInserted(try_insert(std::move(value)));
+  }
+
+  /// Attempts to insert a copy of the given key-value pair, unless the key is
+  /// already present.
+  ///
+  /// @returns  An iterator to the element with the key, and whether the
+  ///           element was inserted. If the element could not be inserted
+  ///           because the map is full or an allocation failed, returns
+  ///           `{end(), false}`.
+  [[nodiscard]] std::pair<iterator, bool> try_insert(const value_type& value) {
+    return TryEmplaceImpl(value.first, value.second);
+  }
+
+  [[nodiscard]] std::pair<iterator, bool> try_insert(value_type&& value) {
+    return TryEmplaceImpl(value.first, std::move(value.second));
+  }
+
+  /// Constructs a value from the given arguments and maps the key to it,
+  /// unless the key is already present. Crashes if the insertion fails.
+  ///
+  /// Unlike `std::unordered_map::emplace`, the key is passed separately and
+  /// nothing is constructed if it is already present. This matches the
+  /// behavior of `std::unordered_map::try_emplace`.
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(const key_type& key, Args&&... args) {
+    return CheckInserted(try_emplace(key, std::forward<Args>(args)...));
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(key_type&& key, Args&&... args) {
+    return CheckInserted(
+        try_emplace(std::move(key), std::forward<Args>(args)...));
+  }
+
+  /// Like `emplace`, but returns `{end(), false}` instead of crashing if the
+  /// map is full or an allocation fails.
+  template <typename... Args>
+  [[nodiscard]] std::pair<iterator, bool> try_emplace(const key_type& key,
+                                                      Args&&... args) {
+    return TryEmplaceImpl(key, std::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  [[nodiscard]] std::pair<iterator, bool> try_emplace(key_type&& key,
+                                                      Args&&... args) {
+    return TryEmplaceImpl(std::move(key), std::forward<Args>(args)...);
+  }
+
+  /// Removes the element with the given key, if present.
+  ///
+  /// @returns  The number of elements removed.
+  size_type erase(const key_type& key) {
+    size_t index = FindIndex(key, HashOf(key));
+    if (index == num_slots_) {
+      return 0;
+    }
+    EraseIndex(index);
+    return 1;
+  }
+
+  /// Removes the element at the given position.
+  ///
+  /// @returns  An iterator to the element following the removed element.
+  iterator erase(const_iterator pos) {
+    auto index = static_cast<size_t>(pos.ctrl_ - ctrl_);
+    EraseIndex(index);
+    return MakeIterator(index);
+  }
+
+  iterator erase(iterator pos) { return erase(const_iterator(pos)); }
+
+  /// Removes all elements. Does not release any memory.
+  void clear() {
+    DestroyAll();
+    ResetCtrl();
+    size_ = 0;
+    growth_left_ = capacity_;
+  }
+
+ protected:
+  static constexpr size_t kWidth = HashMapGroup::kWidth;
+
+  constexpr GenericHashMap() = default;
+
+  /// Returns the maximum number of elements that may be stored in the given
+  /// number of slots. At least one slot is always left empty, so that every
+  /// lookup terminates.
+  static constexpr size_t MaxLoad(size_t num_slots) {
+    if (num_slots <= kWidth) {
+      return num_slots == 0 ? 0 : num_slots - 1;
+    }
+    return num_slots - num_slots / 8;
+  }
+
+  /// Returns the smallest number of slots that can hold the given number of
+  /// elements.
+  static constexpr size_t NumSlotsFor(size_t capacity) {
+    size_t num_slots = 1;
+    while (MaxLoad(num_slots) < capacity) {
+      num_slots *= 2;
+    }
+    return num_slots;
+  }
+
+  /// Returns the number of control bytes needed for the given number of slots.
+  ///
+  /// Control bytes for the first slots are repeated after the last slot, so
+  /// that a group can be loaded starting from any slot.
+  static constexpr size_t NumCtrlBytes(size_t num_slots) {
+    return num_slots + kWidth;
+  }
+
+  size_t num_slots() const { return num_slots_; }
+  size_t num_deleted() const { return capacity_ - size_ - growth_left_; }
+
+  /// Returns the storage for the slots provided by the derived class.
+  std::byte* slot_storage() { return slots_; }
+
+  /// Replaces the storage of an empty map. The control bytes and slots must
+  /// be arrays of `NumCtrlBytes(num_slots)` bytes and `num_slots` values,
+  /// respectively, and `capacity` must not exceed `MaxLoad(num_slots)`.
+  void Init(int8_t* ctrl, std::byte* slots, size_t num_slots, size_t capacity) {
+    ctrl_ = ctrl;
+    slots_ = slots;
+    num_slots_ = num_slots;
+    capacity_ = capacity;
+    size_ = 0;
+    growth_left_ = capacity;
+    ResetCtrl();
+  }
+
+  /// Moves all elements into new storage, as with `Init()`. The old storage is
+  /// not freed.
+  void MoveTo(int8_t* ctrl, std::byte* slots, size_t num_slots) {
+    int8_t* old_ctrl = ctrl_;
+    std::byte* old_slots = slots_;
+    size_t old_num_slots = num_slots_;
+    size_t size = size_;
+    Init(ctrl, slots, num_slots, MaxLoad(num_slots));
+    for (size_t i = 0; i < old_num_slots; ++i) {
+      if (IsHashMapFull(old_ctrl[i])) {
+        pointer old_slot =
+            std::launder(reinterpret_cast<pointer>(old_slots)) + i;
+        size_t hash = HashOf(old_slot->first);
+        size_t target = FindFirstNonFull(hash);
+        SetCtrl(target, H2(hash));
+        Transfer(slot(target), old_slot);
+      }
+    }
+    size_ = size;
+    growth_left_ = capacity_ - size;
+  }
+
+  /// Reclaims all tombstones without changing the storage.
+  ///
+  /// Elements are moved to the first non-full slot of their probe sequence,
+  /// unless that slot is in the same group as their current slot.
+  void DropDeletes() {
+    // Mark tombstones as empty, and full slots as deleted, i.e. "pending".
+    for (size_t i = 0; i < num_slots_; ++i) {
+      ctrl_[i] = IsHashMapFull(ctrl_[i]) ? kHashMapDeleted : kHashMapEmpty;
+    }
+    CopyMirroredCtrl();
+    const size_t mask = num_slots_ - 1;
+    alignas(value_type) std::byte tmp[sizeof(value_type)];
+    auto* tmp_slot = reinterpret_cast<pointer>(tmp);
+    for (size_t i = 0; i < num_slots_; ++i) {
+      if (ctrl_[i] != kHashMapDeleted) {
+        continue;
+      }
+      size_t hash = HashOf(slot(i)->first);
+      size_t target = FindFirstNonFull(hash);
+      size_t start = H1(hash) & mask;
+      auto probe_index = [start, mask](size_t pos) {
+        return ((pos - start) & mask) / kWidth;
+      };
+      if (probe_index(target) == probe_index(i)) {
+        SetCtrl(i, H2(hash));
+        continue;
+      }
+      if (ctrl_[target] == kHashMapEmpty) {
+        SetCtrl(target, H2(hash));
+        Transfer(slot(target), slot(i));
+        SetCtrl(i, kHashMapEmpty);
+      } else {
+        // The target holds another pending element. Swap them, and process
+        // the element now in this slot again.
+        SetCtrl(target, H2(hash));
+        Transfer(tmp_slot, slot(target));
+        Transfer(slot(target), slot(i));
+        Transfer(slot(i), std::launder(tmp_slot));
+        --i;
+      }
+    }
+    growth_left_ = capacity_ - size_;
+  }
+
+  /// Destroys all elements without updating the control bytes.
+  void DestroyAll() {
+    if constexpr (!std::is_trivially_destructible_v<value_type>) {
+      for (size_t i = 0; i < num_slots_ && size_ != 0; ++i) {
+        if (IsHashMapFull(ctrl_[i])) {
+          std::destroy_at(slot(i));
+        }
+      }
+    }
+  }
+
+  /// Takes the storage and elements of another map, leaving it empty.
+  void MoveFrom(GenericHashMap& other) {
+    ctrl_ = std::exchange(other.ctrl_, nullptr);
+    slots_ = std::exchange(other.slots_, nullptr);
+    num_slots_ = std::exchange(other.num_slots_, 0);
+    capacity_ = std::exchange(other.capacity_, 0);
+    size_ = std::exchange(other.size_, 0);
+    growth_left_ = std::exchange(other.growth_left_, 0);
+  }
+
+  void Swap(GenericHashMap& other) {
+    std::swap(ctrl_, other.ctrl_);
+    std::swap(slots_, other.slots_);
+    std::swap(num_slots_, other.num_slots_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(size_, other.size_);
+    std::swap(growth_left_, other.growth_left_);
+  }
+
+ private:
+  static size_t HashOf(const key_type& key) {
+    // Mix the bits, since many hash functions, e.g. `std::hash<int>`, are the
+    // identity function and the low bits are used separately.
+    auto hash = static_cast<size_t>(Hash()(key));
+    if constexpr (sizeof(size_t) == sizeof(uint64_t)) {
+      hash *= static_cast<size_t>(0x9e3779b97f4a7c15ull);
+      return hash ^ (hash >> 32);
+    } else {
+      hash *= static_cast<size_t>(0x9e3779b9u);
+      return hash ^ (hash >> 16);
+    }
+  }
+
+  static size_t H1(size_t hash) { return hash >> 7; }
+  static uint8_t H2(size_t hash) { return static_cast<uint8_t>(hash & 0x7f); }
+
+  static void Transfer(pointer dst, pointer src) {
+    new (dst) value_type(std::move(*src));
+    std::destroy_at(src);
+  }
+
+  pointer slot(size_t index) const {
+    return std::launder(reinterpret_cast<pointer>(slots_)) + index;
+  }
+
+  iterator MakeIterator(size_t index) {
+    if (num_slots_ == 0) {
+      return iterator();
+    }
+    return iterator(ctrl_ + index, slot(index), ctrl_ + num_slots_);
+  }
+
+  const_iterator MakeIterator(size_t index) const {
+    if (num_slots_ == 0) {
+      return const_iterator();
+    }
+    return const_iterator(ctrl_ + index, slot(index), ctrl_ + num_slots_);
+  }
+
+  static std::pair<iterator, bool> CheckInserted(
+      std::pair<iterator, bool> result) {
+    PW_ASSERT(result.first.ctrl_ != result.first.end_);
+    return result;
+  }
+
+  void ResetCtrl() {
+    if (num_slots_ != 0) {
+      std::memset(ctrl_, kHashMapEmpty, NumCtrlBytes(num_slots_));
+    }
+  }
+
+  /// Sets a control byte, along with any of its repeated copies.
+  void SetCtrl(size_t index, int8_t value) {
+    // Copy the members, since writes through `ctrl_` may alias them.
+    int8_t* ctrl = ctrl_;
+    const size_t num_slots = num_slots_;
+    ctrl[index] = value;
+    for (size_t i = index + num_slots; i < num_slots + kWidth;
+         i += num_slots) {
+      ctrl[i] = value;
+    }
+  }
+
+  void CopyMirroredCtrl() {
+    int8_t* ctrl = ctrl_;
+    const size_t num_slots = num_slots_;
+    for (size_t i = num_slots; i < num_slots + kWidth; ++i) {
+      ctrl[i] = ctrl[i & (num_slots - 1)];
+    }
+  }
+
+  /// Returns the index of the slot holding the key, or `num_slots_` if the
+  /// key is not present.
+  size_t FindIndex(const key_type& key, size_t hash) const {
+    if (num_slots_ == 0) {
+      return 0;
+    }
+    HashMapProbe probe(H1(hash), num_slots_ - 1);
+    uint8_t h2 = H2(hash);
+    while (true) {
+      HashMapGroup group(ctrl_ + probe.offset());
+      for (uint64_t mask = group.Match(h2); mask != 0; mask &= mask - 1) {
+        size_t index = probe.offset(HashMapGroup::LowestIndex(mask));
+        if (KeyEqual()(slot(index)->first, key)) {
+          return index;
+        }
+      }
+      if (group.MaskEmpty() != 0) {
+        return num_slots_;
+      }
+      probe.Next();
+    }
+  }
+
+  /// Returns the index of the first empty or deleted slot in the probe
+  /// sequence for the given hash.
+  size_t FindFirstNonFull(size_t hash) const {
+    HashMapProbe probe(H1(hash), num_slots_ - 1);
+    while (true) {
+      uint64_t mask = HashMapGroup(ctrl_ + probe.offset()).MaskEmptyOrDeleted();
+      if (mask != 0) {
+        return probe.offset(HashMapGroup::LowestIndex(mask));
+      }
+      probe.Next();
+    }
+  }
+
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> TryEmplaceImpl(K&& key, Args&&... args) {
+    size_t hash = HashOf(key);
+    size_t index = FindIndex(key, hash);
+    if (index != num_slots_) {
+      return std::make_pair(MakeIterator(index), false);
+    }
+    if (growth_left_ == 0 &&
+        (num_slots_ == 0 ||
+         ctrl_[FindFirstNonFull(hash)] != kHashMapDeleted)) {
+      if (!static_cast<Derived&>(*this).Grow()) {
+        return std::make_pair(end(), false);
+      }
+    }
+    index = FindFirstNonFull(hash);
+    if (ctrl_[index] == kHashMapEmpty) {
+      --growth_left_;
+    }
+    SetCtrl(index, H2(hash));
+    new (slot(index))
+        value_type(std::piecewise_construct,
+                   std::forward_as_tuple(std::forward<K>(key)),
+                   std::forward_as_tuple(std::forward<Args>(args)...));
+    ++size_;
+    return std::make_pair(MakeIterator(index), true);
+  }
+
+  void EraseIndex(size_t index) {
+    std::destroy_at(slot(index));
+    --size_;
+
+    // If the slot is part of a run of fewer than `kWidth` full or deleted
+    // slots, no lookup could have continued past it, and it can be marked as
+    // empty. Small tables are always covered by a single group.
+    bool was_never_full = num_slots_ < kWidth;
+    if (!was_never_full) {
+      size_t before = (index - kWidth) & (num_slots_ - 1);
+      uint64_t empty_before = HashMapGroup(ctrl_ + before).MaskEmpty();
+      uint64_t empty_after = HashMapGroup(ctrl_ + index).MaskEmpty();
+      was_never_full =
+          empty_before != 0 && empty_after != 0 &&
+          HashMapGroup::LowestIndex(empty_after) +
+                  (kWidth - 1 - HashMapGroup::HighestIndex(empty_before)) <
+              kWidth;
+    }
+    if (was_never_full) {
+      SetCtrl(index, kHashMapEmpty);
+      ++growth_left_;
+    } else {
+      SetCtrl(index, kHashMapDeleted);
+    }
+  }
+
+  int8_t* ctrl_ = nullptr;
+  std::byte* slots_ = nullptr;
+  size_t num_slots_ = 0;
+  size_t capacity_ = 0;
+  size_t size_ = 0;
+  size_t growth_left_ = 0;
+};
+
+}  // namespace pw::containers::internal
@@ -0,0 +1,344 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "pw_assert/assert.h"
+#include "pw_containers/flat_map.h"
+
+namespace pw::containers {
+namespace internal {
+
+/// Finalizes a 64-bit hash, so that every input bit affects every output bit.
+constexpr uint64_t PerfectHashMix(uint64_t x) {
+  x ^= x >> 33;
+  x *= 0xff51afd7ed558ccdull;
+  x ^= x >> 33;
+  x *= 0xc4ceb9fe1a85ec53ull;
+  x ^= x >> 33;
+  return x;
+}
+
+/// Hashes a key using the given seed. Keys may be integers, enums, or types
+/// that are convertible to `std::string_view`.
+template <typename Key>
+constexpr uint64_t PerfectHash(const Key& key, uint64_t seed) {
+  if constexpr (std::is_enum_v<Key>) {
+    return PerfectHash(static_cast<std::underlying_type_t<Key>>(key), seed);
+  } else if constexpr (std::is_integral_v<Key>) {
+    return PerfectHashMix(static_cast<uint64_t>(key) ^ seed);
+  } else {
+    static_assert(std::is_convertible_v<const Key&, std::string_view>,
+                  "PerfectHashMap keys must be integers, enums, or strings");
+    uint64_t hash = 0xcbf29ce484222325ull ^ seed;  // FNV-1a
+    for (char c : std::string_view(key)) {
+      hash ^= static_cast<uint8_t>(c);
+      hash *= 0x100000001b3ull;
+    }
+    return PerfectHashMix(hash);
+  }
+}
+
+/// Maps a 32-bit value uniformly onto `[0, n)` without a division.
+constexpr size_t PerfectHashReduce(uint32_t x, size_t n) {
+  return static_cast<size_t>((uint64_t{x} * n) >> 32);
+}
+
+/// Returns the number of buckets used for the given number of keys.
+constexpr size_t PerfectHashNumBuckets(size_t num_keys) {
+  return num_keys < 2 ? 1 : num_keys / 2;
+}
+
+constexpr size_t PerfectHashBucket(uint64_t hash, size_t num_buckets) {
+  return PerfectHashReduce(static_cast<uint32_t>(hash >> 32), num_buckets);
+}
+
+/// Combines a key's hash with its bucket's pilot to select a slot. The
+/// multiplication ensures keys in the same bucket are displaced independently.
+constexpr size_t PerfectHashSlot(uint64_t hash,
+                                 uint16_t pilot,
+                                 size_t num_keys) {
+  uint64_t displaced = (hash ^ (pilot * 0x9e3779b97f4a7c15ull)) *
+                       0xd6e8feb86659fd93ull;
+  return PerfectHashReduce(static_cast<uint32_t>(displaced >> 32), num_keys);
+}
+
+/// Result of building a perfect hash function.
+template <size_t kNumKeys, size_t kNumBuckets>
+struct PerfectHashLayout {
+  uint64_t seed = 0;
+  std::array<uint16_t, kNumBuckets> pilots{};
+
+  /// Index of the item stored in each slot.
+  std::array<size_t, kNumKeys> order{};
+};
+
+/// Attempts to find a pilot for each bucket using the given seed.
+///
+/// Buckets are placed from largest to smallest. For each, pilots are tried in
+/// order until every key in the bucket maps to a distinct, free slot.
+///
+/// @returns  false if no pilot was found for a bucket, or if two different
+///           keys have the same hash.
+template <size_t kNumBuckets, typename Key, typename Value, size_t kNumKeys>
+constexpr bool TryBuildPerfectHash(
+    const std::array<Pair<Key, Value>, kNumKeys>& items,
+    PerfectHashLayout<kNumKeys, kNumBuckets>& layout) {
+  std::array<uint64_t, kNumKeys> hashes{};
+  std::array<size_t, kNumBuckets + 1> starts{};
+  for (size_t i = 0; i < kNumKeys; ++i) {
+    hashes[i] = PerfectHash(items[i].first, layout.seed);
+    ++starts[PerfectHashBucket(hashes[i], kNumBuckets) + 1];
+  }
+
+  // Group the keys by bucket.
+  size_t max_bucket_size = 0;
+  for (size_t b = 0; b < kNumBuckets; ++b) {
+    max_bucket_size = std::max(max_bucket_size, starts[b + 1]);
+    starts[b + 1] += starts[b];
+  }
+  std::array<size_t, kNumBuckets> ends{};
+  for (size_t b = 0; b < kNumBuckets; ++b) {
+    ends[b] = starts[b];
+  }
+  std::array<size_t, kNumKeys> keys{};
+  for (size_t i = 0; i < kNumKeys; ++i) {
+    keys[ends[PerfectHashBucket(hashes[i], kNumBuckets)]++] = i;
+  }
+
+  // Keys with equal hashes can never be separated.
+  for (size_t b = 0; b < kNumBuckets; ++b) {
+    for (size_t i = starts[b]; i < ends[b]; ++i) {
+      for (size_t j = i + 1; j < ends[b]; ++j) {
+        if (hashes[keys[i]] == hashes[keys[j]]) {
+          // Duplicate keys are not allowed.
+          PW_ASSERT(!(items[keys[i]].first == items[keys[j]].first));
+          return false;
+        }
+      }
+    }
+  }
+
+  std::array<bool, kNumKeys> taken{};
+  std::array<size_t, kNumKeys> slots{};
+  for (size_t size = max_bucket_size; size != 0; --size) {
+    for (size_t b = 0; b < kNumBuckets; ++b) {
+      if (ends[b] - starts[b] != size) {
+        continue;
+      }
+      bool placed = false;
+      for (uint32_t pilot = 0; pilot <= UINT16_MAX && !placed; ++pilot) {
+        size_t num_taken = 0;
+        for (size_t i = starts[b]; i < ends[b]; ++i) {
+          size_t slot = PerfectHashSlot(
+              hashes[keys[i]], static_cast<uint16_t>(pilot), kNumKeys);
+          if (taken[slot]) {
+            break;
+          }
+          taken[slot] = true;
+          slots[num_taken++] = slot;
+        }
+        if (num_taken == size) {
+          for (size_t i = 0; i < size; ++i) {
+            layout.order[slots[i]] = keys[starts[b] + i];
+          }
+          layout.pilots[b] = static_cast<uint16_t>(pilot);
+          placed = true;
+        } else {
+          for (size_t i = 0; i < num_taken; ++i) {
+            taken[slots[i]] = false;
+          }
+        }
+      }
+      if (!placed) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/// Builds a minimal perfect hash function for the keys of the given items.
+///
+/// This uses "hash and displace": keys are hashed into buckets, and each
+/// bucket is assigned a "pilot" value that displaces its keys into distinct
+/// slots. If no pilots can be found, the keys are hashed again with a
+/// different seed.
+template <size_t kNumBuckets, typename Key, typename Value, size_t kNumKeys>
+constexpr PerfectHashLayout<kNumKeys, kNumBuckets> BuildPerfectHash(
+    const std::array<Pair<Key, Value>, kNumKeys>& items) {
+  constexpr size_t kMaxAttempts = 16;
+  PerfectHashLayout<kNumKeys, kNumBuckets> layout;
+  for (uint64_t attempt = 0; attempt < kMaxAttempts; ++attempt) {
+    layout.seed = attempt * 0x9e3779b97f4a7c15ull;
+    if (TryBuildPerfectHash<kNumBuckets>(items, layout)) {
+      return layout;
+    }
+  }
+  PW_ASSERT(false);
+  return layout;
+}
+
+}  // namespace internal
+
+/// A fixed-size associative array with constant-time lookup by key.
+///
+/// Like `FlatMap`, a `PerfectHashMap` is constructed from a list of key-value
+/// pairs, and its keys cannot be added or removed. When constructed in a
+/// `constexpr` context, it computes a minimal perfect hash function for its
+/// keys at compile time. Each lookup then hashes the key once, reads a single
+/// 16-bit value from a table, and compares a single key. There is no search,
+/// and no data-dependent branches.
+///
+/// PerfectHashMaps can be initialized by:
+/// @rst
+/// .. literalinclude:: examples/perfect_hash_map.cc
+///    :language: cpp
+///    :linenos:
+///    :start-after: [pw_containers-perfect_hash_map]
+///    :end-before: [pw_containers-perfect_hash_map]
+/// @endrst
+///
+/// Keys may be integers, enums, or strings that are convertible to
+/// `std::string_view`. Keys must be unique. The items are not stored in sorted
+/// order, and iterating over the map visits them in an unspecified order.
+///
+/// In addition to the items, the map stores a 16-bit value per 2 keys. Maps
+/// should always be declared `constexpr`, since building the perfect hash
+/// function at run time uses a large amount of stack.
+template <typename Key, typename Value, size_t kArraySize>
+class PerfectHashMap {
+ public:
+  using key_type = Key;
+  using mapped_type = Value;
+  using value_type = Pair<key_type, mapped_type>;
+  using pointer = value_type*;
+  using reference = value_type&;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using container_type = typename std::array<value_type, kArraySize>;
+  using iterator = typename container_type::iterator;
+  using const_iterator = typename container_type::const_iterator;
+
+  constexpr PerfectHashMap(const std::array<value_type, kArraySize>& items)
+      : PerfectHashMap(items,
+                       internal::BuildPerfectHash<kNumBuckets>(items),
+                       std::make_index_sequence<kArraySize>()) {}
+
+  // Omits explicit here to support assignment-like syntax, which is common to
+  // initialize a container.
+  template <typename... Items,
+            typename = std::enable_if_t<
+                std::conjunction_v<std::is_same<Items, value_type>...>>>
+  constexpr PerfectHashMap(const Items&... items)
+      : PerfectHashMap(std::array<value_type, sizeof...(Items)>{items...}) {}
+
+  PerfectHashMap(PerfectHashMap&) = delete;
+  PerfectHashMap& operator=(PerfectHashMap&) = delete;
+
+  // Capacity.
+  constexpr size_type size() const { return kArraySize; }
+  constexpr size_type empty() const { return size() == 0; }
+  constexpr size_type max_size() const { return kArraySize; }
+
+  // Lookup.
+  /// Accesses a mutable mapped value.
+  ///
+  /// @pre The key must exist.
+  ///
+  /// @param[in] key The key to the mapped value.
+  ///
+  /// @returns A reference to the mapped value.
+  constexpr mapped_type& at(const key_type& key) {
+    size_t slot = FindSlot(key);
+    PW_ASSERT(slot != kArraySize);
+    return items_[slot].second;
+  }
+
+  /// Accesses a mapped value.
+  ///
+  /// @pre The key must exist.
+  ///
+  /// @param[in] key The key to the mapped value.
+  ///
+  /// @returns A const reference to the mapped value.
+  constexpr const mapped_type& at(const key_type& key) const {
+    size_t slot = FindSlot(key);
+    PW_ASSERT(slot != kArraySize);
+    return items_[slot].second;
+  }
+
+  constexpr bool contains(const key_type& key) const {
+    return FindSlot(key) != kArraySize;
+  }
+
+  constexpr size_type count(const key_type& key) const {
+    return contains(key) ? 1 : 0;
+  }
+
+  constexpr const_iterator find(const key_type& key) const {
+    return begin() + static_cast<difference_type>(FindSlot(key));
+  }
+
+  // Iterators.
+  constexpr const_iterator begin() const { return cbegin(); }
+  constexpr const_iterator cbegin() const { return items_.cbegin(); }
+  constexpr const_iterator end() const { return cend(); }
+  constexpr const_iterator cend() const { return items_.cend(); }
+
+ private:
+  static constexpr size_t kNumBuckets =
+      internal::PerfectHashNumBuckets(kArraySize);
+
+  using Layout = internal::PerfectHashLayout<kArraySize, kNumBuckets>;
+
+  template <size_t... kIndices>
+  constexpr PerfectHashMap(const std::array<value_type, kArraySize>& items,
+                           const Layout& layout,
+                           std::index_sequence<kIndices...>)
+      : items_{{items[layout.order[kIndices]]...}},
+        pilots_(layout.pilots),
+        seed_(layout.seed) {}
+
+  /// Returns the slot holding the given key, or `kArraySize` if the key is
+  /// not present.
+  constexpr size_t FindSlot(const key_type& key) const {
+    if constexpr (kArraySize == 0) {
+      static_cast<void>(key);
+      return 0;
+    } else {
+      uint64_t hash = internal::PerfectHash(key, seed_);
+      uint16_t pilot = pilots_[internal::PerfectHashBucket(hash, kNumBuckets)];
+      size_t slot = internal::PerfectHashSlot(hash, pilot, kArraySize);
+      return items_[slot].first == key ? slot : kArraySize;
+    }
+  }
+
+  std::array<value_type, kArraySize> items_;
+  std::array<uint16_t, kNumBuckets> pilots_;
+  uint64_t seed_;
+};
+
+template <typename K, typename V, typename... Items>
+PerfectHashMap(const Pair<K, V>& item1, const Items&... items)
+    -> PerfectHashMap<K, V, 1 + sizeof...(items)>;
+
+}  // namespace pw::containers
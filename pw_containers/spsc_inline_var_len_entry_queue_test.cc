@@ -0,0 +1,177 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#include "pw_containers/inline_var_len_entry_queue.h"
+#include "pw_thread/test_thread_context.h"
+#include "pw_thread/thread.h"
+#include "pw_thread/yield.h"
+#include "pw_unit_test/framework.h"
+
+namespace {
+
+using namespace std::literals::string_view_literals;
+
+template <typename Queue>
+std::string_view Front(const Queue& queue, std::array<char, 16>& buffer) {
+  auto entry = queue.front();
+  const auto size = static_cast<uint32_t>(buffer.size());
+  return std::string_view(buffer.data(), entry.copy(buffer.data(), size));
+}
+
+TEST(SpscInlineVarLenEntryQueue, Construct_Constexpr) {
+  constexpr pw::SpscInlineVarLenEntryQueue<127> queue(pw::kConstexpr);
+  EXPECT_TRUE(queue.empty());
+  EXPECT_EQ(queue.max_size_bytes(),
+            pw::InlineVarLenEntryQueue<127>().max_size_bytes());
+}
+
+TEST(SpscInlineVarLenEntryQueue, PushPop) {
+  pw::BasicSpscInlineVarLenEntryQueue<char, 10> queue;
+  std::array<char, 16> buffer;
+
+  EXPECT_TRUE(queue.empty());
+  EXPECT_TRUE(queue.try_push("abc"sv));
+  EXPECT_TRUE(queue.try_push(""sv));
+  EXPECT_TRUE(queue.try_push("de"sv));
+  EXPECT_FALSE(queue.empty());
+
+  EXPECT_EQ(Front(queue, buffer), "abc"sv);
+  queue.pop();
+  EXPECT_EQ(Front(queue, buffer), ""sv);
+  queue.pop();
+  EXPECT_EQ(Front(queue, buffer), "de"sv);
+  queue.pop();
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(SpscInlineVarLenEntryQueue, TryPush_Full) {
+  pw::BasicSpscInlineVarLenEntryQueue<char, 5> queue;
+  EXPECT_TRUE(queue.try_push("12345"sv));
+  EXPECT_FALSE(queue.try_push(""sv));
+
+  queue.pop();
+  EXPECT_TRUE(queue.try_push("1"sv));
+  EXPECT_TRUE(queue.try_push("2"sv));
+  EXPECT_TRUE(queue.try_push(""sv));
+  EXPECT_FALSE(queue.try_push("3"sv));
+}
+
+TEST(SpscInlineVarLenEntryQueue, Entry_Wraps) {
+  pw::BasicSpscInlineVarLenEntryQueue<char, 5> queue;
+  std::array<char, 16> buffer;
+
+  EXPECT_TRUE(queue.try_push("12"sv));
+  queue.pop();
+  EXPECT_TRUE(queue.try_push("ABCDE"sv));
+
+  // The 7-byte buffer has 3 bytes after the prefix before it wraps.
+  auto front = queue.front();
+  const auto [span_1, span_2] = front.contiguous_data();
+  EXPECT_EQ(span_1.size(), 3u);
+  EXPECT_EQ(span_2.size(), 2u);
+  EXPECT_EQ(Front(queue, buffer), "ABCDE"sv);
+}
+
+TEST(SpscInlineVarLenEntryQueue, Clear) {
+  pw::BasicSpscInlineVarLenEntryQueue<char, 10> queue;
+  EXPECT_TRUE(queue.try_push("abc"sv));
+  EXPECT_TRUE(queue.try_push("def"sv));
+  queue.clear();
+  EXPECT_TRUE(queue.empty());
+  EXPECT_TRUE(queue.try_push("0123456789"sv));
+}
+
+TEST(SpscInlineVarLenEntryQueue, RawStorage_MatchesInlineVarLenEntryQueue) {
+  pw::SpscInlineVarLenEntryQueue<9> spsc_queue(pw::kConstexpr);
+  pw::InlineVarLenEntryQueue<9> queue(pw::kConstexpr);
+
+  for (std::string_view entry : {"1234"sv, "5678"sv, ""sv}) {
+    ASSERT_TRUE(spsc_queue.try_push(pw::as_bytes(pw::span(entry))));
+    ASSERT_TRUE(queue.try_push(pw::as_bytes(pw::span(entry))));
+    spsc_queue.pop();
+    queue.pop();
+  }
+  ASSERT_TRUE(spsc_queue.try_push(pw::as_bytes(pw::span("abcdefg"sv))));
+  ASSERT_TRUE(queue.try_push(pw::as_bytes(pw::span("abcdefg"sv))));
+
+  auto spsc_storage = spsc_queue.raw_storage();
+  auto storage = queue.raw_storage();
+  ASSERT_EQ(spsc_storage.size(), storage.size());
+  EXPECT_EQ(std::memcmp(spsc_storage.data(), storage.data(), storage.size()),
+            0);
+
+  // The storage can be decoded as a regular queue.
+  std::array<uint32_t, sizeof(spsc_queue) / sizeof(uint32_t)> copy;
+  std::memcpy(copy.data(), spsc_storage.data(), spsc_storage.size());
+  EXPECT_EQ(pw_InlineVarLenEntryQueue_Size(copy.data()), 1u);
+  EXPECT_EQ(pw_InlineVarLenEntryQueue_SizeBytes(copy.data()), 7u);
+}
+
+// Pushes entries of varying sizes whose contents depend on their index.
+constexpr uint32_t kNumEntries = 20000;
+constexpr size_t kMaxEntrySize = 13;
+
+size_t EntrySize(uint32_t index) { return index % (kMaxEntrySize + 1); }
+
+std::byte EntryByte(uint32_t index, size_t offset) {
+  return static_cast<std::byte>(index * 7 + offset);
+}
+
+TEST(SpscInlineVarLenEntryQueue, ProducerAndConsumerThreads) {
+  static pw::SpscInlineVarLenEntryQueue<32> queue;
+
+  pw::thread::test::TestThreadContext context;
+  pw::Thread producer(context.options(), [] {
+    std::array<std::byte, kMaxEntrySize> entry;
+    for (uint32_t i = 0; i < kNumEntries; ++i) {
+      const size_t size = EntrySize(i);
+      for (size_t j = 0; j < size; ++j) {
+        entry[j] = EntryByte(i, j);
+      }
+      while (!queue.try_push(pw::span(entry.data(), size))) {
+        pw::this_thread::yield();
+      }
+    }
+  });
+
+  uint32_t mismatches = 0;
+  std::array<std::byte, kMaxEntrySize> entry;
+  for (uint32_t i = 0; i < kNumEntries; ++i) {
+    while (queue.empty()) {
+      pw::this_thread::yield();
+    }
+    const size_t size = queue.front().copy(entry.data(), kMaxEntrySize);
+    if (size != EntrySize(i)) {
+      ++mismatches;
+    }
+    for (size_t j = 0; j < size; ++j) {
+      if (entry[j] != EntryByte(i, j)) {
+        ++mismatches;
+      }
+    }
+    queue.pop();
+  }
+  producer.join();
+
+  EXPECT_EQ(mismatches, 0u);
+  EXPECT_TRUE(queue.empty());
+}
+
+}  // namespace
@@ -14,6 +14,8 @@
 
 #include "pw_hdlc/decoder.h"
 
+#include <cstring>
+
 #include "pw_assert/check.h"
 #include "pw_bytes/endian.h"
 #include "pw_hdlc/internal/protocol.h"
@@ -23,6 +25,37 @@
 using std::byte;
 
 namespace pw::hdlc {
+namespace {
+
+// Returns the index of the first flag or escape byte in data, or data.size()
+// if there are none. Checks eight bytes at a time by testing each word for a
+// zero byte after XORing it with the flag and escape values.
+size_t FindFlagOrEscape(ConstByteSpan data) {
+  constexpr uint64_t kOnes = 0x0101010101010101u;
+  constexpr uint64_t kHighBits = 0x8080808080808080u;
+  constexpr uint64_t kFlags = kOnes * std::to_integer<uint64_t>(kFlag);
+  constexpr uint64_t kEscapes = kOnes * std::to_integer<uint64_t>(kEscape);
+
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= data.size(); i += sizeof(uint64_t)) {
+    uint64_t word;
+    std::memcpy(&word, &data[i], sizeof(word));
+    const uint64_t flags = word ^ kFlags;
+    const uint64_t escapes = word ^ kEscapes;
+    if ((((flags - kOnes) & ~flags) | ((escapes - kOnes) & ~escapes)) &
+        kHighBits) {
+      break;  // This word contains a flag or escape; find it below.
+    }
+  }
+  for (; i < data.size(); ++i) {
+    if (NeedsEscaping(data[i])) {
+      break;
+    }
+  }
+  return i;
+}
+
+}  // namespace
 
 Result<Frame> Frame::Parse(ConstByteSpan frame) {
   uint64_t address;
@@ -118,6 +151,94 @@ void Decoder::AppendByte(byte new_byte) {
   current_frame_size_ += 1;
 }
 
+size_t Decoder::ConsumeRun(ConstByteSpan data) {
+  switch (state_) {
+    case State::kInterFrame: {
+      // Bytes between frames are discarded, but counted to report an error.
+      const void* flag = std::memchr(
+          data.data(), std::to_integer<int>(kFlag), data.size());
+      const size_t discarded =
+          flag == nullptr ? data.size()
+                          : static_cast<size_t>(static_cast<const byte*>(flag) -
+                                                data.data());
+      current_frame_size_ += discarded;
+      return discarded;
+    }
+    case State::kFrameEscape:
+      // The flag character cannot be escaped, and two escapes in a row abort
+      // the frame; leave both for Process(std::byte) to report.
+      if (NeedsEscaping(data.front())) {
+        return 0;
+      }
+      state_ = State::kFrame;
+      AppendByte(Escape(data.front()));
+      return 1 + ConsumeRun(data.subspan(1));
+    case State::kFrame: {
+      size_t consumed = 0;
+      while (consumed < data.size()) {
+        const ConstByteSpan remaining = data.subspan(consumed);
+        const size_t run = NeedsEscaping(remaining.front())
+                               ? 0
+                               : FindFlagOrEscape(remaining);
+        AppendRun(remaining.first(run));
+        consumed += run;
+
+        // Unescape an escaped data byte in place, rather than returning to
+        // Process(std::byte) for each half of the escape sequence.
+        if (consumed + 1 < data.size() && data[consumed] == kEscape &&
+            !NeedsEscaping(data[consumed + 1])) {
+          AppendByte(Escape(data[consumed + 1]));
+          consumed += 2;
+          continue;
+        }
+        break;
+      }
+      return consumed;
+    }
+  }
+  PW_CRASH("Bad decoder state");
+}
+
+void Decoder::AppendRun(ConstByteSpan run) {
+  // Short runs cannot evict the whole FCS ring buffer; append them bytewise.
+  if (run.size() < last_read_bytes_.size()) {
+    for (byte b : run) {
+      AppendByte(b);
+    }
+    return;
+  }
+
+  if (current_frame_size_ < max_size()) {
+    const size_t to_copy =
+        std::min(run.size(), max_size() - current_frame_size_);
+    std::memcpy(&buffer_[current_frame_size_], run.data(), to_copy);
+  }
+
+  // Every byte in the ring buffer is evicted, oldest first, followed by all but
+  // the last four bytes of the run. The last four bytes of the run become the
+  // new contents of the ring buffer.
+  const size_t buffered =
+      std::min(current_frame_size_, last_read_bytes_.size());
+  std::array<byte, sizeof(uint32_t)> evicted;
+  size_t index =
+      buffered < last_read_bytes_.size() ? 0 : last_read_bytes_index_;
+  for (size_t i = 0; i < buffered; ++i) {
+    evicted[i] = last_read_bytes_[index];
+    index = (index + 1) % last_read_bytes_.size();
+  }
+  fcs_.Update(span(evicted).first(buffered));
+
+  const size_t checksummed = run.size() - last_read_bytes_.size();
+  fcs_.Update(run.first(checksummed));
+  std::memcpy(last_read_bytes_.data(),
+              &run[checksummed],
+              last_read_bytes_.size());
+  last_read_bytes_index_ = 0;
+
+  // Always increase size: if it is larger than the buffer, overflow occurred.
+  current_frame_size_ += run.size();
+}
+
 Status Decoder::CheckFrame() const {
   // Empty frames are not an error; repeated flag characters are okay.
   if (current_frame_size_ == 0u) {
@@ -0,0 +1,102 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <array>
+#include <cstddef>
+
+#include "pw_assert/assert.h"
+#include "pw_bytes/span.h"
+#include "pw_hdlc/decoder.h"
+#include "pw_hdlc/encoder.h"
+#include "pw_perf_test/perf_test.h"
+#include "pw_stream/memory_stream.h"
+
+namespace pw::hdlc {
+namespace {
+
+constexpr size_t kMaxPayloadSize = 1024;
+constexpr size_t kFramesPerStream = 8;
+
+// Builds a stream of kFramesPerStream UI frames with payloads of the given
+// size. One in every escape_interval payload bytes is a flag byte, which must
+// be escaped on the wire; 0 means no payload bytes are escaped.
+ConstByteSpan EncodeFrames(size_t payload_size, size_t escape_interval) {
+  static std::array<std::byte, kFramesPerStream * 2 * (kMaxPayloadSize + 32)>
+      encoded;
+  std::array<std::byte, kMaxPayloadSize> payload;
+  for (size_t i = 0; i < payload_size; ++i) {
+    payload[i] = escape_interval != 0 && i % escape_interval == 0
+                     ? kFlag
+                     : static_cast<std::byte>(i % 0x7D);
+  }
+
+  stream::MemoryWriter writer(encoded);
+  for (size_t i = 0; i < kFramesPerStream; ++i) {
+    if (!WriteUIFrame(1, span(payload).first(payload_size), writer).ok()) {
+      return {};
+    }
+  }
+  return writer.WrittenData();
+}
+
+void DecodeByteWise(perf_test::State& state,
+                    size_t payload_size,
+                    size_t escape_interval) {
+  ConstByteSpan data = EncodeFrames(payload_size, escape_interval);
+  DecoderBuffer<kMaxPayloadSize + 16> decoder;
+  size_t frames = 0;
+  while (state.KeepRunning()) {
+    for (std::byte b : data) {
+      if (decoder.Process(b).ok()) {
+        frames += 1;
+      }
+    }
+  }
+  PW_ASSERT(frames != 0);
+}
+
+void DecodeBulk(perf_test::State& state,
+                size_t payload_size,
+                size_t escape_interval) {
+  ConstByteSpan data = EncodeFrames(payload_size, escape_interval);
+  DecoderBuffer<kMaxPayloadSize + 16> decoder;
+  size_t frames = 0;
+  while (state.KeepRunning()) {
+    decoder.Process(data, [&frames](const Result<Frame>& result) {
+      if (result.ok()) {
+        frames += 1;
+      }
+    });
+  }
+  PW_ASSERT(frames != 0);
+}
+
+PW_PERF_TEST(DecodeByteWise_16Bytes, DecodeByteWise, 16, 0);
+PW_PERF_TEST(DecodeBulk_16Bytes, DecodeBulk, 16, 0);
+
+PW_PERF_TEST(DecodeByteWise_256Bytes, DecodeByteWise, 256, 0);
+PW_PERF_TEST(DecodeBulk_256Bytes, DecodeBulk, 256, 0);
+
+PW_PERF_TEST(DecodeByteWise_1KiB, DecodeByteWise, 1024, 0);
+PW_PERF_TEST(DecodeBulk_1KiB, DecodeBulk, 1024, 0);
+
+// Escapes break the payload into shorter runs.
+PW_PERF_TEST(DecodeByteWise_1KiBEscapeEvery16, DecodeByteWise, 1024, 16);
+PW_PERF_TEST(DecodeBulk_1KiBEscapeEvery16, DecodeBulk, 1024, 16);
+
+PW_PERF_TEST(DecodeByteWise_1KiBEscapeEvery2, DecodeByteWise, 1024, 2);
+PW_PERF_TEST(DecodeBulk_1KiBEscapeEvery2, DecodeBulk, 1024, 2);
+
+}  // namespace
+}  // namespace pw::hdlc
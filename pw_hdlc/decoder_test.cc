@@ -14,10 +14,12 @@
 
 #include "pw_hdlc/decoder.h"
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
 
 #include "pw_bytes/array.h"
+#include "pw_checksum/crc32.h"
 #include "pw_fuzzer/fuzztest.h"
 #include "pw_hdlc/internal/protocol.h"
 #include "pw_unit_test/framework.h"
@@ -154,6 +156,119 @@ TEST(Decoder, TooLargeForBuffer_DecodesNextFrame) {
   EXPECT_EQ(OkStatus(), decoder.Process(kFlag).status());
 }
 
+// Summarizes the frames and errors a decoder reports, so that the results of
+// byte-wise and bulk decoding can be compared.
+class ResultLog {
+ public:
+  void Add(const Result<Frame>& result) {
+    count_ += 1;
+    const auto code = static_cast<uint8_t>(result.status().code());
+    crc_.Update(byte{code});
+    if (result.ok()) {
+      const uint64_t address = result.value().address();
+      crc_.Update(as_bytes(span(&address, 1)));
+      crc_.Update(result.value().control());
+      crc_.Update(result.value().data());
+    }
+  }
+
+  size_t count() const { return count_; }
+
+  bool operator==(const ResultLog& other) const {
+    return count_ == other.count_ && crc_.value() == other.crc_.value();
+  }
+
+ private:
+  size_t count_ = 0;
+  checksum::Crc32 crc_;
+};
+
+template <size_t kBufferSize>
+ResultLog DecodeByteWise(ConstByteSpan data) {
+  DecoderBuffer<kBufferSize> decoder;
+  ResultLog log;
+  for (byte b : data) {
+    auto result = decoder.Process(b);
+    if (result.status() != Status::Unavailable()) {
+      log.Add(result);
+    }
+  }
+  return log;
+}
+
+template <size_t kBufferSize>
+ResultLog DecodeBulk(ConstByteSpan data, size_t chunk_size) {
+  DecoderBuffer<kBufferSize> decoder;
+  ResultLog log;
+  while (!data.empty()) {
+    const size_t size = std::min(chunk_size, data.size());
+    decoder.Process(data.first(size),
+                    [&log](const Result<Frame>& result) { log.Add(result); });
+    data = data.subspan(size);
+  }
+  return log;
+}
+
+// A valid frame, a frame that overflows an 8-byte buffer, a valid frame with
+// escaped bytes, a frame aborted by a double escape followed by discarded
+// bytes, a frame too short to be valid, an overflowing frame, and a frame with
+// a bad FCS.
+constexpr auto kStream = bytes::Concat(
+    bytes::String("~1234\xa3\xe0\xe3\x9b~"),
+    bytes::String("~12345678901234567890\xf2\x19\x63\x90~"),
+    bytes::String("~\x01\x03\x7d\x5e\x7d\x5d\x41\xa4\x42\xd2\x2c~"),
+    bytes::String("12\x7d\x7dgarbage~"),
+    bytes::String("abc~"),
+    bytes::String("12345\x1c\x3a\xf5\xcb~"),
+    bytes::String("~1234\xa3\xe0\xe3\x9c~~~"));
+
+TEST(Decoder, BulkProcess_MatchesByteWise) {
+  const ResultLog expected = DecodeByteWise<8>(kStream);
+  EXPECT_EQ(expected.count(), 7u);
+
+  for (size_t chunk_size = 1; chunk_size <= kStream.size(); ++chunk_size) {
+    EXPECT_TRUE(DecodeBulk<8>(kStream, chunk_size) == expected)
+        << "chunk size " << chunk_size;
+  }
+}
+
+TEST(Decoder, BulkProcess_LargeBufferMatchesByteWise) {
+  const ResultLog expected = DecodeByteWise<64>(kStream);
+  for (size_t chunk_size = 1; chunk_size <= kStream.size(); ++chunk_size) {
+    EXPECT_TRUE(DecodeBulk<64>(kStream, chunk_size) == expected)
+        << "chunk size " << chunk_size;
+  }
+}
+
+TEST(Decoder, BulkProcess_TooLargeForBuffer_StaysWithinBufferBoundaries) {
+  std::array<byte, 16> buffer = bytes::Initialized<16>('?');
+
+  Decoder decoder(span(buffer.data(), 8));
+  Status status = Status::Unknown();
+  decoder.Process(
+      bytes::String("~12345678901234567890\xf2\x19\x63\x90~"),
+      [&status](const Result<Frame>& result) { status = result.status(); });
+
+  for (size_t i = 8; i < buffer.size(); ++i) {
+    ASSERT_EQ(byte{'?'}, buffer[i]);
+  }
+  EXPECT_EQ(Status::ResourceExhausted(), status);
+}
+
+void BulkProcessMatchesByteWise(ConstByteSpan data, size_t chunk_size) {
+  EXPECT_TRUE(DecodeBulk<64>(data, chunk_size) == DecodeByteWise<64>(data));
+}
+
+FUZZ_TEST(Decoder, BulkProcessMatchesByteWise)
+    .WithDomains(VectorOf<1024>(ElementOf<byte>({kFlag,
+                                                 kEscape,
+                                                 byte{0x5D},
+                                                 byte{0x5E},
+                                                 byte{0x00},
+                                                 byte{0x31},
+                                                 byte{0xFF}})),
+                 InRange<size_t>(1, 1024));
+
 void ProcessNeverCrashes(ConstByteSpan data) {
   DecoderBuffer<1024> decoder;
   for (byte b : data) {
@@ -112,10 +112,23 @@ class Decoder {
 
   /// @brief Processes a span of data and calls the provided callback with each
   /// frame or error.
+  ///
+  /// Bytes that cannot complete a frame (frame data, escaped frame data, and
+  /// discarded inter-frame bytes) are consumed in bulk: runs of unescaped data
+  /// are located with a word-at-a-time scan, copied to the frame buffer in one
+  /// operation, and folded into the frame check sequence together. Flag bytes
+  /// and invalid escapes are handled by `Process(std::byte)`. The frames and
+  /// errors reported are identical to calling `Process(std::byte)` for each
+  /// byte.
   template <typename F, typename... Args>
   void Process(ConstByteSpan data, F&& callback, Args&&... args) {
-    for (std::byte b : data) {
-      auto result = Process(b);
+    while (!data.empty()) {
+      data = data.subspan(ConsumeRun(data));
+      if (data.empty()) {
+        break;
+      }
+      auto result = Process(data.front());
+      data = data.subspan(1);
       if (result.status() != Status::Unavailable()) {
         callback(std::forward<Args>(args)..., result);
       }
@@ -147,6 +160,14 @@ class Decoder {
 
   void AppendByte(std::byte new_byte);
 
+  // Consumes the leading bytes of data that cannot complete a frame or report
+  // an error. Returns the number of bytes consumed.
+  size_t ConsumeRun(ConstByteSpan data);
+
+  // Appends a run of unescaped bytes to the current frame. Equivalent to
+  // calling AppendByte for each byte.
+  void AppendRun(ConstByteSpan run);
+
   Status CheckFrame() const;
 
   bool VerifyFrameCheckSequence() const;
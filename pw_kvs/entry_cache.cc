@@ -17,6 +17,7 @@
 
 #include "pw_kvs/internal/entry_cache.h"
 
+#include <algorithm>
 #include <cinttypes>
 
 #include "pw_assert/check.h"
@@ -31,6 +32,8 @@ namespace {
 
 constexpr FlashPartition::Address kNoAddress = FlashPartition::Address(-1);
 
+constexpr EntryCache::IndexSlot kEmptySlot = 0;
+
 }  // namespace
 
 void EntryMetadata::RemoveAddress(Address address_to_remove) {
@@ -60,62 +63,69 @@ void EntryMetadata::Reset(const KeyDescriptor& descriptor, Address address) {
   addresses_ = addresses_.first(1);
 }
 
+void EntryCache::Reset() const {
+  PW_DCHECK(!has_index() || index_.size() == IndexSize(max_entries()));
+  descriptors_.clear();
+  std::fill(index_.begin(), index_.end(), kEmptySlot);
+}
+
 StatusWithSize EntryCache::Find(FlashPartition& partition,
                                 const Sectors& sectors,
                                 const EntryFormats& formats,
                                 std::string_view key,
                                 EntryMetadata* metadata) const {
   const uint32_t hash = internal::Hash(key);
+
+  // Key hashes are unique within the cache, so at most one descriptor matches.
+  const int index = FindIndex(hash);
+  if (index == -1) {
+    return StatusWithSize::NotFound();
+  }
+  const size_t i = static_cast<size_t>(index);
+
   Entry::KeyBuffer key_buffer;
   bool error_detected = false;
+  bool key_found = false;
+  std::string_view read_key;
 
-  for (size_t i = 0; i < descriptors_.size(); ++i) {
-    if (descriptors_[i].key_hash == hash) {
-      bool key_found = false;
-      std::string_view read_key;
-
-      for (Address address : addresses(i)) {
-        Status read_result =
-            Entry::ReadKey(partition, address, key.size(), key_buffer.data());
-
-        read_key = std::string_view(key_buffer.data(), key.size());
-
-        if (read_result.ok() && hash == internal::Hash(read_key)) {
-          key_found = true;
-          break;
-        } else {
-          // A hash mismatch can be caused by reading invalid data or a key hash
-          // collision of keys with differing size. To verify the data read from
-          // flash is good, validate the entry.
-          Entry entry;
-          read_result = Entry::Read(partition, address, formats, &entry);
-          if (read_result.ok() && entry.VerifyChecksumInFlash().ok()) {
-            key_found = true;
-            break;
-          }
-
-          PW_LOG_WARN(
-              "   Found corrupt entry, invalidating this copy of the key");
-          error_detected = true;
-          sectors.FromAddress(address).mark_corrupt();
-        }
-      }
-      size_t error_val = error_detected ? 1 : 0;
-
-      if (!key_found) {
-        PW_LOG_ERROR("No valid entries for key. Data has been lost!");
-        return StatusWithSize::DataLoss(error_val);
-      } else if (key == read_key) {
-        PW_LOG_DEBUG("Found match for key hash 0x%08" PRIx32, hash);
-        *metadata = EntryMetadata(descriptors_[i], addresses(i));
-        return StatusWithSize(error_val);
-      } else {
-        PW_LOG_WARN("Found key hash collision for 0x%08" PRIx32, hash);
-        return StatusWithSize::AlreadyExists(error_val);
+  for (Address address : addresses(i)) {
+    Status read_result =
+        Entry::ReadKey(partition, address, key.size(), key_buffer.data());
+
+    read_key = std::string_view(key_buffer.data(), key.size());
+
+    if (read_result.ok() && hash == internal::Hash(read_key)) {
+      key_found = true;
+      break;
+    } else {
+      // A hash mismatch can be caused by reading invalid data or a key hash
+      // collision of keys with differing size. To verify the data read from
+      // flash is good, validate the entry.
+      Entry entry;
+      read_result = Entry::Read(partition, address, formats, &entry);
+      if (read_result.ok() && entry.VerifyChecksumInFlash().ok()) {
+        key_found = true;
+        break;
       }
+
+      PW_LOG_WARN("   Found corrupt entry, invalidating this copy of the key");
+      error_detected = true;
+      sectors.FromAddress(address).mark_corrupt();
     }
   }
-  return StatusWithSize::NotFound();
+  size_t error_val = error_detected ? 1 : 0;
+
+  if (!key_found) {
+    PW_LOG_ERROR("No valid entries for key. Data has been lost!");
+    return StatusWithSize::DataLoss(error_val);
+  } else if (key == read_key) {
+    PW_LOG_DEBUG("Found match for key hash 0x%08" PRIx32, hash);
+    *metadata = EntryMetadata(descriptors_[i], addresses(i));
+    return StatusWithSize(error_val);
+  } else {
+    PW_LOG_WARN("Found key hash collision for 0x%08" PRIx32, hash);
+    return StatusWithSize::AlreadyExists(error_val);
+  }
 }
 
 EntryMetadata EntryCache::AddNew(const KeyDescriptor& descriptor,
@@ -123,6 +133,7 @@ EntryMetadata EntryCache::AddNew(const KeyDescriptor& descriptor,
   // TODO(hepler): DCHECK(!full());
   Address* first_address = ResetAddresses(descriptors_.size(), address);
   descriptors_.push_back(descriptor);
+  AddToIndex(descriptor.key_hash, descriptors_.size() - 1);
   return EntryMetadata(descriptors_.back(), span(first_address, 1));
 }
 
@@ -134,6 +145,16 @@ EntryCache::iterator EntryCache::RemoveEntry(iterator& entry_it) {
       entry_it.metadata_.descriptor_ - &descriptors_.front();
   const KeyDescriptor last_desc = descriptors_[descriptors_.size() - 1];
 
+  // Update the index while it still matches the descriptors. The last
+  // descriptor moves to the removed descriptor's position.
+  if (has_index()) {
+    RemoveFromIndex(descriptors_[index_to_remove].key_hash);
+    if (index_to_remove < descriptors_.size() - 1) {
+      index_[FindSlot(last_desc.key_hash)] =
+          static_cast<IndexSlot>(index_to_remove + 1);
+    }
+  }
+
   // Since order is not important, this copies the last descriptor into the
   // deleted descriptor's space and then pops the last entry.
   Address* addresses_at_end = first_address(descriptors_.size() - 1);
@@ -152,10 +173,9 @@ EntryCache::iterator EntryCache::RemoveEntry(iterator& entry_it) {
   return {this, descriptors_.data() + index_to_remove};
 }
 
-// TODO(hepler): This method is the trigger of the O(valid_entries *
-// all_entries) time complexity for reading. At some cost to memory, this could
-// be optimized by using a hash table instead of scanning, but in practice this
-// should be fine for a small number of keys
+// Without a key hash index, this method is the trigger of the O(valid_entries
+// * all_entries) time complexity for reading. This is fine for a small number
+// of keys; KVS instances with many keys should use a key hash index.
 Status EntryCache::AddNewOrUpdateExisting(const KeyDescriptor& descriptor,
                                           Address address,
                                           size_t sector_size_bytes) const {
@@ -220,6 +240,10 @@ size_t EntryCache::present_entries() const {
 }
 
 int EntryCache::FindIndex(uint32_t key_hash) const {
+  if (has_index()) {
+    return int{index_[FindSlot(key_hash)]} - 1;
+  }
+
   for (size_t i = 0; i < descriptors_.size(); ++i) {
     if (descriptors_[i].key_hash == key_hash) {
       return i;
@@ -228,6 +252,45 @@ int EntryCache::FindIndex(uint32_t key_hash) const {
   return -1;
 }
 
+size_t EntryCache::FindSlot(uint32_t key_hash) const {
+  const size_t mask = index_.size() - 1;
+
+  // The index is never more than half full, so this always finds an empty
+  // slot if the key hash is not present.
+  size_t slot = HomeSlot(key_hash);
+  while (index_[slot] != kEmptySlot &&
+         descriptors_[index_[slot] - 1u].key_hash != key_hash) {
+    slot = (slot + 1) & mask;
+  }
+  return slot;
+}
+
+void EntryCache::AddToIndex(uint32_t key_hash, size_t descriptor_index) const {
+  if (has_index()) {
+    index_[FindSlot(key_hash)] = static_cast<IndexSlot>(descriptor_index + 1);
+  }
+}
+
+void EntryCache::RemoveFromIndex(uint32_t key_hash) const {
+  const size_t mask = index_.size() - 1;
+  size_t hole = FindSlot(key_hash);
+  if (index_[hole] == kEmptySlot) {
+    return;
+  }
+
+  // Rather than leaving a tombstone, shift back any following slots in the
+  // probe sequence that would no longer be reachable across the hole.
+  for (size_t slot = (hole + 1) & mask; index_[slot] != kEmptySlot;
+       slot = (slot + 1) & mask) {
+    const size_t home = HomeSlot(descriptors_[index_[slot] - 1u].key_hash);
+    if (((slot - home) & mask) >= ((slot - hole) & mask)) {
+      index_[hole] = index_[slot];
+      hole = slot;
+    }
+  }
+  index_[hole] = kEmptySlot;
+}
+
 void EntryCache::AddAddressIfRoom(size_t descriptor_index,
                                   Address address) const {
   Address* const existing = first_address(descriptor_index);
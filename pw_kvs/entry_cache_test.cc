@@ -14,6 +14,8 @@
 
 #include "pw_kvs/internal/entry_cache.h"
 
+#include <array>
+
 #include "pw_bytes/array.h"
 #include "pw_kvs/fake_flash_memory.h"
 #include "pw_kvs/flash_memory.h"
@@ -31,10 +33,16 @@ class EmptyEntryCache : public ::testing::Test {
   static constexpr size_t kMaxEntries = 32;
   static constexpr size_t kRedundancy = 3;
 
-  EmptyEntryCache() : entries_(descriptors_, addresses_, kRedundancy) {}
+  EmptyEntryCache(bool use_index = false)
+      : index_(),
+        entries_(descriptors_,
+                 addresses_,
+                 kRedundancy,
+                 use_index ? span(index_) : span<EntryCache::IndexSlot>()) {}
 
   Vector<KeyDescriptor, kMaxEntries> descriptors_;
   EntryCache::AddressList<kMaxEntries, kRedundancy> addresses_;
+  EntryCache::HashIndex<kMaxEntries> index_;
 
   EntryCache entries_;
 };
@@ -248,8 +256,9 @@ class InitializedEntryCache : public EmptyEntryCache {
  protected:
   static_assert(Hash(kCollision1) == Hash(kCollision2));
 
-  InitializedEntryCache()
-      : flash_(bytes::Concat(kTheEntry,
+  InitializedEntryCache(bool use_index = false)
+      : EmptyEntryCache(use_index),
+        flash_(bytes::Concat(kTheEntry,
                              kPadding1,
                              kTheEntry,
                              kPadding1,
@@ -391,5 +400,147 @@ TEST_F(InitializedEntryCache, Find_Collision) {
   CheckForCorruptSectors();
 }
 
+class IndexedInitializedEntryCache : public InitializedEntryCache {
+ protected:
+  IndexedInitializedEntryCache() : InitializedEntryCache(true) {}
+};
+
+TEST_F(IndexedInitializedEntryCache, Find_PresentEntry) {
+  ASSERT_TRUE(entries_.has_index());
+  EntryMetadata metadata;
+
+  StatusWithSize result =
+      entries_.Find(partition_, sectors_, format_, kTheKey, &metadata);
+
+  ASSERT_EQ(OkStatus(), result.status());
+  EXPECT_EQ(Hash(kTheKey), metadata.hash());
+  EXPECT_EQ(2u, metadata.addresses().size());
+  CheckForCorruptSectors();
+}
+
+TEST_F(IndexedInitializedEntryCache, Find_DeletedEntry) {
+  EntryMetadata metadata;
+
+  StatusWithSize result =
+      entries_.Find(partition_, sectors_, format_, "delorted", &metadata);
+
+  ASSERT_EQ(OkStatus(), result.status());
+  EXPECT_EQ(EntryState::kDeleted, metadata.state());
+}
+
+TEST_F(IndexedInitializedEntryCache, Find_MissingEntry) {
+  EntryMetadata metadata;
+
+  StatusWithSize result =
+      entries_.Find(partition_, sectors_, format_, "3.141", &metadata);
+
+  EXPECT_EQ(Status::NotFound(), result.status());
+}
+
+TEST_F(IndexedInitializedEntryCache, Find_Collision) {
+  EntryMetadata metadata;
+
+  StatusWithSize result =
+      entries_.Find(partition_, sectors_, format_, kCollision2, &metadata);
+
+  EXPECT_EQ(Status::AlreadyExists(), result.status());
+}
+
+TEST_F(IndexedInitializedEntryCache, Find_AfterRemoveEntry) {
+  for (EntryCache::iterator it = entries_.begin(); it != entries_.end();) {
+    if (it->hash() == Hash(kTheKey)) {
+      it = entries_.RemoveEntry(it);
+    } else {
+      ++it;
+    }
+  }
+
+  EntryMetadata metadata;
+  EXPECT_EQ(Status::NotFound(),
+            entries_.Find(partition_, sectors_, format_, kTheKey, &metadata)
+                .status());
+
+  // The entry that was moved into the removed entry's place is still found.
+  ASSERT_EQ(OkStatus(),
+            entries_.Find(partition_, sectors_, format_, "delorted", &metadata)
+                .status());
+  EXPECT_EQ(Hash("delorted"), metadata.hash());
+}
+
+TEST_F(IndexedInitializedEntryCache, Reset_ClearsIndex) {
+  entries_.Reset();
+
+  EntryMetadata metadata;
+  EXPECT_EQ(Status::NotFound(),
+            entries_.Find(partition_, sectors_, format_, kTheKey, &metadata)
+                .status());
+}
+
+// Adds or updates the entry for a key hash. Returns the status and whether a
+// new entry was added, which shows whether the cache found the key hash.
+std::pair<Status, bool> AddOrUpdate(EntryCache& entries,
+                                    uint32_t key_hash,
+                                    uint32_t id) {
+  const size_t total_entries = entries.total_entries();
+  const Status status = entries.AddNewOrUpdateExisting(
+      {.key_hash = key_hash, .transaction_id = id, .state = EntryState::kValid},
+      id,
+      1);
+  return {status, entries.total_entries() != total_entries};
+}
+
+class IndexedEntryCache : public EmptyEntryCache {
+ protected:
+  IndexedEntryCache() : EmptyEntryCache(true) {}
+};
+
+TEST_F(IndexedEntryCache, MatchesUnindexedCache) {
+  Vector<KeyDescriptor, kMaxEntries> descriptors;
+  EntryCache::AddressList<kMaxEntries, kRedundancy> addresses;
+  EntryCache unindexed(descriptors, addresses, kRedundancy);
+
+  // Pick key hashes pseudo-randomly so that some share index slots.
+  uint32_t state = 0x12345;
+  auto next_random = [&state] {
+    state = state * 1103515245u + 12345u;
+    return state;
+  };
+  std::array<uint32_t, 2 * kMaxEntries> key_hashes;
+  for (uint32_t& key_hash : key_hashes) {
+    key_hash = next_random();
+  }
+
+  // Add, update, and remove entries in a scrambled order. Removals exercise
+  // filling holes in clusters of full slots.
+  uint32_t id = 1;
+  for (uint32_t round = 0; round < 100; ++round) {
+    const uint32_t key_hash =
+        key_hashes[(next_random() >> 16) % key_hashes.size()];
+    ASSERT_EQ(AddOrUpdate(unindexed, key_hash, id),
+              AddOrUpdate(entries_, key_hash, id));
+    id += 1;
+
+    if (round % 3 == 0) {
+      for (EntryCache* cache : {&entries_, &unindexed}) {
+        for (EntryCache::iterator it = cache->begin(); it != cache->end();) {
+          if (it->hash() % 4 == round % 4) {
+            it = cache->RemoveEntry(it);
+          } else {
+            ++it;
+          }
+        }
+      }
+    }
+
+    // Check every key hash. Transaction ID 0 leaves existing entries as they
+    // are, and adds missing entries while there is room.
+    for (uint32_t other_key_hash : key_hashes) {
+      ASSERT_EQ(AddOrUpdate(unindexed, other_key_hash, 0),
+                AddOrUpdate(entries_, other_key_hash, 0));
+    }
+    ASSERT_EQ(unindexed.total_entries(), entries_.total_entries());
+  }
+}
+
 }  // namespace
 }  // namespace pw::kvs::internal
@@ -45,11 +45,14 @@ KeyValueStore::KeyValueStore(FlashPartition* partition,
                              Vector<SectorDescriptor>& sector_descriptor_list,
                              const SectorDescriptor** temp_sectors_to_skip,
                              Vector<KeyDescriptor>& key_descriptor_list,
-                             Address* addresses)
+                             Address* addresses,
+                             span<internal::EntryCache::IndexSlot>
+                                 key_hash_index)
     : partition_(*partition),
       formats_(formats),
       sectors_(sector_descriptor_list, *partition, temp_sectors_to_skip),
-      entry_cache_(key_descriptor_list, addresses, redundancy),
+      entry_cache_(
+          key_descriptor_list, addresses, redundancy, key_hash_index),
       options_(options),
       initialized_(InitializationState::kNotInitialized),
       error_detected_(false),
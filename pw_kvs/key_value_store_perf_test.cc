@@ -0,0 +1,126 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "pw_assert/check.h"
+#include "pw_kvs/fake_flash_memory.h"
+#include "pw_kvs/flash_memory.h"
+#include "pw_kvs/key_value_store.h"
+#include "pw_perf_test/perf_test.h"
+
+namespace pw::kvs {
+namespace {
+
+// Compares finding keys by scanning the EntryCache with finding them in its
+// key hash index, for KVS instances with different numbers of keys.
+
+constexpr size_t kMaxKeys = 10000;
+
+// Each entry takes 32 bytes: a 16-byte header, a 9-byte key, and a 4-byte
+// value, aligned to 16 bytes. Leave room for garbage collection.
+constexpr size_t kSectorSize = 4096;
+constexpr size_t kSectorCount = 128;
+
+FakeFlashMemoryBuffer<kSectorSize, kSectorCount> flash(16);
+FlashPartition partition(&flash, 0, flash.sector_count());
+
+// For KVS magic value always use a random 32 bit integer rather than a
+// human readable 4 bytes. See pw_kvs/format.h for more information.
+constexpr EntryFormat kFormat{.magic = 0x5f0b5e9d, .checksum = nullptr};
+
+using KeyName = std::array<char, 9>;
+
+// Key names are generated up front so that formatting them is not measured.
+const std::array<KeyName, kMaxKeys> kKeyNames = [] {
+  std::array<KeyName, kMaxKeys> names{};
+  for (size_t i = 0; i < kMaxKeys; ++i) {
+    KeyName& name = names[i];
+    name = {'k', 'e', 'y', '_', '0', '0', '0', '0', '0'};
+    size_t number = i;
+    for (size_t digit = name.size(); number != 0; number /= 10) {
+      name[--digit] = static_cast<char>('0' + number % 10);
+    }
+  }
+  return names;
+}();
+
+std::string_view Key(size_t index) {
+  return std::string_view(kKeyNames[index].data(), kKeyNames[index].size());
+}
+
+// Returns a KVS that holds kKeys keys. Each configuration has its own KVS
+// instance, since the buffers are too large for the stack.
+template <size_t kKeys, bool kHashIndex>
+KeyValueStore& KvsWithKeys() {
+  static_assert(kKeys <= kMaxKeys);
+  static KeyValueStoreBuffer<kKeys, kSectorCount, 1, 1, kHashIndex> kvs(
+      &partition, kFormat);
+
+  PW_CHECK_OK(partition.Erase());
+  PW_CHECK_OK(kvs.Init());
+  for (size_t i = 0; i < kKeys; ++i) {
+    PW_CHECK_OK(kvs.Put(Key(i), static_cast<uint32_t>(i)));
+  }
+  return kvs;
+}
+
+template <size_t kKeys, bool kHashIndex>
+void GetKeys(perf_test::State& state) {
+  KeyValueStore& kvs = KvsWithKeys<kKeys, kHashIndex>();
+
+  // Step through the keys out of order to avoid favoring recent entries.
+  constexpr size_t kStep = 7919;
+  size_t index = 0;
+  uint32_t value = 0;
+
+  while (state.KeepRunning()) {
+    PW_CHECK_OK(kvs.Get(Key(index), &value));
+    index = (index + kStep) % kKeys;
+  }
+}
+
+template <size_t kKeys, bool kHashIndex>
+void PutKeys(perf_test::State& state) {
+  KeyValueStore& kvs = KvsWithKeys<kKeys, kHashIndex>();
+
+  constexpr size_t kStep = 7919;
+  size_t index = 0;
+  uint32_t value = 0;
+
+  while (state.KeepRunning()) {
+    PW_CHECK_OK(kvs.Put(Key(index), value++));
+    index = (index + kStep) % kKeys;
+  }
+}
+
+PW_PERF_TEST(Get_100Keys, (GetKeys<100, false>));
+PW_PERF_TEST(Get_100Keys_HashIndex, (GetKeys<100, true>));
+PW_PERF_TEST(Get_1000Keys, (GetKeys<1000, false>));
+PW_PERF_TEST(Get_1000Keys_HashIndex, (GetKeys<1000, true>));
+PW_PERF_TEST(Get_10000Keys, (GetKeys<10000, false>));
+PW_PERF_TEST(Get_10000Keys_HashIndex, (GetKeys<10000, true>));
+
+PW_PERF_TEST(Put_100Keys, (PutKeys<100, false>));
+PW_PERF_TEST(Put_100Keys_HashIndex, (PutKeys<100, true>));
+PW_PERF_TEST(Put_1000Keys, (PutKeys<1000, false>));
+PW_PERF_TEST(Put_1000Keys_HashIndex, (PutKeys<1000, true>));
+PW_PERF_TEST(Put_10000Keys, (PutKeys<10000, false>));
+PW_PERF_TEST(Put_10000Keys_HashIndex, (PutKeys<10000, true>));
+
+}  // namespace
+}  // namespace pw::kvs
@@ -472,6 +472,50 @@ TEST_F(LargeEmptyInitializedKvs, KeyDeletionMaintenance) {
   ASSERT_EQ(val, kValue2);
 }
 
+TEST(InMemoryKvs, HashIndex_MatchesUnindexed) {
+  constexpr size_t kKeys = 100;
+  ASSERT_EQ(OkStatus(), large_test_partition.Erase());
+
+  KeyValueStoreBuffer<kMaxEntries, kMaxUsableSectors, 1, 1, true> kvs(
+      &large_test_partition, default_format);
+  PW_TEST_ASSERT_OK(kvs.Init());
+
+  std::array<StringBuffer<16>, kKeys> key_names;
+  for (size_t i = 0; i < kKeys; ++i) {
+    key_names[i].Format("key_%u", static_cast<unsigned>(i));
+    PW_TEST_ASSERT_OK(kvs.Put(key_names[i].view(), static_cast<uint32_t>(i)));
+  }
+
+  // Delete every third key, and remove the deleted entries from the cache.
+  for (size_t i = 0; i < kKeys; i += 3) {
+    PW_TEST_ASSERT_OK(kvs.Delete(key_names[i].view()));
+  }
+  PW_TEST_ASSERT_OK(kvs.HeavyMaintenance());
+
+  // Read the KVS from flash with and without an index.
+  KeyValueStoreBuffer<kMaxEntries, kMaxUsableSectors, 1, 1, true> reloaded(
+      &large_test_partition, default_format);
+  KeyValueStoreBuffer<kMaxEntries, kMaxUsableSectors> unindexed(
+      &large_test_partition, default_format);
+  PW_TEST_ASSERT_OK(reloaded.Init());
+  PW_TEST_ASSERT_OK(unindexed.Init());
+
+  for (KeyValueStore* store : {static_cast<KeyValueStore*>(&kvs),
+                               static_cast<KeyValueStore*>(&reloaded),
+                               static_cast<KeyValueStore*>(&unindexed)}) {
+    EXPECT_EQ(store->size(), kKeys - (kKeys + 2) / 3);
+    for (size_t i = 0; i < kKeys; ++i) {
+      uint32_t value = 0;
+      if (i % 3 == 0) {
+        EXPECT_EQ(Status::NotFound(), store->Get(key_names[i].view(), &value));
+      } else {
+        PW_TEST_EXPECT_OK(store->Get(key_names[i].view(), &value));
+        EXPECT_EQ(value, i);
+      }
+    }
+  }
+}
+
 TEST(InMemoryKvs, Put_MaxValueSize) {
   // Create and erase the fake flash.
   Flash flash;
@@ -13,6 +13,7 @@
 // the License.
 #pragma once
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <string_view>
@@ -70,7 +71,8 @@ class EntryMetadata {
   void RemoveAddress(Address address_to_remove);
 
   // Resets the KeyDescrtiptor and addresses to refer to the provided
-  // KeyDescriptor and address.
+  // KeyDescriptor and address. If the EntryCache has a key hash index, the
+  // KeyDescriptor must have the same key hash.
   void Reset(const KeyDescriptor& descriptor, Address address);
 
  private:
@@ -85,6 +87,11 @@ class EntryMetadata {
 
 // Tracks entry metadata. Combines KeyDescriptors and with their associated
 // addresses.
+//
+// Finding an entry scans the KeyDescriptors, which is O(n) in the number of
+// entries. Optionally, the EntryCache maintains an open-addressing index of the
+// key hashes, which makes finding an entry O(1). The index only refers to the
+// KeyDescriptors, so it is rebuilt along with them when the KVS initializes.
 class EntryCache {
  private:
   enum Constness : bool { kMutable = false, kConst = true };
@@ -152,15 +159,38 @@ class EntryCache {
   template <size_t kMaxEntries, size_t kRedundancy>
   using AddressList = Address[kMaxEntries * kRedundancy + kRedundancy];
 
+  // A slot in the key hash index. Holds a KeyDescriptor's index plus one, or 0
+  // if the slot is empty.
+  using IndexSlot = uint16_t;
+
+  // The number of slots in a key hash index for the specified number of
+  // entries. The index is kept at most half full so that probes stay short.
+  static constexpr size_t IndexSize(size_t max_entries) {
+    size_t size = 2;
+    while (size < 2 * max_entries) {
+      size *= 2;
+    }
+    return size;
+  }
+
+  // The type to use for a key hash index with the specified number of entries.
+  template <size_t kMaxEntries>
+  using HashIndex = std::array<IndexSlot, IndexSize(kMaxEntries)>;
+
+  // Constructs an EntryCache. If index is not empty, it is used as a key hash
+  // index. Its size must be IndexSize(descriptors.max_size()).
   constexpr EntryCache(Vector<KeyDescriptor>& descriptors,
                        Address* addresses,
-                       size_t redundancy)
+                       size_t redundancy,
+                       span<IndexSlot> index = {})
       : descriptors_(descriptors),
         addresses_(addresses),
-        redundancy_(redundancy) {}
+        redundancy_(redundancy),
+        index_(index),
+        index_shift_(IndexShift(index.size())) {}
 
   // Clears all KeyDescriptors.
-  void Reset() const { descriptors_.clear(); }
+  void Reset() const;
 
   // Finds the metadata for an entry matching a particular key. Searches for a
   // KeyDescriptor that matches this key and sets *metadata to point to it if
@@ -217,6 +247,9 @@ class EntryCache {
   // The maximum number of entries supported by this EntryCache.
   size_t max_entries() const { return descriptors_.max_size(); }
 
+  // True if this EntryCache has a key hash index.
+  bool has_index() const { return !index_.empty(); }
+
   iterator begin() const { return {this, descriptors_.begin()}; }
   const_iterator cbegin() const { return {this, descriptors_.begin()}; }
 
@@ -239,9 +272,39 @@ class EntryCache {
 
   Address* ResetAddresses(size_t descriptor_index, Address address) const;
 
+  // The index is a power of two in size. Hashes are mixed with a multiplicative
+  // hash and the top bits select the slot where probing starts.
+  static constexpr uint32_t kIndexMultiplier = 0x9E3779B1u;
+
+  static constexpr uint8_t IndexShift(size_t index_size) {
+    uint8_t shift = 32;
+    for (size_t size = index_size; size > 1u; size /= 2) {
+      shift -= 1;
+    }
+    return shift;
+  }
+
+  size_t HomeSlot(uint32_t key_hash) const {
+    return (key_hash * kIndexMultiplier) >> index_shift_;
+  }
+
+  // Returns the index slot that refers to the descriptor with this key hash,
+  // or the empty slot where it would be inserted.
+  size_t FindSlot(uint32_t key_hash) const;
+
+  // Adds a descriptor to the index. The key hash must not be in the index.
+  void AddToIndex(uint32_t key_hash, size_t descriptor_index) const;
+
+  // Removes a key hash from the index, if it is present.
+  void RemoveFromIndex(uint32_t key_hash) const;
+
   Vector<KeyDescriptor>& descriptors_;
   FlashPartition::Address* const addresses_;
   const size_t redundancy_;
+
+  // Optional key hash index. Uses linear probing.
+  const span<IndexSlot> index_;
+  const uint8_t index_shift_;
 };
 
 }  // namespace internal
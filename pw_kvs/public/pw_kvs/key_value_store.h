@@ -16,6 +16,7 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <limits>
 #include <string_view>
 #include <type_traits>
 
@@ -476,7 +477,8 @@ class KeyValueStore {
                 Vector<SectorDescriptor>& sector_descriptor_list,
                 const SectorDescriptor** temp_sectors_to_skip,
                 Vector<KeyDescriptor>& key_descriptor_list,
-                Address* addresses);
+                Address* addresses,
+                span<internal::EntryCache::IndexSlot> key_hash_index = {});
 
  private:
   using EntryMetadata = internal::EntryMetadata;
@@ -652,8 +654,9 @@ class KeyValueStore {
   // List of sectors used by this KVS.
   internal::Sectors sectors_;
 
-  // Unordered list of KeyDescriptors. Finding a key requires scanning and
-  // verifying a match by reading the actual entry.
+  // Unordered list of KeyDescriptors. Finding a key requires scanning, or
+  // looking up its hash in the optional index, and verifying a match by reading
+  // the actual entry.
   internal::EntryCache entry_cache_;
 
   Options options_;
@@ -692,10 +695,17 @@ class KeyValueStore {
   uint32_t last_transaction_id_;
 };
 
+/// Allocates buffers for a `KeyValueStore`.
+///
+/// If `kHashIndex` is true, the KVS keeps an index of its key hashes, which
+/// makes finding a key `O(1)` rather than `O(kMaxEntries)`. The index uses
+/// 4 to 8 bytes per entry. It is recommended for KVS instances with more than
+/// a few hundred keys.
 template <size_t kMaxEntries,
           size_t kMaxUsableSectors,
           size_t kRedundancy = 1,
-          size_t kEntryFormats = 1>
+          size_t kEntryFormats = 1,
+          bool kHashIndex = false>
 class KeyValueStoreBuffer : public KeyValueStore {
  public:
   // Constructs a KeyValueStore on the partition, with support for one
@@ -724,18 +734,25 @@ class KeyValueStoreBuffer : public KeyValueStore {
                       sectors_,
                       temp_sectors_to_skip_,
                       key_descriptors_,
-                      addresses_),
+                      addresses_,
+                      hash_index_),
         sectors_(),
         key_descriptors_(),
+        hash_index_(),
         formats_() {
     std::copy(formats.begin(), formats.end(), formats_.begin());
   }
 
  private:
+  static constexpr size_t kMaxIndexedEntries =
+      std::numeric_limits<internal::EntryCache::IndexSlot>::max();
+
   static_assert(kMaxEntries > 0u);
   static_assert(kMaxUsableSectors > 0u);
   static_assert(kRedundancy > 0u);
   static_assert(kEntryFormats > 0u);
+  static_assert(!kHashIndex || kMaxEntries <= kMaxIndexedEntries,
+                "kMaxEntries is too large for the key hash index");
 
   Vector<SectorDescriptor, kMaxUsableSectors> sectors_;
 
@@ -756,6 +773,12 @@ class KeyValueStoreBuffer : public KeyValueStore {
   // KeyDescriptors.
   internal::EntryCache::AddressList<kRedundancy, kMaxEntries> addresses_;
 
+  // Optional index of the key hashes for the EntryCache. Empty if kHashIndex
+  // is false.
+  std::array<internal::EntryCache::IndexSlot,
+             kHashIndex ? internal::EntryCache::IndexSize(kMaxEntries) : 0>
+      hash_index_;
+
   // EntryFormats that can be read by this KeyValueStore.
   std::array<EntryFormat, kEntryFormats> formats_;
 };
@@ -41,6 +41,13 @@
 #define PW_LOG_RPC_CONFIG_MAX_FILTER_ID_SIZE 4
 #endif  // PW_LOG_RPC_CONFIG_MAX_FILTER_ID_SIZE
 
+// The maximum number of entries an RpcLogDrain pops from its MultiSink at once.
+// The entries must also fit in the drain's log entry buffer, so a buffer that
+// holds only one entry pops one entry at a time.
+#ifndef PW_LOG_RPC_CONFIG_MAX_ENTRIES_PER_BATCH
+#define PW_LOG_RPC_CONFIG_MAX_ENTRIES_PER_BATCH 8
+#endif  // PW_LOG_RPC_CONFIG_MAX_ENTRIES_PER_BATCH
+
 // The log level to use for this module. Logs below this level are omitted.
 #ifndef PW_LOG_RPC_CONFIG_LOG_LEVEL
 #define PW_LOG_RPC_CONFIG_LOG_LEVEL PW_LOG_LEVEL_INFO
@@ -91,4 +98,7 @@ inline constexpr size_t kMaxFilterIdBytes =
 
 inline constexpr size_t kMaxThreadNameBytes =
     PW_LOG_RPC_CONFIG_MAX_FILTER_RULE_THREAD_NAME_SIZE;
+
+inline constexpr size_t kMaxEntriesPerBatch =
+    PW_LOG_RPC_CONFIG_MAX_ENTRIES_PER_BATCH;
 }  // namespace pw::log_rpc::cfg
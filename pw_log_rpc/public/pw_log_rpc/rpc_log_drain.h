@@ -97,6 +97,12 @@ class RpcLogDrain : public multisink::MultiSink::Drain {
   static constexpr size_t kMinEntryBufferSize =
       kMinEntrySizeWithoutPayload + sizeof(kLargestErrorMessageOrTokenSize);
 
+  // The largest encoded log::pwpb::LogEntry that reports dropped entries.
+  static constexpr size_t kMaxDropMessageSize =
+      protobuf::SizeOfFieldBytes(log::pwpb::LogEntry::Fields::kMessage,
+                                 kLargestErrorMessageOrTokenSize) +
+      protobuf::SizeOfFieldUint32(log::pwpb::LogEntry::Fields::kDropped);
+
   // When encoding LogEntry in LogEntries, there are kLogEntriesEncodeFrameSize
   // bytes added to the encoded LogEntry. This constant and kMinEntryBufferSize
   // can be used to calculate the minimum RPC ChannelOutput buffer size.
@@ -124,6 +130,9 @@ class RpcLogDrain : public multisink::MultiSink::Drain {
         error_handling_(error_handling),
         server_writer_(),
         log_entry_buffer_(log_entry_buffer),
+        popped_entries_(),
+        popped_entry_count_(0),
+        next_popped_entry_(0),
         drop_count_ingress_error_(0),
         drop_count_slow_drain_(0),
         drop_count_small_outbound_buffer_(0),
@@ -216,10 +225,25 @@ class RpcLogDrain : public multisink::MultiSink::Drain {
       log::pwpb::LogEntries::MemoryEncoder& encoder,
       uint32_t& packed_entry_count_out) PW_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
+  // Encodes an entry popped from the multisink, preceded by any pending drop
+  // messages. Adds the entry's drop counts to the drain's drop counts and
+  // clears them. Returns false if the entry does not fit in the remaining
+  // encoder space, so it must be sent in the next packet.
+  bool EncodeEntry(multisink::MultiSink::Drain::PoppedEntry& entry,
+                   log::pwpb::LogEntries::MemoryEncoder& encoder,
+                   size_t total_buffer_size,
+                   uint32_t& packed_entry_count_out)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
   const uint32_t channel_id_;
   const LogDrainErrorHandling error_handling_;
   rpc::RawServerWriter server_writer_ PW_GUARDED_BY(mutex_);
   const ByteSpan log_entry_buffer_ PW_GUARDED_BY(mutex_);
+  // Entries popped into log_entry_buffer_ that have not been sent yet.
+  std::array<multisink::MultiSink::Drain::PoppedEntry, cfg::kMaxEntriesPerBatch>
+      popped_entries_ PW_GUARDED_BY(mutex_);
+  size_t popped_entry_count_ PW_GUARDED_BY(mutex_);
+  size_t next_popped_entry_ PW_GUARDED_BY(mutex_);
   uint32_t drop_count_ingress_error_ PW_GUARDED_BY(mutex_);
   uint32_t drop_count_slow_drain_ PW_GUARDED_BY(mutex_);
   uint32_t drop_count_small_outbound_buffer_ PW_GUARDED_BY(mutex_);
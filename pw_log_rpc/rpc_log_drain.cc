@@ -14,6 +14,7 @@
 
 #include "pw_log_rpc/rpc_log_drain.h"
 
+#include <array>
 #include <limits>
 #include <mutex>
 #include <optional>
@@ -155,22 +156,35 @@ RpcLogDrain::LogDrainState RpcLogDrain::EncodeOutgoingPacket(
     log::pwpb::LogEntries::MemoryEncoder& encoder,
     uint32_t& packed_entry_count_out) {
   const size_t total_buffer_size = encoder.ConservativeWriteLimit();
-  do {
-    // Peek entry and get drop count from multisink.
+  while (true) {
+    // Encode the entries that were popped but did not fit in the last packet,
+    // then pop more. Entries are popped in batches with one multisink lock
+    // acquisition, and are filtered and encoded after the lock is released.
+    for (; next_popped_entry_ < popped_entry_count_; ++next_popped_entry_) {
+      if (!EncodeEntry(popped_entries_[next_popped_entry_],
+                       encoder,
+                       total_buffer_size,
+                       packed_entry_count_out)) {
+        return LogDrainState::kMoreEntriesRemaining;
+      }
+    }
+
     uint32_t drop_count = 0;
     uint32_t ingress_drop_count = 0;
-    Result<multisink::MultiSink::Drain::PeekedEntry> possible_entry =
-        PeekEntry(log_entry_buffer_, drop_count, ingress_drop_count);
+    const StatusWithSize result = PopEntries(
+        log_entry_buffer_, popped_entries_, drop_count, ingress_drop_count);
+    popped_entry_count_ = result.size();
+    next_popped_entry_ = 0;
     drop_count_ingress_error_ += ingress_drop_count;
 
     // Check if the entry fits in the entry buffer.
-    if (possible_entry.status().IsResourceExhausted()) {
+    if (result.IsResourceExhausted()) {
       ++drop_count_small_stack_buffer_;
       continue;
     }
 
     // Check if there are any entries left.
-    if (possible_entry.status().IsOutOfRange()) {
+    if (result.IsOutOfRange()) {
       // Stash multisink's reported drop count that will be reported later with
       // any other drop counts.
       drop_count_slow_drain_ += drop_count;
@@ -178,90 +192,89 @@ RpcLogDrain::LogDrainState RpcLogDrain::EncodeOutgoingPacket(
     }
 
     // At this point all expected errors have been handled.
-    PW_CHECK_OK(possible_entry.status());
-
-    // Check if the entry passes any set filter rules.
-    if (filter_ != nullptr &&
-        filter_->ShouldDropLog(possible_entry.value().entry())) {
-      // Add the drop count from the multisink peek, stored in `drop_count`, to
-      // the total drop count. Then drop the entry without counting it towards
-      // the total drop count. Drops will be reported later all together.
-      drop_count_slow_drain_ += drop_count;
-      PW_CHECK_OK(PopEntry(possible_entry.value()));
-      continue;
-    }
+    PW_CHECK_OK(result.status());
+  }
+}
 
-    // Check if the entry fits in the encoder buffer by itself.
-    const size_t encoded_entry_size =
-        possible_entry.value().entry().size() + kLogEntriesEncodeFrameSize;
-    if (encoded_entry_size + kLogEntriesEncodeFrameSize > total_buffer_size) {
-      // Entry is larger than the entire available buffer.
-      ++drop_count_small_outbound_buffer_;
-      PW_CHECK_OK(PopEntry(possible_entry.value()));
-      continue;
-    }
+bool RpcLogDrain::EncodeEntry(multisink::MultiSink::Drain::PoppedEntry& popped,
+                              log::pwpb::LogEntries::MemoryEncoder& encoder,
+                              size_t total_buffer_size,
+                              uint32_t& packed_entry_count_out) {
+  const ConstByteSpan entry = popped.entry;
+  const uint32_t drop_count = popped.drain_drop_count;
+  drop_count_ingress_error_ += popped.ingress_drop_count;
+  // The drop counts are reported with the drain's totals from here on, even if
+  // the entry is sent in the next packet.
+  popped.drain_drop_count = 0;
+  popped.ingress_drop_count = 0;
 
-    // At this point, we have a valid entry that may fit in the encode buffer.
-    // Report any drop counts combined reusing the log_entry_buffer_ to encode a
-    // drop message.
+  // Check if the entry passes any set filter rules.
+  if (filter_ != nullptr && filter_->ShouldDropLog(entry)) {
+    // Add the drop count from the multisink peek, stored in `drop_count`, to
+    // the total drop count. Then drop the entry without counting it towards
+    // the total drop count. Drops will be reported later all together.
     drop_count_slow_drain_ += drop_count;
-    // Account for dropped entries too large for stack buffer, which PeekEntry()
-    // also reports.
-    drop_count_slow_drain_ -= drop_count_small_stack_buffer_;
-    bool log_entry_buffer_has_valid_entry = possible_entry.ok();
-    if (drop_count_slow_drain_ > 0) {
-      TryEncodeDropMessage(log_entry_buffer_,
-                           std::string_view(kSlowDrainErrorMessage),
-                           drop_count_slow_drain_,
-                           encoder);
-      log_entry_buffer_has_valid_entry = false;
-    }
-    if (drop_count_ingress_error_ > 0) {
-      TryEncodeDropMessage(log_entry_buffer_,
-                           std::string_view(kIngressErrorMessage),
-                           drop_count_ingress_error_,
-                           encoder);
-      log_entry_buffer_has_valid_entry = false;
-    }
-    if (drop_count_small_stack_buffer_ > 0) {
-      TryEncodeDropMessage(log_entry_buffer_,
-                           std::string_view(kSmallStackBufferErrorMessage),
-                           drop_count_small_stack_buffer_,
-                           encoder);
-      log_entry_buffer_has_valid_entry = false;
-    }
-    if (drop_count_small_outbound_buffer_ > 0) {
-      TryEncodeDropMessage(log_entry_buffer_,
-                           std::string_view(kSmallOutboundBufferErrorMessage),
-                           drop_count_small_outbound_buffer_,
-                           encoder);
-      log_entry_buffer_has_valid_entry = false;
-    }
-    if (drop_count_writer_error_ > 0) {
-      TryEncodeDropMessage(log_entry_buffer_,
-                           std::string_view(kWriterErrorMessage),
-                           drop_count_writer_error_,
-                           encoder);
-      log_entry_buffer_has_valid_entry = false;
-    }
-    if (possible_entry.ok() && !log_entry_buffer_has_valid_entry) {
-      PW_CHECK_OK(PeekEntry(log_entry_buffer_, drop_count, ingress_drop_count)
-                      .status());
-    }
+    return true;
+  }
 
-    // Check if the entry fits in the partially filled encoder buffer.
-    if (encoded_entry_size > encoder.ConservativeWriteLimit()) {
-      // Notify the caller there are more entries to send.
-      return LogDrainState::kMoreEntriesRemaining;
-    }
+  // Check if the entry fits in the encoder buffer by itself.
+  const size_t encoded_entry_size = entry.size() + kLogEntriesEncodeFrameSize;
+  if (encoded_entry_size + kLogEntriesEncodeFrameSize > total_buffer_size) {
+    // Entry is larger than the entire available buffer.
+    ++drop_count_small_outbound_buffer_;
+    return true;
+  }
 
-    // Encode the entry and remove it from multisink.
-    PW_CHECK_OK(encoder.WriteBytes(
-        static_cast<uint32_t>(log::pwpb::LogEntries::Fields::kEntries),
-        possible_entry.value().entry()));
-    PW_CHECK_OK(PopEntry(possible_entry.value()));
-    ++packed_entry_count_out;
-  } while (true);
+  // At this point, we have a valid entry that may fit in the encode buffer.
+  // Report any drop counts combined. The entries are held in
+  // log_entry_buffer_, so drop messages are encoded in a separate buffer.
+  drop_count_slow_drain_ += drop_count;
+  // Account for dropped entries too large for stack buffer, which PopEntries()
+  // also reports.
+  drop_count_slow_drain_ -= drop_count_small_stack_buffer_;
+  std::array<std::byte, kMaxDropMessageSize> drop_message_buffer;
+  if (drop_count_slow_drain_ > 0) {
+    TryEncodeDropMessage(drop_message_buffer,
+                         std::string_view(kSlowDrainErrorMessage),
+                         drop_count_slow_drain_,
+                         encoder);
+  }
+  if (drop_count_ingress_error_ > 0) {
+    TryEncodeDropMessage(drop_message_buffer,
+                         std::string_view(kIngressErrorMessage),
+                         drop_count_ingress_error_,
+                         encoder);
+  }
+  if (drop_count_small_stack_buffer_ > 0) {
+    TryEncodeDropMessage(drop_message_buffer,
+                         std::string_view(kSmallStackBufferErrorMessage),
+                         drop_count_small_stack_buffer_,
+                         encoder);
+  }
+  if (drop_count_small_outbound_buffer_ > 0) {
+    TryEncodeDropMessage(drop_message_buffer,
+                         std::string_view(kSmallOutboundBufferErrorMessage),
+                         drop_count_small_outbound_buffer_,
+                         encoder);
+  }
+  if (drop_count_writer_error_ > 0) {
+    TryEncodeDropMessage(drop_message_buffer,
+                         std::string_view(kWriterErrorMessage),
+                         drop_count_writer_error_,
+                         encoder);
+  }
+
+  // Check if the entry fits in the partially filled encoder buffer.
+  if (encoded_entry_size > encoder.ConservativeWriteLimit()) {
+    // Keep the entry for the next packet.
+    return false;
+  }
+
+  // Encode the entry.
+  PW_CHECK_OK(encoder.WriteBytes(
+      static_cast<uint32_t>(log::pwpb::LogEntries::Fields::kEntries), entry));
+  ++packed_entry_count_out;
+  return true;
 }
 
 Status RpcLogDrain::Close() {
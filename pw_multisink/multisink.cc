@@ -76,6 +76,65 @@ Status MultiSink::PopEntry(Drain& drain, const Drain::PeekedEntry& entry) {
 }
 
 Result<ConstByteSpan> MultiSink::PeekOrPopEntry(
+    Drain& drain,
+    ByteSpan buffer,
+    Request request,
+    uint32_t& drain_drop_count_out,
+    uint32_t& ingress_drop_count_out,
+    uint32_t& entry_sequence_id_out) {
+  std::lock_guard lock(lock_);
+  return UnsafePeekOrPopEntry(drain,
+                              buffer,
+                              request,
+                              drain_drop_count_out,
+                              ingress_drop_count_out,
+                              entry_sequence_id_out);
+}
+
+StatusWithSize MultiSink::PopEntries(Drain& drain,
+                                     ByteSpan buffer,
+                                     span<Drain::PoppedEntry> entries_out,
+                                     uint32_t& drain_drop_count_out,
+                                     uint32_t& ingress_drop_count_out) {
+  std::lock_guard lock(lock_);
+  size_t count = 0;
+  size_t used = 0;
+  while (count < entries_out.size()) {
+    // After the first entry, stop before an entry that would be discarded for
+    // not fitting, and leave any drops after the last entry for the next call.
+    if (count != 0 &&
+        (drain.reader_.EntryCount() == 0 ||
+         drain.reader_.FrontEntryDataSizeBytes() > buffer.size() - used)) {
+      break;
+    }
+    uint32_t entry_sequence_id;
+    Result<ConstByteSpan> entry = UnsafePeekOrPopEntry(drain,
+                                                       buffer.subspan(used),
+                                                       Request::kPop,
+                                                       drain_drop_count_out,
+                                                       ingress_drop_count_out,
+                                                       entry_sequence_id);
+    if (!entry.ok()) {
+      if (count == 0) {
+        return StatusWithSize(entry.status(), 0);
+      }
+      // The discarded entry is reported as a drop by the next call.
+      break;
+    }
+    entries_out[count++] = {
+        .entry = entry.value(),
+        .drain_drop_count = drain_drop_count_out,
+        .ingress_drop_count = ingress_drop_count_out,
+    };
+    used += entry.value().size();
+  }
+  // The drop counts were returned with the entries.
+  drain_drop_count_out = 0;
+  ingress_drop_count_out = 0;
+  return StatusWithSize(count);
+}
+
+Result<ConstByteSpan> MultiSink::UnsafePeekOrPopEntry(
     Drain& drain,
     ByteSpan buffer,
     Request request,
@@ -88,7 +147,6 @@ Result<ConstByteSpan> MultiSink::PeekOrPopEntry(
   drain_drop_count_out = 0;
   ingress_drop_count_out = 0;
 
-  std::lock_guard lock(lock_);
   PW_DCHECK_PTR_EQ(drain.multisink_, this);
 
   const Status peek_status = drain.reader_.PeekFrontWithPreamble(
@@ -278,6 +336,18 @@ Status MultiSink::Drain::PopEntry(const PeekedEntry& entry) {
   return multisink_->PopEntry(*this, entry);
 }
 
+StatusWithSize MultiSink::Drain::PopEntries(ByteSpan buffer,
+                                            span<PoppedEntry> entries_out,
+                                            uint32_t& drain_drop_count_out,
+                                            uint32_t& ingress_drop_count_out) {
+  PW_DCHECK_NOTNULL(multisink_);
+  return multisink_->PopEntries(*this,
+                                buffer,
+                                entries_out,
+                                drain_drop_count_out,
+                                ingress_drop_count_out);
+}
+
 Result<MultiSink::Drain::PeekedEntry> MultiSink::Drain::PeekEntry(
     ByteSpan buffer,
     uint32_t& drain_drop_count_out,
@@ -23,6 +23,7 @@
 #include "pw_function/function.h"
 #include "pw_span/span.h"
 #include "pw_status/status.h"
+#include "pw_status/status_with_size.h"
 #include "pw_unit_test/framework.h"
 
 namespace pw::multisink {
@@ -283,6 +284,89 @@ TEST_F(MultiSinkTest, TooSmallBuffer) {
   VerifyPopEntry(drains_[0], std::nullopt, 1u, 1u);
 }
 
+TEST_F(MultiSinkTest, PopEntries) {
+  multisink_.AttachDrain(drains_[0]);
+  multisink_.HandleEntry(kMessage);
+  multisink_.HandleDropped(2);
+  multisink_.HandleEntry(kMessageOther);
+  multisink_.HandleEntry(kMessage);
+  multisink_.HandleDropped();
+
+  std::array<MultiSink::Drain::PoppedEntry, 4> entries;
+  uint32_t drop_count = 0;
+  uint32_t ingress_drop_count = 0;
+  StatusWithSize result = drains_[0].PopEntries(
+      entry_buffer_, entries, drop_count, ingress_drop_count);
+  ASSERT_EQ(result.status(), OkStatus());
+  ASSERT_EQ(result.size(), 3u);
+  EXPECT_EQ(drop_count, 0u);
+  EXPECT_EQ(ingress_drop_count, 0u);
+
+  // Each entry carries the drops that precede it.
+  const std::byte* expected[] = {kMessage, kMessageOther, kMessage};
+  const uint32_t expected_ingress_drops[] = {0, 2, 0};
+  for (size_t i = 0; i < result.size(); ++i) {
+    ASSERT_EQ(entries[i].entry.size(), sizeof(kMessage));
+    EXPECT_EQ(memcmp(entries[i].entry.data(), expected[i], sizeof(kMessage)),
+              0);
+    EXPECT_EQ(entries[i].drain_drop_count, 0u);
+    EXPECT_EQ(entries[i].ingress_drop_count, expected_ingress_drops[i]);
+  }
+
+  // Drops after the last entry are reported when the drain catches up.
+  result = drains_[0].PopEntries(
+      entry_buffer_, entries, drop_count, ingress_drop_count);
+  EXPECT_EQ(result.status(), Status::OutOfRange());
+  EXPECT_EQ(result.size(), 0u);
+  EXPECT_EQ(drop_count, 0u);
+  EXPECT_EQ(ingress_drop_count, 1u);
+  VerifyPopEntry(drains_[0], std::nullopt, 0u, 0u);
+}
+
+TEST_F(MultiSinkTest, PopEntriesStopsWhenFull) {
+  multisink_.AttachDrain(drains_[0]);
+  multisink_.HandleEntry(kMessage);
+  multisink_.HandleEntry(kMessageOther);
+  multisink_.HandleEntry(kMessage);
+
+  // Only two entries fit in the entries array.
+  std::array<MultiSink::Drain::PoppedEntry, 2> entries;
+  uint32_t drop_count = 0;
+  uint32_t ingress_drop_count = 0;
+  StatusWithSize result = drains_[0].PopEntries(
+      entry_buffer_, entries, drop_count, ingress_drop_count);
+  EXPECT_EQ(result.status(), OkStatus());
+  EXPECT_EQ(result.size(), 2u);
+
+  // Only one entry fits in the buffer. The second is left in the multisink.
+  multisink_.HandleEntry(kMessageOther);
+  result = drains_[0].PopEntries(span(entry_buffer_, sizeof(kMessage) + 1),
+                                 entries,
+                                 drop_count,
+                                 ingress_drop_count);
+  EXPECT_EQ(result.status(), OkStatus());
+  ASSERT_EQ(result.size(), 1u);
+  EXPECT_EQ(memcmp(entries[0].entry.data(), kMessage, sizeof(kMessage)), 0);
+
+  VerifyPopEntry(drains_[0], kMessageOther, 0u, 0u);
+  VerifyPopEntry(drains_[0], std::nullopt, 0u, 0u);
+}
+
+TEST_F(MultiSinkTest, PopEntriesTooSmallBuffer) {
+  multisink_.AttachDrain(drains_[0]);
+  multisink_.HandleEntry(kMessage);
+
+  // The entry that does not fit is discarded, as with PopEntry().
+  std::array<MultiSink::Drain::PoppedEntry, 4> entries;
+  uint32_t drop_count = 0;
+  uint32_t ingress_drop_count = 0;
+  const StatusWithSize result = drains_[0].PopEntries(
+      span(entry_buffer_, 1), entries, drop_count, ingress_drop_count);
+  EXPECT_EQ(result.status(), Status::ResourceExhausted());
+  EXPECT_EQ(result.size(), 0u);
+  VerifyPopEntry(drains_[0], std::nullopt, 1u, 0u);
+}
+
 TEST_F(MultiSinkTest, Iterator) {
   multisink_.AttachDrain(drains_[0]);
 
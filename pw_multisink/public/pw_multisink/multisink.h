@@ -22,7 +22,9 @@
 #include "pw_multisink/config.h"
 #include "pw_result/result.h"
 #include "pw_ring_buffer/prefixed_entry_ring_buffer.h"
+#include "pw_span/span.h"
 #include "pw_status/status.h"
+#include "pw_status/status_with_size.h"
 #include "pw_sync/lock_annotations.h"
 
 namespace pw {
@@ -62,6 +64,14 @@ class MultiSink {
       const uint32_t sequence_id_;
     };
 
+    // An entry popped by PopEntries(), along with the drain and ingress drop
+    // counts that precede it.
+    struct PoppedEntry {
+      ConstByteSpan entry;
+      uint32_t drain_drop_count;
+      uint32_t ingress_drop_count;
+    };
+
     constexpr Drain()
         : last_handled_sequence_id_(0),
           last_peek_sequence_id_(0),
@@ -151,6 +161,47 @@ class MultiSink {
       return result;
     }
 
+    // Pops as many available entries as fit, copying them back to back into
+    // `buffer` and describing each in `entries_out`. The multisink lock is
+    // acquired once for the whole batch, which avoids the per-entry locking of
+    // PopEntry() when draining many entries. The entries are processed after
+    // the lock is released.
+    //
+    // Stops when `entries_out` is full, when the next entry does not fit in
+    // the rest of `buffer`, or when no entries remain. Each popped entry
+    // carries the drop counts that precede it, as with PopEntry().
+    //
+    // If no entries were available, `drain_drop_count_out` and
+    // `ingress_drop_count_out` are set to the drops since the last handled
+    // entry, as with PopEntry(). Otherwise, they are set to zero.
+    //
+    // Example Usage:
+    //
+    //  std::array<MultiSink::Drain::PoppedEntry, 8> entries;
+    //  uint32_t drop_count;
+    //  uint32_t ingress_drop_count;
+    //  StatusWithSize result =
+    //      drain.PopEntries(buffer, entries, drop_count, ingress_drop_count);
+    //  for (size_t i = 0; i < result.size(); ++i) {
+    //    UserSendFunction(entries[i].entry);
+    //  }
+    //
+    // Precondition: the buffer data must not be corrupt, otherwise there will
+    // be a crash.
+    //
+    // Return values:
+    // OK - size() entries were popped, which is at least one unless
+    // `entries_out` is empty.
+    // OUT_OF_RANGE - No more entries were available.
+    // FAILED_PRECONDITION - The drain must be attached to a sink.
+    // RESOURCE_EXHAUSTED - The provided buffer was not large enough to store
+    // the next available entry, which was discarded.
+    StatusWithSize PopEntries(ByteSpan buffer,
+                              span<PoppedEntry> entries_out,
+                              uint32_t& drain_drop_count_out,
+                              uint32_t& ingress_drop_count_out)
+        PW_LOCKS_EXCLUDED(multisink_->lock_);
+
     // Removes the previously peeked entry from the multisink.
     //
     // Example Usage:
@@ -469,7 +520,24 @@ class MultiSink {
                                        uint32_t& entry_sequence_id_out)
       PW_LOCKS_EXCLUDED(lock_);
 
+  // Pops a batch of entries from the provided drain. See Drain::PopEntries().
+  StatusWithSize PopEntries(Drain& drain,
+                            ByteSpan buffer,
+                            span<Drain::PoppedEntry> entries_out,
+                            uint32_t& drain_drop_count_out,
+                            uint32_t& ingress_drop_count_out)
+      PW_LOCKS_EXCLUDED(lock_);
+
  private:
+  // Implements PeekOrPopEntry() with the lock held.
+  Result<ConstByteSpan> UnsafePeekOrPopEntry(Drain& drain,
+                                             ByteSpan buffer,
+                                             Request request,
+                                             uint32_t& drain_drop_count_out,
+                                             uint32_t& ingress_drop_count_out,
+                                             uint32_t& entry_sequence_id_out)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
   // Notifies attached listeners of new entries or an updated drop count.
   void NotifyListeners() PW_EXCLUSIVE_LOCKS_REQUIRED(lock_);
 
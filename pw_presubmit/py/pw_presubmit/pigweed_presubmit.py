@@ -193,6 +193,12 @@ def _gn_platform_build_check_targets() -> Sequence[str]:
     # TODO: b/269354373 - clang is not supported on windows yet
     if sys.platform != 'win32':
         build_targets.append('host_clang_debug_dynamic_allocation')
+        build_targets.append('host_clang_debug_rpc_send_lock_shards')
+        build_targets.append('host_clang_debug_async2_work_stealing')
+
+    # io_uring is only available on Linux.
+    if sys.platform.startswith('linux'):
+        build_targets.append('host_clang_debug_async2_uring')
 
     return build_targets
 
@@ -1353,5 +1353,152 @@ TEST(CodegenRepeated, FindStream) {
   EXPECT_EQ(fixed32s_finder.Next().status(), Status::NotFound());
 }
 
+TEST(Codegen, View) {
+  // clang-format off
+  constexpr uint8_t proto_data[] = {
+    // pigweed.magic_number
+    0x08, 0x49,
+    // pigweed.error_message
+    0x2a, 0x05, 'h', 'e', 'l', 'l', 'o',
+    // pigweed.pigweed
+    0x3a, 0x02,
+    // pigweed.pigweed.status
+    0x08, 0x02,
+    // pigweed.device_info
+    0x32, 0x14,
+    // pigweed.device_info.attributes[0]
+    0x22, 0x10,
+    // pigweed.device_info.attributes[0].key
+    0x0a, 0x04, 'c', 'h', 'i', 'p',
+    // pigweed.device_info.attributes[0].value
+    0x12, 0x08, 'l', 'e', 'f', 't', '-', 's', 'o', 'c',
+    // pigweed.device_info.status
+    0x18, 0x03,
+    // pigweed.id[0]
+    0x52, 0x02,
+    // pigweed.id[0].id
+    0x08, 0x31,
+    // pigweed.id[1]
+    0x52, 0x02,
+    // pigweed.id[1].id
+    0x08, 0x39,
+  };
+  // clang-format on
+
+  const Pigweed::View pigweed(as_bytes(span(proto_data)));
+  EXPECT_EQ(pigweed.message().data(), as_bytes(span(proto_data)).data());
+
+  EXPECT_EQ(pigweed.GetMagicNumber().value(), 0x49u);
+  EXPECT_EQ(pigweed.GetZiggy().status(), Status::NotFound());
+
+  // Strings refer to the serialized message rather than being copied.
+  Result<std::string_view> error_message = pigweed.GetErrorMessage();
+  ASSERT_EQ(error_message.status(), OkStatus());
+  EXPECT_EQ(*error_message, "hello");
+  EXPECT_EQ(static_cast<const void*>(error_message->data()),
+            static_cast<const void*>(&proto_data[4]));
+
+  Result<Pigweed::Pigweed::View> nested = pigweed.GetPigweed();
+  ASSERT_EQ(nested.status(), OkStatus());
+  EXPECT_EQ(nested->GetStatus().value(), Bool::FILE_NOT_FOUND);
+
+  Result<DeviceInfo::View> device_info = pigweed.GetDeviceInfo();
+  ASSERT_EQ(device_info.status(), OkStatus());
+  EXPECT_EQ(device_info->GetStatus().value(),
+            DeviceInfo::DeviceStatus::PANIC);
+  EXPECT_EQ(device_info->GetDeviceName().status(), Status::NotFound());
+
+  ViewFinder<KeyValuePair::View> attributes = device_info->GetAttributes();
+  Result<KeyValuePair::View> attribute = attributes.Next();
+  ASSERT_EQ(attribute.status(), OkStatus());
+  EXPECT_EQ(attribute->GetKey().value(), "chip");
+  EXPECT_EQ(attribute->GetValue().value(), "left-soc");
+  EXPECT_EQ(attributes.Next().status(), Status::NotFound());
+
+  ViewFinder<Proto::ID::View> ids = pigweed.GetId();
+  for (uint32_t expected : {0x31u, 0x39u}) {
+    Result<Proto::ID::View> id = ids.Next();
+    ASSERT_EQ(id.status(), OkStatus());
+    EXPECT_EQ(id->GetId().value(), expected);
+  }
+  EXPECT_EQ(ids.Next().status(), Status::NotFound());
+
+  EXPECT_EQ(pigweed.GetProto().status(), Status::NotFound());
+}
+
+TEST(CodegenRepeated, View) {
+  // clang-format off
+  constexpr uint8_t proto_data[] = {
+    // uint32s[], v={0}
+    0x08, 0x00,
+    // uint32s[], packed, v={16, 32, 48}
+    0x0a, 0x03, 0x10, 0x20, 0x30,
+    // sint32s[], packed, v={-1, 1}
+    0x12, 0x02, 0x01, 0x02,
+    // strings[], v={"the", "fox"}
+    0x1a, 0x03, 't', 'h', 'e',
+    0x1a, 0x03, 'f', 'o', 'x',
+    // doubles[], packed, v={1.0}
+    0x22, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf0, 0x3f,
+    // structs[0], v={1, 2}
+    0x2a, 0x04, 0x08, 0x01, 0x10, 0x02,
+    // structs[1], v={3}
+    0x2a, 0x02, 0x08, 0x03,
+    // bools[], packed, v={true, false}
+    0x3a, 0x02, 0x01, 0x00,
+    // enums[], packed, v={RED, GREEN, AMBER}
+    0x4a, 0x03, 0x00, 0x02, 0x01,
+  };
+  // clang-format on
+
+  const RepeatedTest::View repeated_test(as_bytes(span(proto_data)));
+
+  RepeatedUint32Finder uint32s = repeated_test.GetUint32s();
+  for (uint32_t expected : {0u, 16u, 32u, 48u}) {
+    Result<uint32_t> result = uint32s.Next();
+    ASSERT_EQ(result.status(), OkStatus());
+    EXPECT_EQ(result.value(), expected);
+  }
+  EXPECT_EQ(uint32s.Next().status(), Status::NotFound());
+
+  RepeatedSint32Finder sint32s = repeated_test.GetSint32s();
+  EXPECT_EQ(sint32s.Next().value(), -1);
+  EXPECT_EQ(sint32s.Next().value(), 1);
+  EXPECT_EQ(sint32s.Next().status(), Status::NotFound());
+
+  StringFinder strings = repeated_test.GetStrings();
+  EXPECT_EQ(strings.Next().value(), "the");
+  EXPECT_EQ(strings.Next().value(), "fox");
+  EXPECT_EQ(strings.Next().status(), Status::NotFound());
+
+  RepeatedDoubleFinder doubles = repeated_test.GetDoubles();
+  EXPECT_EQ(doubles.Next().value(), 1.0);
+  EXPECT_EQ(doubles.Next().status(), Status::NotFound());
+
+  auto structs = repeated_test.GetStructs();
+  auto first = structs.Next();
+  ASSERT_EQ(first.status(), OkStatus());
+  EXPECT_EQ(first->GetOne().value(), 1u);
+  EXPECT_EQ(first->GetTwo().value(), 2u);
+  auto second = structs.Next();
+  ASSERT_EQ(second.status(), OkStatus());
+  EXPECT_EQ(second->GetOne().value(), 3u);
+  EXPECT_EQ(second->GetTwo().status(), Status::NotFound());
+  EXPECT_EQ(structs.Next().status(), Status::NotFound());
+
+  RepeatedBoolFinder bools = repeated_test.GetBools();
+  EXPECT_EQ(bools.Next().value(), true);
+  EXPECT_EQ(bools.Next().value(), false);
+  EXPECT_EQ(bools.Next().status(), Status::NotFound());
+
+  RepeatedEnumFinder<Enum> enums = repeated_test.GetEnums();
+  EXPECT_EQ(enums.Next().value(), Enum::RED);
+  EXPECT_EQ(enums.Next().value(), Enum::GREEN);
+  EXPECT_EQ(enums.Next().value(), Enum::AMBER);
+  EXPECT_EQ(enums.Next().status(), Status::NotFound());
+
+  EXPECT_EQ(repeated_test.GetFixed32s().Next().status(), Status::NotFound());
+}
+
 }  // namespace
 }  // namespace pw::protobuf
@@ -306,6 +306,11 @@ TEST(CodegenMessage, FixReservedIdentifiers) {
   // Check for expected values of `enum class Function::Message_::Fields`:
   std::ignore = Function::Message_::Fields::kContent;
 
+  // Check that the nested `message View` does not conflict with the generated
+  // `Function::View` class.
+  std::ignore = Function::View_::Message{.precision = 5};
+  std::ignore = Function::View_::Fields::kPrecision;
+
   // Check for expected values of `enum class Function::Fields_`:
   std::ignore = Function::Fields_::NONE;
   std::ignore = Function::Fields_::kNone;
@@ -1008,6 +1013,66 @@ TEST(CodegenMessage, ReadNested) {
   EXPECT_EQ(message.ziggy, -111);
 }
 
+TEST(CodegenMessage, ReadOutOfOrderFields) {
+  static_assert(!OutOfOrder::kMessageFields[0].in_field_number_order());
+
+  // clang-format off
+  constexpr uint8_t proto_data[] = {
+    // out_of_order.tenth
+    0x50, 0x0a,
+    // unknown field 2
+    0x10, 0x02,
+    // out_of_order.first
+    0x08, 0x01,
+    // out_of_order.third
+    0x18, 0x03,
+  };
+  // clang-format on
+
+  stream::MemoryReader reader(as_bytes(span(proto_data)));
+  OutOfOrder::StreamDecoder out_of_order(reader);
+
+  OutOfOrder::Message message{};
+  const auto status = out_of_order.Read(message);
+  ASSERT_EQ(status, OkStatus());
+
+  EXPECT_EQ(message.first, 1u);
+  EXPECT_EQ(message.third, 3u);
+  EXPECT_EQ(message.tenth, 10u);
+}
+
+TEST(CodegenMessage, ReadSparseFields) {
+  static_assert(Sparse::kMessageFields[0].in_field_number_order());
+
+  // clang-format off
+  constexpr uint8_t proto_data[] = {
+    // unknown field 101
+    0xa8, 0x06, 0x65,
+    // sparse.hundredth
+    0xa0, 0x06, 0x64,
+    // unknown field 50
+    0x90, 0x03, 0x32,
+    // sparse.fourth
+    0x20, 0x04,
+    // unknown field 2
+    0x10, 0x02,
+    // sparse.first
+    0x08, 0x01,
+  };
+  // clang-format on
+
+  stream::MemoryReader reader(as_bytes(span(proto_data)));
+  Sparse::StreamDecoder sparse(reader);
+
+  Sparse::Message message{};
+  const auto status = sparse.Read(message);
+  ASSERT_EQ(status, OkStatus());
+
+  EXPECT_EQ(message.first, 1u);
+  EXPECT_EQ(message.fourth, 4u);
+  EXPECT_EQ(message.hundredth, 100u);
+}
+
 TEST(CodegenMessage, ReadNestedImported) {
   // clang-format off
   constexpr uint8_t proto_data[] = {
@@ -1815,6 +1880,154 @@ TEST(CodegenMessage, WriteNestedForcedCallback) {
             0);
 }
 
+TEST(CodegenMessage, WriteNestedPrecomputedSize) {
+  Pigweed::Message message{};
+  message.magic_number = 0x49u;
+  message.error_message = "not a typewriter";
+  message.pigweed.status = Bool::FILE_NOT_FOUND;
+  message.proto.pigweed_protobuf_bin = Pigweed::Protobuf::Binary::ZERO;
+  message.proto.meta.file_name = "/etc/passwd";
+  message.proto.meta.status = Pigweed::Protobuf::Compiler::Status::FUBAR;
+  message.proto.meta.pigweed_bin = Pigweed::Pigweed::Binary::ONE;
+
+  std::byte expected_buffer[Pigweed::kMaxEncodedSizeBytesWithoutValues];
+  std::byte temp_buffer[Pigweed::kScratchBufferSizeBytes];
+  stream::MemoryWriter expected_writer(expected_buffer);
+  Pigweed::StreamEncoder expected_encoder(expected_writer, temp_buffer);
+  ASSERT_EQ(expected_encoder.Write(message), OkStatus());
+
+  // Nested messages are written directly to the stream, so no scratch buffer
+  // is needed.
+  std::byte encode_buffer[Pigweed::kMaxEncodedSizeBytesWithoutValues];
+  stream::MemoryWriter writer(encode_buffer);
+  Pigweed::StreamEncoder pigweed(writer, ByteSpan());
+  pigweed.set_nested_message_encoding(
+      StreamEncoder::NestedMessageEncoding::kPrecomputedSize);
+
+  const auto status = pigweed.Write(message);
+  ASSERT_EQ(status, OkStatus());
+
+  ConstByteSpan expected = expected_writer.WrittenData();
+  ConstByteSpan result = writer.WrittenData();
+  EXPECT_EQ(result.size(), expected.size());
+  EXPECT_EQ(std::memcmp(result.data(), expected.data(), expected.size()), 0);
+}
+
+TEST(CodegenMessage, WriteNestedPrecomputedSizeCallbacks) {
+  // pigweed.proto.pigweed is a callback within a nested message, which is
+  // invoked once to size pigweed.proto and once to write it.
+  int invocations = 0;
+  Pigweed::Message message{};
+  message.proto.meta.file_name = "/etc/passwd";
+  message.proto.meta.status = Pigweed::Protobuf::Compiler::Status::FUBAR;
+  message.proto.pigweed.SetEncoder([&invocations](Proto::StreamEncoder& proto) {
+    ++invocations;
+    // Write some fields before the nested encoder is created, so its scratch
+    // buffer would overlap them if not reserved.
+    PW_TRY(proto.WriteBin(Proto::Binary::OFF));
+    PW_TRY(proto.WritePigweedPigweedBin(Pigweed::Pigweed::Binary::ONE));
+    PW_TRY(proto.WritePigweedProtobufBin(Pigweed::Protobuf::Binary::ONE));
+
+    Pigweed::Message inner{};
+    inner.magic_number = 0x1234u;
+    inner.proto.meta.file_name = "/dev/null";
+    return proto.GetPigweedEncoder().Write(inner);
+  });
+
+  std::byte expected_buffer[Pigweed::kMaxEncodedSizeBytesWithoutValues * 2];
+  Pigweed::MemoryEncoder expected_encoder(expected_buffer);
+  ASSERT_EQ(expected_encoder.Write(message), OkStatus());
+  EXPECT_EQ(invocations, 1);
+
+  // The memory encoder is its own scratch buffer. Nested encoders created by
+  // callbacks must not use the space the nested message is written to.
+  invocations = 0;
+  std::byte encode_buffer[Pigweed::kMaxEncodedSizeBytesWithoutValues * 2];
+  Pigweed::MemoryEncoder pigweed(encode_buffer);
+  pigweed.set_nested_message_encoding(
+      StreamEncoder::NestedMessageEncoding::kPrecomputedSize);
+
+  const auto status = pigweed.Write(message);
+  ASSERT_EQ(status, OkStatus());
+  EXPECT_EQ(invocations, 2);
+
+  EXPECT_EQ(pigweed.size(), expected_encoder.size());
+  EXPECT_EQ(
+      std::memcmp(pigweed.data(), expected_encoder.data(), pigweed.size()), 0);
+}
+
+TEST(CodegenMessage, WriteNestedPrecomputedSizeDeepNesting) {
+  // The innermost message is at nesting depth 3. Its callback is invoked once
+  // by the sizing pass and once by the write pass.
+  int invocations = 0;
+  DeepNestedTest::Message message{};
+  message.outer.inner.innermost.value.SetEncoder(
+      [&invocations](
+          DeepNestedTest::Outer::Inner::Innermost::StreamEncoder& innermost) {
+        ++invocations;
+        return innermost.WriteValue(42);
+      });
+
+  // clang-format off
+  constexpr uint8_t expected_proto[] = {
+    // outer
+    0x0a, 0x06,
+    // outer.inner
+    0x12, 0x04,
+    // outer.inner.innermost
+    0x0a, 0x02,
+    // outer.inner.innermost.value
+    0x08, 0x2a,
+  };
+  // clang-format on
+
+  std::byte encode_buffer[sizeof(expected_proto)];
+  stream::MemoryWriter writer(encode_buffer);
+  DeepNestedTest::StreamEncoder encoder(writer, ByteSpan());
+  encoder.set_nested_message_encoding(
+      StreamEncoder::NestedMessageEncoding::kPrecomputedSize);
+
+  ASSERT_EQ(encoder.Write(message), OkStatus());
+  EXPECT_EQ(invocations, 2);
+
+  ConstByteSpan result = writer.WrittenData();
+  ASSERT_EQ(result.size(), sizeof(expected_proto));
+  EXPECT_EQ(std::memcmp(result.data(), expected_proto, sizeof(expected_proto)),
+            0);
+}
+
+TEST(CodegenMessage, WriteNestedPrecomputedSizeInconsistentCallback) {
+  static constexpr std::array<std::byte, 8> kData{};
+
+  // The callback writes less on the second invocation than on the first.
+  size_t size = kData.size();
+  LargeNestedTest::Message message{};
+  message.large_nested.data.SetEncoder(
+      [&size](LargeNestedTest::LargeNested::StreamEncoder& encoder) {
+        return encoder.WriteData(span(kData).first(size--));
+      });
+
+  std::byte encode_buffer[32];
+  stream::MemoryWriter shrinking_writer(encode_buffer);
+  LargeNestedTest::StreamEncoder shrinking(shrinking_writer, ByteSpan());
+  shrinking.set_nested_message_encoding(
+      StreamEncoder::NestedMessageEncoding::kPrecomputedSize);
+  EXPECT_EQ(shrinking.Write(message), Status::OutOfRange());
+
+  // The callback writes more on the second invocation than on the first.
+  size = 1;
+  message.large_nested.data.SetEncoder(
+      [&size](LargeNestedTest::LargeNested::StreamEncoder& encoder) {
+        return encoder.WriteData(span(kData).first(size++));
+      });
+
+  stream::MemoryWriter growing_writer(encode_buffer);
+  LargeNestedTest::StreamEncoder growing(growing_writer, ByteSpan());
+  growing.set_nested_message_encoding(
+      StreamEncoder::NestedMessageEncoding::kPrecomputedSize);
+  EXPECT_EQ(growing.Write(message), Status::ResourceExhausted());
+}
+
 TEST(CodegenMessage, EnumAliases) {
   // Unprefixed enum.
   EXPECT_EQ(Bool::kTrue, Bool::TRUE);
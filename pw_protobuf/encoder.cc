@@ -22,6 +22,7 @@
 #include "pw_assert/check.h"
 #include "pw_bytes/span.h"
 #include "pw_function/scope_guard.h"
+#include "pw_preprocessor/compiler.h"
 #include "pw_protobuf/internal/codegen.h"
 #include "pw_protobuf/serialized_size.h"
 #include "pw_protobuf/stream_decoder.h"
@@ -40,6 +41,30 @@ namespace pw::protobuf {
 
 using internal::VarintType;
 
+namespace {
+
+// Counts the bytes written to it when sizing a nested message. Nested messages
+// within it that were already sized are accounted for with Skip(), rather than
+// written.
+class SizeCounter final : public stream::NonSeekableWriter {
+ public:
+  constexpr SizeCounter() = default;
+
+  size_t size() const { return size_; }
+
+  void Skip(size_t size) { size_ += size; }
+
+ private:
+  Status DoWrite(ConstByteSpan data) final {
+    size_ += data.size();
+    return OkStatus();
+  }
+
+  size_t size_ = 0;
+};
+
+}  // namespace
+
 Status StreamEncoder::DoWriteNestedMessage(
     uint32_t field_number,
     AnyMessageWriter const& write_message,
@@ -131,7 +156,136 @@ StreamEncoder StreamEncoder::GetNestedEncoder(uint32_t field_number,
   }
 
   ByteSpan nested_buffer = GetNestedScratchBuffer(field_number);
-  return StreamEncoder(*this, nested_buffer, write_when_empty);
+  return StreamEncoder(
+      *this, nested_buffer, write_when_empty, nested_message_encoding_);
+}
+
+ByteSpan StreamEncoder::GetUnusedScratchBuffer(size_t reserved_size) {
+  const size_t unused = memory_writer_.ConservativeWriteLimit();
+  if (reserved_size >= unused) {
+    return ByteSpan();
+  }
+  return ByteSpan(
+      memory_writer_.data() + memory_writer_.bytes_written() + reserved_size,
+      unused - reserved_size);
+}
+
+Result<size_t> StreamEncoder::SizeOfNestedMessage(
+    ConstByteSpan message,
+    span<const internal::MessageField> table,
+    NestedMessageSizes& sizes) {
+  // Nothing is staged in the scratch buffer while sizing, so callbacks may use
+  // all of it for their own nested encoders.
+  SizeCounter counter;
+  StreamEncoder sizer(counter, GetUnusedScratchBuffer(0));
+  sizer.sizing_only_ = true;
+  sizer.nested_message_encoding_ = NestedMessageEncoding::kPrecomputedSize;
+  sizer.nested_message_sizes_ = &sizes;
+  PW_TRY(sizer.Write(message, table));
+  return counter.size();
+}
+
+Result<size_t> StreamEncoder::PrecomputedNestedMessageSize(
+    ConstByteSpan message, span<const internal::MessageField> table) {
+  NestedMessageSizes& sizes = *nested_message_sizes_;
+  if (!sizing_only_) {
+    const size_t index = sizes.used++;
+    if (index < sizes.entries.size()) {
+      const NestedMessageSizes::Entry& entry = sizes.entries[index];
+      if (entry.size == 0) {
+        // Empty messages are not written, so the messages nested within them
+        // are not visited by the write pass.
+        sizes.used = entry.end;
+      }
+      return entry.size;
+    }
+    // This message was beyond the capacity of the table, so it was not
+    // recorded and must be sized again. Messages recorded after it during this
+    // pass land beyond the capacity too, so they do not overwrite the table.
+    return SizeOfNestedMessage(message, table, sizes);
+  }
+
+  // Messages are recorded in the order they are visited, before the messages
+  // nested within them, so that the write pass reads them back in that order.
+  const size_t index = sizes.recorded++;
+  const Result<size_t> size = SizeOfNestedMessage(message, table, sizes);
+  if (size.ok() && index < sizes.entries.size()) {
+    sizes.entries[index] = {size.value(), sizes.recorded};
+  }
+  return size;
+}
+
+Status StreamEncoder::WriteNestedMessageDirect(
+    uint32_t field_number,
+    ConstByteSpan message,
+    span<const internal::MessageField> table) {
+  if (nested_message_sizes_ == nullptr) {
+    return WriteOutermostNestedMessageDirect(field_number, message, table);
+  }
+  return WriteSizedNestedMessage(field_number,
+                                 message,
+                                 table,
+                                 PrecomputedNestedMessageSize(message, table),
+                                 *nested_message_sizes_);
+}
+
+// Not inlined, so that the sizes table is only on the stack once per outermost
+// nested message rather than once per level of nesting.
+PW_NO_INLINE Status StreamEncoder::WriteOutermostNestedMessageDirect(
+    uint32_t field_number,
+    ConstByteSpan message,
+    span<const internal::MessageField> table) {
+  // The outermost nested message is sized with a single pass over all of its
+  // fields, which records the sizes of the messages nested within it for
+  // their write passes.
+  NestedMessageSizes sizes;
+  const Result<size_t> size = SizeOfNestedMessage(message, table, sizes);
+  return WriteSizedNestedMessage(field_number, message, table, size, sizes);
+}
+
+Status StreamEncoder::WriteSizedNestedMessage(
+    uint32_t field_number,
+    ConstByteSpan message,
+    span<const internal::MessageField> table,
+    const Result<size_t>& size,
+    NestedMessageSizes& sizes) {
+  status_.Update(size.status());
+  PW_TRY(status_);
+  if (size.value() == 0) {
+    return OkStatus();
+  }
+
+  PW_TRY(
+      UpdateStatusForWrite(field_number, WireType::kDelimited, size.value()));
+  status_.Update(WriteLengthDelimitedKeyAndLengthPrefix(
+      field_number, size.value(), writer_));
+  PW_TRY(status_);
+
+  if (sizing_only_) {
+    // The nested message's fields were already counted by the first pass.
+    static_cast<SizeCounter&>(writer_).Skip(size.value());
+    return OkStatus();
+  }
+
+  // Second pass: write the fields straight to the stream, ensuring no more
+  // bytes are written than were counted. If this encoder writes to its own
+  // scratch buffer, the nested message's fields must not be overwritten by
+  // nested encoders that callbacks create.
+  stream::LimitedStreamWriter write_stream(writer_, size.value());
+  StreamEncoder write_encoder(
+      write_stream,
+      GetUnusedScratchBuffer(&writer_ == &memory_writer_ ? size.value() : 0));
+  write_encoder.nested_message_encoding_ =
+      NestedMessageEncoding::kPrecomputedSize;
+  write_encoder.nested_message_sizes_ = &sizes;
+  status_ = write_encoder.Write(message, table);
+  PW_TRY(status_);
+
+  // Verify that callbacks wrote the same number of bytes as the first pass.
+  if (write_stream.bytes_written() != size.value()) {
+    status_ = Status::OutOfRange();
+  }
+  return status_;
 }
 
 void StreamEncoder::CloseEncoder() {
@@ -592,7 +746,14 @@ Status StreamEncoder::Write(span<const std::byte> message,
         // size (we always need a type).
         PW_CHECK(!field.is_repeated(),
                  "Repeated delimited messages always require a callback");
-        if (field.nested_message_fields()) {
+        if (field.nested_message_fields() &&
+            nested_message_encoding_ ==
+                NestedMessageEncoding::kPrecomputedSize) {
+          // Nested Message. Size the embedded struct, then recursively call
+          // Write() to write its fields directly to the stream.
+          PW_TRY(WriteNestedMessageDirect(
+              field.field_number(), values, *field.nested_message_fields()));
+        } else if (field.nested_message_fields()) {
           // Nested Message. Struct member is an embedded struct for the
           // nested field. Obtain a nested encoder and recursively call Write()
           // using the fields table pointer from this field.
@@ -15,13 +15,18 @@
 #include "pw_bytes/span.h"
 #include "pw_perf_test/perf_test.h"
 #include "pw_protobuf/encoder.h"
+#include "pw_protobuf/stream_decoder.h"
+#include "pw_protobuf_test_protos/full_test.pwpb.h"
 #include "pw_span/span.h"
 #include "pw_status/status.h"
 #include "pw_stream/memory_stream.h"
+#include "pw_stream/stream.h"
 
 namespace pw::protobuf {
 namespace {
 
+using namespace ::pw::protobuf::test::pwpb;
+
 void BasicIntegerPerformance(pw::perf_test::State& state, uint32_t value) {
   std::byte encode_buffer[30];
 
@@ -34,5 +39,117 @@ void BasicIntegerPerformance(pw::perf_test::State& state, uint32_t value) {
 PW_PERF_TEST(SmallIntegerEncoding, BasicIntegerPerformance, 1);
 PW_PERF_TEST(LargerIntegerEncoding, BasicIntegerPerformance, 4000000000);
 
+Pigweed::Message PigweedMessage() {
+  Pigweed::Message message{};
+  message.magic_number = 0x49u;
+  message.error_message = "not a typewriter";
+  message.pigweed.status = Bool::FILE_NOT_FOUND;
+  message.proto.pigweed_protobuf_bin = Pigweed::Protobuf::Binary::ZERO;
+  message.proto.meta.file_name = "/etc/passwd";
+  message.proto.meta.status = Pigweed::Protobuf::Compiler::Status::FUBAR;
+  message.proto.meta.pigweed_bin = Pigweed::Pigweed::Binary::ONE;
+  return message;
+}
+
+void NestedMessagePerformance(
+    pw::perf_test::State& state,
+    StreamEncoder::NestedMessageEncoding nested_message_encoding) {
+  const Pigweed::Message message = PigweedMessage();
+
+  std::byte encode_buffer[Pigweed::kMaxEncodedSizeBytesWithoutValues];
+  std::byte scratch_buffer[Pigweed::kScratchBufferSizeBytes];
+
+  while (state.KeepRunning()) {
+    stream::MemoryWriter writer(encode_buffer);
+    Pigweed::StreamEncoder encoder(writer, scratch_buffer);
+    encoder.set_nested_message_encoding(nested_message_encoding);
+    encoder.Write(message).IgnoreError();
+  }
+}
+
+PW_PERF_TEST(NestedMessageScratchBuffer,
+             NestedMessagePerformance,
+             StreamEncoder::NestedMessageEncoding::kScratchBuffer);
+PW_PERF_TEST(NestedMessagePrecomputedSize,
+             NestedMessagePerformance,
+             StreamEncoder::NestedMessageEncoding::kPrecomputedSize);
+
+// Forwards to a MemoryReader, hiding it from the decoder so that the decoder
+// reads through the generic stream::Reader interface.
+class ForwardingReader : public stream::SeekableReader {
+ public:
+  explicit ForwardingReader(stream::MemoryReader& reader) : reader_(reader) {}
+
+ private:
+  StatusWithSize DoRead(ByteSpan destination) override {
+    const Result<ByteSpan> result = reader_.Read(destination);
+    if (!result.ok()) {
+      return StatusWithSize(result.status(), 0);
+    }
+    return StatusWithSize(result.value().size_bytes());
+  }
+
+  Status DoSeek(ptrdiff_t offset, Whence origin) override {
+    return reader_.Seek(offset, origin);
+  }
+
+  size_t ConservativeLimit(LimitType limit_type) const override {
+    return limit_type == LimitType::kRead ? reader_.ConservativeReadLimit() : 0;
+  }
+
+  stream::MemoryReader& reader_;
+};
+
+void DecodeMessagePerformance(pw::perf_test::State& state,
+                              bool decode_from_memory_reader) {
+  std::byte encode_buffer[Pigweed::kMaxEncodedSizeBytesWithoutValues];
+  std::byte scratch_buffer[Pigweed::kScratchBufferSizeBytes];
+  stream::MemoryWriter writer(encode_buffer);
+  Pigweed::StreamEncoder encoder(writer, scratch_buffer);
+  encoder.Write(PigweedMessage()).IgnoreError();
+  const ConstByteSpan encoded = writer.WrittenData();
+
+  while (state.KeepRunning()) {
+    stream::MemoryReader memory_reader(encoded);
+    ForwardingReader forwarding_reader(memory_reader);
+    Pigweed::Message message{};
+    if (decode_from_memory_reader) {
+      Pigweed::StreamDecoder decoder(memory_reader);
+      decoder.Read(message).IgnoreError();
+    } else {
+      Pigweed::StreamDecoder decoder(forwarding_reader);
+      decoder.Read(message).IgnoreError();
+    }
+  }
+}
+
+PW_PERF_TEST(DecodeFromMemoryReader, DecodeMessagePerformance, true);
+PW_PERF_TEST(DecodeFromStreamReader, DecodeMessagePerformance, false);
+
+// Reads the same two fields that a router might inspect, without decoding the
+// rest of the message. Compare with DecodeFromMemoryReader.
+void ViewFieldsPerformance(pw::perf_test::State& state) {
+  std::byte encode_buffer[Pigweed::kMaxEncodedSizeBytesWithoutValues];
+  std::byte scratch_buffer[Pigweed::kScratchBufferSizeBytes];
+  stream::MemoryWriter writer(encode_buffer);
+  Pigweed::StreamEncoder encoder(writer, scratch_buffer);
+  encoder.Write(PigweedMessage()).IgnoreError();
+  const ConstByteSpan encoded = writer.WrittenData();
+
+  while (state.KeepRunning()) {
+    const Pigweed::View view(encoded);
+    view.GetMagicNumber().IgnoreError();
+    Result<Proto::View> proto = view.GetProto();
+    if (proto.ok()) {
+      Result<Pigweed::Protobuf::Compiler::View> meta = proto->GetMeta();
+      if (meta.ok()) {
+        meta->GetFileName().IgnoreError();
+      }
+    }
+  }
+}
+
+PW_PERF_TEST(ReadFieldsWithView, ViewFieldsPerformance);
+
 }  // namespace
 }  // namespace pw::protobuf
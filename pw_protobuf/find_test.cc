@@ -273,5 +273,101 @@ TEST(EnumStreamFinder, RepeatedField) {
   EXPECT_EQ(result.status(), Status::NotFound());
 }
 
+constexpr auto kEncodedPackedProto = bytes::Array<  // clang-format off
+    // type=uint32, k=1, v=1
+    0x08, 0x01,
+    // type=uint32, k=1, packed, v={2, 300}
+    0x0a, 0x03, 0x02, 0xac, 0x02,
+    // type=uint32, k=1, v=4
+    0x08, 0x04,
+    // type=sint32, k=2, packed, v={-1, 1, -64}
+    0x12, 0x03, 0x01, 0x02, 0x7f,
+    // type=fixed32, k=3, packed, v={0xdeadbeef}
+    0x1a, 0x04, 0xef, 0xbe, 0xad, 0xde,
+    // type=uint32, k=4, packed, v={}
+    0x22, 0x00,
+    // type=uint32, k=4, v=7
+    0x20, 0x07,
+    // type=uint32, k=5, packed, truncated varint
+    0x2a, 0x01, 0x80,
+    // type=uint32, k=6, packed, v={2^33 - 1}
+    0x32, 0x05, 0xff, 0xff, 0xff, 0xff, 0x1f,
+    // type=int32, k=7, packed, v={-1, 2^33 - 1}
+    0x3a, 0x0f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01,
+                0xff, 0xff, 0xff, 0xff, 0x1f
+>();  // clang-format on
+
+TEST(RepeatedFinder, PackedAndUnpacked) {
+  RepeatedUint32Finder finder(kEncodedPackedProto, 1);
+  for (uint32_t expected : {1u, 2u, 300u, 4u}) {
+    Result<uint32_t> result = finder.Next();
+    ASSERT_EQ(result.status(), OkStatus());
+    EXPECT_EQ(result.value(), expected);
+  }
+  EXPECT_EQ(finder.Next().status(), Status::NotFound());
+}
+
+TEST(RepeatedFinder, PackedZigZag) {
+  RepeatedSint32Finder finder(kEncodedPackedProto, 2);
+  for (int32_t expected : {-1, 1, -64}) {
+    Result<int32_t> result = finder.Next();
+    ASSERT_EQ(result.status(), OkStatus());
+    EXPECT_EQ(result.value(), expected);
+  }
+  EXPECT_EQ(finder.Next().status(), Status::NotFound());
+}
+
+TEST(RepeatedFinder, PackedFixed) {
+  RepeatedFixed32Finder finder(kEncodedPackedProto, 3);
+  Result<uint32_t> result = finder.Next();
+  ASSERT_EQ(result.status(), OkStatus());
+  EXPECT_EQ(result.value(), 0xdeadbeef);
+  EXPECT_EQ(finder.Next().status(), Status::NotFound());
+}
+
+TEST(RepeatedFinder, EmptyPackedField) {
+  RepeatedUint32Finder finder(kEncodedPackedProto, 4);
+  Result<uint32_t> result = finder.Next();
+  ASSERT_EQ(result.status(), OkStatus());
+  EXPECT_EQ(result.value(), 7u);
+  EXPECT_EQ(finder.Next().status(), Status::NotFound());
+}
+
+TEST(RepeatedFinder, TruncatedPackedField) {
+  RepeatedUint32Finder finder(kEncodedPackedProto, 5);
+  EXPECT_EQ(finder.Next().status(), Status::DataLoss());
+  EXPECT_EQ(finder.Next().status(), Status::NotFound());
+}
+
+TEST(RepeatedFinder, PackedValueOutOfRange) {
+  RepeatedUint32Finder finder(kEncodedPackedProto, 6);
+  EXPECT_EQ(finder.Next().status(), Status::OutOfRange());
+  EXPECT_EQ(finder.Next().status(), Status::NotFound());
+}
+
+TEST(RepeatedFinder, PackedInt32ValueOutOfRange) {
+  RepeatedInt32Finder finder(kEncodedPackedProto, 7);
+  Result<int32_t> result = finder.Next();
+  ASSERT_EQ(result.status(), OkStatus());
+  EXPECT_EQ(result.value(), -1);
+  EXPECT_EQ(finder.Next().status(), Status::OutOfRange());
+  EXPECT_EQ(finder.Next().status(), Status::NotFound());
+}
+
+TEST(RepeatedFinder, WrongWireType) {
+  RepeatedFixed32Finder finder(kEncodedPackedProto, 1);
+  EXPECT_EQ(finder.Next().status(), Status::FailedPrecondition());
+}
+
+TEST(RepeatedEnumFinder, PackedField) {
+  RepeatedEnumFinder<Boolean> finder(kEncodedPackedProto, 1);
+  Result<Boolean> result = finder.Next();
+  ASSERT_EQ(result.status(), OkStatus());
+  EXPECT_EQ(result.value(), Boolean::kFalse);
+  result = finder.Next();
+  ASSERT_EQ(result.status(), OkStatus());
+  EXPECT_EQ(result.value(), Boolean::kFileNotFound);
+}
+
 }  // namespace
 }  // namespace pw::protobuf
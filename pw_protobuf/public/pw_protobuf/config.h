@@ -37,8 +37,18 @@
 static_assert(PW_PROTOBUF_CFG_MAX_VARINT_SIZE > 0 &&
               PW_PROTOBUF_CFG_MAX_VARINT_SIZE <= 5);
 
+// With StreamEncoder::NestedMessageEncoding::kPrecomputedSize, the number of
+// nested message sizes recorded on the stack while sizing a nested message.
+// Messages nested within it beyond this count are sized again when written.
+#ifndef PW_PROTOBUF_CFG_MAX_PRECOMPUTED_NESTED_MESSAGES
+#define PW_PROTOBUF_CFG_MAX_PRECOMPUTED_NESTED_MESSAGES 16
+#endif  // PW_PROTOBUF_CFG_MAX_PRECOMPUTED_NESTED_MESSAGES
+
 namespace pw::protobuf::config {
 
 inline constexpr size_t kMaxVarintSize = PW_PROTOBUF_CFG_MAX_VARINT_SIZE;
 
+inline constexpr size_t kMaxPrecomputedNestedMessages =
+    PW_PROTOBUF_CFG_MAX_PRECOMPUTED_NESTED_MESSAGES;
+
 }  // namespace pw::protobuf::config
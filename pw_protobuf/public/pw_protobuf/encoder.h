@@ -28,6 +28,7 @@
 #include "pw_protobuf/config.h"
 #include "pw_protobuf/internal/codegen.h"
 #include "pw_protobuf/wire_format.h"
+#include "pw_result/result.h"
 #include "pw_span/span.h"
 #include "pw_status/status.h"
 #include "pw_status/try.h"
@@ -121,6 +122,9 @@ class StreamEncoder {
   constexpr StreamEncoder(stream::Writer& writer, ByteSpan scratch_buffer)
       : status_(OkStatus()),
         write_when_empty_(true),
+        sizing_only_(false),
+        nested_message_encoding_(NestedMessageEncoding::kScratchBuffer),
+        nested_message_sizes_(nullptr),
         parent_(nullptr),
         nested_field_number_(0),
         memory_writer_(scratch_buffer),
@@ -164,6 +168,31 @@ class StreamEncoder {
 
   enum class EmptyEncoderBehavior { kWriteFieldNumber, kWriteNothing };
 
+  // Selects how Write() encodes the nested message fields of a generated
+  // message struct.
+  enum class NestedMessageEncoding : uint8_t {
+    // Each nested message is encoded into the scratch buffer, then copied to
+    // the parent once its size is known. This is the default.
+    kScratchBuffer,
+
+    // The size of each nested message is computed first, and its field key,
+    // length prefix, and fields are then written directly to the stream. No
+    // scratch buffer is needed and nothing is copied, but the fields of each
+    // nested message are visited twice: once to size it and once to write it.
+    // Callbacks within nested messages are invoked once per visit, and MUST
+    // perform the exact same set of writes on every invocation.
+    kPrecomputedSize,
+  };
+
+  // Sets how Write() encodes nested message fields. Encoders created with
+  // GetNestedEncoder() inherit this setting.
+  //
+  // Precondition: Encoder has no active child encoder.
+  void set_nested_message_encoding(NestedMessageEncoding encoding) {
+    PW_ASSERT(!nested_encoder_open());
+    nested_message_encoding_ = encoding;
+  }
+
   // Creates a nested encoder with the provided field number. Once this is
   // called, the parent encoder is locked and not available for use until the
   // nested encoder is finalized (either explicitly or through destruction).
@@ -671,6 +700,9 @@ class StreamEncoder {
   constexpr StreamEncoder(StreamEncoder&& other)
       : status_(other.status_),
         write_when_empty_(true),
+        sizing_only_(other.sizing_only_),
+        nested_message_encoding_(other.nested_message_encoding_),
+        nested_message_sizes_(other.nested_message_sizes_),
         parent_(other.parent_),
         nested_field_number_(other.nested_field_number_),
         memory_writer_(std::move(other.memory_writer_)),
@@ -702,9 +734,14 @@ class StreamEncoder {
 
   constexpr StreamEncoder(StreamEncoder& parent,
                           ByteSpan scratch_buffer,
-                          bool write_when_empty = true)
+                          bool write_when_empty = true,
+                          NestedMessageEncoding nested_message_encoding =
+                              NestedMessageEncoding::kScratchBuffer)
       : status_(OkStatus()),
         write_when_empty_(write_when_empty),
+        sizing_only_(false),
+        nested_message_encoding_(nested_message_encoding),
+        nested_message_sizes_(nullptr),
         parent_(&parent),
         nested_field_number_(0),
         memory_writer_(scratch_buffer),
@@ -727,6 +764,59 @@ class StreamEncoder {
 
   ByteSpan GetNestedScratchBuffer(uint32_t field_number);
 
+  // Returns the unused space of the scratch buffer, skipping the first
+  // reserved_size bytes of it.
+  ByteSpan GetUnusedScratchBuffer(size_t reserved_size);
+
+  // The sizes of the nested message structs within an outermost nested message
+  // written with NestedMessageEncoding::kPrecomputedSize. The sizing pass
+  // records them in the order Write() visits the messages, and the write pass
+  // reads them back in the same order, so each message is sized only once.
+  struct NestedMessageSizes {
+    struct Entry {
+      size_t size;
+      // The index following the entries of the messages nested within it.
+      size_t end;
+    };
+
+    std::array<Entry, config::kMaxPrecomputedNestedMessages> entries;
+    size_t recorded = 0;
+    size_t used = 0;
+  };
+
+  // Computes the encoded size of the fields of a nested message struct,
+  // without writing them. The sizes of the messages nested within it are
+  // recorded in sizes.
+  Result<size_t> SizeOfNestedMessage(ConstByteSpan message,
+                                     span<const internal::MessageField> table,
+                                     NestedMessageSizes& sizes);
+
+  // Returns the size of a nested message struct within an outermost nested
+  // message, recording it during the sizing pass and reading it back during
+  // the write pass.
+  Result<size_t> PrecomputedNestedMessageSize(
+      ConstByteSpan message, span<const internal::MessageField> table);
+
+  // Writes a nested message struct field for
+  // NestedMessageEncoding::kPrecomputedSize. Nothing is written if the nested
+  // message is empty.
+  Status WriteNestedMessageDirect(uint32_t field_number,
+                                  ConstByteSpan message,
+                                  span<const internal::MessageField> table);
+
+  // Sizes and writes a nested message struct that is not within another one.
+  Status WriteOutermostNestedMessageDirect(
+      uint32_t field_number,
+      ConstByteSpan message,
+      span<const internal::MessageField> table);
+
+  // Writes a nested message struct whose size was computed by the first pass.
+  Status WriteSizedNestedMessage(uint32_t field_number,
+                                 ConstByteSpan message,
+                                 span<const internal::MessageField> table,
+                                 const Result<size_t>& size,
+                                 NestedMessageSizes& sizes);
+
   // Implementation for encoding all varint field types.
   Status WriteVarintField(uint32_t field_number, uint64_t value);
 
@@ -858,6 +948,16 @@ class StreamEncoder {
   // were written, the field is not written.
   bool write_when_empty_;
 
+  // Set for the encoders used by SizeOfNestedMessage(), whose writer only
+  // counts the bytes written to it.
+  bool sizing_only_;
+
+  NestedMessageEncoding nested_message_encoding_;
+
+  // Set for encoders writing or sizing the fields of an outermost nested
+  // message with NestedMessageEncoding::kPrecomputedSize.
+  NestedMessageSizes* nested_message_sizes_;
+
   // If this is a nested encoder, this points to the encoder that created it.
   // For user-created MemoryEncoders, parent_ points to this object as an
   // optimization for the MemoryEncoder and nested encoders to use the same
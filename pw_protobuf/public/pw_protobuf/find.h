@@ -39,10 +39,15 @@
 ///
 /// @endcode
 
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
 #include "pw_bytes/span.h"
 #include "pw_protobuf/decoder.h"
 #include "pw_protobuf/stream_decoder.h"
 #include "pw_result/result.h"
+#include "pw_status/status_with_size.h"
 #include "pw_status/try.h"
 #include "pw_string/string.h"
 
@@ -125,6 +130,187 @@ class EnumStreamFinder
   }
 };
 
+namespace internal {
+
+// Decoders for a single value at the start of a packed field's payload. Each
+// returns the number of bytes the value occupies, or 0 if the payload is
+// truncated. Values that do not fit in the output type are OUT_OF_RANGE, as
+// with the corresponding Decoder::Read*() function.
+
+template <typename T>
+StatusWithSize DecodePackedVarint(ConstByteSpan data, T* out) {
+  uint64_t value;
+  const size_t bytes_read = varint::Decode(data, &value);
+  if (bytes_read == 0) {
+    return StatusWithSize::DataLoss();
+  }
+  if constexpr (std::is_same_v<T, uint32_t>) {
+    if (value > std::numeric_limits<uint32_t>::max()) {
+      return StatusWithSize::OutOfRange(bytes_read);
+    }
+  } else if constexpr (std::is_same_v<T, int32_t>) {
+    // Negative int32 values are sign-extended to 64 bits on the wire.
+    const int64_t signed_value = static_cast<int64_t>(value);
+    if (signed_value > std::numeric_limits<int32_t>::max() ||
+        signed_value < std::numeric_limits<int32_t>::min()) {
+      return StatusWithSize::OutOfRange(bytes_read);
+    }
+  }
+  *out = static_cast<T>(value);
+  return StatusWithSize(bytes_read);
+}
+
+template <typename T>
+StatusWithSize DecodePackedZigZag(ConstByteSpan data, T* out) {
+  uint64_t value;
+  const size_t bytes_read = varint::Decode(data, &value);
+  if (bytes_read == 0) {
+    return StatusWithSize::DataLoss();
+  }
+  const int64_t decoded = varint::ZigZagDecode(value);
+  if constexpr (std::is_same_v<T, int32_t>) {
+    if (decoded > std::numeric_limits<int32_t>::max() ||
+        decoded < std::numeric_limits<int32_t>::min()) {
+      return StatusWithSize::OutOfRange(bytes_read);
+    }
+  }
+  *out = static_cast<T>(decoded);
+  return StatusWithSize(bytes_read);
+}
+
+template <typename T>
+StatusWithSize DecodePackedFixed(ConstByteSpan data, T* out) {
+  if (data.size() < sizeof(T)) {
+    return StatusWithSize::DataLoss();
+  }
+  std::memcpy(out, data.data(), sizeof(T));
+  return StatusWithSize(sizeof(T));
+}
+
+}  // namespace internal
+
+/// Iterates over the values of a repeated scalar field in a serialized
+/// message, reading them in place.
+///
+/// Unlike `Finder`, this accepts both the unpacked encoding, where each value
+/// is a separate field, and the packed encoding, where the values share a
+/// single length-delimited field. Parsers must accept both, in any mix.
+template <typename T, auto kReadFn, auto kDecodeFn>
+class RepeatedFinder {
+ public:
+  constexpr RepeatedFinder(ConstByteSpan message, uint32_t field_number)
+      : decoder_(message), field_number_(field_number) {}
+
+  Result<T> Next() {
+    T output;
+    while (packed_values_.empty()) {
+      PW_TRY(internal::AdvanceToField(decoder_, field_number_));
+      const Status status = (decoder_.*kReadFn)(&output);
+      if (!status.IsFailedPrecondition()) {
+        PW_TRY(status);
+        return output;
+      }
+      // The field is not an unpacked value, so it must be a packed run.
+      PW_TRY(decoder_.ReadBytes(&packed_values_));
+    }
+
+    const StatusWithSize result = kDecodeFn(packed_values_, &output);
+    if (result.size() == 0) {
+      packed_values_ = ConstByteSpan();
+      return Status::DataLoss();
+    }
+    packed_values_ = packed_values_.subspan(result.size());
+    PW_TRY(result.status());
+    return output;
+  }
+
+ private:
+  Decoder decoder_;
+  ConstByteSpan packed_values_;
+  uint32_t field_number_;
+};
+
+using RepeatedUint32Finder =
+    RepeatedFinder<uint32_t,
+                   &Decoder::ReadUint32,
+                   &internal::DecodePackedVarint<uint32_t>>;
+using RepeatedInt32Finder =
+    RepeatedFinder<int32_t,
+                   &Decoder::ReadInt32,
+                   &internal::DecodePackedVarint<int32_t>>;
+using RepeatedSint32Finder =
+    RepeatedFinder<int32_t,
+                   &Decoder::ReadSint32,
+                   &internal::DecodePackedZigZag<int32_t>>;
+using RepeatedUint64Finder =
+    RepeatedFinder<uint64_t,
+                   &Decoder::ReadUint64,
+                   &internal::DecodePackedVarint<uint64_t>>;
+using RepeatedInt64Finder =
+    RepeatedFinder<int64_t,
+                   &Decoder::ReadInt64,
+                   &internal::DecodePackedVarint<int64_t>>;
+using RepeatedSint64Finder =
+    RepeatedFinder<int64_t,
+                   &Decoder::ReadSint64,
+                   &internal::DecodePackedZigZag<int64_t>>;
+using RepeatedBoolFinder = RepeatedFinder<bool,
+                                          &Decoder::ReadBool,
+                                          &internal::DecodePackedVarint<bool>>;
+using RepeatedFixed32Finder =
+    RepeatedFinder<uint32_t,
+                   &Decoder::ReadFixed32,
+                   &internal::DecodePackedFixed<uint32_t>>;
+using RepeatedFixed64Finder =
+    RepeatedFinder<uint64_t,
+                   &Decoder::ReadFixed64,
+                   &internal::DecodePackedFixed<uint64_t>>;
+using RepeatedSfixed32Finder =
+    RepeatedFinder<int32_t,
+                   &Decoder::ReadSfixed32,
+                   &internal::DecodePackedFixed<int32_t>>;
+using RepeatedSfixed64Finder =
+    RepeatedFinder<int64_t,
+                   &Decoder::ReadSfixed64,
+                   &internal::DecodePackedFixed<int64_t>>;
+using RepeatedFloatFinder = RepeatedFinder<float,
+                                           &Decoder::ReadFloat,
+                                           &internal::DecodePackedFixed<float>>;
+using RepeatedDoubleFinder =
+    RepeatedFinder<double,
+                   &Decoder::ReadDouble,
+                   &internal::DecodePackedFixed<double>>;
+
+template <typename T>
+class RepeatedEnumFinder : private RepeatedUint32Finder {
+ public:
+  using RepeatedFinder::RepeatedFinder;
+
+  Result<T> Next() {
+    Result<uint32_t> result = RepeatedFinder::Next();
+    if (!result.ok()) {
+      return result.status();
+    }
+    return static_cast<T>(result.value());
+  }
+};
+
+/// Iterates over the occurrences of a repeated submessage field, returning a
+/// generated `View` of each one.
+template <typename View>
+class ViewFinder : private Finder<ConstByteSpan, &Decoder::ReadBytes> {
+ public:
+  using Finder::Finder;
+
+  Result<View> Next() {
+    Result<ConstByteSpan> result = Finder::Next();
+    if (!result.ok()) {
+      return result.status();
+    }
+    return View(result.value());
+  }
+};
+
 namespace internal {
 template <typename T, auto kReadFn>
 Result<T> Find(ConstByteSpan message, uint32_t field_number) {
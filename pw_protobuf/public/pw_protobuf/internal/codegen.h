@@ -68,6 +68,11 @@ enum class CallbackType {
 // parent to a pointer to the (global data) span. Since the size of the nested
 // message is stored as part of the global span, the cost of a nested message
 // is only the size of a pointer to that span.
+//
+// Most tables list their fields in ascending field number order, so that a
+// field's number bounds its position in the table. Such tables are flagged at
+// codegen time, allowing the decoder to index them by field number instead of
+// searching them.
 class MessageField {
  public:
   static constexpr unsigned int kMaxFieldSize = (1u << 16) - 1;
@@ -83,7 +88,8 @@ class MessageField {
                          CallbackType callback_type,
                          size_t field_offset,
                          size_t field_size,
-                         const span<const MessageField>* nested_message_fields)
+                         const span<const MessageField>* nested_message_fields,
+                         bool in_field_number_order = false)
       : field_number_(field_number),
         field_info_(static_cast<uint32_t>(wire_type) << kWireTypeShift |
                     static_cast<uint32_t>(elem_size) << kElemSizeShift |
@@ -91,6 +97,8 @@ class MessageField {
                     static_cast<uint32_t>(is_string) << kIsStringShift |
                     static_cast<uint32_t>(is_fixed_size) << kIsFixedSizeShift |
                     static_cast<uint32_t>(is_repeated) << kIsRepeatedShift |
+                    static_cast<uint32_t>(in_field_number_order)
+                        << kInFieldNumberOrderShift |
                     static_cast<uint32_t>(is_optional) << kIsOptionalShift |
                     static_cast<uint32_t>(callback_type) << kCallbackTypeShift |
                     static_cast<uint32_t>(field_size) << kFieldSizeShift),
@@ -118,6 +126,11 @@ class MessageField {
   constexpr bool is_repeated() const {
     return (field_info_ >> kIsRepeatedShift) & 1;
   }
+  // True if every field in this field's table is in ascending field number
+  // order. This is set for all of a table's fields or none of them.
+  constexpr bool in_field_number_order() const {
+    return (field_info_ >> kInFieldNumberOrderShift) & 1;
+  }
   constexpr bool is_optional() const {
     return (field_info_ >> kIsOptionalShift) & 1;
   }
@@ -140,18 +153,18 @@ class MessageField {
  private:
   // field_info_ packs multiple fields into a single word as follows:
   //
-  //   wire_type      : 3
-  //   varint_type    : 2
-  //   is_string      : 1
-  //   is_fixed_size  : 1
-  //   is_repeated    : 1
-  //   [unused space] : 1
+  //   wire_type             : 3
+  //   varint_type           : 2
+  //   is_string             : 1
+  //   is_fixed_size         : 1
+  //   is_repeated           : 1
+  //   in_field_number_order : 1
   //   -
-  //   elem_size      : 4
-  //   callback_type  : 2
-  //   is_optional    : 1
+  //   elem_size             : 4
+  //   callback_type         : 2
+  //   is_optional           : 1
   //   -
-  //   field_size     : 16
+  //   field_size            : 16
   //
   // The protobuf field type is spread among a few fields (wire_type,
   // varint_type, is_string, elem_size). The exact field type (e.g. int32, bool,
@@ -165,7 +178,7 @@ class MessageField {
   static constexpr unsigned int kIsStringShift = 26u;
   static constexpr unsigned int kIsFixedSizeShift = 25u;
   static constexpr unsigned int kIsRepeatedShift = 24u;
-  // Unused space: bit 23 (previously use_callback).
+  static constexpr unsigned int kInFieldNumberOrderShift = 23u;
   static constexpr unsigned int kElemSizeShift = 19u;
   static constexpr unsigned int kElemSizeMask = (1u << 4) - 1;
   static constexpr unsigned int kCallbackTypeShift = 17;
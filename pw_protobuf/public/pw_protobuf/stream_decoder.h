@@ -25,6 +25,7 @@
 #include "pw_span/span.h"
 #include "pw_status/status.h"
 #include "pw_status/status_with_size.h"
+#include "pw_stream/memory_stream.h"
 #include "pw_stream/stream.h"
 #include "pw_varint/stream.h"
 #include "pw_varint/varint.h"
@@ -110,16 +111,16 @@ class StreamDecoder {
   // for streaming situations. When constructed in this way, the decoder will
   // consume any remaining bytes when it goes out of scope.
   constexpr StreamDecoder(stream::Reader& reader, size_t length)
-      : reader_(reader),
-        stream_bounds_({0, length}),
-        position_(0),
-        current_field_(kInitialFieldKey),
-        delimited_field_size_(0),
-        delimited_field_offset_(0),
-        parent_(nullptr),
-        field_consumed_(true),
-        nested_reader_open_(false),
-        status_(OkStatus()) {}
+      : StreamDecoder(reader, nullptr, length) {}
+
+  // Decoders for a contiguous buffer in a MemoryReader read varints, field
+  // keys, and lengths directly from the buffer, rather than one byte at a time
+  // through the stream::Reader interface.
+  constexpr StreamDecoder(stream::MemoryReader& reader)
+      : StreamDecoder(reader, std::numeric_limits<size_t>::max()) {}
+
+  constexpr StreamDecoder(stream::MemoryReader& reader, size_t length)
+      : StreamDecoder(reader, &reader, length) {}
 
   StreamDecoder(const StreamDecoder& other) = delete;
   StreamDecoder& operator=(const StreamDecoder& other) = delete;
@@ -510,6 +511,7 @@ class StreamDecoder {
   //     acts like a parent decoder with an active child decoder.
   constexpr StreamDecoder(StreamDecoder&& other)
       : reader_(other.reader_),
+        memory_reader_(other.memory_reader_),
         stream_bounds_(other.stream_bounds_),
         position_(other.position_),
         current_field_(other.current_field_),
@@ -547,11 +549,27 @@ class StreamDecoder {
   static constexpr FieldKey kInitialFieldKey =
       FieldKey(20000, WireType::kVarint);
 
+  constexpr StreamDecoder(stream::Reader& reader,
+                          stream::MemoryReader* memory_reader,
+                          size_t length)
+      : reader_(reader),
+        memory_reader_(memory_reader),
+        stream_bounds_({0, length}),
+        position_(0),
+        current_field_(kInitialFieldKey),
+        delimited_field_size_(0),
+        delimited_field_offset_(0),
+        parent_(nullptr),
+        field_consumed_(true),
+        nested_reader_open_(false),
+        status_(OkStatus()) {}
+
   constexpr StreamDecoder(stream::Reader& reader,
                           StreamDecoder* parent,
                           size_t low,
                           size_t high)
       : reader_(reader),
+        memory_reader_(parent->memory_reader_),
         stream_bounds_({low, high}),
         position_(parent->position_),
         current_field_(kInitialFieldKey),
@@ -568,6 +586,7 @@ class StreamDecoder {
                           StreamDecoder* parent,
                           Status status)
       : reader_(reader),
+        memory_reader_(nullptr),
         stream_bounds_({0, std::numeric_limits<size_t>::max()}),
         position_(0),
         current_field_(kInitialFieldKey),
@@ -582,6 +601,9 @@ class StreamDecoder {
 
   Status Advance(size_t end_position);
 
+  // Reads a varint from the stream, with the same results as varint::Read().
+  StatusWithSize ReadVarint(uint64_t* value, size_t max_size);
+
   size_t RemainingBytes() {
     return stream_bounds_.high < std::numeric_limits<size_t>::max()
                ? stream_bounds_.high - position_
@@ -719,6 +741,8 @@ class StreamDecoder {
   Status CheckOkToRead(WireType type);
 
   stream::Reader& reader_;
+  // Set if reader_ is a MemoryReader, whose buffer can be decoded directly.
+  stream::MemoryReader* memory_reader_;
   Bounds stream_bounds_;
   size_t position_;
 
@@ -504,6 +504,67 @@ class FindStreamMethod(FindMethod):
         return lines
 
 
+class ViewMethod(ProtoMethod):
+    """A method of a message's View which reads a field in place.
+
+    View methods have the following format (for the proto field foo):
+
+        ::pw::Result<{ctype}> GetFoo() const {
+          return FindFoo(message_);
+        }
+
+    Repeated scalar fields return a RepeatedFinder, which reads both packed
+    and unpacked values.
+    """
+
+    def __init__(
+        self,
+        codegen_options: GeneratorOptions,
+        field: ProtoMessageField,
+        scope: ProtoNode,
+        root: ProtoNode,
+        base_class: str,
+    ):
+        super().__init__(codegen_options, field, scope, root, base_class)
+        # The ConstByteSpan find method is always listed first.
+        self._find_method: FindMethod = PROTO_FIELD_FIND_METHODS[
+            field.type()
+        ][0](codegen_options, field, scope, root, base_class)
+
+    def name(self) -> str:
+        return 'Get{}'.format(self._field.name())
+
+    def params(self) -> list[tuple[str, str]]:
+        return []
+
+    def return_type(self, from_root: bool = False) -> str:
+        if self._is_packable():
+            return f'::pw::protobuf::{self._finder()}'
+        return self._find_method.return_type(from_root)
+
+    def body(self) -> list[str]:
+        if self._is_packable():
+            return [
+                f'return ::pw::protobuf::{self._finder()}'
+                f'(message_, {self.field_cast()});'
+            ]
+        return [f'return {self._find_method.name()}(message_);']
+
+    def in_class_definition(self) -> bool:
+        return True
+
+    def _is_packable(self) -> bool:
+        return self._field.is_repeated() and self._field.type() not in (
+            descriptor_pb2.FieldDescriptorProto.TYPE_BYTES,
+            descriptor_pb2.FieldDescriptorProto.TYPE_STRING,
+            descriptor_pb2.FieldDescriptorProto.TYPE_MESSAGE,
+        )
+
+    def _finder(self) -> str:
+        finder = self._find_method._finder()  # pylint: disable=protected-access
+        return f'Repeated{finder}'
+
+
 class MessageProperty(ProtoMember):
     """Base class for a C++ property for a field in a protobuf message."""
 
@@ -652,7 +713,11 @@ class MessageProperty(ProtoMember):
         """C++ string for a bool argument that includes the argument name."""
         return f'/*{attr}=*/{bool(getattr(self, attr)())}'.lower()
 
-    def table_entry(self) -> list[str]:
+    def field_number(self) -> int:
+        """Returns the protobuf field number of the member."""
+        return self._field.number()
+
+    def table_entry(self, in_field_number_order: bool) -> list[str]:
         """Table entry."""
 
         oneof = self._field.oneof()
@@ -681,6 +746,7 @@ class MessageProperty(ProtoMember):
             'offsetof(Message, {})'.format(struct_member),
             'sizeof(Message::{})'.format(struct_member),
             self.sub_table(),
+            f'/*in_field_number_order=*/{str(in_field_number_order).lower()}',
         ]
 
     @abc.abstractmethod
@@ -822,6 +888,38 @@ class SubMessageFindMethod(FindMethod):
         return 'BytesFinder'
 
 
+class SubMessageViewMethod(ViewMethod):
+    """Method which returns a View of a proto submessage."""
+
+    def return_type(self, from_root: bool = False) -> str:
+        if self._field.is_repeated():
+            return f'::pw::protobuf::ViewFinder<{self._view_type(from_root)}>'
+        return f'::pw::Result<{self._view_type(from_root)}>'
+
+    def body(self) -> list[str]:
+        if self._field.is_repeated():
+            return [
+                f'return {self.return_type()}(message_, {self.field_cast()});'
+            ]
+
+        return [
+            '::pw::Result<::pw::ConstByteSpan> result = '
+            f'{self._find_method.name()}(message_);',
+            'if (!result.ok()) {',
+            '  return result.status();',
+            '}',
+            f'return {self._view_type()}(result.value());',
+        ]
+
+    # Submessage methods are not defined within the class itself because the
+    # submessage View may not yet have been defined.
+    def in_class_definition(self) -> bool:
+        return False
+
+    def _view_type(self, from_root: bool = False) -> str:
+        return f'{self._relative_type_namespace(from_root)}::View'
+
+
 class SubMessageProperty(MessageProperty):
     """Property which contains a sub-message."""
 
@@ -3132,6 +3230,98 @@ def define_not_in_class_methods(
             output.write_line('}')
 
 
+def proto_field_view_method(field_type: int) -> Type[ViewMethod]:
+    if field_type == descriptor_pb2.FieldDescriptorProto.TYPE_MESSAGE:
+        return SubMessageViewMethod
+    return ViewMethod
+
+
+def generate_view_for_message(
+    message: ProtoMessage,
+    root: ProtoNode,
+    output: OutputFile,
+    codegen_options: GeneratorOptions,
+) -> None:
+    """Creates a C++ class to read fields from a serialized protobuf message.
+
+    The View holds only a span of the serialized message. Each accessor finds
+    its field in the span when called, returning values which refer to the
+    serialized data rather than copies of it.
+    """
+    assert message.type() == ProtoNode.Type.MESSAGE
+
+    output.write_line(f'class {message.cpp_namespace(root=root)}::View {{')
+    output.write_line(' public:')
+
+    with output.indent():
+        output.write_line(
+            'constexpr explicit View(::pw::ConstByteSpan message) '
+            ': message_(message) {}'
+        )
+        output.write_line()
+        output.write_line(
+            'constexpr ::pw::ConstByteSpan message() const '
+            '{ return message_; }'
+        )
+
+        for field in message.fields():
+            method = proto_field_view_method(field.type())(
+                codegen_options, field, message, root, ''
+            )
+            if not method.should_appear():
+                continue
+
+            output.write_line()
+            method_signature = (
+                f'{method.return_type()} '
+                f'{method.name()}({method.param_string()}) const'
+            )
+
+            if not method.in_class_definition():
+                output.write_line(f'{method_signature};')
+                continue
+
+            output.write_line(f'{method_signature} {{')
+            with output.indent():
+                for line in method.body():
+                    output.write_line(line)
+            output.write_line('}')
+
+    output.write_line()
+    output.write_line(' private:')
+    output.write_line('  ::pw::ConstByteSpan message_;')
+    output.write_line('};')
+
+
+def define_not_in_class_view_methods(
+    message: ProtoMessage,
+    root: ProtoNode,
+    output: OutputFile,
+    codegen_options: GeneratorOptions,
+) -> None:
+    """Defines methods for a message View that were previously declared."""
+    assert message.type() == ProtoNode.Type.MESSAGE
+
+    for field in message.fields():
+        method = proto_field_view_method(field.type())(
+            codegen_options, field, message, root, ''
+        )
+        if not method.should_appear() or method.in_class_definition():
+            continue
+
+        output.write_line()
+        method_signature = (
+            f'inline {method.return_type(from_root=True)} '
+            f'{message.cpp_namespace(root=root)}::View::'
+            f'{method.name()}({method.param_string()}) const'
+        )
+        output.write_line(f'{method_signature} {{')
+        with output.indent():
+            for line in method.body():
+                output.write_line(line)
+        output.write_line('}')
+
+
 def _common_value_prefix(proto_enum: ProtoEnum) -> str:
     """Calculate the common prefix of all enum values.
 
@@ -3297,6 +3487,7 @@ def forward_declare(
     # Declare the message's decoder classes.
     output.write_line()
     output.write_line('class StreamDecoder;')
+    output.write_line('class View;')
 
     # Declare the message's enums.
     for child in message.children():
@@ -3410,10 +3601,17 @@ def generate_table_for_message(
             ' _kMessageFields[] = {'
         )
 
+        # Tables in field number order can be indexed by field number when
+        # decoding, rather than searched.
+        field_numbers = [prop.field_number() for prop in all_properties]
+        in_field_number_order = all(
+            a < b for a, b in zip(field_numbers, field_numbers[1:])
+        )
+
         # Generate members for each of the message's fields.
         with output.indent():
             for prop in all_properties:
-                table = ', '.join(prop.table_entry())
+                table = ', '.join(prop.table_entry(in_field_number_order))
                 output.write_line(f'{{{table}}},')
 
         output.write_line('};')
@@ -3700,6 +3898,9 @@ def generate_code_for_package(
                 class_type,
             )
 
+        output.write_line()
+        generate_view_for_message(message, package, output, codegen_options)
+
     # Run a second pass through the messages, this time defining all of the
     # methods which were previously only declared.
     for message in messages:
@@ -3711,6 +3912,9 @@ def generate_code_for_package(
                 codegen_options,
                 class_type,
             )
+        define_not_in_class_view_methods(
+            message, package, output, codegen_options
+        )
 
     if package.cpp_namespace():
         output.write_line(f'\n}}  // namespace {package.cpp_namespace()}')
@@ -27,6 +27,7 @@ PW_PROTO_CODEGEN_RESERVED_WORDS: Set[str] = {
     # contexts:
     "Fields",
     "Message",
+    "View",
     # C++20 keywords (https://en.cppreference.com/w/cpp/keyword):
     "alignas",
     "alignof",
@@ -23,6 +23,7 @@
 #include "pw_assert/assert.h"
 #include "pw_assert/check.h"
 #include "pw_bytes/bit.h"
+#include "pw_bytes/span.h"
 #include "pw_containers/vector.h"
 #include "pw_function/function.h"
 #include "pw_protobuf/encoder.h"
@@ -184,6 +185,34 @@ Status StreamDecoder::Advance(size_t end_position) {
   return OkStatus();
 }
 
+StatusWithSize StreamDecoder::ReadVarint(uint64_t* value, size_t max_size) {
+  if (memory_reader_ == nullptr) {
+    return varint::Read(reader_, value, max_size);
+  }
+
+  // Decode the varint in place, then advance the reader past it. The error
+  // cases match varint::Read(), which reads as many bytes as it can before
+  // failing.
+  stream::MemoryReader& reader = *memory_reader_;
+  const ConstByteSpan input(reader.data() + reader.bytes_read(),
+                            std::min({max_size,
+                                      reader.ConservativeReadLimit(),
+                                      varint::kMaxVarint64SizeBytes}));
+  if (input.empty()) {
+    return StatusWithSize::OutOfRange();
+  }
+
+  const size_t bytes_read = varint::Decode(input, value);
+  if (bytes_read == 0) {
+    PW_CHECK_OK(reader.Seek(static_cast<ptrdiff_t>(input.size()),
+                            stream::Stream::kCurrent));
+    return StatusWithSize::DataLoss(input.size());
+  }
+  PW_CHECK_OK(reader.Seek(static_cast<ptrdiff_t>(bytes_read),
+                          stream::Stream::kCurrent));
+  return StatusWithSize(bytes_read);
+}
+
 void StreamDecoder::CloseBytesReader(BytesReader& reader) {
   status_ = reader.status_;
   if (status_.ok()) {
@@ -217,8 +246,7 @@ Status StreamDecoder::ReadFieldKey() {
   PW_DCHECK(field_consumed_);
 
   uint64_t varint = 0;
-  PW_TRY_ASSIGN(size_t bytes_read,
-                varint::Read(reader_, &varint, RemainingBytes()));
+  PW_TRY_ASSIGN(size_t bytes_read, ReadVarint(&varint, RemainingBytes()));
   position_ += bytes_read;
 
   if (!FieldKey::IsValidKey(varint)) {
@@ -231,7 +259,7 @@ Status StreamDecoder::ReadFieldKey() {
   if (current_field_.wire_type() == WireType::kDelimited) {
     // Read the length varint of length-delimited fields immediately to simplify
     // later processing of the field.
-    StatusWithSize sws = varint::Read(reader_, &varint, RemainingBytes());
+    StatusWithSize sws = ReadVarint(&varint, RemainingBytes());
     position_ += sws.size();
     if (sws.IsOutOfRange()) {
       // Out of range indicates the end of the stream. As a value is expected
@@ -271,8 +299,7 @@ Status StreamDecoder::SkipField() {
   switch (current_field_.wire_type()) {
     case WireType::kVarint: {
       // Consume the varint field; nothing more to skip afterward.
-      PW_TRY_ASSIGN(size_t bytes_read,
-                    varint::Read(reader_, &value, RemainingBytes()));
+      PW_TRY_ASSIGN(size_t bytes_read, ReadVarint(&value, RemainingBytes()));
       position_ += bytes_read;
       break;
     }
@@ -327,7 +354,7 @@ Status StreamDecoder::ReadVarintField(span<std::byte> out,
 StatusWithSize StreamDecoder::ReadOneVarint(span<std::byte> out,
                                             VarintType decode_type) {
   uint64_t value;
-  StatusWithSize sws = varint::Read(reader_, &value, RemainingBytes());
+  StatusWithSize sws = ReadVarint(&value, RemainingBytes());
   position_ += sws.size();
   if (sws.IsOutOfRange()) {
     // Out of range indicates the end of the stream. As a value is expected
@@ -519,16 +546,43 @@ Status StreamDecoder::CheckOkToRead(WireType type) {
   return status_;
 }
 
+namespace {
+
+// Returns the table entry for a field number, or nullptr if there is none.
+const internal::MessageField* FindField(
+    span<const internal::MessageField> table, uint32_t field_number) {
+  if (table.empty()) {
+    return nullptr;
+  }
+
+  if (!table.front().in_field_number_order()) {
+    const auto field = std::find(table.begin(), table.end(), field_number);
+    return field == table.end() ? nullptr : &*field;
+  }
+
+  // Field numbers start at 1, so in a table in field number order the entry
+  // for a field number can be no later than index field_number - 1. Step back
+  // from there over any gaps in the numbering. When the fields are numbered
+  // consecutively, the first entry checked is the one for the field.
+  for (size_t i = std::min<size_t>(field_number, table.size()); i > 0; --i) {
+    const internal::MessageField& field = table[i - 1];
+    if (field.field_number() <= field_number) {
+      return field.field_number() == field_number ? &field : nullptr;
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace
+
 Status StreamDecoder::Read(span<std::byte> message,
                            span<const internal::MessageField> table) {
   PW_TRY(status_);
 
   while (Next().ok()) {
-    // Find the field in the table,
-    // TODO: b/234876102 - Finding the field can be made more efficient.
-    const auto field =
-        std::find(table.begin(), table.end(), current_field_.field_number());
-    if (field == table.end()) {
+    const internal::MessageField* field =
+        FindField(table, current_field_.field_number());
+    if (field == nullptr) {
       // If the field is not found, skip to the next one.
       // TODO: b/234873295 - Provide a way to allow the caller to inspect
       // unknown fields, and serialize them back out later.
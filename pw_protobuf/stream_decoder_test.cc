@@ -200,6 +200,61 @@ TEST(StreamDecoder, Decode_NonSeekable_SkipsUnusedFields) {
   EXPECT_EQ(decoder.Next(), Status::OutOfRange());
 }
 
+// Decoders for a MemoryReader decode varints directly from its buffer. They
+// must report errors and advance the reader exactly as other decoders do.
+TEST(StreamDecoder, Decode_MemoryReader_MatchesNonSeekable) {
+  // clang-format off
+  static constexpr const uint8_t encoded_proto[] = {
+    // type=uint32, k=1, v=300
+    0x08, 0xac, 0x02,
+    // type=uint64, k=2, v=11-byte varint
+    0x10, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01,
+  };
+  // clang-format on
+
+  stream::MemoryReader memory_reader(as_bytes(span(encoded_proto)));
+  StreamDecoder memory_decoder(memory_reader);
+
+  stream::MemoryReader wrapped_reader(as_bytes(span(encoded_proto)));
+  NonSeekableMemoryReader non_seekable_reader(wrapped_reader);
+  StreamDecoder non_seekable_decoder(non_seekable_reader);
+
+  for (StreamDecoder* decoder : {&memory_decoder, &non_seekable_decoder}) {
+    EXPECT_EQ(decoder->Next(), OkStatus());
+    ASSERT_EQ(*decoder->FieldNumber(), 1u);
+    Result<uint32_t> uint32 = decoder->ReadUint32();
+    ASSERT_EQ(uint32.status(), OkStatus());
+    EXPECT_EQ(uint32.value(), 300u);
+
+    EXPECT_EQ(decoder->Next(), OkStatus());
+    ASSERT_EQ(*decoder->FieldNumber(), 2u);
+    EXPECT_EQ(decoder->ReadUint64().status(), Status::DataLoss());
+  }
+
+  // Both decoders give up after the maximum varint size.
+  EXPECT_EQ(memory_reader.bytes_read(), 14u);
+  EXPECT_EQ(non_seekable_reader.bytes_read(), 14u);
+  EXPECT_EQ(memory_decoder.Next(), non_seekable_decoder.Next());
+}
+
+TEST(StreamDecoder, Decode_MemoryReader_VarintCrossesLength) {
+  // clang-format off
+  static constexpr const uint8_t encoded_proto[] = {
+    // type=uint32, k=1, v=300
+    0x08, 0xac, 0x02,
+  };
+  // clang-format on
+
+  // Limit the decoder to the first two bytes, splitting the varint.
+  stream::MemoryReader reader(as_bytes(span(encoded_proto)));
+  StreamDecoder decoder(reader, 2);
+
+  EXPECT_EQ(decoder.Next(), OkStatus());
+  ASSERT_EQ(*decoder.FieldNumber(), 1u);
+  EXPECT_EQ(decoder.ReadUint32().status(), Status::DataLoss());
+  EXPECT_EQ(reader.bytes_read(), 2u);
+}
+
 TEST(StreamDecoder, Decode_BadData) {
   // clang-format off
   static constexpr const uint8_t encoded_proto[] = {
@@ -0,0 +1,368 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_ring_buffer/mpsc_prefixed_entry_ring_buffer.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "pw_assert/check.h"
+#include "pw_status/try.h"
+#include "pw_varint/varint.h"
+
+namespace pw::ring_buffer {
+
+using std::byte;
+using Reader = MpscPrefixedEntryRingBuffer::Reader;
+
+StatusWithSize Reader::PopBatch(span<byte> buffer, span<Entry> entries) {
+  if (ring_buffer_ == nullptr) {
+    return StatusWithSize::FailedPrecondition();
+  }
+  return ring_buffer_->InternalPopBatch(*this, buffer, entries);
+}
+
+Status MpscPrefixedEntryRingBuffer::SetBuffer(span<byte> buffer) {
+  if ((buffer.data() == nullptr) ||  //
+      (buffer.size_bytes() == 0) ||  //
+      (buffer.size_bytes() > kMaxBufferBytes)) {
+    return Status::InvalidArgument();
+  }
+
+  buffer_ = buffer.data();
+  buffer_bytes_ = static_cast<uint32_t>(buffer.size_bytes());
+  position_limit_ = (kPositionMask + 1) / buffer_bytes_ * buffer_bytes_;
+
+  write_.store(0, std::memory_order_relaxed);
+  published_.store(0, std::memory_order_relaxed);
+  for (std::atomic<uint32_t>& commit : commits_) {
+    commit.store(0, std::memory_order_relaxed);
+  }
+  for (Reader& reader : readers_) {
+    reader.read_pos_.store(0, std::memory_order_relaxed);
+    reader.drop_count_.store(0, std::memory_order_relaxed);
+  }
+  return OkStatus();
+}
+
+Status MpscPrefixedEntryRingBuffer::AttachReader(Reader& reader) {
+  if (reader.ring_buffer_ != nullptr) {
+    return Status::InvalidArgument();
+  }
+  bool pinned;
+  reader.read_pos_.store(SlowestReader(PublishedEnd(), pinned),
+                         std::memory_order_relaxed);
+  reader.drop_count_.store(0, std::memory_order_relaxed);
+  reader.ring_buffer_ = this;
+  readers_.push_back(reader);
+  return OkStatus();
+}
+
+Status MpscPrefixedEntryRingBuffer::DetachReader(Reader& reader) {
+  if (reader.ring_buffer_ != this) {
+    return Status::InvalidArgument();
+  }
+  reader.ring_buffer_ = nullptr;
+  readers_.remove(reader);
+  return OkStatus();
+}
+
+Status MpscPrefixedEntryRingBuffer::InternalPushBack(
+    span<const byte> data,
+    uint32_t user_preamble_data,
+    bool pop_front_if_needed) {
+  if (buffer_ == nullptr) {
+    return Status::FailedPrecondition();
+  }
+
+  // Prepare a single buffer that can hold both the user preamble and entry
+  // length.
+  byte preamble_buf[varint::kMaxVarint32SizeBytes * 2];
+  size_t user_preamble_bytes = 0;
+  if (user_preamble_) {
+    user_preamble_bytes =
+        varint::Encode<uint32_t>(user_preamble_data, preamble_buf);
+  }
+  size_t length_bytes =
+      varint::Encode<uint32_t>(static_cast<uint32_t>(data.size_bytes()),
+                               span(preamble_buf).subspan(user_preamble_bytes));
+  size_t preamble_bytes = user_preamble_bytes + length_bytes;
+  size_t total_write_bytes = preamble_bytes + data.size_bytes();
+  if (buffer_bytes_ < total_write_bytes) {
+    return Status::OutOfRange();
+  }
+
+  PW_TRY_ASSIGN(uint32_t reservation,
+                Reserve(total_write_bytes, pop_front_if_needed));
+
+  // The reserved space is owned by this writer until it commits.
+  size_t index = RawWrite(Index(reservation & kPositionMask),
+                          span(preamble_buf, preamble_bytes));
+  RawWrite(index, data);
+  Commit(reservation, total_write_bytes);
+  return OkStatus();
+}
+
+Result<uint32_t> MpscPrefixedEntryRingBuffer::Reserve(
+    size_t size, bool pop_front_if_needed) {
+  while (true) {
+    // Load the published index first, so that its ticket is not ahead of the
+    // write index's.
+    uint32_t published = published_.load(std::memory_order_acquire);
+    uint32_t write = write_.load(std::memory_order_relaxed);
+    uint32_t unpublished =
+        ((write / kOneTicket) - (published / kOneTicket)) % kTickets;
+    if (unpublished == kMaxConcurrentWriters) {
+      return Status::ResourceExhausted();
+    }
+    uint32_t head = write & kPositionMask;
+    bool pinned = false;
+    uint32_t tail;
+    if (readers_.empty()) {
+      // Without readers, only the space of unpublished entries is used.
+      tail = published & kPositionMask;
+    } else {
+      tail = SlowestReader(head, pinned);
+    }
+    uint32_t used = Distance(head, tail);
+
+    if (used <= buffer_bytes_ && buffer_bytes_ - used >= size) {
+      // Reader positions were loaded with acquire ordering, so any reads of
+      // this space by readers or evicting writers happen before it is
+      // overwritten.
+      uint32_t next =
+          ((write & ~kPositionMask) + kOneTicket) | Advance(head, size);
+      if (!write_.compare_exchange_weak(write,
+                                        next,
+                                        std::memory_order_acquire,
+                                        std::memory_order_relaxed)) {
+        continue;
+      }
+      return write;
+    }
+
+    // Writers may not wait for a reader to finish with its front entries, or
+    // for other writers to commit the entries they have reserved.
+    if (!pop_front_if_needed || pinned || readers_.empty() ||
+        used > buffer_bytes_) {
+      return Status::ResourceExhausted();
+    }
+    PW_TRY(EvictFront(tail));
+  }
+}
+
+void MpscPrefixedEntryRingBuffer::Commit(uint32_t reservation, size_t size) {
+  // The store and the load of the published index in Publish() are sequentially
+  // consistent with the publishing thread's update of the published index and
+  // its load of this slot. Either this writer sees that its entry is next, or
+  // the publishing thread sees this slot.
+  CommitSlot(reservation)
+      .store(kCommitted | Advance(reservation & kPositionMask, size),
+             std::memory_order_seq_cst);
+  Publish();
+}
+
+void MpscPrefixedEntryRingBuffer::Publish() {
+  uint32_t published = published_.load(std::memory_order_seq_cst);
+  while (true) {
+    std::atomic<uint32_t>& slot = CommitSlot(published);
+    uint32_t commit = slot.load(std::memory_order_seq_cst);
+    if (commit == 0) {
+      return;  // The next entry's writer publishes it when it commits.
+    }
+
+    // Claim the entry by clearing its slot, so that its ticket's slot is clear
+    // before a later reservation can reuse it.
+    if (!slot.compare_exchange_strong(commit, 0, std::memory_order_seq_cst)) {
+      published = published_.load(std::memory_order_seq_cst);
+      continue;
+    }
+    const uint32_t next =
+        ((published & ~kPositionMask) + kOneTicket) | (commit & kPositionMask);
+    if (published_.compare_exchange_strong(
+            published, next, std::memory_order_seq_cst)) {
+      published = next;
+      continue;
+    }
+
+    // The published index moved while this thread was preempted, so the slot
+    // belongs to a later reservation. Restore it and check again.
+    slot.store(commit, std::memory_order_seq_cst);
+    published = published_.load(std::memory_order_seq_cst);
+  }
+}
+
+Status MpscPrefixedEntryRingBuffer::EvictFront(uint32_t tail) {
+  for (Reader& reader : readers_) {
+    // Pin the reader's front entry so it cannot be overwritten while its size
+    // is read. This fails if the reader moved or is reading.
+    uint32_t pos = tail;
+    if (!reader.read_pos_.compare_exchange_strong(pos,
+                                                  tail | kPinned,
+                                                  std::memory_order_acquire,
+                                                  std::memory_order_relaxed)) {
+      continue;
+    }
+    if (!IsBefore(tail, PublishedEnd())) {
+      reader.read_pos_.store(tail, std::memory_order_relaxed);
+      return Status::ResourceExhausted();
+    }
+    EntryInfo info = ReadEntryInfo(Index(tail));
+    reader.drop_count_.store(
+        reader.drop_count_.load(std::memory_order_relaxed) + 1,
+        std::memory_order_relaxed);
+    reader.read_pos_.store(
+        Advance(tail, info.preamble_bytes + info.data_bytes),
+        std::memory_order_release);
+  }
+  return OkStatus();
+}
+
+StatusWithSize MpscPrefixedEntryRingBuffer::InternalPopBatch(
+    Reader& reader, span<byte> buffer, span<Entry> entries) {
+  if (buffer_ == nullptr) {
+    return StatusWithSize::FailedPrecondition();
+  }
+  if (entries.empty()) {
+    return StatusWithSize(0);
+  }
+
+  // Pin the reader's position for the whole batch, so that writers cannot
+  // evict the entries while they are copied out.
+  uint32_t pos = reader.read_pos_.load(std::memory_order_relaxed);
+  do {
+    if ((pos & kPinned) != 0) {
+      return StatusWithSize::Unavailable();
+    }
+    if (!IsBefore(pos, PublishedEnd())) {
+      return StatusWithSize::OutOfRange();
+    }
+  } while (!reader.read_pos_.compare_exchange_weak(pos,
+                                                   pos | kPinned,
+                                                   std::memory_order_acquire,
+                                                   std::memory_order_relaxed));
+
+  // Only writers that have pinned the position update the drop count, and the
+  // acquire above synchronized with the last of them.
+  uint32_t drop_count = reader.drop_count_.load(std::memory_order_relaxed);
+
+  // Check the end again now that the position is pinned, in case writers
+  // pushed the reader all the way around to the same position.
+  const uint32_t end = PublishedEnd();
+  size_t index = Index(pos);
+  size_t count = 0;
+  size_t used = 0;
+  while (count < entries.size() && IsBefore(pos, end)) {
+    EntryInfo info = ReadEntryInfo(index);
+    if (info.data_bytes > buffer.size() - used) {
+      break;
+    }
+    span<byte> data = buffer.subspan(used, info.data_bytes);
+    RawRead(IncrementIndex(index, info.preamble_bytes), data);
+    used += data.size();
+    entries[count++] = {
+        .buffer = data,
+        .preamble = info.user_preamble,
+        .drop_count = drop_count,
+    };
+    drop_count = 0;
+
+    size_t entry_bytes = info.preamble_bytes + info.data_bytes;
+    pos = Advance(pos, entry_bytes);
+    index = IncrementIndex(index, entry_bytes);
+  }
+  reader.drop_count_.store(drop_count, std::memory_order_relaxed);
+  reader.read_pos_.store(pos, std::memory_order_release);
+
+  if (count != 0) {
+    return StatusWithSize(count);
+  }
+  return IsBefore(pos, end) ? StatusWithSize::ResourceExhausted()
+                            : StatusWithSize::OutOfRange();
+}
+
+uint32_t MpscPrefixedEntryRingBuffer::SlowestReader(uint32_t head,
+                                                    bool& pinned) const {
+  pinned = false;
+  uint32_t tail = head;
+  uint32_t max_lag = 0;
+  for (const Reader& reader : readers_) {
+    uint32_t pos = reader.read_pos_.load(std::memory_order_acquire);
+    uint32_t lag = Distance(head, pos & ~kPinned);
+    if (lag > buffer_bytes_ || lag < max_lag) {
+      // Readers ahead of `head` moved after it was loaded, and cannot be the
+      // slowest.
+      continue;
+    }
+    if (lag > max_lag) {
+      max_lag = lag;
+      tail = pos & ~kPinned;
+      pinned = false;
+    }
+    pinned = pinned || (pos & kPinned) != 0;
+  }
+  return tail;
+}
+
+MpscPrefixedEntryRingBuffer::EntryInfo
+MpscPrefixedEntryRingBuffer::ReadEntryInfo(size_t index) const {
+  // Decode the varints one byte at a time so that nothing past the end of the
+  // entry is read, since that space may be in use by a writer.
+  auto decode = [this](size_t& varint_index, uint32_t& value) {
+    byte varint_buf[varint::kMaxVarint32SizeBytes];
+    size_t bytes = 0;
+    do {
+      varint_buf[bytes] = buffer_[varint_index];
+      varint_index = IncrementIndex(varint_index, 1);
+    } while ((varint_buf[bytes++] & byte{0x80}) != byte{0} &&
+             bytes < sizeof(varint_buf));
+    uint64_t decoded;
+    PW_CHECK(varint::Decode(span(varint_buf, bytes), &decoded) == bytes);
+    value = static_cast<uint32_t>(decoded);
+  };
+
+  EntryInfo info = {};
+  size_t varint_index = index;
+  if (user_preamble_) {
+    decode(varint_index, info.user_preamble);
+  }
+  uint32_t data_bytes;
+  decode(varint_index, data_bytes);
+  info.preamble_bytes = varint_index >= index
+                            ? varint_index - index
+                            : varint_index + buffer_bytes_ - index;
+  info.data_bytes = data_bytes;
+  return info;
+}
+
+size_t MpscPrefixedEntryRingBuffer::RawWrite(size_t index,
+                                             span<const byte> data) {
+  size_t first = std::min(data.size_bytes(), buffer_bytes_ - index);
+  if (first != 0) {
+    std::memcpy(buffer_ + index, data.data(), first);
+    std::memcpy(buffer_, data.data() + first, data.size_bytes() - first);
+  }
+  return IncrementIndex(index, data.size_bytes());
+}
+
+void MpscPrefixedEntryRingBuffer::RawRead(size_t index,
+                                          span<byte> data) const {
+  size_t first = std::min(data.size_bytes(), buffer_bytes_ - index);
+  if (first != 0) {
+    std::memcpy(data.data(), buffer_ + index, first);
+    std::memcpy(data.data() + first, buffer_, data.size_bytes() - first);
+  }
+}
+
+}  // namespace pw::ring_buffer
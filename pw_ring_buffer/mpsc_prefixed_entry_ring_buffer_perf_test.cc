@@ -0,0 +1,93 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+#include "pw_perf_test/perf_test.h"
+#include "pw_ring_buffer/mpsc_prefixed_entry_ring_buffer.h"
+#include "pw_ring_buffer/prefixed_entry_ring_buffer.h"
+#include "pw_sync/interrupt_spin_lock.h"
+
+namespace pw::ring_buffer {
+namespace {
+
+// Compares writing and draining entries with a lock-free
+// `MpscPrefixedEntryRingBuffer` and with a `PrefixedEntryRingBuffer` guarded
+// by an `InterruptSpinLock`, as is required when it has multiple writers.
+
+constexpr size_t kBufferSizeBytes = 1024;
+constexpr size_t kEntriesPerBatch = 16;
+constexpr size_t kMaxEntrySize = 64;
+
+std::array<std::byte, kMaxEntrySize> entry_data{};
+
+void MpscPushPop(perf_test::State& state, size_t entry_size) {
+  static std::array<std::byte, kBufferSizeBytes> storage;
+  static MpscPrefixedEntryRingBuffer ring(/*user_preamble=*/true);
+  MpscPrefixedEntryRingBuffer::Reader reader;
+  static_cast<void>(ring.SetBuffer(storage));
+  static_cast<void>(ring.AttachReader(reader));
+
+  std::array<std::byte, kMaxEntrySize * kEntriesPerBatch> buffer;
+  std::array<MpscPrefixedEntryRingBuffer::Entry, kEntriesPerBatch> entries;
+  span<const std::byte> entry(entry_data.data(), entry_size);
+  while (state.KeepRunning()) {
+    for (uint32_t i = 0; i < kEntriesPerBatch; ++i) {
+      static_cast<void>(ring.PushBack(entry, i));
+    }
+    while (reader.PopBatch(buffer, entries).ok()) {
+    }
+  }
+  static_cast<void>(ring.DetachReader(reader));
+}
+
+void LockedPushPop(perf_test::State& state, size_t entry_size) {
+  static std::array<std::byte, kBufferSizeBytes> storage;
+  static PrefixedEntryRingBufferMulti ring(/*user_preamble=*/true);
+  static sync::InterruptSpinLock lock;
+  PrefixedEntryRingBufferMulti::Reader reader;
+  static_cast<void>(ring.SetBuffer(storage));
+  static_cast<void>(ring.AttachReader(reader));
+
+  std::array<std::byte, kMaxEntrySize> buffer;
+  span<const std::byte> entry(entry_data.data(), entry_size);
+  while (state.KeepRunning()) {
+    for (uint32_t i = 0; i < kEntriesPerBatch; ++i) {
+      std::lock_guard guard(lock);
+      static_cast<void>(ring.PushBack(entry, i));
+    }
+    while (true) {
+      std::lock_guard guard(lock);
+      size_t bytes_read;
+      if (!reader.PeekFront(buffer, &bytes_read).ok()) {
+        break;
+      }
+      static_cast<void>(reader.PopFront());
+    }
+  }
+  static_cast<void>(ring.DetachReader(reader));
+}
+
+PW_PERF_TEST(MpscPushPop4, MpscPushPop, 4);
+PW_PERF_TEST(MpscPushPop16, MpscPushPop, 16);
+PW_PERF_TEST(MpscPushPop64, MpscPushPop, 64);
+PW_PERF_TEST(LockedPushPop4, LockedPushPop, 4);
+PW_PERF_TEST(LockedPushPop16, LockedPushPop, 16);
+PW_PERF_TEST(LockedPushPop64, LockedPushPop, 64);
+
+}  // namespace
+}  // namespace pw::ring_buffer
@@ -0,0 +1,373 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_ring_buffer/mpsc_prefixed_entry_ring_buffer.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "pw_bytes/array.h"
+#include "pw_thread/test_thread_context.h"
+#include "pw_thread/thread.h"
+#include "pw_thread/yield.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::ring_buffer {
+namespace {
+
+using Entry = MpscPrefixedEntryRingBuffer::Entry;
+using Reader = MpscPrefixedEntryRingBuffer::Reader;
+
+constexpr auto kData = bytes::Array<1, 2, 3, 4, 5, 6, 7, 8>();
+
+TEST(MpscPrefixedEntryRingBuffer, NoBuffer) {
+  MpscPrefixedEntryRingBuffer ring;
+  Reader reader;
+  std::array<std::byte, 16> buffer;
+  Entry entry;
+
+  EXPECT_EQ(reader.PopFront(buffer, entry), Status::FailedPrecondition());
+  ASSERT_EQ(ring.AttachReader(reader), OkStatus());
+  EXPECT_EQ(ring.PushBack(kData), Status::FailedPrecondition());
+  EXPECT_EQ(reader.PopFront(buffer, entry), Status::FailedPrecondition());
+
+  EXPECT_EQ(ring.SetBuffer(span<std::byte>()), Status::InvalidArgument());
+  EXPECT_EQ(ring.DetachReader(reader), OkStatus());
+  EXPECT_EQ(ring.DetachReader(reader), Status::InvalidArgument());
+}
+
+TEST(MpscPrefixedEntryRingBuffer, PushAndPop) {
+  std::array<std::byte, 64> storage;
+  MpscPrefixedEntryRingBuffer ring(/*user_preamble=*/true);
+  Reader reader;
+  ASSERT_EQ(ring.SetBuffer(storage), OkStatus());
+  ASSERT_EQ(ring.AttachReader(reader), OkStatus());
+
+  std::array<std::byte, 16> buffer;
+  Entry entry;
+  EXPECT_EQ(reader.PopFront(buffer, entry), Status::OutOfRange());
+
+  ASSERT_EQ(ring.PushBack(kData, 300), OkStatus());
+  ASSERT_EQ(ring.PushBack(span(kData).first(3), 7), OkStatus());
+
+  ASSERT_EQ(reader.PopFront(buffer, entry), OkStatus());
+  EXPECT_EQ(entry.preamble, 300u);
+  EXPECT_EQ(entry.drop_count, 0u);
+  ASSERT_EQ(entry.buffer.size(), kData.size());
+  EXPECT_EQ(std::memcmp(entry.buffer.data(), kData.data(), kData.size()), 0);
+
+  ASSERT_EQ(reader.PopFront(buffer, entry), OkStatus());
+  EXPECT_EQ(entry.preamble, 7u);
+  ASSERT_EQ(entry.buffer.size(), 3u);
+  EXPECT_EQ(std::memcmp(entry.buffer.data(), kData.data(), 3), 0);
+
+  EXPECT_EQ(reader.PopFront(buffer, entry), Status::OutOfRange());
+}
+
+TEST(MpscPrefixedEntryRingBuffer, PopBatch) {
+  std::array<std::byte, 128> storage;
+  MpscPrefixedEntryRingBuffer ring;
+  Reader reader;
+  ASSERT_EQ(ring.SetBuffer(storage), OkStatus());
+  ASSERT_EQ(ring.AttachReader(reader), OkStatus());
+
+  for (size_t i = 1; i <= kData.size(); ++i) {
+    ASSERT_EQ(ring.PushBack(span(kData).first(i)), OkStatus());
+  }
+
+  // Limited by the number of entries.
+  std::array<std::byte, 64> buffer;
+  std::array<Entry, 3> entries;
+  StatusWithSize result = reader.PopBatch(buffer, entries);
+  ASSERT_EQ(result.status(), OkStatus());
+  ASSERT_EQ(result.size(), 3u);
+  EXPECT_EQ(entries[0].buffer.size(), 1u);
+  EXPECT_EQ(entries[1].buffer.size(), 2u);
+  EXPECT_EQ(entries[2].buffer.size(), 3u);
+  EXPECT_EQ(entries[2].buffer.data(), buffer.data() + 3);
+
+  // Limited by the buffer size. Entries of 4 and 5 bytes fit in 10 bytes.
+  result = reader.PopBatch(span(buffer).first(10), entries);
+  ASSERT_EQ(result.status(), OkStatus());
+  ASSERT_EQ(result.size(), 2u);
+  EXPECT_EQ(entries[1].buffer.size(), 5u);
+
+  // An entry that does not fit at all is left in place.
+  result = reader.PopBatch(span(buffer).first(5), entries);
+  EXPECT_EQ(result.status(), Status::ResourceExhausted());
+  EXPECT_EQ(result.size(), 0u);
+
+  result = reader.PopBatch(buffer, entries);
+  ASSERT_EQ(result.status(), OkStatus());
+  ASSERT_EQ(result.size(), 3u);
+  EXPECT_EQ(entries[2].buffer.size(), 8u);
+  EXPECT_EQ(std::memcmp(entries[2].buffer.data(), kData.data(), 8), 0);
+
+  EXPECT_EQ(reader.PopBatch(buffer, entries).status(), Status::OutOfRange());
+}
+
+TEST(MpscPrefixedEntryRingBuffer, TooLarge) {
+  std::array<std::byte, 8> storage;
+  MpscPrefixedEntryRingBuffer ring;
+  ASSERT_EQ(ring.SetBuffer(storage), OkStatus());
+
+  // One byte is needed for the length.
+  EXPECT_EQ(ring.PushBack(kData), Status::OutOfRange());
+  EXPECT_EQ(ring.PushBack(span(kData).first(7)), OkStatus());
+}
+
+TEST(MpscPrefixedEntryRingBuffer, TryPushBack_DoesNotEvict) {
+  std::array<std::byte, 20> storage;
+  MpscPrefixedEntryRingBuffer ring;
+  Reader reader;
+  ASSERT_EQ(ring.SetBuffer(storage), OkStatus());
+  ASSERT_EQ(ring.AttachReader(reader), OkStatus());
+
+  EXPECT_EQ(ring.TryPushBack(kData), OkStatus());
+  EXPECT_EQ(ring.TryPushBack(kData), OkStatus());
+  EXPECT_EQ(ring.TryPushBack(kData), Status::ResourceExhausted());
+
+  std::array<std::byte, 16> buffer;
+  Entry entry;
+  ASSERT_EQ(reader.PopFront(buffer, entry), OkStatus());
+  EXPECT_EQ(ring.TryPushBack(kData), OkStatus());
+}
+
+TEST(MpscPrefixedEntryRingBuffer, PushBack_EvictsAndCountsDrops) {
+  std::array<std::byte, 32> storage;
+  MpscPrefixedEntryRingBuffer ring(/*user_preamble=*/true);
+  Reader fast;
+  Reader slow;
+  ASSERT_EQ(ring.SetBuffer(storage), OkStatus());
+  ASSERT_EQ(ring.AttachReader(fast), OkStatus());
+  ASSERT_EQ(ring.AttachReader(slow), OkStatus());
+
+  // Each entry takes 10 bytes, so the buffer holds 3 entries.
+  std::array<std::byte, 16> buffer;
+  Entry entry;
+  for (uint32_t i = 0; i < 8; ++i) {
+    ASSERT_EQ(ring.PushBack(kData, i), OkStatus());
+    ASSERT_EQ(fast.PopFront(buffer, entry), OkStatus());
+    EXPECT_EQ(entry.preamble, i);
+    EXPECT_EQ(entry.drop_count, 0u);
+  }
+
+  // The slow reader lost the first 5 entries.
+  std::array<Entry, 8> entries;
+  StatusWithSize result = slow.PopBatch(buffer, span(entries).first(1));
+  ASSERT_EQ(result.status(), OkStatus());
+  EXPECT_EQ(entries[0].preamble, 5u);
+  EXPECT_EQ(entries[0].drop_count, 5u);
+
+  std::array<std::byte, 64> large_buffer;
+  result = slow.PopBatch(large_buffer, entries);
+  ASSERT_EQ(result.status(), OkStatus());
+  ASSERT_EQ(result.size(), 2u);
+  EXPECT_EQ(entries[0].preamble, 6u);
+  EXPECT_EQ(entries[0].drop_count, 0u);
+  EXPECT_EQ(entries[1].preamble, 7u);
+}
+
+TEST(MpscPrefixedEntryRingBuffer, AttachReader_StartsAtSlowestReader) {
+  std::array<std::byte, 64> storage;
+  MpscPrefixedEntryRingBuffer ring;
+  Reader first;
+  Reader second;
+  ASSERT_EQ(ring.SetBuffer(storage), OkStatus());
+
+  // Entries pushed with no readers are not visible to readers attached later.
+  ASSERT_EQ(ring.PushBack(kData), OkStatus());
+  ASSERT_EQ(ring.AttachReader(first), OkStatus());
+  EXPECT_EQ(ring.AttachReader(first), Status::InvalidArgument());
+
+  ASSERT_EQ(ring.PushBack(span(kData).first(1)), OkStatus());
+  ASSERT_EQ(ring.AttachReader(second), OkStatus());
+
+  std::array<std::byte, 16> buffer;
+  Entry entry;
+  ASSERT_EQ(second.PopFront(buffer, entry), OkStatus());
+  EXPECT_EQ(entry.buffer.size(), 1u);
+  EXPECT_EQ(second.PopFront(buffer, entry), Status::OutOfRange());
+}
+
+TEST(MpscPrefixedEntryRingBuffer, Wraparound) {
+  std::array<std::byte, 37> storage;
+  MpscPrefixedEntryRingBuffer ring(/*user_preamble=*/true);
+  Reader reader;
+  ASSERT_EQ(ring.SetBuffer(storage), OkStatus());
+  ASSERT_EQ(ring.AttachReader(reader), OkStatus());
+
+  std::array<std::byte, 16> buffer;
+  std::array<Entry, 4> entries;
+  for (uint32_t i = 0; i < 1000; ++i) {
+    ASSERT_EQ(ring.TryPushBack(span(kData).first(i % 9), i), OkStatus());
+    ASSERT_EQ(ring.TryPushBack(span(kData).first(8 - i % 9), i + 1),
+              OkStatus());
+
+    StatusWithSize result = reader.PopBatch(buffer, entries);
+    ASSERT_EQ(result.status(), OkStatus());
+    ASSERT_EQ(result.size(), 2u);
+    EXPECT_EQ(entries[0].preamble, i);
+    EXPECT_EQ(entries[1].preamble, i + 1);
+    ASSERT_EQ(entries[0].buffer.size(), i % 9);
+    ASSERT_EQ(entries[1].buffer.size(), 8 - i % 9);
+    EXPECT_EQ(std::memcmp(buffer.data(), kData.data(), i % 9), 0);
+    EXPECT_EQ(
+        std::memcmp(entries[1].buffer.data(), kData.data(), 8 - i % 9), 0);
+  }
+}
+
+// Entries written by the producer threads.
+struct ThreadEntry {
+  uint32_t producer;
+  uint32_t sequence;
+  std::array<uint32_t, 3> payload;
+};
+
+constexpr uint32_t kNumProducers = 3;
+constexpr uint32_t kEntriesPerProducer = 5000;
+
+TEST(MpscPrefixedEntryRingBuffer, ConcurrentProducers) {
+  static std::array<std::byte, 256> storage;
+  static MpscPrefixedEntryRingBuffer ring;
+  static std::atomic<uint32_t> failed_pushes;
+  static std::atomic<uint32_t> producers_done;
+  failed_pushes = 0;
+  producers_done = 0;
+
+  Reader reader;
+  ASSERT_EQ(ring.SetBuffer(storage), OkStatus());
+  ASSERT_EQ(ring.AttachReader(reader), OkStatus());
+
+  auto produce = [](uint32_t producer) {
+    for (uint32_t i = 0; i < kEntriesPerProducer; ++i) {
+      ThreadEntry entry{producer, i, {i, i * 3, ~i}};
+      if (!ring.PushBack(as_bytes(span(&entry, 1))).ok()) {
+        failed_pushes.fetch_add(1, std::memory_order_relaxed);
+      }
+      if (i % 16 == 0) {
+        this_thread::yield();
+      }
+    }
+    producers_done.fetch_add(1, std::memory_order_release);
+  };
+
+  std::array<thread::test::TestThreadContext, kNumProducers> contexts;
+  Thread producer_0(contexts[0].options(), [&] { produce(0); });
+  Thread producer_1(contexts[1].options(), [&] { produce(1); });
+  Thread producer_2(contexts[2].options(), [&] { produce(2); });
+
+  uint32_t popped = 0;
+  uint32_t dropped = 0;
+  uint32_t mismatches = 0;
+  std::array<uint32_t, kNumProducers> next_sequence{};
+  std::array<std::byte, sizeof(ThreadEntry) * 8> buffer;
+  std::array<Entry, 8> entries;
+
+  auto check_batch = [&](size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+      dropped += entries[i].drop_count;
+      ++popped;
+      ThreadEntry entry;
+      if (entries[i].buffer.size() != sizeof(entry)) {
+        ++mismatches;
+        continue;
+      }
+      std::memcpy(&entry, entries[i].buffer.data(), sizeof(entry));
+      uint32_t seq = entry.sequence;
+      if (entry.producer >= kNumProducers ||
+          seq < next_sequence[entry.producer] || entry.payload[0] != seq ||
+          entry.payload[1] != seq * 3 || entry.payload[2] != ~seq) {
+        ++mismatches;
+        continue;
+      }
+      next_sequence[entry.producer] = seq + 1;
+    }
+  };
+
+  while (producers_done.load(std::memory_order_acquire) < kNumProducers) {
+    StatusWithSize result = reader.PopBatch(buffer, entries);
+    if (result.ok()) {
+      check_batch(result.size());
+    } else {
+      this_thread::yield();
+    }
+  }
+  producer_0.join();
+  producer_1.join();
+  producer_2.join();
+
+  // A final entry reports any drops that have no later entry yet.
+  ASSERT_EQ(ring.PushBack(as_bytes(span(&kNumProducers, 1))), OkStatus());
+  StatusWithSize result;
+  while ((result = reader.PopBatch(buffer, entries)).ok()) {
+    check_batch(result.size());
+  }
+  EXPECT_EQ(result.status(), Status::OutOfRange());
+
+  EXPECT_EQ(mismatches, 1u);  // The final entry.
+  EXPECT_EQ(popped + dropped + failed_pushes.load(),
+            kNumProducers * kEntriesPerProducer + 1);
+  EXPECT_GT(popped, 0u);
+}
+
+TEST(MpscPrefixedEntryRingBuffer, ReaderProgressesDuringContinuousWrites) {
+  // Writers publish entries as soon as earlier entries commit, so the reader
+  // keeps receiving entries even though the producers write until it is done.
+  constexpr uint32_t kEntriesToPop = 2000;
+  static std::array<std::byte, 256> storage;
+  static MpscPrefixedEntryRingBuffer ring;
+  static std::atomic<bool> stop;
+  stop = false;
+
+  Reader reader;
+  ASSERT_EQ(ring.SetBuffer(storage), OkStatus());
+  ASSERT_EQ(ring.AttachReader(reader), OkStatus());
+
+  auto produce = [](uint32_t producer) {
+    for (uint32_t i = 0; !stop.load(std::memory_order_relaxed); ++i) {
+      ThreadEntry entry{producer, i, {i, i * 3, ~i}};
+      ring.PushBack(as_bytes(span(&entry, 1))).IgnoreError();
+    }
+  };
+
+  std::array<thread::test::TestThreadContext, kNumProducers> contexts;
+  Thread producer_0(contexts[0].options(), [&] { produce(0); });
+  Thread producer_1(contexts[1].options(), [&] { produce(1); });
+  Thread producer_2(contexts[2].options(), [&] { produce(2); });
+
+  uint32_t popped = 0;
+  std::array<std::byte, sizeof(ThreadEntry) * 8> buffer;
+  std::array<Entry, 8> entries;
+  while (popped < kEntriesToPop) {
+    StatusWithSize result = reader.PopBatch(buffer, entries);
+    if (result.ok()) {
+      popped += result.size();
+    } else {
+      this_thread::yield();
+    }
+  }
+  stop.store(true, std::memory_order_relaxed);
+  producer_0.join();
+  producer_1.join();
+  producer_2.join();
+
+  EXPECT_GE(popped, kEntriesToPop);
+}
+
+}  // namespace
+}  // namespace pw::ring_buffer
@@ -0,0 +1,283 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_containers/intrusive_list.h"
+#include "pw_result/result.h"
+#include "pw_span/span.h"
+#include "pw_status/status.h"
+#include "pw_status/status_with_size.h"
+
+namespace pw::ring_buffer {
+
+// A circular buffer for arbitrary length data entries that can be written by
+// multiple threads or interrupts concurrently without a lock. Entries use the
+// same layout as PrefixedEntryRingBuffer: an optional varint user preamble, a
+// varint data length, and the data.
+//
+// Writers reserve space for an entry by atomically advancing the write index,
+// copy their data into the reserved space, and then commit it. Each
+// reservation takes a ticket, which is packed into the same atomic word as the
+// write index, and commits by marking its ticket's slot. Entries are published
+// to readers in ticket order as soon as every earlier entry is committed, by
+// whichever writer commits the entry that completes the run. A slow writer
+// only delays the entries reserved after it. Writers never wait on each other:
+// if space cannot be made without waiting, the write fails with
+// RESOURCE_EXHAUSTED and the caller can count the entry as dropped.
+//
+// As with PrefixedEntryRingBufferMulti, PushBack() makes space by pushing slow
+// readers forward. Each reader counts how many entries it lost this way, and
+// reports that count with the next entry it pops. Readers pop entries in
+// batches, copying as many as fit into a caller-provided buffer in one call.
+//
+// Each Reader must only be used by one thread at a time. Setting the buffer
+// and attaching or detaching readers must not race with any other operation.
+class MpscPrefixedEntryRingBuffer {
+ public:
+  // Largest supported buffer. Positions are stored in 26 bits of an atomic
+  // word, and must be able to distinguish two laps around the buffer.
+  static constexpr size_t kMaxBufferBytes = size_t{1} << 24;
+
+  // Maximum number of entries that may be reserved but not yet published at
+  // the same time. Additional writers fail with RESOURCE_EXHAUSTED.
+  static constexpr uint32_t kMaxConcurrentWriters = 63;
+
+  // An entry popped by a reader.
+  struct Entry {
+    // Entry data, copied into the buffer passed to PopBatch().
+    span<const std::byte> buffer;
+
+    // User preamble, or zero if the ring buffer has no user preamble.
+    uint32_t preamble;
+
+    // Number of entries this reader lost to eviction just before this entry.
+    uint32_t drop_count;
+  };
+
+  // A reader with its own read position in the ring buffer it is attached to.
+  //
+  // Writers may push the reader forward to make space. The entry at the read
+  // position is pinned while it is being copied out, so a reader never
+  // observes a partially overwritten entry.
+  class Reader : public IntrusiveList<Reader>::Item {
+   public:
+    constexpr Reader() = default;
+
+    Reader(const Reader&) = delete;
+    Reader& operator=(const Reader&) = delete;
+
+    // Pops up to entries.size() entries, copying their data back-to-back into
+    // buffer and describing each in entries. Stops early when the next entry
+    // does not fit in the remaining buffer space.
+    //
+    // Return values:
+    // OK - At least one entry was popped; size() is the number of entries.
+    // FAILED_PRECONDITION - Not attached, or the buffer is not initialized.
+    // OUT_OF_RANGE - No committed entries are available.
+    // RESOURCE_EXHAUSTED - The front entry is larger than buffer. It is left
+    // in place.
+    // UNAVAILABLE - A writer is evicting the front entry. Retry later.
+    StatusWithSize PopBatch(span<std::byte> buffer, span<Entry> entries);
+
+    // Pops a single entry. Equivalent to PopBatch() with one entry.
+    Status PopFront(span<std::byte> buffer, Entry& entry) {
+      return PopBatch(buffer, span(&entry, 1)).status();
+    }
+
+   private:
+    friend class MpscPrefixedEntryRingBuffer;
+
+    MpscPrefixedEntryRingBuffer* ring_buffer_ = nullptr;
+
+    // Read position, with kPinned set while entries are being read or evicted.
+    std::atomic<uint32_t> read_pos_{0};
+
+    // Entries evicted since this reader last popped an entry.
+    std::atomic<uint32_t> drop_count_{0};
+  };
+
+  constexpr MpscPrefixedEntryRingBuffer(bool user_preamble = false)
+      : user_preamble_(user_preamble) {}
+
+  MpscPrefixedEntryRingBuffer(const MpscPrefixedEntryRingBuffer&) = delete;
+  MpscPrefixedEntryRingBuffer& operator=(const MpscPrefixedEntryRingBuffer&) =
+      delete;
+
+  // Sets the raw buffer to be used by the ring buffer and discards any entries.
+  //
+  // Return values:
+  // OK - Successfully set the raw buffer.
+  // INVALID_ARGUMENT - Argument was nullptr, size zero, or too large.
+  Status SetBuffer(span<std::byte> buffer);
+
+  // Attaches a reader. The reader starts at the position of the slowest
+  // attached reader, or after the newest entry if no readers are attached.
+  //
+  // Return values:
+  // OK - Successfully attached the reader.
+  // INVALID_ARGUMENT - The reader is already attached to a ring buffer.
+  Status AttachReader(Reader& reader);
+
+  // Detaches a reader.
+  //
+  // Return values:
+  // OK - Successfully detached the reader.
+  // INVALID_ARGUMENT - The reader is not attached to this ring buffer.
+  Status DetachReader(Reader& reader);
+
+  // Writes an entry, pushing slow readers forward as needed to make space.
+  // Safe to call from multiple threads and interrupts concurrently.
+  //
+  // Return values:
+  // OK - Data successfully written to the ring buffer.
+  // FAILED_PRECONDITION - Buffer not initialized.
+  // OUT_OF_RANGE - Size of the entry is greater than the buffer size.
+  // RESOURCE_EXHAUSTED - Space could not be made without waiting on a reader
+  // or on other writers. The entry was not written.
+  Status PushBack(span<const std::byte> data, uint32_t user_preamble_data = 0) {
+    return InternalPushBack(data, user_preamble_data, true);
+  }
+
+  // Writes an entry if there is space without evicting any entries. Safe to
+  // call from multiple threads and interrupts concurrently.
+  //
+  // Return values:
+  // OK - Data successfully written to the ring buffer.
+  // FAILED_PRECONDITION - Buffer not initialized.
+  // OUT_OF_RANGE - Size of the entry is greater than the buffer size.
+  // RESOURCE_EXHAUSTED - The ring buffer doesn't have space for the entry.
+  Status TryPushBack(span<const std::byte> data,
+                     uint32_t user_preamble_data = 0) {
+    return InternalPushBack(data, user_preamble_data, false);
+  }
+
+  // Returns total size of ring buffer in bytes.
+  size_t TotalSizeBytes() const { return buffer_bytes_; }
+
+ private:
+  // Bit in a reader's position that is set while its front entry is in use.
+  static constexpr uint32_t kPinned = uint32_t{1} << 31;
+
+  // The write and published indices hold a position in the low bits and a
+  // ticket in the high bits. The write index holds the ticket for the next
+  // reservation, and the published index holds the ticket of the oldest entry
+  // that is not yet published.
+  static constexpr uint32_t kPositionBits = 26;
+  static constexpr uint32_t kPositionMask = (uint32_t{1} << kPositionBits) - 1;
+  static constexpr uint32_t kOneTicket = uint32_t{1} << kPositionBits;
+  static constexpr uint32_t kTickets = ~uint32_t{0} / kOneTicket + 1;
+
+  // Set in a commit slot that holds the end position of a committed entry.
+  static constexpr uint32_t kCommitted = uint32_t{1} << 31;
+
+  static_assert(kMaxConcurrentWriters == kTickets - 1);
+  static_assert(kMaxBufferBytes * 2 <= kPositionMask + 1);
+  static_assert(std::atomic<uint32_t>::is_always_lock_free);
+
+  struct EntryInfo {
+    size_t preamble_bytes;
+    uint32_t user_preamble;
+    size_t data_bytes;
+  };
+
+  Status InternalPushBack(span<const std::byte> data,
+                          uint32_t user_preamble_data,
+                          bool pop_front_if_needed);
+
+  // Reserves `size` bytes, evicting entries if allowed. Returns the ticket and
+  // position of the reserved space, packed like the write index.
+  Result<uint32_t> Reserve(size_t size, bool pop_front_if_needed);
+
+  // Marks the entry reserved as `reservation` as complete, and publishes it
+  // if every entry before it has been published.
+  void Commit(uint32_t reservation, size_t size);
+
+  // Publishes committed entries, in ticket order, until reaching an entry
+  // that is not committed.
+  void Publish();
+
+  // Pushes every reader at `tail` past the entry at `tail`.
+  Status EvictFront(uint32_t tail);
+
+  StatusWithSize InternalPopBatch(Reader& reader,
+                                  span<std::byte> buffer,
+                                  span<Entry> entries);
+
+  // Returns the position of the slowest reader relative to `head`, or `head`
+  // if there are no readers. Sets `pinned` if the slowest reader's front entry
+  // is in use.
+  uint32_t SlowestReader(uint32_t head, bool& pinned) const;
+
+  // Returns the position after the newest entry that readers may read.
+  uint32_t PublishedEnd() const {
+    return published_.load(std::memory_order_acquire) & kPositionMask;
+  }
+
+  std::atomic<uint32_t>& CommitSlot(uint32_t index) {
+    return commits_[index / kOneTicket];
+  }
+
+  // Returns true if `pos` is before `end`.
+  bool IsBefore(uint32_t pos, uint32_t end) const {
+    return pos != end && Distance(end, pos) <= buffer_bytes_;
+  }
+
+  // Reads the preamble of the entry that starts at buffer index `index`.
+  EntryInfo ReadEntryInfo(size_t index) const;
+
+  // Copies data to or from the buffer starting at `index`, wrapping around the
+  // end of the buffer as needed. RawWrite() returns the index after the data.
+  size_t RawWrite(size_t index, span<const std::byte> data);
+  void RawRead(size_t index, span<std::byte> data) const;
+
+  // Positions count bytes modulo position_limit_, a multiple of the buffer
+  // size, which keeps them unambiguous across more than one lap.
+  uint32_t Advance(uint32_t pos, size_t bytes) const {
+    uint32_t next = pos + static_cast<uint32_t>(bytes);
+    return next >= position_limit_ ? next - position_limit_ : next;
+  }
+  uint32_t Distance(uint32_t end, uint32_t begin) const {
+    return end >= begin ? end - begin : end + position_limit_ - begin;
+  }
+  size_t Index(uint32_t pos) const { return pos % buffer_bytes_; }
+  size_t IncrementIndex(size_t index, size_t bytes) const {
+    index += bytes;
+    return index >= buffer_bytes_ ? index - buffer_bytes_ : index;
+  }
+
+  std::byte* buffer_ = nullptr;
+  uint32_t buffer_bytes_ = 0;
+  uint32_t position_limit_ = 0;
+
+  // Position after the newest reserved entry and the next ticket.
+  std::atomic<uint32_t> write_{0};
+
+  // Position after the newest published entry and the ticket of the entry
+  // after it. Every entry before this position has been committed.
+  std::atomic<uint32_t> published_{0};
+
+  // For each ticket, zero until the entry that holds it is committed, and then
+  // its end position with kCommitted set until it is published.
+  std::array<std::atomic<uint32_t>, kTickets> commits_{};
+
+  IntrusiveList<Reader> readers_;
+  const bool user_preamble_;
+};
+
+}  // namespace pw::ring_buffer
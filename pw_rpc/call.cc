@@ -259,20 +259,59 @@ Status Call::TryCloseAndSendFinalPacketLocked(PacketType type,
   return send_status;
 }
 
-Status Call::WriteLocked(ConstByteSpan payload) {
-  return SendPacket(properties_.call_type() == kServerCall
-                        ? PacketType::SERVER_STREAM
-                        : PacketType::CLIENT_STREAM,
-                    payload);
+Status Call::SendPacketAndUnlock(PacketType type, ConstByteSpan payload) {
+  if (!active_locked()) {
+    encoding_buffer.ReleaseIfAllocated();
+    rpc_lock().unlock();
+    return Status::FailedPrecondition();
+  }
+
+  ChannelBase* channel = endpoint_->GetInternalChannel(channel_id_);
+  if (channel == nullptr) {
+    encoding_buffer.ReleaseIfAllocated();
+    rpc_lock().unlock();
+    return Status::Unavailable();
+  }
+  return channel->SendAndUnlock(MakePacket(type, payload));
 }
 
-Status Call::WriteCallbackLocked(
+Status Call::WriteAndUnlock(ConstByteSpan payload) {
+  return SendPacketAndUnlock(properties_.call_type() == kServerCall
+                                 ? PacketType::SERVER_STREAM
+                                 : PacketType::CLIENT_STREAM,
+                             payload);
+}
+
+Status Call::WriteWithHeader(
+    size_t payload_size,
+    const Function<Status(ChannelOutput&, ConstByteSpan)>& send) {
+  RpcLockGuard lock;
+  if (!active_locked()) {
+    return Status::FailedPrecondition();
+  }
+
+  ChannelBase* channel = endpoint_->GetInternalChannel(channel_id_);
+  if (channel == nullptr) {
+    return Status::Unavailable();
+  }
+  return channel->SendWithHeader(
+      MakePacket(properties_.call_type() == kServerCall
+                     ? PacketType::SERVER_STREAM
+                     : PacketType::CLIENT_STREAM,
+                 {}),
+      payload_size,
+      send);
+}
+
+Status Call::WriteCallbackAndUnlock(
     const Function<StatusWithSize(ByteSpan)>& callback) {
-  PW_TRY_ASSIGN(ConstByteSpan payload, EncodeCallbackToPayloadBuffer(callback));
-  return SendPacket(properties_.call_type() == kServerCall
-                        ? PacketType::SERVER_STREAM
-                        : PacketType::CLIENT_STREAM,
-                    payload);
+  Result<ConstByteSpan> payload = EncodeCallbackToPayloadBuffer(callback);
+  if (!payload.ok()) {
+    encoding_buffer.ReleaseIfAllocated();
+    rpc_lock().unlock();
+    return payload.status();
+  }
+  return WriteAndUnlock(*payload);
 }
 
 // This definition is in the .cc file because the Endpoint class is not defined
@@ -18,6 +18,10 @@
 #include "pw_rpc/channel.h"
 // clang-format on
 
+#include <array>
+#include <cstdint>
+#include <mutex>
+
 #include "pw_assert/check.h"
 #include "pw_bytes/span.h"
 #include "pw_log/log.h"
@@ -26,6 +30,7 @@
 #include "pw_rpc/internal/config.h"
 #include "pw_rpc/internal/encoding_buffer.h"
 #include "pw_rpc/internal/packet.pwpb.h"
+#include "pw_toolchain/no_destructor.h"
 
 using pw::rpc::internal::pwpb::RpcPacket::Fields;
 
@@ -46,7 +51,9 @@ Status OverwriteChannelId(ByteSpan rpc_packet, uint32_t channel_id_under_128) {
   return OkStatus();
 }
 
-Status ChannelBase::Send(const Packet& packet) {
+namespace {
+
+void LogOutgoingPacket([[maybe_unused]] const Packet& packet) {
   static constexpr bool kLogAllOutgoingPackets = false;
   if constexpr (kLogAllOutgoingPackets) {
     PW_LOG_INFO("pw_rpc channel sending RPC packet type %u for %u:%08x/%08x",
@@ -55,36 +62,162 @@ Status ChannelBase::Send(const Packet& packet) {
                 static_cast<unsigned>(packet.service_id()),
                 static_cast<unsigned>(packet.method_id()));
   }
+}
+
+Status EncodeFailed(const Packet& packet, uint32_t channel_id, Status status) {
+  PW_LOG_ERROR(
+      "Failed to encode RPC packet type %u to channel %u buffer, status %u",
+      static_cast<unsigned>(packet.type()),
+      static_cast<unsigned>(channel_id),
+      status.code());
+  return Status::Internal();
+}
+
+Status SendResult(uint32_t channel_id, Status sent) {
+  if (!sent.ok()) {
+    PW_LOG_ERROR("Channel %u failed to send packet with status %u",
+                 static_cast<unsigned>(channel_id),
+                 sent.code());
+    // Channel implementers are free to return whichever status makes sense in
+    // their context, but these are always mapped to UNKNOWN so the user-facing
+    // functions (e.g. Finish()) always return a fixed set of statuses.
+    return Status::Unknown();
+  }
+  return OkStatus();
+}
+
+#if PW_RPC_SEND_LOCK_SHARDS > 0
+
+// ChannelOutput::Send requires the RPC lock, but with send shards, stream
+// packets are sent while holding only the output's shard lock.
+Status SendWithShardLock(ChannelOutput& output, ConstByteSpan packet)
+    PW_NO_LOCK_SAFETY_ANALYSIS {
+  return output.Send(packet);
+}
+
+#endif  // PW_RPC_SEND_LOCK_SHARDS > 0
+
+}  // namespace
+
+#if PW_RPC_SEND_LOCK_SHARDS > 0
+
+SendShard& GetSendShard(const ChannelOutput& output) {
+  static NoDestructor<std::array<SendShard, PW_RPC_SEND_LOCK_SHARDS>> shards;
+  const auto address = reinterpret_cast<uintptr_t>(&output);
+  return (*shards)[(address / alignof(ChannelOutput)) %
+                   PW_RPC_SEND_LOCK_SHARDS];
+}
+
+#endif  // PW_RPC_SEND_LOCK_SHARDS > 0
+
+Status ChannelBase::Send(const Packet& packet) {
+  LogOutgoingPacket(packet);
 
   ByteSpan buffer = encoding_buffer.GetPacketBuffer(packet.payload().size());
   Result encoded = packet.Encode(buffer);
 
   if (!encoded.ok()) {
     encoding_buffer.Release();
-    PW_LOG_ERROR(
-        "Failed to encode RPC packet type %u to channel %u buffer, status %u",
-        static_cast<unsigned>(packet.type()),
-        static_cast<unsigned>(id()),
-        encoded.status().code());
-    return Status::Internal();
+    return EncodeFailed(packet, id(), encoded.status());
   }
 
   PW_CHECK_NOTNULL(output_);
+#if PW_RPC_SEND_LOCK_SHARDS > 0
+  // Another thread may be sending to this output without the RPC lock.
+  std::lock_guard shard_lock(GetSendShard(*output_).mutex());
+#endif  // PW_RPC_SEND_LOCK_SHARDS > 0
   Status sent = output_->Send(encoded.value());
   encoding_buffer.Release();
 
-  if (!sent.ok()) {
-    PW_LOG_ERROR("Channel %u failed to send packet with status %u",
-                 static_cast<unsigned>(id()),
-                 sent.code());
-    // Channel implementers are free to return whichever status makes sense in
-    // their context, but these are always mapped to UNKNOWN so the user-facing
-    // functions (e.g. Finish()) always return a fixed set of statuses.
-    return Status::Unknown();
+  return SendResult(id(), sent);
+}
+
+Status ChannelBase::SendWithHeader(
+    const Packet& packet,
+    size_t payload_size,
+    const Function<Status(ChannelOutput&, ConstByteSpan)>& send) {
+  LogOutgoingPacket(packet);
+
+  std::array<std::byte, Packet::kMinEncodedSizeWithoutPayload> buffer;
+  Result header = packet.EncodeHeader(buffer, payload_size);
+  if (!header.ok()) {
+    return EncodeFailed(packet, id(), header.status());
   }
-  return OkStatus();
+
+  PW_CHECK_NOTNULL(output_);
+#if PW_RPC_SEND_LOCK_SHARDS > 0
+  std::lock_guard shard_lock(GetSendShard(*output_).mutex());
+#endif  // PW_RPC_SEND_LOCK_SHARDS > 0
+  return SendResult(id(), send(*output_, *header));
+}
+
+#if PW_RPC_SEND_LOCK_SHARDS > 0
+
+Status ChannelBase::SendAndUnlock(const Packet& packet) {
+  LogOutgoingPacket(packet);
+
+  PW_CHECK_NOTNULL(output_);
+
+  // The channel may be moved or closed once the RPC lock is released, so copy
+  // what is needed to send the packet.
+  ChannelOutput& output = *output_;
+  const uint32_t channel_id = id();
+
+  // Acquire the shard lock before releasing the RPC lock. This keeps packets
+  // for the same call in order, since any later send for the call must also
+  // acquire this shard's lock.
+  SendShard& shard = GetSendShard(output);
+  shard.mutex().lock();
+
+  EncodingBuffer& shard_buffer = shard.encoding_buffer();
+  Result encoded =
+      packet.Encode(shard_buffer.GetPacketBuffer(packet.payload().size()));
+
+  // The payload has been copied, so the global encoding buffer is free.
+  encoding_buffer.ReleaseIfAllocated();
+  rpc_lock().unlock();
+
+  Status status;
+  if (encoded.ok()) {
+    status = SendResult(channel_id, SendWithShardLock(output, *encoded));
+  } else {
+    status = EncodeFailed(packet, channel_id, encoded.status());
+  }
+
+  shard_buffer.Release();
+  shard.mutex().unlock();
+  return status;
 }
 
+void ChannelBase::Close() {
+  PW_ASSERT(id_ != kUnassignedChannelId);
+
+  // New sends cannot start while the RPC lock is held. Acquire the shard lock
+  // to wait for any send that already released the RPC lock to finish.
+  if (output_ != nullptr) {
+    std::lock_guard shard_lock(GetSendShard(*output_).mutex());
+  }
+
+  id_ = kUnassignedChannelId;
+  output_ = nullptr;
+}
+
+#else
+
+Status ChannelBase::SendAndUnlock(const Packet& packet) {
+  const Status status = Send(packet);
+  rpc_lock().unlock();
+  return status;
+}
+
+void ChannelBase::Close() {
+  PW_ASSERT(id_ != kUnassignedChannelId);
+  id_ = kUnassignedChannelId;
+  output_ = nullptr;
+}
+
+#endif  // PW_RPC_SEND_LOCK_SHARDS > 0
+
 }  // namespace internal
 
 Result<uint32_t> ExtractChannelId(ConstByteSpan packet) {
@@ -0,0 +1,177 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// Measures stream write throughput with 1 to 16 threads, each writing to its
+// own channel. Compare builds with different PW_RPC_SEND_LOCK_SHARDS values to
+// see how much of the send path runs in parallel.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_assert/assert.h"
+#include "pw_perf_test/perf_test.h"
+#include "pw_rpc/internal/packet.h"
+#include "pw_rpc/raw/server_reader_writer.h"
+#include "pw_rpc/server.h"
+#include "pw_rpc_test_protos/test.raw_rpc.pb.h"
+#include "pw_sync/binary_semaphore.h"
+#include "pw_thread/test_thread_context.h"
+#include "pw_thread/thread.h"
+
+namespace pw::rpc {
+namespace {
+
+using internal::Packet;
+using internal::pwpb::PacketType;
+using StreamMethod =
+    internal::MethodInfo<test::pw_rpc::raw::TestService::TestServerStreamRpc>;
+
+constexpr size_t kMaxThreads = 16;
+constexpr size_t kWritesPerIteration = 32;
+constexpr size_t kPayloadSize = 64;
+
+class TestServiceImpl final
+    : public test::pw_rpc::raw::TestService::Service<TestServiceImpl> {
+ public:
+  static void TestUnaryRpc(ConstByteSpan, RawUnaryResponder&) {}
+
+  void TestAnotherUnaryRpc(ConstByteSpan, RawUnaryResponder&) {}
+
+  void TestServerStreamRpc(ConstByteSpan, RawServerWriter& writer) {
+    writers[opened++] = std::move(writer);
+  }
+
+  void TestClientStreamRpc(RawServerReader&) {}
+
+  void TestBidirectionalStreamRpc(RawServerReaderWriter&) {}
+
+  std::array<RawServerWriter, kMaxThreads> writers;
+  size_t opened = 0;
+};
+
+// Copies and checksums each packet, standing in for a transport's framing.
+class TransportChannelOutput : public ChannelOutput {
+ public:
+  TransportChannelOutput() : ChannelOutput("TransportChannelOutput") {}
+
+  Status Send(span<const std::byte> buffer) override {
+    PW_ASSERT(buffer.size() <= frame_.size());
+    uint32_t checksum = 2166136261u;
+    for (size_t i = 0; i < buffer.size(); ++i) {
+      frame_[i] = buffer[i];
+      checksum = (checksum ^ static_cast<uint32_t>(buffer[i])) * 16777619u;
+    }
+    checksum_ = checksum;
+    return OkStatus();
+  }
+
+ private:
+  std::array<std::byte, 128> frame_;
+  volatile uint32_t checksum_ = 0;
+};
+
+// A thread that writes kWritesPerIteration packets to a stream each time it is
+// started.
+class Writer {
+ public:
+  void Start(RawServerWriter& writer) {
+    writer_ = &writer;
+    thread_ = Thread(context_.options(), [this] { Run(); });
+  }
+
+  void Write() { start_.release(); }
+
+  void WaitForWrites() { done_.acquire(); }
+
+  void Stop() {
+    running_ = false;
+    start_.release();
+    thread_.join();
+  }
+
+ private:
+  void Run() {
+    const std::array<std::byte, kPayloadSize> payload{};
+    while (true) {
+      start_.acquire();
+      if (!running_) {
+        return;
+      }
+      for (size_t i = 0; i < kWritesPerIteration; ++i) {
+        PW_ASSERT(writer_->Write(payload).ok());
+      }
+      done_.release();
+    }
+  }
+
+  RawServerWriter* writer_ = nullptr;
+  bool running_ = true;
+  sync::BinarySemaphore start_;
+  sync::BinarySemaphore done_;
+  thread::test::TestThreadContext context_;
+  Thread thread_;
+};
+
+void WriteStreamTest(perf_test::State& state, size_t thread_count) {
+  std::array<TransportChannelOutput, kMaxThreads> outputs;
+  std::array<Channel, kMaxThreads> channels;
+  Server server(channels);
+  TestServiceImpl service;
+  server.RegisterService(service);
+
+  for (uint32_t i = 0; i < thread_count; ++i) {
+    PW_ASSERT(server.OpenChannel(i + 1, outputs[i]).ok());
+
+    std::array<std::byte, 32> buffer;
+    const Result<ConstByteSpan> request = Packet(PacketType::REQUEST,
+                                                 i + 1,
+                                                 StreamMethod::kServiceId,
+                                                 StreamMethod::kMethodId,
+                                                 i + 1,
+                                                 {})
+                                              .Encode(buffer);
+    PW_ASSERT(request.ok());
+    PW_ASSERT(server.ProcessPacket(*request).ok());
+  }
+  PW_ASSERT(service.opened == thread_count);
+
+  std::array<Writer, kMaxThreads> writers;
+  for (size_t i = 0; i < thread_count; ++i) {
+    writers[i].Start(service.writers[i]);
+  }
+
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < thread_count; ++i) {
+      writers[i].Write();
+    }
+    for (size_t i = 0; i < thread_count; ++i) {
+      writers[i].WaitForWrites();
+    }
+  }
+
+  for (size_t i = 0; i < thread_count; ++i) {
+    writers[i].Stop();
+  }
+  server.UnregisterService(service);
+}
+
+PW_PERF_TEST(WriteStream_1Thread, WriteStreamTest, 1);
+PW_PERF_TEST(WriteStream_2Threads, WriteStreamTest, 2);
+PW_PERF_TEST(WriteStream_4Threads, WriteStreamTest, 4);
+PW_PERF_TEST(WriteStream_8Threads, WriteStreamTest, 8);
+PW_PERF_TEST(WriteStream_16Threads, WriteStreamTest, 16);
+
+}  // namespace
+}  // namespace pw::rpc
@@ -0,0 +1,277 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// Stress tests for streams written from many threads at once. These cover the
+// guarantees pw_rpc makes regardless of PW_RPC_SEND_LOCK_SHARDS: each call's
+// packets are sent in order, ChannelOutput::Send is never called concurrently
+// for the same output, and no packets are sent to an output after its channel
+// is closed.
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+#include "pw_bytes/span.h"
+#include "pw_rpc/internal/packet.h"
+#include "pw_rpc/raw/server_reader_writer.h"
+#include "pw_rpc/server.h"
+#include "pw_rpc_test_protos/test.raw_rpc.pb.h"
+#include "pw_status/status.h"
+#include "pw_thread/test_thread_context.h"
+#include "pw_thread/thread.h"
+#include "pw_thread/yield.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::rpc {
+namespace {
+
+using internal::Packet;
+using internal::pwpb::PacketType;
+using StreamMethod =
+    internal::MethodInfo<test::pw_rpc::raw::TestService::TestServerStreamRpc>;
+
+constexpr size_t kChannelCount = 4;
+constexpr size_t kThreadCount = 8;
+constexpr uint32_t kWritesPerThread = 500;
+
+class TestServiceImpl final
+    : public test::pw_rpc::raw::TestService::Service<TestServiceImpl> {
+ public:
+  static void TestUnaryRpc(ConstByteSpan, RawUnaryResponder&) {}
+
+  void TestAnotherUnaryRpc(ConstByteSpan, RawUnaryResponder&) {}
+
+  void TestServerStreamRpc(ConstByteSpan, RawServerWriter& writer) {
+    writers[opened++] = std::move(writer);
+  }
+
+  void TestClientStreamRpc(RawServerReader&) {}
+
+  void TestBidirectionalStreamRpc(RawServerReaderWriter&) {}
+
+  std::array<RawServerWriter, kThreadCount> writers;
+  size_t opened = 0;
+};
+
+// Checks the packets sent to it. Problems are counted rather than reported
+// with test assertions, which may only be used from the test thread.
+class CheckingChannelOutput : public ChannelOutput {
+ public:
+  CheckingChannelOutput() : ChannelOutput("CheckingChannelOutput") {}
+
+  Status Send(span<const std::byte> buffer) override {
+    if (sending_.exchange(true)) {
+      concurrent_sends_ += 1;
+    }
+    if (closed_) {
+      sends_after_close_ += 1;
+    }
+
+    Result<Packet> packet = Packet::FromBuffer(buffer);
+    if (!packet.ok() || packet->call_id() == 0 ||
+        packet->call_id() > kThreadCount) {
+      invalid_packets_ += 1;
+    } else if (packet->type() == PacketType::SERVER_STREAM) {
+      uint32_t sequence;
+      std::memcpy(&sequence, packet->payload().data(), sizeof(sequence));
+      uint32_t& expected = next_sequence_[packet->call_id() - 1];
+      if (sequence != expected) {
+        out_of_order_packets_ += 1;
+      }
+      expected = sequence + 1;
+      stream_packets_ += 1;
+    } else if (packet->type() == PacketType::RESPONSE) {
+      responses_ += 1;
+    }
+
+    // Give other threads a chance to send while this send is in progress.
+    this_thread::yield();
+
+    sending_.store(false);
+    return OkStatus();
+  }
+
+  void set_closed() { closed_ = true; }
+
+  int concurrent_sends() const { return concurrent_sends_; }
+  int sends_after_close() const { return sends_after_close_; }
+  int invalid_packets() const { return invalid_packets_; }
+  int out_of_order_packets() const { return out_of_order_packets_; }
+  uint32_t stream_packets() const { return stream_packets_; }
+  uint32_t responses() const { return responses_; }
+
+ private:
+  std::atomic<bool> sending_ = false;
+  std::atomic<bool> closed_ = false;
+  std::atomic<int> concurrent_sends_ = 0;
+  std::atomic<int> sends_after_close_ = 0;
+
+  // Only accessed while sending_ is set.
+  int invalid_packets_ = 0;
+  int out_of_order_packets_ = 0;
+  uint32_t stream_packets_ = 0;
+  uint32_t responses_ = 0;
+  std::array<uint32_t, kThreadCount> next_sequence_{};
+};
+
+class ConcurrentWrites : public ::testing::Test {
+ protected:
+  // Creates channels using the provided outputs, which may be repeated.
+  void Init(std::array<CheckingChannelOutput*, kChannelCount> outputs) {
+    for (size_t i = 0; i < kChannelCount; ++i) {
+      ASSERT_EQ(OkStatus(), server_.OpenChannel(ChannelId(i), *outputs[i]));
+    }
+    server_.RegisterService(service_);
+
+    // Open one server stream per thread, spread across the channels.
+    for (uint32_t call = 0; call < kThreadCount; ++call) {
+      std::array<std::byte, 32> buffer;
+      Result<ConstByteSpan> request = Packet(PacketType::REQUEST,
+                                             ChannelId(call % kChannelCount),
+                                             StreamMethod::kServiceId,
+                                             StreamMethod::kMethodId,
+                                             call + 1,
+                                             {})
+                                          .Encode(buffer);
+      ASSERT_EQ(OkStatus(), request.status());
+      ASSERT_EQ(OkStatus(), server_.ProcessPacket(*request));
+    }
+    ASSERT_EQ(service_.opened, kThreadCount);
+  }
+
+  static constexpr uint32_t ChannelId(size_t index) {
+    return static_cast<uint32_t>(index) + 1;
+  }
+
+  // Writes sequence numbers to a stream until kWritesPerThread are written or
+  // a write fails. Returns the number of successful writes.
+  static uint32_t WriteStream(RawServerWriter& writer) {
+    uint32_t sequence = 0;
+    while (sequence < kWritesPerThread &&
+           writer.Write(as_bytes(span(&sequence, 1))).ok()) {
+      sequence += 1;
+    }
+    return sequence;
+  }
+
+  // Runs a function on kThreadCount threads and waits for them to finish.
+  template <typename Function>
+  void RunThreads(Function function) {
+    struct Task {
+      Function* function;
+      size_t index;
+    };
+    std::array<Task, kThreadCount> tasks;
+    std::array<thread::test::TestThreadContext, kThreadCount> contexts;
+    std::array<Thread, kThreadCount> threads;
+    for (size_t i = 0; i < kThreadCount; ++i) {
+      tasks[i] = {&function, i};
+      threads[i] = Thread(contexts[i].options(), [task = &tasks[i]] {
+        (*task->function)(task->index);
+      });
+    }
+    for (Thread& thread : threads) {
+      thread.join();
+    }
+  }
+
+  // The outputs must outlive the server and service, since destroying an open
+  // stream sends its final response.
+  std::array<CheckingChannelOutput, kChannelCount> outputs_;
+  std::array<Channel, kChannelCount> channels_;
+  Server server_{channels_};
+  TestServiceImpl service_;
+};
+
+TEST_F(ConcurrentWrites, SeparateOutputs_AllPacketsSentInOrder) {
+  Init({&outputs_[0], &outputs_[1], &outputs_[2], &outputs_[3]});
+
+  std::array<uint32_t, kThreadCount> writes{};
+  std::array<Status, kThreadCount> finish_statuses;
+  RunThreads([&](size_t i) {
+    writes[i] = WriteStream(service_.writers[i]);
+    finish_statuses[i] = service_.writers[i].Finish();
+  });
+
+  for (size_t i = 0; i < kThreadCount; ++i) {
+    EXPECT_EQ(writes[i], kWritesPerThread);
+    EXPECT_EQ(finish_statuses[i], OkStatus());
+  }
+  for (const CheckingChannelOutput& output : outputs_) {
+    EXPECT_EQ(output.concurrent_sends(), 0);
+    EXPECT_EQ(output.invalid_packets(), 0);
+    EXPECT_EQ(output.out_of_order_packets(), 0);
+    EXPECT_EQ(output.stream_packets(),
+              kWritesPerThread * (kThreadCount / kChannelCount));
+    EXPECT_EQ(output.responses(), kThreadCount / kChannelCount);
+  }
+}
+
+TEST_F(ConcurrentWrites, SharedOutput_SendsAreSerialized) {
+  CheckingChannelOutput& output = outputs_[0];
+  Init({&output, &output, &output, &output});
+
+  std::array<Status, kThreadCount> finish_statuses;
+  RunThreads([&](size_t i) {
+    WriteStream(service_.writers[i]);
+    finish_statuses[i] = service_.writers[i].Finish();
+  });
+
+  for (Status status : finish_statuses) {
+    EXPECT_EQ(status, OkStatus());
+  }
+  EXPECT_EQ(output.concurrent_sends(), 0);
+  EXPECT_EQ(output.invalid_packets(), 0);
+  EXPECT_EQ(output.out_of_order_packets(), 0);
+  EXPECT_EQ(output.stream_packets(), kWritesPerThread * kThreadCount);
+  EXPECT_EQ(output.responses(), kThreadCount);
+}
+
+TEST_F(ConcurrentWrites, CloseChannel_NoSendsAfterClose) {
+  Init({&outputs_[0], &outputs_[1], &outputs_[2], &outputs_[3]});
+
+  std::atomic<bool> writing = false;
+  Status close_status;
+  RunThreads([&](size_t i) {
+    if (i == 0) {
+      // Close the first channel once another thread is writing to it.
+      while (!writing.load()) {
+        this_thread::yield();
+      }
+      close_status = server_.CloseChannel(ChannelId(0));
+      outputs_[0].set_closed();
+    } else if (i % kChannelCount == 0) {
+      // Write to the first channel until it is closed.
+      for (uint32_t sequence = 0;
+           service_.writers[i].Write(as_bytes(span(&sequence, 1))).ok();
+           ++sequence) {
+        writing = true;
+      }
+    } else {
+      WriteStream(service_.writers[i]);
+    }
+  });
+
+  EXPECT_EQ(close_status, OkStatus());
+  for (const CheckingChannelOutput& output : outputs_) {
+    EXPECT_EQ(output.concurrent_sends(), 0);
+    EXPECT_EQ(output.sends_after_close(), 0);
+    EXPECT_EQ(output.invalid_packets(), 0);
+    EXPECT_EQ(output.out_of_order_packets(), 0);
+  }
+}
+
+}  // namespace
+}  // namespace pw::rpc
@@ -0,0 +1,126 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// clang-format off
+#include "pw_rpc/internal/log_config.h" // PW_LOG_* macros must be first.
+
+#include "pw_rpc/internal/method_index.h"
+// clang-format on
+
+#include <algorithm>
+
+#include "pw_log/log.h"
+#include "pw_rpc/service.h"
+
+namespace pw::rpc::internal {
+
+void MethodIndex::Rebuild(IntrusiveList<Service>& services) {
+  size_ = 0;
+  active_ = false;
+
+  if (entries_.empty()) {
+    return;
+  }
+
+  const auto less = [](const Entry& lhs, const Entry& rhs) {
+    return lhs.service_id < rhs.service_id ||
+           (lhs.service_id == rhs.service_id && lhs.method_id < rhs.method_id);
+  };
+
+  // Inserts an entry after any equal entries, so the first match in the list
+  // is found first, as it would be by a linear search.
+  bool overflow = false;
+  const auto insert = [&](const Entry& entry) {
+    if (size_ == entries_.size()) {
+      overflow = true;
+      return false;
+    }
+    Entry* const end = entries_.data() + size_;
+    Entry* const position = std::upper_bound(entries_.data(), end, entry, less);
+    std::move_backward(position, end, end + 1);
+    *position = entry;
+    size_ += 1;
+    return true;
+  };
+
+  for (auto service = services.begin();
+       service != services.end() && !overflow;
+       ++service) {
+    // Only the first match in the list, which is the most recently registered
+    // service, is indexed for each service ID.
+    if (std::find_if(services.begin(), service, [&](const Service& other) {
+          return other.id_ == service->id_;
+        }) != service) {
+      continue;
+    }
+
+    Entry entry;
+    entry.service_id = service->id_;
+    entry.service = &(*service);
+
+    // A service without methods still needs an entry so that lookups can
+    // distinguish an unknown method from an unknown service.
+    if (service->method_count_ == 0u) {
+      entry.method_id = 0;
+      entry.method = nullptr;
+      insert(entry);
+      continue;
+    }
+
+    for (size_t i = 0; i < service->method_count_; ++i) {
+      entry.method = &service->method(i);
+      entry.method_id = entry.method->id();
+      if (!insert(entry)) {
+        break;
+      }
+    }
+  }
+
+  if (overflow) {
+    PW_LOG_WARN(
+        "RPC method index is full (%u entries); falling back to linear search",
+        static_cast<unsigned>(entries_.size()));
+    size_ = 0;
+    return;
+  }
+
+  active_ = true;
+}
+
+std::tuple<Service*, const Method*> MethodIndex::Find(
+    uint32_t service_id, uint32_t method_id) const {
+  const Entry* const begin = entries_.data();
+  const Entry* const end = begin + size_;
+  const Entry* const entry = std::lower_bound(
+      begin, end, service_id, [method_id](const Entry& e, uint32_t id) {
+        return e.service_id < id ||
+               (e.service_id == id && e.method_id < method_id);
+      });
+
+  if (entry != end && entry->service_id == service_id) {
+    if (entry->method_id == method_id) {
+      return {entry->service, entry->method};
+    }
+    return {entry->service, nullptr};
+  }
+
+  // The method ID may be greater than any of the service's method IDs.
+  if (entry != begin && (entry - 1)->service_id == service_id) {
+    return {(entry - 1)->service, nullptr};
+  }
+
+  return {};
+}
+
+}  // namespace pw::rpc::internal
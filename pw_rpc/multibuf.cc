@@ -0,0 +1,173 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_rpc/multibuf.h"
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <optional>
+
+#include "pw_assert/check.h"
+#include "pw_rpc/internal/call.h"
+#include "pw_rpc/internal/encoding_buffer.h"
+
+namespace pw::rpc {
+namespace internal {
+
+class MultiBufWriter {
+ public:
+  // Sends a packet made up of the header and payload. Called by
+  // Call::WriteWithHeader with the RPC lock held.
+  static Status Send(ChannelOutput& output,
+                     ConstByteSpan header,
+                     MultiBuf& payload) PW_NO_LOCK_SAFETY_ANALYSIS {
+    MultiBufChannelOutput* multibuf_output = output.AsMultiBufChannelOutput();
+    if (multibuf_output == nullptr) {
+      return SendFromEncodingBuffer(output, header, payload);
+    }
+    if (!PrependHeader(header, payload)) {
+      return multibuf_output->SendCopy(header, &payload);
+    }
+    return multibuf_output->SendMultiBuf(std::move(payload));
+  }
+
+ private:
+  // Returns the offset of the top layer within the layer beneath it, or
+  // std::nullopt if it cannot be determined. On success, the top layer is
+  // removed.
+  static std::optional<size_t> PopPayloadLayer(MultiBuf& payload) {
+    if (payload.NumLayers() < 2u || payload.IsTopLayerSealed()) {
+      return std::nullopt;
+    }
+    auto chunks = payload.ConstChunks();
+    if (chunks.begin() == chunks.end()) {
+      return std::nullopt;
+    }
+    const std::byte* const start = (*chunks.begin()).data();
+
+    payload.PopLayer();
+
+    // Find where the payload starts within the exposed layer.
+    size_t offset = 0;
+    for (ConstByteSpan chunk : payload.ConstChunks()) {
+      if (!std::less<>()(start, chunk.data()) &&
+          std::less<>()(start, chunk.data() + chunk.size())) {
+        return offset + static_cast<size_t>(start - chunk.data());
+      }
+      offset += chunk.size();
+    }
+    PW_CRASH("A MultiBuf layer must be within the layer beneath it");
+  }
+
+  // Encodes the header into the space reserved in front of the payload, and
+  // adds a layer for the packet. Returns false if there was no room, in which
+  // case the payload is unchanged.
+  static bool PrependHeader(ConstByteSpan header, MultiBuf& payload) {
+    const size_t payload_size = payload.size();
+    const std::optional<size_t> offset = PopPayloadLayer(payload);
+    if (!offset.has_value()) {
+      return false;
+    }
+
+    if (*offset < header.size()) {
+      PW_ASSERT(payload.AddLayer(*offset, payload_size));
+      return false;
+    }
+
+    const size_t packet_offset = *offset - header.size();
+    payload.CopyFrom(header, packet_offset);
+    if (!payload.AddLayer(packet_offset, header.size() + payload_size)) {
+      PW_ASSERT(payload.AddLayer(*offset, payload_size));
+      return false;
+    }
+    return true;
+  }
+
+  // Copies the header and payload into the encoding buffer and sends them to
+  // an output that only accepts contiguous packets.
+  static Status SendFromEncodingBuffer(ChannelOutput& output,
+                                       ConstByteSpan header,
+                                       const MultiBuf& payload)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
+    const size_t packet_size = header.size() + payload.size();
+    ByteSpan buffer = encoding_buffer.GetPacketBuffer(payload.size());
+    if (buffer.size() < packet_size) {
+      encoding_buffer.ReleaseIfAllocated();
+      return Status::ResourceExhausted();
+    }
+    std::memcpy(buffer.data(), header.data(), header.size());
+    payload.CopyTo(buffer.subspan(header.size()));
+
+    const Status status = output.Send(buffer.first(packet_size));
+    encoding_buffer.Release();
+    return status;
+  }
+};
+
+Result<ConstByteSpan> ContiguousPacket(const FlatConstMultiBuf& packet,
+                                       ByteSpan scratch) {
+  ConstByteSpan contiguous;
+  for (ConstByteSpan chunk : packet.ConstChunks()) {
+    if (contiguous.empty()) {
+      contiguous = chunk;
+    } else if (contiguous.data() + contiguous.size() == chunk.data()) {
+      contiguous = ConstByteSpan(contiguous.data(),
+                                 contiguous.size() + chunk.size());
+    } else {
+      if (scratch.size() < packet.size()) {
+        return Status::ResourceExhausted();
+      }
+      return scratch.first(packet.CopyTo(scratch));
+    }
+  }
+  return contiguous;
+}
+
+}  // namespace internal
+
+Status MultiBufChannelOutput::Send(span<const std::byte> buffer) {
+  return SendCopy(buffer, nullptr);
+}
+
+Status MultiBufChannelOutput::SendCopy(ConstByteSpan header,
+                                       const MultiBuf* payload) {
+  const size_t payload_size = payload == nullptr ? 0u : payload->size();
+  UniquePtr<std::byte[]> bytes =
+      allocator_.MakeUnique<std::byte[]>(header.size() + payload_size);
+  if (bytes == nullptr) {
+    return Status::ResourceExhausted();
+  }
+  std::memcpy(bytes.get(), header.data(), header.size());
+  if (payload != nullptr) {
+    payload->CopyTo(ByteSpan(bytes.get() + header.size(), payload_size));
+  }
+
+  MultiBuf::Instance packet(allocator_);
+  if (!packet->TryReserveForPushBack(bytes)) {
+    return Status::ResourceExhausted();
+  }
+  packet->PushBack(std::move(bytes));
+  return SendMultiBuf(std::move(packet));
+}
+
+Status WriteMultiBuf(Writer& writer, MultiBuf::Instance&& payload) {
+  MultiBuf& packet = *payload;
+  return internal::Call::FromWriter(writer).WriteWithHeader(
+      packet.size(), [&packet](ChannelOutput& output, ConstByteSpan header) {
+        return internal::MultiBufWriter::Send(output, header, packet);
+      });
+}
+
+}  // namespace pw::rpc
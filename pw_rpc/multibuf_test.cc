@@ -0,0 +1,326 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_rpc/multibuf.h"
+
+#include <array>
+#include <cstring>
+#include <optional>
+
+#include "pw_allocator/testing.h"
+#include "pw_bytes/array.h"
+#include "pw_rpc/internal/packet.h"
+#include "pw_rpc/raw/server_reader_writer.h"
+#include "pw_rpc/server.h"
+#include "pw_rpc_test_protos/test.raw_rpc.pb.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::rpc {
+namespace {
+
+using allocator::test::AllocatorForTest;
+using internal::Packet;
+using internal::pwpb::PacketType;
+using StreamMethod =
+    internal::MethodInfo<test::pw_rpc::raw::TestService::TestServerStreamRpc>;
+
+constexpr uint32_t kChannelId = 1;
+constexpr uint32_t kCallId = 7;
+constexpr auto kPayload = bytes::Array<1, 2, 3, 4, 5, 6, 7, 8, 9, 10>();
+
+class TestServiceImpl final
+    : public test::pw_rpc::raw::TestService::Service<TestServiceImpl> {
+ public:
+  static void TestUnaryRpc(ConstByteSpan, RawUnaryResponder&) {}
+
+  void TestAnotherUnaryRpc(ConstByteSpan, RawUnaryResponder&) {}
+
+  void TestServerStreamRpc(ConstByteSpan, RawServerWriter& new_writer) {
+    writer = std::move(new_writer);
+  }
+
+  void TestClientStreamRpc(RawServerReader&) {}
+
+  void TestBidirectionalStreamRpc(RawServerReaderWriter&) {}
+
+  RawServerWriter writer;
+};
+
+// Holds the last packet sent to it.
+class TestMultiBufChannelOutput : public MultiBufChannelOutput {
+ public:
+  TestMultiBufChannelOutput(Allocator& allocator)
+      : MultiBufChannelOutput("TestMultiBufChannelOutput", allocator) {}
+
+  Status SendMultiBuf(MultiBuf::Instance&& packet) override {
+    packet_ = std::move(packet);
+    packets_sent_ += 1;
+    return OkStatus();
+  }
+
+  // Decodes the last packet sent. Returns a default packet if it is not
+  // contiguous.
+  Packet last_packet() const {
+    if (!packet_.has_value()) {
+      return Packet();
+    }
+    auto chunks = (*packet_)->ConstChunks();
+    if (chunks.begin() == chunks.end() ||
+        (*chunks.begin()).size() != (*packet_)->size()) {
+      return Packet();
+    }
+    return Packet::FromBuffer(*chunks.begin()).value_or(Packet());
+  }
+
+  int packets_sent() const { return packets_sent_; }
+
+ private:
+  std::optional<MultiBuf::Instance> packet_;
+  int packets_sent_ = 0;
+};
+
+// Stores a copy of the last packet sent to it.
+class ContiguousChannelOutput : public ChannelOutput {
+ public:
+  ContiguousChannelOutput() : ChannelOutput("ContiguousChannelOutput") {}
+
+  Status Send(span<const std::byte> buffer) override {
+    std::memcpy(buffer_.data(), buffer.data(), buffer.size());
+    packet_ = Packet::FromBuffer(span(buffer_).first(buffer.size()))
+                  .value_or(Packet());
+    return OkStatus();
+  }
+
+  const Packet& last_packet() const { return packet_; }
+
+ private:
+  std::array<std::byte, 128> buffer_;
+  Packet packet_;
+};
+
+class MultiBufWrite : public ::testing::Test {
+ protected:
+  MultiBufWrite() : multibuf_output_(allocator_) {}
+
+  // Opens a server stream on a channel using the given output.
+  void OpenStream(ChannelOutput& output) {
+    ASSERT_EQ(OkStatus(), server_.OpenChannel(kChannelId, output));
+    server_.RegisterService(service_);
+
+    std::array<std::byte, 32> buffer;
+    Result<ConstByteSpan> request = Packet(PacketType::REQUEST,
+                                           kChannelId,
+                                           StreamMethod::kServiceId,
+                                           StreamMethod::kMethodId,
+                                           kCallId,
+                                           {})
+                                        .Encode(buffer);
+    ASSERT_EQ(OkStatus(), request.status());
+    ASSERT_EQ(OkStatus(), server_.ProcessPacket(*request));
+    ASSERT_TRUE(service_.writer.active());
+  }
+
+  // Creates a payload with space for the packet header in front of it.
+  MultiBuf::Instance PayloadWithReservation(size_t reservation) {
+    MultiBuf::Instance payload(allocator_);
+    auto bytes = allocator_.MakeUnique<std::byte[]>(reservation +
+                                                    kPayload.size() + 16);
+    EXPECT_NE(bytes, nullptr);
+    payload->PushBack(std::move(bytes));
+    EXPECT_TRUE(payload->AddLayer(reservation));
+    payload->TruncateTopLayer(kPayload.size());
+    payload->CopyFrom(kPayload);
+    return payload;
+  }
+
+  // Returns the address of the first byte of a payload.
+  static const std::byte* PayloadAddress(const MultiBuf::Instance& payload) {
+    return (*payload->ConstChunks().begin()).data();
+  }
+
+  static void ExpectStreamPacket(const Packet& packet) {
+    EXPECT_EQ(packet.type(), PacketType::SERVER_STREAM);
+    EXPECT_EQ(packet.channel_id(), kChannelId);
+    EXPECT_EQ(packet.service_id(), StreamMethod::kServiceId);
+    EXPECT_EQ(packet.method_id(), StreamMethod::kMethodId);
+    EXPECT_EQ(packet.call_id(), kCallId);
+    ASSERT_EQ(packet.payload().size(), kPayload.size());
+    EXPECT_EQ(0, std::memcmp(packet.payload().data(),
+                             kPayload.data(),
+                             kPayload.size()));
+  }
+
+  // The outputs must outlive the server and service, since destroying an open
+  // stream sends its final response.
+  AllocatorForTest<2048> allocator_;
+  TestMultiBufChannelOutput multibuf_output_;
+  ContiguousChannelOutput contiguous_output_;
+  std::array<Channel, 1> channels_;
+  Server server_{channels_};
+  TestServiceImpl service_;
+};
+
+TEST_F(MultiBufWrite, WithReservation_SendsPayloadWithoutCopying) {
+  OpenStream(multibuf_output_);
+
+  MultiBuf::Instance payload =
+      PayloadWithReservation(kMultiBufHeaderReservation);
+  const std::byte* payload_address = PayloadAddress(payload);
+
+  ASSERT_EQ(OkStatus(),
+            WriteMultiBuf(service_.writer.as_writer(), std::move(payload)));
+  ASSERT_EQ(multibuf_output_.packets_sent(), 1);
+
+  const Packet packet = multibuf_output_.last_packet();
+  ExpectStreamPacket(packet);
+  EXPECT_EQ(packet.payload().data(), payload_address);
+}
+
+TEST_F(MultiBufWrite, ReservationTooSmall_CopiesPayload) {
+  OpenStream(multibuf_output_);
+
+  MultiBuf::Instance payload = PayloadWithReservation(2);
+  const std::byte* payload_address = PayloadAddress(payload);
+
+  ASSERT_EQ(OkStatus(),
+            WriteMultiBuf(service_.writer.as_writer(), std::move(payload)));
+  ASSERT_EQ(multibuf_output_.packets_sent(), 1);
+
+  const Packet packet = multibuf_output_.last_packet();
+  ExpectStreamPacket(packet);
+  EXPECT_NE(packet.payload().data(), payload_address);
+}
+
+TEST_F(MultiBufWrite, NoLayers_CopiesPayload) {
+  OpenStream(multibuf_output_);
+
+  auto bytes = kPayload;
+  MultiBuf::Instance payload(allocator_);
+  payload->PushBack(bytes);
+
+  ASSERT_EQ(OkStatus(),
+            WriteMultiBuf(service_.writer.as_writer(), std::move(payload)));
+  ASSERT_EQ(multibuf_output_.packets_sent(), 1);
+  ExpectStreamPacket(multibuf_output_.last_packet());
+}
+
+TEST_F(MultiBufWrite, FragmentedPayload_CopiesPayload) {
+  OpenStream(multibuf_output_);
+
+  auto bytes = kPayload;
+  MultiBuf::Instance payload(allocator_);
+  payload->PushBack(span(bytes).first(4));
+  payload->PushBack(span(bytes).subspan(4));
+
+  ASSERT_EQ(OkStatus(),
+            WriteMultiBuf(service_.writer.as_writer(), std::move(payload)));
+  ExpectStreamPacket(multibuf_output_.last_packet());
+}
+
+TEST_F(MultiBufWrite, OtherPackets_CopiedIntoMultiBufs) {
+  OpenStream(multibuf_output_);
+
+  ASSERT_EQ(OkStatus(), service_.writer.Write(kPayload));
+  ExpectStreamPacket(multibuf_output_.last_packet());
+
+  ASSERT_EQ(OkStatus(), service_.writer.Finish(Status::NotFound()));
+  const Packet response = multibuf_output_.last_packet();
+  EXPECT_EQ(response.type(), PacketType::RESPONSE);
+  EXPECT_EQ(response.status(), Status::NotFound());
+  EXPECT_EQ(multibuf_output_.packets_sent(), 2);
+}
+
+TEST_F(MultiBufWrite, ContiguousOutput_CopiesPayload) {
+  OpenStream(contiguous_output_);
+
+  ASSERT_EQ(OkStatus(),
+            WriteMultiBuf(service_.writer.as_writer(),
+                          PayloadWithReservation(kMultiBufHeaderReservation)));
+  ExpectStreamPacket(contiguous_output_.last_packet());
+}
+
+TEST_F(MultiBufWrite, ClosedCall_FailedPrecondition) {
+  OpenStream(multibuf_output_);
+  ASSERT_EQ(OkStatus(), service_.writer.Finish());
+  const int packets_sent = multibuf_output_.packets_sent();
+
+  EXPECT_EQ(Status::FailedPrecondition(),
+            WriteMultiBuf(service_.writer.as_writer(),
+                          PayloadWithReservation(kMultiBufHeaderReservation)));
+  EXPECT_EQ(multibuf_output_.packets_sent(), packets_sent);
+}
+
+class MultiBufProcessPacket : public MultiBufWrite {
+ protected:
+  void SetUp() override { OpenChannelAndService(); }
+
+  void OpenChannelAndService() {
+    ASSERT_EQ(OkStatus(), server_.OpenChannel(kChannelId, multibuf_output_));
+    server_.RegisterService(service_);
+
+    Result<ConstByteSpan> encoded = Packet(PacketType::REQUEST,
+                                           kChannelId,
+                                           StreamMethod::kServiceId,
+                                           StreamMethod::kMethodId,
+                                           kCallId,
+                                           {})
+                                        .Encode(request_);
+    ASSERT_EQ(OkStatus(), encoded.status());
+    request_size_ = encoded->size();
+  }
+
+  ByteSpan request() { return span(request_).first(request_size_); }
+
+  std::array<std::byte, 32> request_;
+  size_t request_size_ = 0;
+};
+
+TEST_F(MultiBufProcessPacket, Contiguous_ProcessedInPlace) {
+  MultiBuf::Instance packet(allocator_);
+  packet->PushBack(request().first(5));
+  packet->PushBack(request().subspan(5));
+
+  EXPECT_EQ(OkStatus(), ProcessPacket(server_, *packet));
+  EXPECT_TRUE(service_.writer.active());
+}
+
+TEST_F(MultiBufProcessPacket, Fragmented_CopiedToScratch) {
+  std::array<std::byte, 32> other;
+  std::memcpy(other.data(), request().data(), request().size());
+
+  MultiBuf::Instance packet(allocator_);
+  packet->PushBack(request().first(5));
+  packet->PushBack(span(other).subspan(5, request().size() - 5));
+
+  std::array<std::byte, 32> scratch;
+  EXPECT_EQ(OkStatus(), ProcessPacket(server_, *packet, scratch));
+  EXPECT_TRUE(service_.writer.active());
+}
+
+TEST_F(MultiBufProcessPacket, Fragmented_ScratchTooSmall) {
+  std::array<std::byte, 32> other;
+  std::memcpy(other.data(), request().data(), request().size());
+
+  MultiBuf::Instance packet(allocator_);
+  packet->PushBack(request().first(5));
+  packet->PushBack(span(other).subspan(5, request().size() - 5));
+
+  std::array<std::byte, 8> scratch;
+  EXPECT_EQ(Status::ResourceExhausted(),
+            ProcessPacket(server_, *packet, scratch));
+  EXPECT_FALSE(service_.writer.active());
+}
+
+}  // namespace
+}  // namespace pw::rpc
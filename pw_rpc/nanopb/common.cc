@@ -109,15 +109,19 @@ Status NanopbSendStream(Call& call,
                         const void* payload,
                         const NanopbMethodSerde* serde) {
   if (!call.active_locked()) {
+    rpc_lock().unlock();
     return Status::FailedPrecondition();
   }
 
   Result<ByteSpan> result = EncodeToPayloadBuffer(
       payload,
       call.type() == kClientCall ? serde->request() : serde->response());
+  if (!result.ok()) {
+    rpc_lock().unlock();
+    return result.status();
+  }
 
-  PW_TRY(result.status());
-  return call.WriteLocked(*result);
+  return call.WriteAndUnlock(*result);
 }
 
 Status SendFinalResponse(NanopbServerCall& call,
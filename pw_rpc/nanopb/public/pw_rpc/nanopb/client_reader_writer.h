@@ -93,7 +93,7 @@ class NanopbUnaryResponseClientCall : public UnaryResponseClientCall {
   }
 
   Status SendClientStream(const void* payload) PW_LOCKS_EXCLUDED(rpc_lock()) {
-    RpcLockGuard lock;
+    rpc_lock().lock();
     return NanopbSendStream(*this, payload, serde_);
   }
 
@@ -179,7 +179,7 @@ class NanopbStreamResponseClientCall : public StreamResponseClientCall {
         serde_(&serde) {}
 
   Status SendClientStream(const void* payload) PW_LOCKS_EXCLUDED(rpc_lock()) {
-    RpcLockGuard lock;
+    rpc_lock().lock();
     return NanopbSendStream(*this, payload, serde_);
   }
 
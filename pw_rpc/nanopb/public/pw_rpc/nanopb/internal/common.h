@@ -94,12 +94,12 @@ void NanopbSendInitialRequest(ClientCall& call,
                               const void* payload)
     PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock());
 
-// [Client/Server] Encodes and sends a client or server stream message.
-// active() must be true.
+// [Client/Server] Encodes and sends a client or server stream message, then
+// releases the RPC lock. Returns FAILED_PRECONDITION if active() is false.
 Status NanopbSendStream(Call& call,
                         const void* payload,
                         const NanopbMethodSerde* serde)
-    PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock());
+    PW_UNLOCK_FUNCTION(rpc_lock());
 
 // [Server] Encodes and sends the final response message.
 // Returns Status::FailedPrecondition if active() is false.
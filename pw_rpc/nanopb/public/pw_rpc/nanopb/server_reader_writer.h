@@ -82,7 +82,7 @@ class NanopbServerCall : public ServerCall {
   }
 
   Status SendServerStream(const void* payload) PW_LOCKS_EXCLUDED(rpc_lock()) {
-    RpcLockGuard lock;
+    rpc_lock().lock();
     return NanopbSendStream(*this, payload, serde_);
   }
 
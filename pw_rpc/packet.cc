@@ -16,6 +16,9 @@
 
 #include "pw_log/log.h"
 #include "pw_protobuf/decoder.h"
+#include "pw_protobuf/wire_format.h"
+#include "pw_status/try.h"
+#include "pw_varint/varint.h"
 
 namespace pw::rpc::internal {
 
@@ -91,20 +94,7 @@ Result<ConstByteSpan> Packet::Encode(ByteSpan buffer) const {
     rpc_packet.WritePayload(payload_).IgnoreError();
   }
 
-  rpc_packet.WriteType(type_).IgnoreError();
-  rpc_packet.WriteChannelId(channel_id_).IgnoreError();
-  rpc_packet.WriteServiceId(service_id_).IgnoreError();
-  rpc_packet.WriteMethodId(method_id_).IgnoreError();
-
-  // Status code 0 is OK. In protobufs, 0 is the default int value, so skip
-  // encoding it to save two bytes in the output.
-  if (status_.code() != 0) {
-    rpc_packet.WriteStatus(status_.code()).IgnoreError();
-  }
-
-  if (call_id_ != 0) {
-    rpc_packet.WriteCallId(call_id_).IgnoreError();
-  }
+  EncodeMetadata(rpc_packet);
 
   if (rpc_packet.status().ok()) {
     return ConstByteSpan(rpc_packet);
@@ -112,6 +102,28 @@ Result<ConstByteSpan> Packet::Encode(ByteSpan buffer) const {
   return rpc_packet.status();
 }
 
+Result<ConstByteSpan> Packet::EncodeHeader(ByteSpan buffer,
+                                           size_t payload_size) const {
+  RpcPacket::MemoryEncoder rpc_packet(buffer);
+  EncodeMetadata(rpc_packet);
+  PW_TRY(rpc_packet.status());
+
+  // The payload's key and length are encoded last, so that the payload
+  // immediately follows the header.
+  const size_t metadata_size = rpc_packet.size();
+  ByteSpan remaining = buffer.subspan(metadata_size);
+  const uint32_t payload_key = protobuf::FieldKey(
+      static_cast<uint32_t>(RpcPacket::Fields::kPayload),
+      protobuf::WireType::kDelimited);
+  const size_t key_size = varint::Encode(payload_key, remaining);
+  const size_t length_size =
+      varint::Encode(payload_size, remaining.subspan(key_size));
+  if (key_size == 0u || length_size == 0u) {
+    return Status::ResourceExhausted();
+  }
+  return buffer.first(metadata_size + key_size + length_size);
+}
+
 size_t Packet::MinEncodedSizeBytes() const {
   size_t reserved_size = 0;
 
@@ -134,6 +146,23 @@ size_t Packet::MinEncodedSizeBytes() const {
   return reserved_size;
 }
 
+void Packet::EncodeMetadata(RpcPacket::MemoryEncoder& rpc_packet) const {
+  rpc_packet.WriteType(type_).IgnoreError();
+  rpc_packet.WriteChannelId(channel_id_).IgnoreError();
+  rpc_packet.WriteServiceId(service_id_).IgnoreError();
+  rpc_packet.WriteMethodId(method_id_).IgnoreError();
+
+  // Status code 0 is OK. In protobufs, 0 is the default int value, so skip
+  // encoding it to save two bytes in the output.
+  if (status_.code() != 0) {
+    rpc_packet.WriteStatus(status_.code()).IgnoreError();
+  }
+
+  if (call_id_ != 0) {
+    rpc_packet.WriteCallId(call_id_).IgnoreError();
+  }
+}
+
 void Packet::DebugLog() const {
   PW_LOG_INFO(
       "Packet {\n"
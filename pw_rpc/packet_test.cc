@@ -97,6 +97,40 @@ TEST(Packet, Encode_BufferTooSmall) {
   EXPECT_EQ(Status::ResourceExhausted(), result.status());
 }
 
+TEST(Packet, EncodeHeader_FollowedByPayload) {
+  byte buffer[64];
+
+  Packet packet(PacketType::SERVER_STREAM, 1, 42, 100, 7, {});
+
+  auto header = packet.EncodeHeader(buffer, kPayload.size());
+  ASSERT_EQ(OkStatus(), header.status());
+  ASSERT_LE(header->size(), Packet::kMinEncodedSizeWithoutPayload);
+  std::memcpy(buffer + header->size(), kPayload.data(), kPayload.size());
+
+  auto decoded =
+      Packet::FromBuffer(span(buffer, header->size() + kPayload.size()));
+  ASSERT_EQ(OkStatus(), decoded.status());
+  EXPECT_EQ(decoded->type(), PacketType::SERVER_STREAM);
+  EXPECT_EQ(decoded->channel_id(), 1u);
+  EXPECT_EQ(decoded->service_id(), 42u);
+  EXPECT_EQ(decoded->method_id(), 100u);
+  EXPECT_EQ(decoded->call_id(), 7u);
+  ASSERT_EQ(decoded->payload().size(), kPayload.size());
+  EXPECT_EQ(std::memcmp(decoded->payload().data(),
+                        kPayload.data(),
+                        kPayload.size()),
+            0);
+}
+
+TEST(Packet, EncodeHeader_BufferTooSmall) {
+  byte buffer[4];
+
+  Packet packet(PacketType::SERVER_STREAM, 1, 42, 100, 7, {});
+
+  auto result = packet.EncodeHeader(buffer, kPayload.size());
+  EXPECT_EQ(Status::ResourceExhausted(), result.status());
+}
+
 TEST(Packet, Decode_ValidPacket) {
   auto result = Packet::FromBuffer(kEncoded);
   ASSERT_TRUE(result.ok());
@@ -19,6 +19,7 @@
 
 #include "pw_assert/assert.h"
 #include "pw_bytes/span.h"
+#include "pw_function/function.h"
 #include "pw_result/result.h"
 #include "pw_rpc/internal/config.h"
 #include "pw_rpc/internal/lock.h"
@@ -102,6 +103,8 @@ constexpr size_t MaxSafePayloadSize(
              : 0;
 }
 
+class MultiBufChannelOutput;
+
 class ChannelOutput {
  public:
   // Returned from MaximumTransmissionUnit() to indicate that this ChannelOutput
@@ -127,7 +130,8 @@ class ChannelOutput {
   //
   // The RPC system’s internal lock is held while this function is called. Avoid
   // long-running operations, since these will delay any other users of the RPC
-  // system.
+  // system. If PW_RPC_SEND_LOCK_SHARDS is enabled, stream packets may instead
+  // be sent while holding only a lock that serializes sends to this output.
   //
   // !!! DANGER !!!
   //
@@ -143,6 +147,10 @@ class ChannelOutput {
   virtual Status Send(span<const std::byte> buffer)
       PW_EXCLUSIVE_LOCKS_REQUIRED(internal::rpc_lock()) = 0;
 
+  // Returns this output if it accepts packets as MultiBufs, or nullptr if it
+  // only accepts contiguous packets. See pw_rpc/multibuf.h.
+  virtual MultiBufChannelOutput* AsMultiBufChannelOutput() { return nullptr; }
+
  private:
   const char* name_;
 };
@@ -214,11 +222,24 @@ class ChannelBase {
   // indicates that the Channel is permanently closed.
   Status Send(const Packet& packet) PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock());
 
-  constexpr void Close() {
-    PW_ASSERT(id_ != kUnassignedChannelId);
-    id_ = kUnassignedChannelId;
-    output_ = nullptr;
-  }
+  // Sends a packet like Send(), then releases the RPC lock. If
+  // PW_RPC_SEND_LOCK_SHARDS is enabled, the RPC lock is released before
+  // ChannelOutput::Send is called. The packet's payload may be in the global
+  // encoding buffer, which is released.
+  Status SendAndUnlock(const Packet& packet) PW_UNLOCK_FUNCTION(rpc_lock());
+
+  // Encodes the packet's header for a payload of payload_size bytes, then calls
+  // the send function with the output and the header. The packet's payload is
+  // ignored. Returns statuses like Send().
+  Status SendWithHeader(
+      const Packet& packet,
+      size_t payload_size,
+      const Function<Status(ChannelOutput&, ConstByteSpan)>& send)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock());
+
+  // Unassigns the channel. If PW_RPC_SEND_LOCK_SHARDS is enabled, waits for
+  // sends to the channel's output that released the RPC lock to finish.
+  void Close();
 
  protected:
   constexpr ChannelBase(uint32_t id, ChannelOutput* output)
@@ -31,6 +31,10 @@ class ClientServer {
   _PW_RPC_CONSTEXPR ClientServer(span<Channel> channels)
       : client_(channels), server_(channels) {}
 
+  _PW_RPC_CONSTEXPR ClientServer(span<Channel> channels,
+                                 span<Server::MethodIndexEntry> method_index)
+      : client_(channels), server_(channels, method_index) {}
+
   // Sends a packet to either the client or the server, depending on its type.
   Status ProcessPacket(ConstByteSpan packet);
 
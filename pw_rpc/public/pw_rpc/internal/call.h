@@ -273,8 +273,8 @@ class Call : public IntrusiveList<Call>::Item, private rpc::Writer {
 
   // Sends a payload in either a server or client stream packet.
   Status Write(ConstByteSpan payload) PW_LOCKS_EXCLUDED(rpc_lock()) {
-    RpcLockGuard lock;
-    return WriteLocked(payload);
+    rpc_lock().lock();
+    return WriteAndUnlock(payload);
   }
 
   /// Provides a buffer into which to encode an RPC server or client stream
@@ -286,15 +286,31 @@ class Call : public IntrusiveList<Call>::Item, private rpc::Writer {
   ///   otherwise.
   Status Write(const Function<StatusWithSize(ByteSpan)>& callback)
       PW_LOCKS_EXCLUDED(rpc_lock()) {
-    RpcLockGuard lock;
-    return WriteCallbackLocked(callback);
+    rpc_lock().lock();
+    return WriteCallbackAndUnlock(callback);
   }
 
-  Status WriteLocked(ConstByteSpan payload)
-      PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock());
+  // Sends a payload in a stream packet and releases the RPC lock. If
+  // PW_RPC_SEND_LOCK_SHARDS is enabled, the lock is released before the packet
+  // is passed to the ChannelOutput, so the call may not be accessed after this
+  // function begins sending.
+  Status WriteAndUnlock(ConstByteSpan payload) PW_UNLOCK_FUNCTION(rpc_lock());
 
-  Status WriteCallbackLocked(const Function<StatusWithSize(ByteSpan)>& callback)
-      PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock());
+  Status WriteCallbackAndUnlock(
+      const Function<StatusWithSize(ByteSpan)>& callback)
+      PW_UNLOCK_FUNCTION(rpc_lock());
+
+  // Converts a generic writer back to the call that implements it.
+  static Call& FromWriter(Writer& writer) { return static_cast<Call&>(writer); }
+
+  // Sends a stream packet whose payload_size-byte payload is held outside of
+  // pw_rpc's buffers, such as in a MultiBuf. The send function is called with
+  // the RPC lock held. It is passed the channel's output and the packet's
+  // encoded header, and must send the header followed by the payload.
+  Status WriteWithHeader(
+      size_t payload_size,
+      const Function<Status(ChannelOutput&, ConstByteSpan)>& send)
+      PW_LOCKS_EXCLUDED(rpc_lock());
 
   // Sends the initial request for a client call. If the request fails, the call
   // is closed.
@@ -598,6 +614,10 @@ class Call : public IntrusiveList<Call>::Item, private rpc::Writer {
                     Status status = OkStatus())
       PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock());
 
+  // Sends a payload like SendPacket(), then releases the RPC lock.
+  Status SendPacketAndUnlock(pwpb::PacketType type, ConstByteSpan payload)
+      PW_UNLOCK_FUNCTION(rpc_lock());
+
   Status CloseAndSendFinalPacketLocked(pwpb::PacketType type,
                                        ConstByteSpan response,
                                        Status status)
@@ -249,6 +249,33 @@ static_assert(
 #define PW_RPC_ENCODING_BUFFER_SIZE_BYTES 512
 #endif  // PW_RPC_ENCODING_BUFFER_SIZE_BYTES
 
+/// Number of locks used to serialize packets sent to `ChannelOutput`s. If 0
+/// (the default), every packet is encoded and sent while holding the global
+/// RPC lock, so only one thread may send at a time.
+///
+/// If nonzero, each `ChannelOutput` is hashed to one of this many send shards.
+/// Each shard has a mutex and an encoding buffer. Stream writes hold the global
+/// RPC lock only while checking the call's state and encoding the packet into
+/// the shard's buffer. The RPC lock is released before
+/// `ChannelOutput::Send()` is called, so streams on outputs in different
+/// shards send concurrently. Other packets are still sent with the RPC lock
+/// held.
+///
+/// A shard's lock is always acquired while holding the RPC lock, and a thread
+/// never holds more than one shard lock, so the existing lock ordering is
+/// preserved. Packets for a call are sent in the order they were written.
+/// `ChannelOutput::Send()` is never called concurrently for the same output.
+///
+/// Requires @c_macro{PW_RPC_USE_GLOBAL_MUTEX}. Unless
+/// @c_macro{PW_RPC_DYNAMIC_ALLOCATION} is enabled, each shard statically
+/// allocates a @c_macro{PW_RPC_ENCODING_BUFFER_SIZE_BYTES} buffer.
+#ifndef PW_RPC_SEND_LOCK_SHARDS
+#define PW_RPC_SEND_LOCK_SHARDS 0
+#endif  // PW_RPC_SEND_LOCK_SHARDS
+
+static_assert(PW_RPC_SEND_LOCK_SHARDS == 0 || PW_RPC_USE_GLOBAL_MUTEX,
+              "PW_RPC_SEND_LOCK_SHARDS requires PW_RPC_USE_GLOBAL_MUTEX");
+
 /// The log level to use for this module. Logs below this level are omitted.
 #ifndef PW_RPC_CONFIG_LOG_LEVEL
 #define PW_RPC_CONFIG_LOG_LEVEL PW_LOG_LEVEL_INFO
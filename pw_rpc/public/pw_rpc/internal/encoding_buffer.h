@@ -27,6 +27,12 @@
 #include "pw_rpc/internal/packet.h"
 #include "pw_status/status_with_size.h"
 
+#if PW_RPC_SEND_LOCK_SHARDS > 0
+
+#include "pw_sync/mutex.h"  // nogncheck
+
+#endif  // PW_RPC_SEND_LOCK_SHARDS > 0
+
 #if PW_RPC_DYNAMIC_ALLOCATION
 
 #include PW_RPC_DYNAMIC_CONTAINER_INCLUDE
@@ -118,6 +124,32 @@ using EncodingBuffer = StaticEncodingBuffer;
 // allocation is enabled or not.
 inline EncodingBuffer encoding_buffer PW_GUARDED_BY(rpc_lock());
 
+#if PW_RPC_SEND_LOCK_SHARDS > 0
+
+// Serializes sends to the ChannelOutputs that hash to it. Packets are encoded
+// into the shard's buffer while holding both the RPC lock and the shard's
+// lock. The RPC lock may then be released while the output sends the packet.
+class SendShard {
+ public:
+  SendShard() = default;
+
+  sync::Mutex& mutex() PW_LOCK_RETURNED(mutex_) { return mutex_; }
+
+  EncodingBuffer& encoding_buffer() PW_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return encoding_buffer_;
+  }
+
+ private:
+  sync::Mutex mutex_;
+  EncodingBuffer encoding_buffer_ PW_GUARDED_BY(mutex_);
+};
+
+// Returns the send shard for a ChannelOutput. An output always maps to the
+// same shard.
+SendShard& GetSendShard(const ChannelOutput& output);
+
+#endif  // PW_RPC_SEND_LOCK_SHARDS > 0
+
 // Successful calls to EncodeToPayloadBuffer MUST send the returned buffer,
 // without releasing the RPC lock.
 template <typename Proto, typename Encoder>
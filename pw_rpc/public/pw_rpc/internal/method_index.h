@@ -0,0 +1,80 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+
+#include "pw_containers/intrusive_list.h"
+#include "pw_rpc/internal/method.h"
+#include "pw_span/span.h"
+
+namespace pw::rpc {
+
+class Service;
+
+namespace internal {
+
+// A flat array of (service ID, method ID) pairs, sorted for binary search. A
+// Server with a MethodIndex finds methods in O(log n) time, rather than
+// scanning every registered service and each service's method table.
+//
+// The index is rebuilt whenever services are registered or unregistered. If
+// the registered services have more methods than the index can hold, the index
+// is disabled and the Server falls back to a linear search.
+class MethodIndex {
+ public:
+  class Entry {
+   private:
+    friend class MethodIndex;
+
+    uint32_t service_id;
+    uint32_t method_id;
+    Service* service;
+    const Method* method;
+  };
+
+  constexpr MethodIndex() = default;
+
+  constexpr MethodIndex(span<Entry> entries) : entries_(entries) {}
+
+  MethodIndex(const MethodIndex&) = delete;
+  MethodIndex& operator=(const MethodIndex&) = delete;
+
+  // True if the index covers every method of every registered service.
+  bool active() const { return active_; }
+
+  // Number of methods currently in the index.
+  size_t size() const { return size_; }
+
+  // Repopulates the index from the list of registered services. If services
+  // share an ID, the first match in the list, which is the most recently
+  // registered service, wins, matching the behavior of a linear search.
+  void Rebuild(IntrusiveList<Service>& services);
+
+  // Finds a method in the index. If the service is present but the method is
+  // not, returns the service with a null method. Must only be called while
+  // the index is active().
+  std::tuple<Service*, const Method*> Find(uint32_t service_id,
+                                           uint32_t method_id) const;
+
+ private:
+  span<Entry> entries_;
+  size_t size_ = 0;
+  bool active_ = false;
+};
+
+}  // namespace internal
+}  // namespace pw::rpc
@@ -110,6 +110,14 @@ class Packet {
   // Encodes the packet into its wire format. Returns the encoded size.
   Result<ConstByteSpan> Encode(ByteSpan buffer) const;
 
+  // Encodes every field of the packet except the payload's contents, ending
+  // with the payload field's key and length. The payload_size bytes of the
+  // payload may then follow the header on the wire without being copied. The
+  // packet's own payload is ignored. Requires at most
+  // kMinEncodedSizeWithoutPayload bytes.
+  Result<ConstByteSpan> EncodeHeader(ByteSpan buffer,
+                                     size_t payload_size) const;
+
   // Determines the space required to encode the packet proto fields for a
   // response, excluding the payload. This may be used to split the buffer into
   // reserved space and available space for the payload.
@@ -148,6 +156,8 @@ class Packet {
   void DebugLog() const;
 
  private:
+  void EncodeMetadata(pwpb::RpcPacket::MemoryEncoder& encoder) const;
+
   pwpb::PacketType type_;
   uint32_t channel_id_;
   uint32_t service_id_;
@@ -0,0 +1,137 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+
+#include "pw_allocator/allocator.h"
+#include "pw_bytes/span.h"
+#include "pw_multibuf/multibuf_v2.h"
+#include "pw_result/result.h"
+#include "pw_rpc/channel.h"
+#include "pw_rpc/internal/packet.h"
+#include "pw_rpc/writer.h"
+#include "pw_status/status.h"
+
+namespace pw::rpc {
+namespace internal {
+
+class MultiBufWriter;  // Forward declaration for friend statement
+
+}  // namespace internal
+
+/// Number of bytes to reserve in front of a MultiBuf payload so that
+/// `WriteMultiBuf` can add the RPC packet header without copying the payload.
+inline constexpr size_t kMultiBufHeaderReservation =
+    internal::Packet::kMinEncodedSizeWithoutPayload;
+
+/// A `ChannelOutput` that sends packets as MultiBufs.
+///
+/// Stream payloads written with `WriteMultiBuf` are passed to `SendMultiBuf`
+/// without being copied. All other packets are copied from pw_rpc's encoding
+/// buffer into memory from the output's allocator.
+class MultiBufChannelOutput : public ChannelOutput {
+ public:
+  /// @param name       Name of the output, used for logging only.
+  /// @param allocator  Allocates MultiBuf metadata, and memory for packets that
+  ///                   are copied.
+  constexpr MultiBufChannelOutput(const char* name, Allocator& allocator)
+      : ChannelOutput(name), allocator_(allocator) {}
+
+  constexpr Allocator& allocator() const { return allocator_; }
+
+  /// Sends an encoded RPC packet, taking ownership of its memory. The packet's
+  /// memory may be held after this function returns.
+  ///
+  /// Like `ChannelOutput::Send`, this is called with pw_rpc's lock held, and
+  /// must not call into any RPC endpoint or call object.
+  virtual Status SendMultiBuf(MultiBuf::Instance&& packet) = 0;
+
+ private:
+  friend class internal::MultiBufWriter;
+
+  Status Send(span<const std::byte> buffer) final;
+
+  MultiBufChannelOutput* AsMultiBufChannelOutput() final { return this; }
+
+  // Copies the header and the payload, if any, into a single allocation and
+  // sends it.
+  Status SendCopy(ConstByteSpan header, const MultiBuf* payload);
+
+  Allocator& allocator_;
+};
+
+/// Writes a MultiBuf as the payload of a stream packet.
+///
+/// If the call's channel output is a `MultiBufChannelOutput` and the payload
+/// has room for the packet header in front of it, the header is encoded into
+/// that space and the payload is sent without being copied. To reserve the
+/// space, add `kMultiBufHeaderReservation` bytes before the payload and add a
+/// layer for the payload:
+///
+/// @code{.cpp}
+///   MultiBuf::Instance payload(allocator);
+///   payload->PushBack(allocator.MakeUnique<std::byte[]>(
+///       kMultiBufHeaderReservation + kMaxPayloadSize));
+///   PW_CHECK(payload->AddLayer(kMultiBufHeaderReservation));
+///   // Write to the payload, then truncate it with TruncateTopLayer().
+///   PW_TRY(pw::rpc::WriteMultiBuf(writer.as_writer(), std::move(payload)));
+/// @endcode
+///
+/// Otherwise, the payload is copied, as with `Writer::Write`.
+///
+/// @returns @rst
+///
+/// .. pw-status-codes::
+///
+///    OK: The packet was sent.
+///
+///    FAILED_PRECONDITION: The call is not active.
+///
+///    UNAVAILABLE: The call's channel is closed.
+///
+///    UNKNOWN: The payload needed to be copied but did not fit in the
+///       available memory, or the channel output failed to send the packet.
+///
+/// @endrst
+Status WriteMultiBuf(Writer& writer, MultiBuf::Instance&& payload);
+
+namespace internal {
+
+// Finds a contiguous view of a packet, copying it into the scratch buffer only
+// if it is split across multiple chunks.
+Result<ConstByteSpan> ContiguousPacket(const FlatConstMultiBuf& packet,
+                                       ByteSpan scratch);
+
+}  // namespace internal
+
+/// Processes a packet received as a MultiBuf with a `Server`, `Client`, or
+/// `ClientServer`.
+///
+/// If the packet is contiguous, it is processed in place. Otherwise, it is
+/// copied into `scratch` first; `RESOURCE_EXHAUSTED` is returned if it does not
+/// fit. Returns the endpoint's `ProcessPacket` status otherwise.
+template <typename Endpoint>
+Status ProcessPacket(Endpoint& endpoint,
+                     const FlatConstMultiBuf& packet,
+                     ByteSpan scratch = {}) {
+  Result<ConstByteSpan> contiguous =
+      internal::ContiguousPacket(packet, scratch);
+  if (!contiguous.ok()) {
+    return contiguous.status();
+  }
+  return endpoint.ProcessPacket(*contiguous);
+}
+
+}  // namespace pw::rpc
@@ -13,6 +13,7 @@
 // the License.
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <limits>
 
@@ -24,6 +25,11 @@
 #include "pw_span/span.h"
 
 namespace pw::rpc {
+namespace internal {
+
+class MethodIndex;
+
+}  // namespace internal
 
 // Base class for all RPC services. This cannot be instantiated directly; use a
 // generated subclass instead.
@@ -70,10 +76,19 @@ class Service : public IntrusiveList<Service>::Item {
  private:
   friend class Server;
   friend class ServiceTestHelper;
+  friend class internal::MethodIndex;
 
   // Finds the method with the provided method_id. Returns nullptr if no match.
   const internal::Method* FindMethod(uint32_t method_id) const;
 
+  // Returns the method at the provided index in the methods table.
+  const internal::Method& method(size_t index) const {
+    const auto raw = reinterpret_cast<const std::byte*>(methods_);
+    return reinterpret_cast<const internal::MethodUnion*>(
+               raw + index * method_size_)
+        ->method();
+  }
+
   const uint32_t id_;
   const internal::MethodUnion* const methods_;
   const uint16_t method_size_;
@@ -146,7 +146,7 @@ class PwpbUnaryResponseClientCall : public UnaryResponseClientCall {
   template <typename Request>
   Status SendStreamRequest(const Request& request)
       PW_LOCKS_EXCLUDED(rpc_lock()) {
-    RpcLockGuard lock;
+    rpc_lock().lock();
     return PwpbSendStream(*this, request, serde_);
   }
 
@@ -307,7 +307,7 @@ class PwpbStreamResponseClientCall : public StreamResponseClientCall {
   template <typename Request>
   Status SendStreamRequest(const Request& request)
       PW_LOCKS_EXCLUDED(rpc_lock()) {
-    RpcLockGuard lock;
+    rpc_lock().lock();
     return PwpbSendStream(*this, request, serde_);
   }
 
@@ -52,23 +52,27 @@ void PwpbSendInitialRequest(ClientCall& call,
   }
 }
 
-// [Client/Server] Encodes and sends a client or server stream message.
-// Returns FAILED_PRECONDITION if active() is false.
+// [Client/Server] Encodes and sends a client or server stream message, then
+// releases the RPC lock. Returns FAILED_PRECONDITION if active() is false.
 template <typename Payload>
 Status PwpbSendStream(Call& call,
                       const Payload& payload,
                       const PwpbMethodSerde* serde)
-    PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
+    PW_UNLOCK_FUNCTION(rpc_lock()) {
   if (!call.active_locked()) {
+    rpc_lock().unlock();
     return Status::FailedPrecondition();
   }
 
   Result<ByteSpan> buffer = EncodeToPayloadBuffer(
       payload,
       call.type() == kClientCall ? serde->request() : serde->response());
-  PW_TRY(buffer);
+  if (!buffer.ok()) {
+    rpc_lock().unlock();
+    return buffer.status();
+  }
 
-  return call.WriteLocked(*buffer);
+  return call.WriteAndUnlock(*buffer);
 }
 
 }  // namespace pw::rpc::internal
@@ -137,7 +137,7 @@ class PwpbServerCall : public ServerCall {
   template <typename Response>
   Status SendStreamResponse(const Response& response)
       PW_LOCKS_EXCLUDED(rpc_lock()) {
-    RpcLockGuard lock;
+    rpc_lock().lock();
     return PwpbSendStream(*this, response, serde_);
   }
 
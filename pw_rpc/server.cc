@@ -127,6 +127,10 @@ std::tuple<Service*, const internal::Method*> Server::FindMethod(
 
 std::tuple<Service*, const internal::Method*> Server::FindMethodLocked(
     uint32_t service_id, uint32_t method_id) {
+  if (method_index_.active()) {
+    return method_index_.Find(service_id, method_id);
+  }
+
   auto service = std::find_if(services_.begin(), services_.end(), [&](auto& s) {
     return internal::UnwrapServiceId(s.service_id()) == service_id;
   });
@@ -0,0 +1,153 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "pw_assert/assert.h"
+#include "pw_perf_test/perf_test.h"
+#include "pw_rpc/channel.h"
+#include "pw_rpc/internal/packet.h"
+#include "pw_rpc/server.h"
+#include "pw_rpc/service.h"
+#include "pw_rpc_private/test_method.h"
+#include "pw_span/span.h"
+
+namespace pw::rpc {
+
+class ServerTestHelper {
+ public:
+  static std::tuple<Service*, const internal::Method*> FindMethod(
+      Server& server, uint32_t service_id, uint32_t method_id) {
+    return server.FindMethod(service_id, method_id);
+  }
+};
+
+namespace {
+
+using internal::Packet;
+using internal::TestMethod;
+using internal::TestMethodUnion;
+using internal::pwpb::PacketType;
+
+constexpr size_t kMaxServices = 64;
+constexpr size_t kMethodsPerService = 4;
+
+class BenchmarkService : public Service {
+ public:
+  BenchmarkService(uint32_t id)
+      : Service(id, methods_),
+        methods_{TestMethod(1), TestMethod(2), TestMethod(3), TestMethod(4)} {}
+
+ private:
+  std::array<TestMethodUnion, kMethodsPerService> methods_;
+};
+
+// Service IDs are hashes in practice, so spread them across the ID space.
+constexpr uint32_t ServiceId(size_t index) {
+  return static_cast<uint32_t>(index + 1) * 0x9E3779B9u;
+}
+
+class DiscardingChannelOutput : public ChannelOutput {
+ public:
+  constexpr DiscardingChannelOutput() : ChannelOutput("discard") {}
+
+  Status Send(span<const std::byte>) override { return OkStatus(); }
+};
+
+std::array<std::optional<BenchmarkService>, kMaxServices> services;
+
+// Registers services one at a time, as is typical of an application. The
+// first service registered is the last found by a linear search.
+void RegisterServices(Server& server, size_t service_count) {
+  for (size_t i = 0; i < service_count; ++i) {
+    if (!services[i].has_value()) {
+      services[i].emplace(ServiceId(i));
+    }
+    server.RegisterService(*services[i]);
+  }
+}
+
+void UnregisterServices(Server& server, size_t service_count) {
+  for (size_t i = 0; i < service_count; ++i) {
+    server.UnregisterService(*services[i]);
+  }
+}
+
+std::array<Server::MethodIndexEntry, kMaxServices * kMethodsPerService>
+    method_index;
+
+void FindMethodTest(perf_test::State& state,
+                    size_t service_count,
+                    bool indexed) {
+  Server server = indexed ? Server({}, method_index) : Server({});
+  RegisterServices(server, service_count);
+
+  while (state.KeepRunning()) {
+    const auto [service, method] =
+        ServerTestHelper::FindMethod(server, ServiceId(0), kMethodsPerService);
+    PW_ASSERT(method != nullptr);
+  }
+
+  UnregisterServices(server, service_count);
+}
+
+void ProcessPacketTest(perf_test::State& state,
+                       size_t service_count,
+                       bool indexed) {
+  DiscardingChannelOutput output;
+  std::array<Channel, 1> channels{Channel::Create<1>(&output)};
+  Server server = indexed ? Server(channels, method_index) : Server(channels);
+  RegisterServices(server, service_count);
+
+  std::array<std::byte, 64> buffer;
+  const auto packet = Packet(PacketType::REQUEST,
+                             1,
+                             ServiceId(0),
+                             kMethodsPerService,
+                             1,
+                             {},
+                             OkStatus())
+                          .Encode(buffer);
+  PW_ASSERT(packet.ok());
+
+  while (state.KeepRunning()) {
+    PW_ASSERT(server.ProcessPacket(*packet).ok());
+  }
+
+  UnregisterServices(server, service_count);
+}
+
+PW_PERF_TEST(FindMethod_Linear_1Service, FindMethodTest, 1, false);
+PW_PERF_TEST(FindMethod_Indexed_1Service, FindMethodTest, 1, true);
+
+PW_PERF_TEST(FindMethod_Linear_8Services, FindMethodTest, 8, false);
+PW_PERF_TEST(FindMethod_Indexed_8Services, FindMethodTest, 8, true);
+
+PW_PERF_TEST(FindMethod_Linear_32Services, FindMethodTest, 32, false);
+PW_PERF_TEST(FindMethod_Indexed_32Services, FindMethodTest, 32, true);
+
+PW_PERF_TEST(FindMethod_Linear_64Services, FindMethodTest, 64, false);
+PW_PERF_TEST(FindMethod_Indexed_64Services, FindMethodTest, 64, true);
+
+PW_PERF_TEST(ProcessPacket_Linear_1Service, ProcessPacketTest, 1, false);
+PW_PERF_TEST(ProcessPacket_Indexed_1Service, ProcessPacketTest, 1, true);
+
+PW_PERF_TEST(ProcessPacket_Linear_64Services, ProcessPacketTest, 64, false);
+PW_PERF_TEST(ProcessPacket_Indexed_64Services, ProcessPacketTest, 64, true);
+
+}  // namespace
+}  // namespace pw::rpc
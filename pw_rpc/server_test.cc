@@ -35,6 +35,11 @@ class ServerTestHelper {
       Server& server, uint32_t service_id, uint32_t method_id) {
     return server.FindMethod(service_id, method_id);
   }
+
+  static bool MethodIndexActive(Server& server) {
+    internal::RpcLockGuard lock;
+    return server.method_index_.active();
+  }
 };
 
 namespace {
@@ -457,6 +462,133 @@ TEST_F(BasicServer, FindMethod_NotFound) {
   }
 }
 
+class IndexedServer : public ::testing::Test {
+ protected:
+  IndexedServer()
+      : channels_{Channel::Create<1>(&output_)},
+        server_(channels_, method_index_),
+        service_1_(1),
+        service_42_(42) {
+    server_.RegisterService(service_1_, service_42_, empty_service_);
+  }
+
+  RawFakeChannelOutput<2> output_;
+  std::array<Channel, 1> channels_;
+  std::array<Server::MethodIndexEntry, 8> method_index_;
+  Server server_;
+  TestService service_1_;
+  TestService service_42_;
+  EmptyService empty_service_;
+};
+
+TEST_F(IndexedServer, FindMethod_Found) {
+  ASSERT_TRUE(ServerTestHelper::MethodIndexActive(server_));
+
+  for (TestService* test_service : {&service_1_, &service_42_}) {
+    for (uint32_t method_id : {100u, 200u}) {
+      const auto [service, method] = ServerTestHelper::FindMethod(
+          server_, internal::UnwrapServiceId(test_service->service_id()),
+          method_id);
+      EXPECT_EQ(service, test_service);
+      EXPECT_EQ(method, &test_service->method(method_id));
+    }
+  }
+}
+
+TEST_F(IndexedServer, FindMethod_UnknownService) {
+  for (uint32_t service_id : {0u, 2u, 41u, 43u, 199u, 201u, 0xffffffffu}) {
+    const auto [service, method] =
+        ServerTestHelper::FindMethod(server_, service_id, 100);
+    EXPECT_EQ(service, nullptr);
+    EXPECT_EQ(method, nullptr);
+  }
+}
+
+TEST_F(IndexedServer, FindMethod_UnknownMethod) {
+  for (uint32_t method_id : {0u, 99u, 101u, 199u, 201u, 0xffffffffu}) {
+    const auto [service, method] =
+        ServerTestHelper::FindMethod(server_, 42, method_id);
+    EXPECT_EQ(service, &service_42_);
+    EXPECT_EQ(method, nullptr);
+  }
+}
+
+TEST_F(IndexedServer, FindMethod_ServiceWithoutMethods) {
+  for (uint32_t method_id : {0u, 100u, 0xffffffffu}) {
+    const auto [service, method] =
+        ServerTestHelper::FindMethod(server_, 200, method_id);
+    EXPECT_EQ(service, &empty_service_);
+    EXPECT_EQ(method, nullptr);
+  }
+}
+
+TEST_F(IndexedServer, FindMethod_DuplicateServiceId_FindsLastRegistered) {
+  TestService duplicate(42);
+  server_.RegisterService(duplicate);
+
+  const auto [service, method] =
+      ServerTestHelper::FindMethod(server_, 42, 200);
+  EXPECT_EQ(service, &duplicate);
+  EXPECT_EQ(method, &duplicate.method(200));
+
+  server_.UnregisterService(duplicate);
+}
+
+TEST_F(IndexedServer, UnregisterService_RemovesMethods) {
+  server_.UnregisterService(service_42_);
+  ASSERT_TRUE(ServerTestHelper::MethodIndexActive(server_));
+
+  {
+    const auto [service, method] =
+        ServerTestHelper::FindMethod(server_, 42, 100);
+    EXPECT_EQ(service, nullptr);
+    EXPECT_EQ(method, nullptr);
+  }
+
+  {
+    const auto [service, method] =
+        ServerTestHelper::FindMethod(server_, 1, 100);
+    EXPECT_EQ(service, &service_1_);
+    EXPECT_EQ(method, &service_1_.method(100));
+  }
+}
+
+TEST_F(IndexedServer, ProcessPacket_InvokesMethod) {
+  std::byte buffer[64];
+  const auto packet =
+      Packet(PacketType::REQUEST, 1, 42, 200, kDefaultCallId, {}, OkStatus())
+          .Encode(buffer);
+  ASSERT_EQ(OkStatus(), packet.status());
+
+  EXPECT_EQ(OkStatus(), server_.ProcessPacket(*packet));
+  EXPECT_EQ(1u, service_42_.method(200).last_channel_id());
+  EXPECT_EQ(0u, service_1_.method(200).last_channel_id());
+}
+
+TEST_F(IndexedServer, IndexFull_FallsBackToLinearSearch) {
+  TestService service_2(2), service_3(3), service_4(4);
+  server_.RegisterService(service_2, service_3, service_4);
+  EXPECT_FALSE(ServerTestHelper::MethodIndexActive(server_));
+
+  {
+    const auto [service, method] =
+        ServerTestHelper::FindMethod(server_, 3, 200);
+    EXPECT_EQ(service, &service_3);
+    EXPECT_EQ(method, &service_3.method(200));
+  }
+
+  {
+    const auto [service, method] =
+        ServerTestHelper::FindMethod(server_, 42, 300);
+    EXPECT_EQ(service, &service_42_);
+    EXPECT_EQ(method, nullptr);
+  }
+
+  // Once the methods fit again, the index is used.
+  server_.UnregisterService(service_2, service_3, service_4);
+  EXPECT_TRUE(ServerTestHelper::MethodIndexActive(server_));
+}
+
 class BidiMethod : public BasicServer {
  protected:
   BidiMethod() {
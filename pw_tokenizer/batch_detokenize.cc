@@ -0,0 +1,231 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_tokenizer/batch_detokenize.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace pw::tokenizer {
+namespace {
+
+size_t DefaultThreadCount() {
+  return std::max<size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+}  // namespace
+
+BatchDetokenizer::BatchDetokenizer(const Detokenizer& detokenizer,
+                                   size_t thread_count)
+    : detokenizer_(detokenizer),
+      thread_count_(thread_count == 0 ? DefaultThreadCount() : thread_count) {
+  workers_.reserve(thread_count_ - 1);
+  for (size_t i = 1; i < thread_count_; ++i) {
+    workers_.emplace_back([this, i] { WorkerLoop(i); });
+  }
+}
+
+BatchDetokenizer::~BatchDetokenizer() {
+  {
+    std::lock_guard lock(mutex_);
+    stopping_ = true;
+  }
+  start_.notify_all();
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+}
+
+void BatchDetokenizer::WorkerLoop(size_t thread) {
+  uint64_t generation = 0;
+  std::unique_lock lock(mutex_);
+  while (true) {
+    start_.wait(lock, [&] { return stopping_ || generation_ != generation; });
+    if (stopping_) {
+      return;
+    }
+    generation = generation_;
+    if (thread >= work_threads_) {
+      continue;  // This operation does not need this worker.
+    }
+
+    lock.unlock();
+    work_(work_function_, thread);
+    lock.lock();
+
+    running_ -= 1;
+    if (running_ == 0) {
+      done_.notify_one();
+    }
+  }
+}
+
+void BatchDetokenizer::Run(size_t threads,
+                           void (*work)(const void* function, size_t thread),
+                           const void* function) {
+  if (threads > 1) {
+    {
+      std::lock_guard lock(mutex_);
+      work_ = work;
+      work_function_ = function;
+      work_threads_ = threads;
+      running_ = threads - 1;
+      generation_ += 1;
+    }
+    start_.notify_all();
+  }
+
+  work(function, 0);
+
+  if (threads > 1) {
+    std::unique_lock lock(mutex_);
+    done_.wait(lock, [this] { return running_ == 0; });
+  }
+}
+
+size_t BatchDetokenizer::ThreadsFor(size_t work,
+                                    size_t min_work_per_thread) const {
+  return std::clamp<size_t>(work / min_work_per_thread, 1, thread_count_);
+}
+
+template <typename DetokenizeOne>
+BatchDetokenizeStats BatchDetokenizer::DetokenizeMessages(
+    size_t count, DetokenizeOne&& detokenize_one) {
+  BatchDetokenizeStats stats;
+  stats.messages = count;
+  stats.threads = ThreadsFor(count, kMinMessagesPerThread);
+
+  // Threads claim groups of messages rather than fixed ranges so that a thread
+  // that gets slow messages does not hold up the others.
+  std::atomic<size_t> next_message = 0;
+  std::vector<size_t> output_bytes(stats.threads);
+
+  const auto start = std::chrono::steady_clock::now();
+  RunOnThreads(stats.threads, [&](size_t thread) {
+    size_t bytes = 0;
+    while (true) {
+      const size_t first =
+          next_message.fetch_add(kMessagesPerClaim, std::memory_order_relaxed);
+      if (first >= count) {
+        break;
+      }
+      const size_t last = std::min(first + kMessagesPerClaim, count);
+      for (size_t i = first; i < last; ++i) {
+        bytes += detokenize_one(i);
+      }
+    }
+    output_bytes[thread] = bytes;
+  });
+  stats.elapsed = std::chrono::steady_clock::now() - start;
+
+  for (size_t bytes : output_bytes) {
+    stats.output_bytes += bytes;
+  }
+  return stats;
+}
+
+BatchDetokenizeStats BatchDetokenizer::Detokenize(
+    span<const span<const std::byte>> messages,
+    std::vector<std::string>& results) {
+  results.resize(messages.size());
+
+  BatchDetokenizeStats stats =
+      DetokenizeMessages(messages.size(), [&](size_t i) {
+        results[i].assign(detokenizer_.Detokenize(messages[i]).BestString());
+        return results[i].size();
+      });
+
+  for (const span<const std::byte>& message : messages) {
+    stats.input_bytes += message.size();
+  }
+  return stats;
+}
+
+BatchDetokenizeStats BatchDetokenizer::DetokenizeText(
+    span<const std::string_view> messages, std::vector<std::string>& results) {
+  results.resize(messages.size());
+
+  BatchDetokenizeStats stats =
+      DetokenizeMessages(messages.size(), [&](size_t i) {
+        results[i] = detokenizer_.DetokenizeText(messages[i]);
+        return results[i].size();
+      });
+
+  for (std::string_view message : messages) {
+    stats.input_bytes += message.size();
+  }
+  return stats;
+}
+
+BatchDetokenizeStats BatchDetokenizer::DetokenizeLines(std::string_view text,
+                                                       std::string& output) {
+  BatchDetokenizeStats stats;
+  stats.input_bytes = text.size();
+  stats.threads = ThreadsFor(text.size(), kMinBytesPerThread);
+
+  // Give each thread a contiguous range of lines of about the same size, so
+  // that each thread's output can be appended in order.
+  std::vector<size_t> boundaries(stats.threads + 1, text.size());
+  boundaries[0] = 0;
+  for (size_t i = 1; i < stats.threads; ++i) {
+    const size_t target = std::max(text.size() / stats.threads * i,
+                                   boundaries[i - 1]);
+    const size_t newline = text.find('\n', target);
+    boundaries[i] =
+        newline == std::string_view::npos ? text.size() : newline + 1;
+  }
+
+  if (line_buffers_.size() < stats.threads) {
+    line_buffers_.resize(stats.threads);
+  }
+  std::vector<size_t> lines(stats.threads);
+
+  const auto start = std::chrono::steady_clock::now();
+  RunOnThreads(stats.threads, [&](size_t thread) {
+    std::string& buffer = line_buffers_[thread];
+    buffer.clear();
+
+    std::string_view remaining = text.substr(
+        boundaries[thread], boundaries[thread + 1] - boundaries[thread]);
+    while (!remaining.empty()) {
+      const size_t newline = remaining.find('\n');
+      const size_t end =
+          newline == std::string_view::npos ? remaining.size() : newline;
+
+      buffer += detokenizer_.DetokenizeText(remaining.substr(0, end));
+      if (end < remaining.size()) {
+        buffer += '\n';
+        remaining.remove_prefix(end + 1);
+      } else {
+        remaining = {};
+      }
+      lines[thread] += 1;
+    }
+  });
+
+  size_t output_bytes = 0;
+  for (size_t i = 0; i < stats.threads; ++i) {
+    output_bytes += line_buffers_[i].size();
+  }
+  output.reserve(output.size() + output_bytes);
+  for (size_t i = 0; i < stats.threads; ++i) {
+    output += line_buffers_[i];
+    stats.messages += lines[i];
+  }
+  stats.elapsed = std::chrono::steady_clock::now() - start;
+  stats.output_bytes = output_bytes;
+  return stats;
+}
+
+}  // namespace pw::tokenizer
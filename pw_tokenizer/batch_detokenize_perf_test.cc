@@ -0,0 +1,101 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// Measures how batch detokenization scales with the number of threads. Compare
+// the per-iteration time of each thread count against the one-thread case.
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "pw_assert/check.h"
+#include "pw_perf_test/perf_test.h"
+#include "pw_tokenizer/batch_detokenize.h"
+#include "pw_tokenizer/flat_token_database.h"
+
+namespace pw::tokenizer {
+namespace {
+
+constexpr char kDatabaseData[] =
+    "TOKENS\0\0"
+    "\x03\x00\x00\x00"
+    "\0\0\0\0"
+    "\x0E\x0F\x00\x01----"
+    "\xAA\xAA\xAA\xAA----"
+    "\xBB\xBB\xBB\xBB----"
+    "Now there are %d of %s!\0"
+    "%c!\0"
+    "%hhu!";
+constexpr TokenDatabase kDatabase = TokenDatabase::Create<kDatabaseData>();
+
+constexpr std::array<std::string_view, 4> kTextMessages = {
+    "$qqqqqvwB",
+    "Plain text, no tokens",
+    "What the $qqqqqvwB, $Dg8AAQQEdGhlbQ==",
+    "$Dg8AAYABBHRoZW0=",
+};
+
+constexpr size_t kMessageCount = 4096;
+
+// Detokenizes a batch of messages per iteration with up to thread_count
+// threads. The BatchDetokenizer is created outside the loop, so its workers are
+// started once, as they would be in a long-running host tool.
+void DetokenizeTextBatch(perf_test::State& state, size_t thread_count) {
+  const Detokenizer detokenizer(kDatabase);
+  BatchDetokenizer batch(detokenizer, thread_count);
+
+  std::vector<std::string_view> messages(kMessageCount);
+  for (size_t i = 0; i < messages.size(); ++i) {
+    messages[i] = kTextMessages[i % kTextMessages.size()];
+  }
+  std::vector<std::string> results;
+
+  while (state.KeepRunning()) {
+    batch.DetokenizeText(messages, results);
+  }
+
+  PW_CHECK(results[2] == "What the ~!, Now there are 2 of them!");
+}
+
+void DetokenizeLinesBatch(perf_test::State& state, size_t thread_count) {
+  const Detokenizer detokenizer(kDatabase);
+  BatchDetokenizer batch(detokenizer, thread_count);
+
+  std::string text;
+  for (size_t i = 0; i < kMessageCount; ++i) {
+    text.append(kTextMessages[i % kTextMessages.size()]).push_back('\n');
+  }
+  std::string output;
+
+  while (state.KeepRunning()) {
+    output.clear();
+    batch.DetokenizeLines(text, output);
+  }
+
+  PW_CHECK(output.substr(0, 3) == "~!\n");
+}
+
+PW_PERF_TEST(DetokenizeText_1Thread, DetokenizeTextBatch, 1);
+PW_PERF_TEST(DetokenizeText_2Threads, DetokenizeTextBatch, 2);
+PW_PERF_TEST(DetokenizeText_4Threads, DetokenizeTextBatch, 4);
+PW_PERF_TEST(DetokenizeText_8Threads, DetokenizeTextBatch, 8);
+
+PW_PERF_TEST(DetokenizeLines_1Thread, DetokenizeLinesBatch, 1);
+PW_PERF_TEST(DetokenizeLines_2Threads, DetokenizeLinesBatch, 2);
+PW_PERF_TEST(DetokenizeLines_4Threads, DetokenizeLinesBatch, 4);
+PW_PERF_TEST(DetokenizeLines_8Threads, DetokenizeLinesBatch, 8);
+
+}  // namespace
+}  // namespace pw::tokenizer
@@ -0,0 +1,231 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_tokenizer/batch_detokenize.h"
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "pw_bytes/array.h"
+#include "pw_tokenizer/flat_token_database.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::tokenizer {
+namespace {
+
+constexpr char kDatabaseData[] =
+    "TOKENS\0\0"
+    "\x03\x00\x00\x00"
+    "\0\0\0\0"
+    "\x0E\x0F\x00\x01----"
+    "\xAA\xAA\xAA\xAA----"
+    "\xBB\xBB\xBB\xBB----"
+    "Now there are %d of %s!\0"
+    "%c!\0"
+    "%hhu!";
+constexpr TokenDatabase kDatabase = TokenDatabase::Create<kDatabaseData>();
+
+constexpr std::array<std::string_view, 4> kTextMessages = {
+    "$qqqqqvwB",
+    "Plain text, no tokens",
+    "What the $qqqqqvwB, $Dg8AAQQEdGhlbQ==",
+    "$Dg8AAYABBHRoZW0=",
+};
+constexpr std::array<std::string_view, 4> kDetokenizedText = {
+    "~!",
+    "Plain text, no tokens",
+    "What the ~!, Now there are 2 of them!",
+    "Now there are 64 of them!",
+};
+
+// Enough messages that every thread gets some work.
+constexpr size_t kMessageCount = 1000;
+
+class BatchDetokenizerTest : public ::testing::Test {
+ protected:
+  BatchDetokenizerTest() : detokenizer_(kDatabase) {}
+
+  static std::vector<std::string_view> TextMessages() {
+    std::vector<std::string_view> messages;
+    for (size_t i = 0; i < kMessageCount; ++i) {
+      messages.push_back(kTextMessages[i % kTextMessages.size()]);
+    }
+    return messages;
+  }
+
+  static std::string TextLines() {
+    std::string text;
+    for (size_t i = 0; i < kMessageCount; ++i) {
+      text += kTextMessages[i % kTextMessages.size()];
+      text += '\n';
+    }
+    return text;
+  }
+
+  static std::string DetokenizedLines() {
+    std::string text;
+    for (size_t i = 0; i < kMessageCount; ++i) {
+      text += kDetokenizedText[i % kDetokenizedText.size()];
+      text += '\n';
+    }
+    return text;
+  }
+
+  Detokenizer detokenizer_;
+};
+
+TEST_F(BatchDetokenizerTest, DefaultThreadCount_AtLeastOne) {
+  BatchDetokenizer batch(detokenizer_);
+  EXPECT_GE(batch.thread_count(), 1u);
+}
+
+TEST_F(BatchDetokenizerTest, Detokenize_PreservesOrder) {
+  constexpr auto kOneArg = bytes::String("\xAA\xAA\xAA\xAA\xfc\x01");
+  constexpr auto kTwoArgs = bytes::String("\x0E\x0F\x00\x01\x04\x04them");
+  constexpr auto kUnknown = bytes::Array<1, 2, 3, 4>();
+
+  std::vector<span<const std::byte>> messages;
+  for (size_t i = 0; i < kMessageCount; ++i) {
+    switch (i % 3) {
+      case 0:
+        messages.push_back(kOneArg);
+        break;
+      case 1:
+        messages.push_back(kTwoArgs);
+        break;
+      default:
+        messages.push_back(kUnknown);
+        break;
+    }
+  }
+
+  BatchDetokenizer batch(detokenizer_, 4);
+  std::vector<std::string> results;
+  const BatchDetokenizeStats stats = batch.Detokenize(messages, results);
+
+  ASSERT_EQ(results.size(), kMessageCount);
+  for (size_t i = 0; i < kMessageCount; ++i) {
+    EXPECT_EQ(results[i], detokenizer_.Detokenize(messages[i]).BestString());
+  }
+  EXPECT_EQ(stats.messages, kMessageCount);
+  EXPECT_EQ(stats.threads, 4u);
+  EXPECT_EQ(stats.input_bytes,
+            (kOneArg.size() + kTwoArgs.size() + kUnknown.size()) *
+                    (kMessageCount / 3) +
+                kOneArg.size());
+}
+
+TEST_F(BatchDetokenizerTest, DetokenizeText_PreservesOrder) {
+  const std::vector<std::string_view> messages = TextMessages();
+
+  BatchDetokenizer batch(detokenizer_, 4);
+  std::vector<std::string> results;
+  const BatchDetokenizeStats stats = batch.DetokenizeText(messages, results);
+
+  ASSERT_EQ(results.size(), kMessageCount);
+  size_t output_bytes = 0;
+  for (size_t i = 0; i < kMessageCount; ++i) {
+    EXPECT_EQ(results[i], kDetokenizedText[i % kDetokenizedText.size()]);
+    output_bytes += results[i].size();
+  }
+  EXPECT_EQ(stats.messages, kMessageCount);
+  EXPECT_EQ(stats.output_bytes, output_bytes);
+}
+
+TEST_F(BatchDetokenizerTest, DetokenizeText_ReusesResults) {
+  BatchDetokenizer batch(detokenizer_, 2);
+  std::vector<std::string> results;
+  batch.DetokenizeText(TextMessages(), results);
+
+  const std::array<std::string_view, 1> one = {"$qqqqqvwB"};
+  const BatchDetokenizeStats stats = batch.DetokenizeText(one, results);
+
+  ASSERT_EQ(results.size(), 1u);
+  EXPECT_EQ(results[0], "~!");
+  EXPECT_EQ(stats.threads, 1u);
+}
+
+TEST_F(BatchDetokenizerTest, DetokenizeText_Empty) {
+  BatchDetokenizer batch(detokenizer_, 4);
+  std::vector<std::string> results = {"leftover"};
+  const BatchDetokenizeStats stats =
+      batch.DetokenizeText(span<const std::string_view>(), results);
+
+  EXPECT_TRUE(results.empty());
+  EXPECT_EQ(stats.messages, 0u);
+  EXPECT_EQ(stats.input_bytes, 0u);
+  EXPECT_EQ(stats.output_bytes, 0u);
+}
+
+TEST_F(BatchDetokenizerTest, DetokenizeLines_MatchesSerial) {
+  const std::string text = TextLines();
+
+  BatchDetokenizer batch(detokenizer_, 4);
+  std::string output;
+  const BatchDetokenizeStats stats = batch.DetokenizeLines(text, output);
+
+  EXPECT_EQ(output, DetokenizedLines());
+  EXPECT_EQ(stats.messages, kMessageCount);
+  EXPECT_EQ(stats.threads, 4u);
+  EXPECT_EQ(stats.input_bytes, text.size());
+  EXPECT_EQ(stats.output_bytes, output.size());
+}
+
+TEST_F(BatchDetokenizerTest, DetokenizeLines_AppendsAcrossCalls) {
+  const std::string text = TextLines();
+
+  BatchDetokenizer batch(detokenizer_, 3);
+  std::string output = "start\n";
+  batch.DetokenizeLines(text, output);
+  batch.DetokenizeLines(text, output);
+
+  EXPECT_EQ(output, "start\n" + DetokenizedLines() + DetokenizedLines());
+}
+
+TEST_F(BatchDetokenizerTest, DetokenizeLines_NoTrailingNewline) {
+  BatchDetokenizer batch(detokenizer_, 4);
+  std::string output;
+  const BatchDetokenizeStats stats =
+      batch.DetokenizeLines("$qqqqqvwB\n\nhello $qqqqqvwB", output);
+
+  EXPECT_EQ(output, "~!\n\nhello ~!");
+  EXPECT_EQ(stats.messages, 3u);
+  EXPECT_EQ(stats.threads, 1u);
+}
+
+TEST_F(BatchDetokenizerTest, DetokenizeLines_Empty) {
+  BatchDetokenizer batch(detokenizer_, 4);
+  std::string output;
+  const BatchDetokenizeStats stats = batch.DetokenizeLines("", output);
+
+  EXPECT_TRUE(output.empty());
+  EXPECT_EQ(stats.messages, 0u);
+}
+
+TEST_F(BatchDetokenizerTest, DetokenizeLines_FlatDatabase) {
+  std::vector<std::byte> flat(FlatTokenDatabase::EncodedSizeBytes(kDatabase));
+  ASSERT_EQ(OkStatus(), FlatTokenDatabase::Encode(kDatabase, flat).status());
+  const Detokenizer detokenizer(FlatTokenDatabase::Create(flat));
+
+  BatchDetokenizer batch(detokenizer, 4);
+  std::string output;
+  batch.DetokenizeLines(TextLines(), output);
+
+  EXPECT_EQ(output, DetokenizedLines());
+}
+
+}  // namespace
+}  // namespace pw::tokenizer
@@ -18,7 +18,10 @@
 #include <cctype>
 #include <charconv>
 #include <cstring>
+#include <mutex>
+#include <shared_mutex>
 #include <string_view>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -47,6 +50,10 @@ constexpr bool IsValidBase16(char ch) {
          ('a' <= ch && ch <= 'f');
 }
 
+}  // namespace
+
+namespace internal {
+
 class NestedMessageDetokenizer {
  public:
   NestedMessageDetokenizer(const Detokenizer& detokenizer)
@@ -282,7 +289,7 @@ class NestedMessageDetokenizer {
   }
 
   void DetokenizeOnce(uint32_t token) {
-    if (auto result = detokenizer_.DatabaseLookup(token, domain());
+    if (auto result = detokenizer_.Lookup(token, domain());
         result.size() == 1) {
       std::string replacement =
           result.front().first.Format(span<const uint8_t>()).value();
@@ -329,6 +336,10 @@ class NestedMessageDetokenizer {
   bool output_changed_ = false;
 };
 
+}  // namespace internal
+
+namespace {
+
 std::string UnknownTokenMessage(uint32_t value) {
   std::string output(PW_TOKENIZER_ARG_DECODING_ERROR_PREFIX "unknown token ");
 
@@ -389,6 +400,21 @@ constexpr bool IsPrintableAscii(std::string_view data) {
   return true;
 }
 
+// Compares a domain to a canonical domain, ignoring whitespace in the domain.
+bool IsCanonicalDomain(std::string_view domain, std::string_view canonical) {
+  size_t i = 0;
+  for (char ch : domain) {
+    if (std::isspace(ch)) {
+      continue;
+    }
+    if (i == canonical.size() || canonical[i] != ch) {
+      return false;
+    }
+    i += 1;
+  }
+  return i == canonical.size();
+}
+
 void AddEntryIfUnique(std::vector<TokenizedStringEntry>& entries,
                       std::string_view new_entry) {
   // TODO(b/326365218): Construct FormatString with string_view to avoid
@@ -451,6 +477,17 @@ Detokenizer::Detokenizer(const TokenDatabase& database) {
   }
 }
 
+// A token's entries are added the first time it is found and never change, so
+// spans of them stay valid while other threads add tokens.
+struct Detokenizer::FlatEntryCache {
+  std::shared_mutex mutex;
+  std::unordered_map<uint32_t, std::vector<TokenizedStringEntry>> entries;
+};
+
+Detokenizer::Detokenizer(const FlatTokenDatabase& database)
+    : flat_database_(database),
+      flat_entries_(std::make_shared<FlatEntryCache>()) {}
+
 Result<Detokenizer> Detokenizer::FromElfSection(
     span<const std::byte> elf_section) {
   size_t index = 0;
@@ -600,7 +637,7 @@ DetokenizedString Detokenizer::Detokenize(const span<const std::byte>& encoded,
   uint32_t token = bytes::ReadInOrder<uint32_t>(
       endian::little, encoded.data(), encoded.size());
 
-  const auto result = DatabaseLookup(token, domain);
+  const auto result = Lookup(token, domain);
 
   return DetokenizedString(*this,
                            recursion,
@@ -639,9 +676,50 @@ span<const TokenizedStringEntry> Detokenizer::DatabaseLookup(
   return span(token_it->second);
 }
 
+span<const TokenizedStringEntry> Detokenizer::Lookup(
+    uint32_t token, std::string_view domain) const {
+  if (!flat_database_.ok()) {
+    return DatabaseLookup(token, domain);
+  }
+
+  // Flat databases only have the default domain.
+  if (!IsCanonicalDomain(domain, kDefaultDomain)) {
+    return span<const TokenizedStringEntry>();
+  }
+  return FlatLookup(token);
+}
+
+span<const TokenizedStringEntry> Detokenizer::FlatLookup(uint32_t token) const {
+  {
+    std::shared_lock lock(flat_entries_->mutex);
+    if (auto it = flat_entries_->entries.find(token);
+        it != flat_entries_->entries.end()) {
+      return span(it->second);
+    }
+  }
+
+  // Unknown tokens are not cached. Finding them does not allocate.
+  const FlatTokenDatabase::Entries matches = flat_database_.Find(token);
+  if (matches.empty()) {
+    return span<const TokenizedStringEntry>();
+  }
+
+  std::vector<TokenizedStringEntry> entries;
+  entries.reserve(matches.size());
+  for (const FlatTokenDatabase::Entry& entry : matches) {
+    entries.emplace_back(entry.string, entry.date_removed);
+  }
+
+  // If another thread parsed this token first, its entries are kept.
+  std::lock_guard lock(flat_entries_->mutex);
+  auto [it, inserted] =
+      flat_entries_->entries.try_emplace(token, std::move(entries));
+  return span(it->second);
+}
+
 std::string Detokenizer::DetokenizeTextRecursive(std::string_view text,
                                                  unsigned max_passes) const {
-  NestedMessageDetokenizer detokenizer(*this);
+  internal::NestedMessageDetokenizer detokenizer(*this);
   detokenizer.Detokenize(text);
 
   std::string result;
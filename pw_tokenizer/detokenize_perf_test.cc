@@ -13,12 +13,17 @@
 // the License.
 
 #include <array>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
 
 #include "pw_assert/check.h"
 #include "pw_bytes/array.h"
 #include "pw_perf_test/perf_test.h"
 #include "pw_span/span.h"
 #include "pw_tokenizer/detokenize.h"
+#include "pw_tokenizer/flat_token_database.h"
 
 namespace pw::tokenizer {
 namespace {
@@ -121,5 +126,95 @@ PW_PERF_TEST(DetokenizeText_TwoMessages,
              "What the $qqqqqvwB, $Dg8AAQQEdGhlbQ==",
              "What the ~!, Now there are 2 of them!");
 
+// A larger database for comparing how long it takes to load databases and look
+// up tokens in them.
+constexpr uint32_t kLargeDatabaseEntries = 10000;
+constexpr uint32_t kTokenSpacing = 0xFFFFFFFFu / kLargeDatabaseEntries;
+
+class LargeDatabase {
+ public:
+  static const LargeDatabase& Get() {
+    static const LargeDatabase database;
+    return database;
+  }
+
+  TokenDatabase v0() const { return TokenDatabase::Create(v0_); }
+
+  FlatTokenDatabase flat() const { return FlatTokenDatabase::Create(flat_); }
+
+ private:
+  LargeDatabase() : v0_(16) {
+    std::memcpy(v0_.data(), "TOKENS\0\0", 8);
+    std::memcpy(&v0_[8], &kLargeDatabaseEntries, sizeof(uint32_t));
+
+    for (uint32_t i = 0; i < kLargeDatabaseEntries; ++i) {
+      const uint32_t entry[2] = {i * kTokenSpacing,
+                                 TokenDatabase::kDateRemovedNever};
+      const char* bytes = reinterpret_cast<const char*>(entry);
+      v0_.insert(v0_.end(), bytes, bytes + sizeof(entry));
+    }
+    for (uint32_t i = 0; i < kLargeDatabaseEntries; ++i) {
+      const std::string string = "Message " + std::to_string(i) + ": %d";
+      v0_.insert(v0_.end(), string.c_str(), string.c_str() + string.size() + 1);
+    }
+
+    flat_.resize(FlatTokenDatabase::EncodedSizeBytes(v0()));
+    PW_CHECK_OK(FlatTokenDatabase::Encode(v0(), flat_).status());
+  }
+
+  std::vector<char> v0_;
+  std::vector<std::byte> flat_;
+};
+
+void LoadDatabase(perf_test::State& state) {
+  const TokenDatabase database = LargeDatabase::Get().v0();
+
+  while (state.KeepRunning()) {
+    Detokenizer detokenizer(database);
+    PW_CHECK(!detokenizer.database().empty());
+  }
+}
+
+PW_PERF_TEST(LoadDatabase_HashTable, LoadDatabase);
+
+void LoadFlatDatabase(perf_test::State& state) {
+  const LargeDatabase& database = LargeDatabase::Get();
+
+  while (state.KeepRunning()) {
+    Detokenizer detokenizer(database.flat());
+    PW_CHECK(database.flat().ok());
+  }
+}
+
+PW_PERF_TEST(LoadDatabase_Flat, LoadFlatDatabase);
+
+// Detokenizes messages with one argument, cycling through tokens spread across
+// the database.
+void LookUpTokens(perf_test::State& state, const Detokenizer& detokenizer) {
+  std::array<uint8_t, 5> message = {0, 0, 0, 0, 2};
+  uint32_t index = 0;
+
+  while (state.KeepRunning()) {
+    const uint32_t token = index * kTokenSpacing;
+    std::memcpy(message.data(), &token, sizeof(token));
+    PW_CHECK(detokenizer.Detokenize(message).ok());
+    index = (index + 97) % kLargeDatabaseEntries;
+  }
+}
+
+void LookUpHashTable(perf_test::State& state) {
+  const Detokenizer detokenizer(LargeDatabase::Get().v0());
+  LookUpTokens(state, detokenizer);
+}
+
+PW_PERF_TEST(LookUp_HashTable, LookUpHashTable);
+
+void LookUpFlat(perf_test::State& state) {
+  const Detokenizer detokenizer(LargeDatabase::Get().flat());
+  LookUpTokens(state, detokenizer);
+}
+
+PW_PERF_TEST(LookUp_Flat, LookUpFlat);
+
 }  // namespace
 }  // namespace pw::tokenizer
@@ -16,6 +16,7 @@
 
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include "pw_stream/memory_stream.h"
 #include "pw_tokenizer/base64.h"
@@ -670,6 +671,78 @@ TEST_F(DetokenizeWithCollisions, Collision_TracksAllMatches) {
   EXPECT_EQ(result.matches().size(), 7u);
 }
 
+std::vector<std::byte> EncodeFlat(const TokenDatabase& database) {
+  std::vector<std::byte> flat(FlatTokenDatabase::EncodedSizeBytes(database));
+  EXPECT_EQ(OkStatus(), FlatTokenDatabase::Encode(database, flat).status());
+  return flat;
+}
+
+class DetokenizeFlatDatabase : public ::testing::Test {
+ protected:
+  DetokenizeFlatDatabase()
+      : data_(EncodeFlat(TokenDatabase::Create<kTestDatabase>())),
+        collisions_data_(EncodeFlat(kWithCollisions)),
+        detok_(FlatTokenDatabase::Create(data_)),
+        collisions_detok_(FlatTokenDatabase::Create(collisions_data_)) {}
+
+  std::vector<std::byte> data_;
+  std::vector<std::byte> collisions_data_;
+  Detokenizer detok_;
+  Detokenizer collisions_detok_;
+};
+
+TEST_F(DetokenizeFlatDatabase, NoFormatting) {
+  EXPECT_EQ(detok_.Detokenize("\1\0\0\0"sv).BestString(), "One");
+  EXPECT_EQ(detok_.Detokenize("\5\0\0\0"sv).BestString(), "TWO");
+  EXPECT_EQ(detok_.Detokenize("\xff\x00\x00\x00"sv).BestString(), "333");
+  EXPECT_EQ(detok_.Detokenize("\xff\xee\xee\xdd"sv).BestString(), "FOUR");
+  EXPECT_TRUE(detok_.database().empty());
+}
+
+TEST_F(DetokenizeFlatDatabase, UnknownToken_IsEmpty) {
+  EXPECT_EQ(detok_.Detokenize("\2\0\0\0"sv).BestString(), "");
+  EXPECT_TRUE(detok_.Detokenize("\2\0\0\0"sv).matches().empty());
+}
+
+TEST_F(DetokenizeFlatDatabase, OnlyDefaultDomain) {
+  EXPECT_EQ(detok_.Detokenize("\1\0\0\0"sv, " ").BestString(), "One");
+  EXPECT_EQ(detok_.Detokenize("\1\0\0\0"sv, "other").BestString(), "");
+}
+
+TEST_F(DetokenizeFlatDatabase, DetokenizeText) {
+  for (auto [data, expected] : TestCases(
+           Case{ONE TWO THREE FOUR, "OneTWO333FOUR"},
+           Case{NEST_ONE NEST_ONE NEST_ONE, "OneOneOne"},
+           Case{"${unknown domain}16==", "${unknown domain}16=="},
+           Case{"${ }16==", "d7 encodes as 16=="},
+           Case{"$#000000d7", "d7 encodes as 16=="},
+           Case{"$64==", "$64==++++"})) {
+    EXPECT_EQ(detok_.DetokenizeText(data), expected);
+  }
+}
+
+TEST_F(DetokenizeFlatDatabase, Collisions) {
+  for (auto [data, expected] :
+       TestCases(Case{"\0\0\0\0\x01"sv, "One arg -1"},
+                 Case{"\x00\x00\x00\x00"sv, "This string is present"},
+                 Case{"\xAA\xAA\xAA\xAA"sv, "This one is present"})) {
+    EXPECT_EQ(collisions_detok_.Detokenize(data).BestString(), expected);
+  }
+  EXPECT_EQ(collisions_detok_.Detokenize("\0\0\0\0"sv).matches().size(), 7u);
+}
+
+TEST_F(DetokenizeFlatDatabase, RepeatedLookups_ReuseParsedStrings) {
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(detok_.Detokenize("\5\0\0\0"sv).BestString(), "TWO");
+    EXPECT_EQ(collisions_detok_.Detokenize("\0\0\0\0"sv).matches().size(),
+              7u);
+  }
+
+  const Detokenizer copy = detok_;
+  EXPECT_EQ(copy.Detokenize("\5\0\0\0"sv).BestString(), "TWO");
+  EXPECT_EQ(copy.Detokenize("\1\0\0\0"sv).BestString(), "One");
+}
+
 class DetokenizeFromElfSection : public ::testing::Test {
  protected:
   // Offset and size of the .pw_tokenizer.entries section in bytes.
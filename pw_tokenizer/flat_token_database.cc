@@ -0,0 +1,204 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_tokenizer/flat_token_database.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+
+#include "pw_bytes/endian.h"
+
+namespace pw::tokenizer {
+namespace {
+
+constexpr std::array<char, 8> kMagicAndVersion = {
+    'T', 'O', 'K', 'F', 'L', 'T', '\0', '\0'};
+
+void WriteUint32(std::byte* bytes, uint32_t value) {
+  const auto little_endian = bytes::CopyInOrder(endian::little, value);
+  std::memcpy(bytes, little_endian.data(), little_endian.size());
+}
+
+}  // namespace
+
+FlatTokenDatabase FlatTokenDatabase::Create(span<const std::byte> bytes) {
+  if (bytes.size() < kHeaderSize ||
+      std::memcmp(bytes.data(),
+                  kMagicAndVersion.data(),
+                  kMagicAndVersion.size()) != 0) {
+    return FlatTokenDatabase();
+  }
+
+  const size_type entry_count = ReadUint32(&bytes[8]);
+  const uint8_t index_bits = static_cast<uint8_t>(bytes[12]);
+  if (index_bits > kMaxIndexBits) {
+    return FlatTokenDatabase();
+  }
+
+  // Check the sizes in steps to avoid overflow.
+  span<const std::byte> remaining = bytes.subspan(kHeaderSize);
+  if (remaining.size() < IndexSize(index_bits)) {
+    return FlatTokenDatabase();
+  }
+  const std::byte* const index = remaining.data();
+  remaining = remaining.subspan(IndexSize(index_bits));
+
+  if (remaining.size() / kEntrySize < entry_count) {
+    return FlatTokenDatabase();
+  }
+  const std::byte* const entries = remaining.data();
+  remaining = remaining.subspan(entry_count * kEntrySize);
+
+  // Every string offset must lead to a null terminator. Ensuring that the
+  // string table ends with one makes lookups safe without checking each entry.
+  if (entry_count != 0u &&
+      (remaining.empty() || remaining.back() != std::byte{'\0'})) {
+    return FlatTokenDatabase();
+  }
+
+  FlatTokenDatabase database;
+  database.index_ = index;
+  database.entries_ = entries;
+  database.end_ = entries + entry_count * kEntrySize;
+  database.strings_ = reinterpret_cast<const char*>(remaining.data());
+  database.strings_size_ = remaining.size();
+  database.index_bits_ = index_bits;
+  return database;
+}
+
+uint8_t FlatTokenDatabase::IndexBits(size_type entry_count) {
+  // Use about one bucket per entry.
+  uint8_t bits = 0;
+  while (bits < kMaxIndexBits && (size_type{2} << bits) <= entry_count) {
+    bits += 1;
+  }
+  return bits;
+}
+
+FlatTokenDatabase::size_type FlatTokenDatabase::EncodedSizeBytes(
+    const TokenDatabase& database) {
+  if (!database.ok()) {
+    return 0;
+  }
+  size_type strings_size = 0;
+  for (const TokenDatabase::Entry& entry : database) {
+    strings_size += std::strlen(entry.string) + 1;
+  }
+  return kHeaderSize + IndexSize(IndexBits(database.size())) +
+         database.size() * kEntrySize + strings_size;
+}
+
+StatusWithSize FlatTokenDatabase::Encode(const TokenDatabase& database,
+                                         span<std::byte> output) {
+  if (!database.ok()) {
+    return StatusWithSize::InvalidArgument();
+  }
+  const size_type size = EncodedSizeBytes(database);
+  if (output.size() < size) {
+    return StatusWithSize::ResourceExhausted();
+  }
+
+  const size_type entry_count = database.size();
+  const uint8_t index_bits = IndexBits(entry_count);
+
+  std::byte* const header = output.data();
+  std::memset(header, 0, kHeaderSize);
+  std::memcpy(header, kMagicAndVersion.data(), kMagicAndVersion.size());
+  WriteUint32(header + 8, static_cast<uint32_t>(entry_count));
+  header[12] = static_cast<std::byte>(index_bits);
+
+  std::byte* const index = header + kHeaderSize;
+  std::byte* entry = index + IndexSize(index_bits);
+  std::byte* const strings = entry + entry_count * kEntrySize;
+
+  // String offsets are stored in 32 bits.
+  if (size - static_cast<size_type>(strings - header) >
+      std::numeric_limits<uint32_t>::max()) {
+    return StatusWithSize::InvalidArgument();
+  }
+
+  // Entries are already sorted by token, so fill in the index as they are
+  // written. Each bucket points to the first entry at or after it.
+  const uint32_t bucket_count = uint32_t{1} << index_bits;
+  uint32_t next_bucket = 0;
+  uint32_t position = 0;
+  uint32_t previous_token = 0;
+  size_type string_offset = 0;
+
+  for (const TokenDatabase::Entry& raw : database) {
+    if (raw.token < previous_token) {
+      return StatusWithSize::InvalidArgument();
+    }
+    previous_token = raw.token;
+
+    const uint32_t bucket =
+        index_bits == 0 ? 0 : raw.token >> (32 - index_bits);
+    for (; next_bucket <= bucket; ++next_bucket) {
+      WriteUint32(index + next_bucket * kIndexEntrySize, position);
+    }
+
+    WriteUint32(entry, raw.token);
+    WriteUint32(entry + 4, raw.date_removed);
+    WriteUint32(entry + 8, static_cast<uint32_t>(string_offset));
+    entry += kEntrySize;
+
+    const size_type string_size = std::strlen(raw.string) + 1;
+    std::memcpy(strings + string_offset, raw.string, string_size);
+    string_offset += string_size;
+    position += 1;
+  }
+
+  for (; next_bucket <= bucket_count; ++next_bucket) {
+    WriteUint32(index + next_bucket * kIndexEntrySize, position);
+  }
+  return StatusWithSize(size);
+}
+
+FlatTokenDatabase::size_type FlatTokenDatabase::ReadIndex(
+    uint32_t bucket) const {
+  return std::min<size_type>(ReadUint32(index_ + bucket * kIndexEntrySize),
+                             size());
+}
+
+FlatTokenDatabase::Entries FlatTokenDatabase::Find(uint32_t token) const {
+  if (!ok()) {
+    return Entries();
+  }
+
+  const uint32_t bucket = index_bits_ == 0 ? 0 : token >> (32 - index_bits_);
+  size_type last = ReadIndex(bucket + 1);
+  size_type first = std::min(ReadIndex(bucket), last);
+
+  // Binary search within the bucket for the first matching entry.
+  const auto token_at = [this](size_type i) {
+    return ReadUint32(entries_ + i * kEntrySize);
+  };
+  while (first < last) {
+    const size_type middle = first + (last - first) / 2;
+    if (token_at(middle) < token) {
+      first = middle + 1;
+    } else {
+      last = middle;
+    }
+  }
+  last = first;
+  while (last < size() && token_at(last) == token) {
+    last += 1;
+  }
+  return Entries(iterator(*this, first), iterator(*this, last));
+}
+
+}  // namespace pw::tokenizer
@@ -0,0 +1,237 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_tokenizer/flat_token_database.h"
+
+#include <array>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "pw_unit_test/framework.h"
+
+namespace pw::tokenizer {
+namespace {
+
+constexpr char kBasicData[] =
+    "TOKENS\0\0\x04\x00\x00\x00\0\0\0\0"
+    "\x01\0\0\0\xff\xff\xff\xff"
+    "\x02\0\0\0\x01\x02\x03\x04"
+    "\x02\0\0\0\xff\xff\xff\xff"
+    "\xFF\0\0\x80\xff\xff\xff\xff"
+    "hi!\0"
+    "goodbye\0"
+    "bye\0"
+    ":)";
+
+constexpr TokenDatabase kBasicDatabase = TokenDatabase::Create<kBasicData>();
+
+constexpr char kEmptyData[] = "TOKENS\0\0\x00\x00\x00\x00\0\0\0";
+
+constexpr char kUnsortedData[] =
+    "TOKENS\0\0\x02\x00\x00\x00\0\0\0\0"
+    "\x02\0\0\0\xff\xff\xff\xff"
+    "\x01\0\0\0\xff\xff\xff\xff"
+    "two\0"
+    "one";
+
+std::vector<std::byte> EncodeFlat(const TokenDatabase& database) {
+  std::vector<std::byte> flat(FlatTokenDatabase::EncodedSizeBytes(database));
+  const StatusWithSize result = FlatTokenDatabase::Encode(database, flat);
+  EXPECT_EQ(OkStatus(), result.status());
+  EXPECT_EQ(result.size(), flat.size());
+  return flat;
+}
+
+TEST(FlatTokenDatabase, Encode_MatchesSourceDatabase) {
+  const std::vector<std::byte> flat = EncodeFlat(kBasicDatabase);
+  const FlatTokenDatabase database = FlatTokenDatabase::Create(flat);
+  ASSERT_TRUE(database.ok());
+  ASSERT_EQ(database.size(), kBasicDatabase.size());
+
+  auto expected = kBasicDatabase.begin();
+  for (const FlatTokenDatabase::Entry& entry : database) {
+    EXPECT_EQ(entry.token, expected->token);
+    EXPECT_EQ(entry.date_removed, expected->date_removed);
+    EXPECT_STREQ(entry.string, expected->string);
+    ++expected;
+  }
+  EXPECT_EQ(expected, kBasicDatabase.end());
+}
+
+TEST(FlatTokenDatabase, Find_SingleEntry) {
+  const std::vector<std::byte> flat = EncodeFlat(kBasicDatabase);
+  const FlatTokenDatabase database = FlatTokenDatabase::Create(flat);
+
+  const auto entries = database.Find(1);
+  ASSERT_EQ(entries.size(), 1u);
+  EXPECT_STREQ(entries.begin()->string, "hi!");
+  EXPECT_EQ(entries.begin()->date_removed, TokenDatabase::kDateRemovedNever);
+
+  const auto last = database.Find(0x800000FF);
+  ASSERT_EQ(last.size(), 1u);
+  EXPECT_STREQ(last.begin()->string, ":)");
+}
+
+TEST(FlatTokenDatabase, Find_Collision) {
+  const std::vector<std::byte> flat = EncodeFlat(kBasicDatabase);
+  const FlatTokenDatabase database = FlatTokenDatabase::Create(flat);
+
+  const auto entries = database.Find(2);
+  ASSERT_EQ(entries.size(), 2u);
+  auto it = entries.begin();
+  EXPECT_STREQ(it->string, "goodbye");
+  EXPECT_EQ(it->date_removed, 0x04030201u);
+  ++it;
+  EXPECT_STREQ(it->string, "bye");
+  ++it;
+  EXPECT_EQ(it, entries.end());
+}
+
+TEST(FlatTokenDatabase, Find_Missing) {
+  const std::vector<std::byte> flat = EncodeFlat(kBasicDatabase);
+  const FlatTokenDatabase database = FlatTokenDatabase::Create(flat);
+
+  EXPECT_TRUE(database.Find(0).empty());
+  EXPECT_TRUE(database.Find(3).empty());
+  EXPECT_TRUE(database.Find(0xFF).empty());
+  EXPECT_TRUE(database.Find(0xFFFFFFFF).empty());
+}
+
+TEST(FlatTokenDatabase, Find_LargeDatabase) {
+  // Build a v0 database with tokens spread across the token space.
+  constexpr uint32_t kEntries = 1000;
+  std::vector<char> data(16);
+  std::memcpy(data.data(), "TOKENS\0\0", 8);
+  std::memcpy(&data[8], &kEntries, sizeof(kEntries));
+  for (uint32_t i = 0; i < kEntries; ++i) {
+    const uint32_t token = i * 4294967u;
+    const uint32_t date = i;
+    data.insert(data.end(),
+                reinterpret_cast<const char*>(&token),
+                reinterpret_cast<const char*>(&token) + sizeof(token));
+    data.insert(data.end(),
+                reinterpret_cast<const char*>(&date),
+                reinterpret_cast<const char*>(&date) + sizeof(date));
+  }
+  for (uint32_t i = 0; i < kEntries; ++i) {
+    const std::string string = "string " + std::to_string(i);
+    data.insert(data.end(), string.begin(), string.end());
+    data.push_back('\0');
+  }
+  const TokenDatabase source = TokenDatabase::Create(data);
+  ASSERT_TRUE(source.ok());
+
+  const std::vector<std::byte> flat = EncodeFlat(source);
+  const FlatTokenDatabase database = FlatTokenDatabase::Create(flat);
+  ASSERT_EQ(database.size(), kEntries);
+
+  for (uint32_t i = 0; i < kEntries; ++i) {
+    const auto entries = database.Find(i * 4294967u);
+    ASSERT_EQ(entries.size(), 1u);
+    EXPECT_EQ(entries.begin()->date_removed, i);
+    EXPECT_EQ(entries.begin()->string, "string " + std::to_string(i));
+    EXPECT_TRUE(database.Find(i * 4294967u + 1).empty());
+  }
+}
+
+TEST(FlatTokenDatabase, EmptyDatabase) {
+  const TokenDatabase source = TokenDatabase::Create(kEmptyData);
+  const std::vector<std::byte> flat = EncodeFlat(source);
+  const FlatTokenDatabase database = FlatTokenDatabase::Create(flat);
+
+  ASSERT_TRUE(database.ok());
+  EXPECT_EQ(database.size(), 0u);
+  EXPECT_EQ(database.begin(), database.end());
+  EXPECT_TRUE(database.Find(0).empty());
+}
+
+TEST(FlatTokenDatabase, DefaultConstructed) {
+  const FlatTokenDatabase database;
+
+  EXPECT_FALSE(database.ok());
+  EXPECT_EQ(database.size(), 0u);
+  EXPECT_EQ(database.begin(), database.end());
+  EXPECT_TRUE(database.Find(1).empty());
+}
+
+TEST(FlatTokenDatabase, Encode_BufferTooSmall) {
+  std::vector<std::byte> flat(
+      FlatTokenDatabase::EncodedSizeBytes(kBasicDatabase) - 1);
+  EXPECT_EQ(Status::ResourceExhausted(),
+            FlatTokenDatabase::Encode(kBasicDatabase, flat).status());
+}
+
+TEST(FlatTokenDatabase, Encode_InvalidDatabase) {
+  std::array<std::byte, 64> flat;
+  EXPECT_EQ(FlatTokenDatabase::EncodedSizeBytes(TokenDatabase()), 0u);
+  EXPECT_EQ(Status::InvalidArgument(),
+            FlatTokenDatabase::Encode(TokenDatabase(), flat).status());
+}
+
+TEST(FlatTokenDatabase, Encode_UnsortedDatabase) {
+  const TokenDatabase source = TokenDatabase::Create(kUnsortedData);
+  ASSERT_TRUE(source.ok());
+  std::vector<std::byte> flat(FlatTokenDatabase::EncodedSizeBytes(source));
+  EXPECT_EQ(Status::InvalidArgument(),
+            FlatTokenDatabase::Encode(source, flat).status());
+}
+
+TEST(FlatTokenDatabase, Create_InvalidData) {
+  const std::vector<std::byte> valid = EncodeFlat(kBasicDatabase);
+  ASSERT_TRUE(FlatTokenDatabase::Create(valid).ok());
+
+  // Too short for the header.
+  EXPECT_FALSE(FlatTokenDatabase::Create(span(valid).first(15)).ok());
+
+  // Truncated entries or string table.
+  EXPECT_FALSE(FlatTokenDatabase::Create(span(valid).first(40)).ok());
+  EXPECT_FALSE(
+      FlatTokenDatabase::Create(span(valid).first(valid.size() - 1)).ok());
+
+  std::vector<std::byte> bad_magic = valid;
+  bad_magic[0] = std::byte{'t'};
+  EXPECT_FALSE(FlatTokenDatabase::Create(bad_magic).ok());
+
+  std::vector<std::byte> bad_version = valid;
+  bad_version[6] = std::byte{1};
+  EXPECT_FALSE(FlatTokenDatabase::Create(bad_version).ok());
+
+  std::vector<std::byte> bad_index_bits = valid;
+  bad_index_bits[12] = std::byte{32};
+  EXPECT_FALSE(FlatTokenDatabase::Create(bad_index_bits).ok());
+
+  std::vector<std::byte> bad_entry_count = valid;
+  bad_entry_count[10] = std::byte{1};
+  EXPECT_FALSE(FlatTokenDatabase::Create(bad_entry_count).ok());
+}
+
+TEST(FlatTokenDatabase, CorruptStringOffset_EmptyString) {
+  std::vector<std::byte> flat = EncodeFlat(kBasicDatabase);
+  constexpr size_t kStringTableSize = sizeof("hi!\0goodbye\0bye\0:)");
+  const size_t first_entry = flat.size() - kStringTableSize - 4 * 12;
+
+  // Point the first entry's string past the end of the string table.
+  flat[first_entry + 8] = std::byte{0xff};
+  flat[first_entry + 9] = std::byte{0xff};
+
+  const FlatTokenDatabase database = FlatTokenDatabase::Create(flat);
+  ASSERT_TRUE(database.ok());
+  const auto entries = database.Find(1);
+  ASSERT_EQ(entries.size(), 1u);
+  EXPECT_STREQ(entries.begin()->string, "");
+}
+
+}  // namespace
+}  // namespace pw::tokenizer
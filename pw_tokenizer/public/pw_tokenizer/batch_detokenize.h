@@ -0,0 +1,177 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+// This file provides a host-only API for detokenizing large batches of
+// messages, such as log archives, on multiple threads.
+//
+//   Detokenizer detok(TokenDatabase::Create(data));
+//   BatchDetokenizer batch(detok);
+//
+//   std::string output;
+//   BatchDetokenizeStats stats = batch.DetokenizeLines(text_chunk, output);
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "pw_span/span.h"
+#include "pw_tokenizer/detokenize.h"
+
+namespace pw::tokenizer {
+
+/// Statistics for one `BatchDetokenizer` operation.
+struct BatchDetokenizeStats {
+  /// Number of messages or lines that were detokenized.
+  size_t messages = 0;
+
+  /// Total size of the encoded input.
+  size_t input_bytes = 0;
+
+  /// Total size of the detokenized output.
+  size_t output_bytes = 0;
+
+  /// Number of threads that detokenized messages, including the caller.
+  size_t threads = 0;
+
+  /// Wall-clock time taken by the operation.
+  std::chrono::steady_clock::duration elapsed{};
+
+  /// Messages detokenized per second, or 0 if no time elapsed.
+  double MessagesPerSecond() const { return PerSecond(messages); }
+
+  /// Input bytes processed per second, or 0 if no time elapsed.
+  double InputBytesPerSecond() const { return PerSecond(input_bytes); }
+
+ private:
+  double PerSecond(size_t count) const {
+    const double seconds = std::chrono::duration<double>(elapsed).count();
+    return seconds > 0 ? static_cast<double>(count) / seconds : 0;
+  }
+};
+
+/// Detokenizes batches of messages on a pool of threads that share one
+/// read-only `Detokenizer`. Results are always in the same order as the input.
+///
+/// The worker threads are started when the `BatchDetokenizer` is created and
+/// wait for work between operations. Each operation splits its input across up
+/// to `thread_count()` threads. The calling thread does part of the work, and
+/// the operation returns once all messages are detokenized. Small batches use
+/// fewer threads, since waking a thread costs more than detokenizing a few
+/// messages.
+///
+/// The `Detokenizer` must outlive the `BatchDetokenizer`. A `BatchDetokenizer`
+/// reuses its per-thread buffers between operations, so it must not be used by
+/// multiple threads at once. Create one `BatchDetokenizer` per calling thread
+/// instead; they may share a `Detokenizer`.
+class BatchDetokenizer {
+ public:
+  /// Creates a `BatchDetokenizer` that uses up to `thread_count` threads,
+  /// including the calling thread, and starts `thread_count - 1` workers. If
+  /// `thread_count` is 0, uses one thread per hardware thread.
+  explicit BatchDetokenizer(const Detokenizer& detokenizer,
+                            size_t thread_count = 0);
+
+  /// Stops and joins the worker threads.
+  ~BatchDetokenizer();
+
+  BatchDetokenizer(const BatchDetokenizer&) = delete;
+  BatchDetokenizer& operator=(const BatchDetokenizer&) = delete;
+
+  /// The maximum number of threads used for an operation, including the
+  /// calling thread.
+  size_t thread_count() const { return thread_count_; }
+
+  /// Detokenizes binary messages with `Detokenizer::Detokenize`. Resizes
+  /// `results` to the number of messages and stores the `BestString` for
+  /// `messages[i]` in `results[i]`. Existing strings in `results` are reused.
+  BatchDetokenizeStats Detokenize(span<const span<const std::byte>> messages,
+                                  std::vector<std::string>& results);
+
+  /// Detokenizes text with `Detokenizer::DetokenizeText`. Resizes `results` to
+  /// the number of messages and stores the result for `messages[i]` in
+  /// `results[i]`.
+  BatchDetokenizeStats DetokenizeText(span<const std::string_view> messages,
+                                      std::vector<std::string>& results);
+
+  /// Detokenizes each line of newline-separated text with
+  /// `Detokenizer::DetokenizeText` and appends the lines to `output`, in order.
+  /// Newlines are preserved.
+  ///
+  /// Use this to stream a large archive through a fixed amount of memory: read
+  /// a chunk that ends on a line boundary, detokenize it, and write out
+  /// `output`. A Base64 message split between two chunks cannot be decoded.
+  BatchDetokenizeStats DetokenizeLines(std::string_view text,
+                                       std::string& output);
+
+ private:
+  // Waking a worker and waiting for it takes roughly as long as detokenizing
+  // this many messages or bytes, so batches get one thread for each.
+  static constexpr size_t kMinMessagesPerThread = 16;
+  static constexpr size_t kMinBytesPerThread = 1024;
+
+  // Threads claim messages in groups of this size from a shared counter.
+  static constexpr size_t kMessagesPerClaim = 32;
+
+  size_t ThreadsFor(size_t work, size_t min_work_per_thread) const;
+
+  template <typename DetokenizeOne>
+  BatchDetokenizeStats DetokenizeMessages(size_t count,
+                                          DetokenizeOne&& detokenize_one);
+
+  // Calls work(i) for each i in [0, threads). The calling thread runs work(0)
+  // and the workers run the rest. Returns once all calls have returned.
+  template <typename Function>
+  void RunOnThreads(size_t threads, const Function& work) {
+    Run(threads,
+        [](const void* function, size_t thread) {
+          (*static_cast<const Function*>(function))(thread);
+        },
+        &work);
+  }
+
+  void Run(size_t threads,
+           void (*work)(const void* function, size_t thread),
+           const void* function);
+
+  void WorkerLoop(size_t thread);
+
+  const Detokenizer& detokenizer_;
+  const size_t thread_count_;
+
+  // Output buffer for each thread in DetokenizeLines.
+  std::vector<std::string> line_buffers_;
+
+  // The current operation. Workers with an index below work_threads_ run it
+  // when generation_ changes, and the last to finish signals done_.
+  std::mutex mutex_;
+  std::condition_variable start_;
+  std::condition_variable done_;
+  void (*work_)(const void*, size_t) = nullptr;
+  const void* work_function_ = nullptr;
+  size_t work_threads_ = 0;
+  size_t running_ = 0;
+  uint64_t generation_ = 0;
+  bool stopping_ = false;
+
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace pw::tokenizer
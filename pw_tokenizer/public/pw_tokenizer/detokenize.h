@@ -26,6 +26,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -34,6 +35,7 @@
 #include "pw_result/result.h"
 #include "pw_span/span.h"
 #include "pw_stream/stream.h"
+#include "pw_tokenizer/flat_token_database.h"
 #include "pw_tokenizer/internal/decode.h"
 #include "pw_tokenizer/token_database.h"
 #include "pw_tokenizer/tokenize.h"
@@ -45,6 +47,12 @@ namespace pw::tokenizer {
 
 class Detokenizer;
 
+namespace internal {
+
+class NestedMessageDetokenizer;  // Forward declaration for friend statement
+
+}  // namespace internal
+
 /// Token database entry.
 using TokenizedStringEntry = std::pair<FormatString, uint32_t /*date removed*/>;
 using DomainTokenEntriesMap = std::unordered_map<
@@ -100,7 +108,8 @@ class DetokenizedString {
 };
 
 /// Decodes and detokenizes from a token database. This class builds a hash
-/// table of tokens to give `O(1)` token lookups.
+/// table of tokens to give `O(1)` token lookups, or looks tokens up directly in
+/// a `FlatTokenDatabase`.
 class Detokenizer {
  public:
   /// Constructs a detokenizer from a `TokenDatabase`. The `TokenDatabase` is
@@ -108,6 +117,13 @@ class Detokenizer {
   /// freed.
   explicit Detokenizer(const TokenDatabase& database);
 
+  /// Constructs a detokenizer that looks up tokens directly in a
+  /// `FlatTokenDatabase`. Construction is `O(1)`: the database is not copied or
+  /// parsed, so its memory must outlive the `Detokenizer`. Strings are parsed
+  /// the first time their token is looked up and reused afterwards. All tokens
+  /// are in the default domain.
+  explicit Detokenizer(const FlatTokenDatabase& database);
+
   /// Constructs a detokenizer by directly passing the parsed database.
   explicit Detokenizer(DomainTokenEntriesMap&& database)
       : database_(std::move(database)) {}
@@ -219,12 +235,18 @@ class Detokenizer {
   std::string DecodeOptionallyTokenizedData(
       const span<const std::byte>& optionally_tokenized_data);
 
+  /// Returns the parsed database. This is empty for a detokenizer that was
+  /// constructed from a `FlatTokenDatabase`.
   const DomainTokenEntriesMap& database() const { return database_; }
 
+  /// Returns the entries for a token from the parsed database. This is always
+  /// empty for a detokenizer that was constructed from a `FlatTokenDatabase`.
   span<const TokenizedStringEntry> DatabaseLookup(
       uint32_t token, std::string_view domain) const;
 
  private:
+  friend class internal::NestedMessageDetokenizer;
+
   // 4 passes supports detokenizing two layers of nested messages with tokenized
   // domains (e.g. ${${bar}#ab12cd34}#00000012), without allowing a hypothetical
   // detokenization cycle to continue for too long.
@@ -239,7 +261,23 @@ class Detokenizer {
                                std::string_view domain,
                                bool recursion) const;
 
+  // Format strings parsed from a FlatTokenDatabase, by token. Defined in
+  // detokenize.cc so that this header does not depend on <shared_mutex>.
+  struct FlatEntryCache;
+
+  // Returns the entries for a token from either database.
+  span<const TokenizedStringEntry> Lookup(uint32_t token,
+                                          std::string_view domain) const;
+
+  // Returns the entries for a token from the flat database, parsing them if
+  // this is the first time the token was found.
+  span<const TokenizedStringEntry> FlatLookup(uint32_t token) const;
+
   DomainTokenEntriesMap database_;
+  FlatTokenDatabase flat_database_;
+
+  // Shared by copies of the Detokenizer, which reference the same database.
+  std::shared_ptr<FlatEntryCache> flat_entries_;
 };
 
 /// @}
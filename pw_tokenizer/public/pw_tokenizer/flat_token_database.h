@@ -0,0 +1,260 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+#include "pw_span/span.h"
+#include "pw_status/status_with_size.h"
+#include "pw_tokenizer/token_database.h"
+
+namespace pw::tokenizer {
+
+/// Reads entries from a flat binary token database, which supports fast
+/// lookups directly from its encoded form. This class does not copy or modify
+/// the contents of the database, so it works well with memory-mapped files:
+/// creating a `FlatTokenDatabase` is `O(1)` and lookups never allocate.
+///
+/// Flat databases are created from v0 binary databases (`TokenDatabase`) with
+/// `FlatTokenDatabase::Encode`. Like v0 databases, all tokens are in the
+/// default domain.
+///
+/// A flat database is comprised of a 16-byte header, a bucket index, an array
+/// of 12-byte entries sorted by token, and a table of null-terminated strings.
+/// All fields are little-endian.
+///
+/// @rst
+///   ======  ====  ==========================
+///   Header (16 bytes)
+///   ----------------------------------------
+///   Offset  Size  Field
+///   ======  ====  ==========================
+///        0     6  Magic number (``TOKFLT``)
+///        6     2  Version (``00 00``)
+///        8     4  Entry count
+///       12     1  Index bits
+///       13     3  Reserved
+///   ======  ====  ==========================
+///
+///   ======  ====  ==================================
+///   Entry (12 bytes)
+///   ------------------------------------------------
+///   Offset  Size  Field
+///   ======  ====  ==================================
+///        0     4  Token
+///        4     4  Removal date (as in ``TokenDatabase``)
+///        8     4  String offset in the string table
+///   ======  ====  ==================================
+/// @endrst
+///
+/// The bucket index has `2^(index bits) + 1` 4-byte entries. Index `i` holds
+/// the position of the first entry whose token's top `index bits` bits are at
+/// least `i`, and the final index holds the entry count. Lookups read the
+/// bucket for a token and then search the few entries within it.
+class FlatTokenDatabase {
+ public:
+  using Entry = TokenDatabase::Entry;
+  using size_type = std::size_t;
+
+  /// Iterator for `FlatTokenDatabase` entries.
+  class iterator {
+   public:
+    using difference_type = std::ptrdiff_t;
+    using value_type = Entry;
+    using pointer = const Entry*;
+    using reference = const Entry&;
+    using iterator_category = std::forward_iterator_tag;
+
+    constexpr iterator() : entry_{}, raw_(nullptr), database_(nullptr) {}
+
+    constexpr iterator(const iterator& other) = default;
+    constexpr iterator& operator=(const iterator& other) = default;
+
+    iterator& operator++() {
+      raw_ += kEntrySize;
+      ReadRawEntry();
+      return *this;
+    }
+    iterator operator++(int) {
+      iterator previous(*this);
+      operator++();
+      return previous;
+    }
+    constexpr bool operator==(const iterator& rhs) const {
+      return raw_ == rhs.raw_;
+    }
+    constexpr bool operator!=(const iterator& rhs) const {
+      return raw_ != rhs.raw_;
+    }
+
+    constexpr const Entry& operator*() const { return entry_; }
+
+    constexpr const Entry* operator->() const { return &entry_; }
+
+    constexpr difference_type operator-(const iterator& rhs) const {
+      return (raw_ - rhs.raw_) / static_cast<difference_type>(kEntrySize);
+    }
+
+   private:
+    friend class FlatTokenDatabase;
+
+    iterator(const FlatTokenDatabase& database, size_type index)
+        : entry_{}, raw_(database.entries_ + index * kEntrySize),
+          database_(&database) {
+      ReadRawEntry();
+    }
+
+    void ReadRawEntry() {
+      if (raw_ != database_->end_) {
+        entry_ = database_->ReadEntry(raw_);
+      }
+    }
+
+    Entry entry_;
+    const std::byte* raw_;
+    const FlatTokenDatabase* database_;
+  };
+
+  using value_type = Entry;
+  using const_iterator = iterator;
+
+  /// A list of token entries returned from a `Find` operation.
+  class Entries {
+   public:
+    constexpr Entries() = default;
+
+    constexpr Entries(const iterator& begin, const iterator& end)
+        : begin_(begin), end_(end) {}
+
+    /// The number of entries in this list.
+    constexpr size_type size() const {
+      return static_cast<size_type>(end_ - begin_);
+    }
+
+    /// True if the list is empty.
+    constexpr bool empty() const { return begin_ == end_; }
+
+    constexpr const iterator& begin() const { return begin_; }
+    constexpr const iterator& end() const { return end_; }
+
+   private:
+    iterator begin_;
+    iterator end_;
+  };
+
+  /// Creates a `FlatTokenDatabase` from encoded flat database bytes. The bytes
+  /// must outlive the database object. Only the header and sizes are checked,
+  /// so this is `O(1)`. If the data is not valid, returns a default-constructed
+  /// database for which `ok()` is false.
+  static FlatTokenDatabase Create(span<const std::byte> bytes);
+
+  /// Overload of `Create` for a `uint8_t` span.
+  static FlatTokenDatabase Create(span<const uint8_t> bytes) {
+    return Create(as_bytes(bytes));
+  }
+
+  /// Returns the size of a v0 binary database when encoded as a flat database.
+  /// Returns 0 if the database is not `ok()`.
+  static size_type EncodedSizeBytes(const TokenDatabase& database);
+
+  /// Encodes a v0 binary database as a flat database.
+  ///
+  /// @returns @rst
+  ///
+  /// .. pw-status-codes::
+  ///
+  ///    OK: The database was encoded. The size is the number of bytes written.
+  ///
+  ///    INVALID_ARGUMENT: The database is not valid or its entries are not
+  ///       sorted by token.
+  ///
+  ///    RESOURCE_EXHAUSTED: The output buffer is too small. Use
+  ///       ``EncodedSizeBytes`` to determine the required size.
+  ///
+  /// @endrst
+  static StatusWithSize Encode(const TokenDatabase& database,
+                               span<std::byte> output);
+
+  /// Creates a database with no data. `ok()` returns false.
+  constexpr FlatTokenDatabase()
+      : index_(nullptr),
+        entries_(nullptr),
+        end_(nullptr),
+        strings_(nullptr),
+        strings_size_(0),
+        index_bits_(0) {}
+
+  /// Returns all entries associated with this token. This is `O(1)` for tokens
+  /// with a uniform distribution, such as hashes, and never allocates. The
+  /// entries refer to this object, which must outlive them.
+  Entries Find(uint32_t token) const;
+
+  /// Returns the total number of entries (unique token-string pairs).
+  constexpr size_type size() const {
+    return static_cast<size_type>(end_ - entries_) / kEntrySize;
+  }
+
+  /// True if this database was constructed with valid data.
+  constexpr bool ok() const { return entries_ != nullptr; }
+
+  /// Returns an iterator for the first token entry.
+  iterator begin() const { return iterator(*this, 0); }
+
+  /// Returns an iterator for one past the last token entry.
+  iterator end() const { return iterator(*this, size()); }
+
+ private:
+  static constexpr size_type kHeaderSize = 16;
+  static constexpr size_type kEntrySize = 12;
+  static constexpr size_type kIndexEntrySize = 4;
+
+  // Largest supported number of index bits. The index for 2^20 buckets is 4 MB.
+  static constexpr uint8_t kMaxIndexBits = 20;
+
+  static uint32_t ReadUint32(const std::byte* bytes) {
+    return static_cast<uint32_t>(bytes[0]) |
+           static_cast<uint32_t>(bytes[1]) << 8 |
+           static_cast<uint32_t>(bytes[2]) << 16 |
+           static_cast<uint32_t>(bytes[3]) << 24;
+  }
+
+  static uint8_t IndexBits(size_type entry_count);
+
+  static constexpr size_type IndexSize(uint8_t index_bits) {
+    return ((size_type{1} << index_bits) + 1) * kIndexEntrySize;
+  }
+
+  // Reads an entry, pointing out-of-range string offsets at an empty string.
+  Entry ReadEntry(const std::byte* raw) const {
+    const uint32_t offset = ReadUint32(raw + 8);
+    const char* string = offset < strings_size_
+                             ? strings_ + offset
+                             : strings_ + strings_size_ - 1;
+    return Entry{ReadUint32(raw), ReadUint32(raw + 4), string};
+  }
+
+  // Reads a bucket's position from the index, clamped to the entry count.
+  size_type ReadIndex(uint32_t bucket) const;
+
+  const std::byte* index_;
+  const std::byte* entries_;
+  const std::byte* end_;
+  const char* strings_;
+  size_type strings_size_;
+  uint8_t index_bits_;
+};
+
+}  // namespace pw::tokenizer
@@ -14,6 +14,76 @@
 
 #include "pw_varint/varint.h"
 
+#include <string.h>
+
+// The fast paths below load 8 bytes at once and locate the terminating byte
+// with a bit scan, so they require a little-endian target and GCC or Clang
+// builtins. Other targets use the byte-at-a-time loops.
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && \
+    __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define _PW_VARINT_HAS_FAST_PATH 1
+#else
+#define _PW_VARINT_HAS_FAST_PATH 0
+#endif  // defined(__GNUC__) && little endian
+
+// PEXT gathers the 7-bit groups of a word in one instruction where BMI2 is
+// enabled at build time. Otherwise, the groups are gathered with shifts.
+#if _PW_VARINT_HAS_FAST_PATH && defined(__BMI2__)
+#include <immintrin.h>
+#define _PW_VARINT_HAS_BMI2 1
+#else
+#define _PW_VARINT_HAS_BMI2 0
+#endif  // _PW_VARINT_HAS_FAST_PATH && defined(__BMI2__)
+
+#if _PW_VARINT_HAS_FAST_PATH
+
+#define _PW_VARINT_CONTINUATION_BITS 0x8080808080808080ull
+#define _PW_VARINT_VALUE_BITS 0x7f7f7f7f7f7f7f7full
+
+// Decodes a varint from the first 8 bytes of the input, read as one
+// little-endian word. Returns the number of bytes in the varint, or 0 if it is
+// longer than 8 bytes.
+static inline size_t DecodeWord(const uint8_t* input, uint64_t* value) {
+  uint64_t word;
+  memcpy(&word, input, sizeof(word));
+
+  // The lowest clear continuation bit marks the last byte of the varint.
+  const uint64_t last_byte_bits = ~word & _PW_VARINT_CONTINUATION_BITS;
+  if (last_byte_bits == 0u) {
+    return 0u;
+  }
+
+  // Discard the bytes that follow the last byte, then gather the 7-bit groups.
+  word &= (last_byte_bits ^ (last_byte_bits - 1u)) & _PW_VARINT_VALUE_BITS;
+#if _PW_VARINT_HAS_BMI2
+  *value = _pext_u64(word, _PW_VARINT_VALUE_BITS);
+#else
+  word = ((word & 0x7f007f007f007f00ull) >> 1) | (word & 0x007f007f007f007full);
+  word = ((word & 0x3fff00003fff0000ull) >> 2) | (word & 0x00003fff00003fffull);
+  word = ((word & 0x0fffffff00000000ull) >> 4) | (word & 0x000000000fffffffull);
+  *value = word;
+#endif  // _PW_VARINT_HAS_BMI2
+  return (size_t)__builtin_ctzll(last_byte_bits) / 8u + 1u;
+}
+
+// Encodes a varint after computing its length, so the output size is checked
+// once and each byte is written without testing for the end of the value.
+#define VARINT_ENCODE_FUNCTION_BODY(bits)                                    \
+  uint8_t* buffer = (uint8_t*)output;                                        \
+  const size_t size =                                                        \
+      (size_t)(64 - __builtin_clzll((uint64_t)integer | 1u) + 6) / 7u;       \
+  if (size > output_size_bytes) {                                            \
+    return 0u;                                                               \
+  }                                                                          \
+                                                                             \
+  for (size_t i = 0; i < size - 1; ++i) {                                    \
+    buffer[i] = pw_varint_EncodeOneByte##bits(&integer);                     \
+  }                                                                          \
+  buffer[size - 1] = (uint8_t)integer;                                       \
+  return size
+
+#else
+
 #define VARINT_ENCODE_FUNCTION_BODY(bits)                        \
   size_t written = 0;                                            \
   uint8_t* buffer = (uint8_t*)output;                            \
@@ -28,6 +98,8 @@
   buffer[written - 1] &= 0x7f;                                   \
   return written
 
+#endif  // _PW_VARINT_HAS_FAST_PATH
+
 size_t pw_varint_Encode32(uint32_t integer,
                           void* output,
                           size_t output_size_bytes) {
@@ -67,11 +139,31 @@ size_t pw_varint_Encode64(uint64_t integer,
 size_t pw_varint_Decode32(const void* input,
                           size_t input_size_bytes,
                           uint32_t* output) {
+#if _PW_VARINT_HAS_FAST_PATH
+  if (input_size_bytes >= sizeof(uint64_t)) {
+    uint64_t value;
+    const size_t count = DecodeWord((const uint8_t*)input, &value);
+    if (count == 0u || count > PW_VARINT_MAX_INT32_SIZE_BYTES) {
+      return 0u;
+    }
+    *output = (uint32_t)value;
+    return count;
+  }
+#endif  // _PW_VARINT_HAS_FAST_PATH
   VARINT_DECODE_FUNCTION_BODY(32);
 }
 
 size_t pw_varint_Decode64(const void* input,
                           size_t input_size_bytes,
                           uint64_t* output) {
+#if _PW_VARINT_HAS_FAST_PATH
+  if (input_size_bytes >= sizeof(uint64_t)) {
+    const size_t count = DecodeWord((const uint8_t*)input, output);
+    if (count != 0u) {
+      return count;
+    }
+    // Varints of 9 or 10 bytes are decoded one byte at a time.
+  }
+#endif  // _PW_VARINT_HAS_FAST_PATH
   VARINT_DECODE_FUNCTION_BODY(64);
 }
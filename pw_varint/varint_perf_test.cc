@@ -0,0 +1,142 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_perf_test/perf_test.h"
+#include "pw_span/span.h"
+#include "pw_varint/varint.h"
+
+namespace pw::varint {
+namespace {
+
+// Each test encodes or decodes a packed stream of varints whose values are
+// drawn from one of several distributions. The custom format tests use the
+// same encoding as the default format, but always take the generic path.
+
+constexpr size_t kValueCount = 256;
+
+enum Distribution {
+  kOneByte,   // Small values, e.g. field tags and short lengths.
+  kTwoBytes,  // Values up to 2^14.
+  kMixed,     // Values of 1 to 10 bytes in equal proportion.
+  kUint32,    // Uniformly distributed 32-bit values, mostly 5 bytes.
+  kNegative,  // Negative int32 values as encoded by protobuf, 10 bytes.
+};
+
+std::array<uint64_t, kValueCount> values;
+std::array<std::byte, kValueCount * kMaxVarint64SizeBytes> encoded;
+
+uint64_t Value(Distribution distribution, size_t index) {
+  // A simple LCG is enough to spread the values.
+  static uint64_t state = 0x2545f4914f6cdd1du;
+  state = state * 6364136223846793005u + 1442695040888963407u;
+  const uint64_t random = state;
+  switch (distribution) {
+    case kOneByte:
+      return random & 0x7f;
+    case kTwoBytes:
+      return random & 0x3fff;
+    case kMixed: {
+      const size_t bits = 7 * (index % kMaxVarint64SizeBytes + 1);
+      return bits >= 64 ? random | (uint64_t{1} << 63) : random >> (64 - bits);
+    }
+    case kUint32:
+      return random & 0xffffffffu;
+    case kNegative:
+      return static_cast<uint64_t>(-static_cast<int64_t>(random & 0xffff) - 1);
+  }
+  return 0;
+}
+
+span<const std::byte> Prepare(Distribution distribution) {
+  size_t size = 0;
+  for (size_t i = 0; i < kValueCount; ++i) {
+    values[i] = Value(distribution, i);
+    size += Encode(values[i], span(encoded).subspan(size));
+  }
+  return span(encoded).first(size);
+}
+
+void EncodeTest(perf_test::State& state, Distribution distribution) {
+  Prepare(distribution);
+  while (state.KeepRunning()) {
+    size_t size = 0;
+    for (uint64_t value : values) {
+      size += Encode(value, span(encoded).subspan(size));
+    }
+  }
+}
+
+void EncodeCustomTest(perf_test::State& state, Distribution distribution) {
+  Prepare(distribution);
+  while (state.KeepRunning()) {
+    size_t size = 0;
+    for (uint64_t value : values) {
+      size += Encode(value,
+                     span(encoded).subspan(size),
+                     Format::kZeroTerminatedMostSignificant);
+    }
+  }
+}
+
+void DecodeTest(perf_test::State& state, Distribution distribution) {
+  const span<const std::byte> data = Prepare(distribution);
+  while (state.KeepRunning()) {
+    span<const std::byte> remaining = data;
+    for (uint64_t& value : values) {
+      remaining = remaining.subspan(Decode(remaining, &value));
+    }
+  }
+}
+
+void DecodeCustomTest(perf_test::State& state, Distribution distribution) {
+  const span<const std::byte> data = Prepare(distribution);
+  while (state.KeepRunning()) {
+    span<const std::byte> remaining = data;
+    for (uint64_t& value : values) {
+      remaining = remaining.subspan(
+          Decode(remaining, &value, Format::kZeroTerminatedMostSignificant));
+    }
+  }
+}
+
+PW_PERF_TEST(Encode_OneByte, EncodeTest, kOneByte);
+PW_PERF_TEST(Encode_TwoBytes, EncodeTest, kTwoBytes);
+PW_PERF_TEST(Encode_Mixed, EncodeTest, kMixed);
+PW_PERF_TEST(Encode_Uint32, EncodeTest, kUint32);
+PW_PERF_TEST(Encode_Negative, EncodeTest, kNegative);
+
+PW_PERF_TEST(EncodeCustom_OneByte, EncodeCustomTest, kOneByte);
+PW_PERF_TEST(EncodeCustom_TwoBytes, EncodeCustomTest, kTwoBytes);
+PW_PERF_TEST(EncodeCustom_Mixed, EncodeCustomTest, kMixed);
+PW_PERF_TEST(EncodeCustom_Uint32, EncodeCustomTest, kUint32);
+PW_PERF_TEST(EncodeCustom_Negative, EncodeCustomTest, kNegative);
+
+PW_PERF_TEST(Decode_OneByte, DecodeTest, kOneByte);
+PW_PERF_TEST(Decode_TwoBytes, DecodeTest, kTwoBytes);
+PW_PERF_TEST(Decode_Mixed, DecodeTest, kMixed);
+PW_PERF_TEST(Decode_Uint32, DecodeTest, kUint32);
+PW_PERF_TEST(Decode_Negative, DecodeTest, kNegative);
+
+PW_PERF_TEST(DecodeCustom_OneByte, DecodeCustomTest, kOneByte);
+PW_PERF_TEST(DecodeCustom_TwoBytes, DecodeCustomTest, kTwoBytes);
+PW_PERF_TEST(DecodeCustom_Mixed, DecodeCustomTest, kMixed);
+PW_PERF_TEST(DecodeCustom_Uint32, DecodeCustomTest, kUint32);
+PW_PERF_TEST(DecodeCustom_Negative, DecodeCustomTest, kNegative);
+
+}  // namespace
+}  // namespace pw::varint
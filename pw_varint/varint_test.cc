@@ -1134,6 +1134,70 @@ ENCODED_SIZE_TEST(EncodedSize);
 ENCODED_SIZE_TEST(pw_varint_EncodedSizeBytes);
 ENCODED_SIZE_TEST(PW_VARINT_ENCODED_SIZE_BYTES);
 
+// Encodes and decodes the value with padding after it, which exercises the
+// word-at-a-time paths, and compares the results against the generic custom
+// format functions, which process one byte at a time.
+void EncodeDecodeMatchesGeneric(uint64_t value, std::byte padding) {
+  std::byte expected[kMaxVarint64SizeBytes];
+  const size_t expected_size =
+      Encode(value, expected, Format::kZeroTerminatedMostSignificant);
+  ASSERT_EQ(expected_size, EncodedSize(value));
+
+  std::byte buffer[kMaxVarint64SizeBytes + 8];
+  std::memset(buffer, static_cast<int>(padding), sizeof(buffer));
+  ASSERT_EQ(Encode(value, buffer), expected_size);
+  EXPECT_EQ(std::memcmp(buffer, expected, expected_size), 0);
+  EXPECT_EQ(buffer[expected_size], padding);
+
+  // Decode with exactly the encoded bytes and with trailing bytes.
+  for (size_t size : {expected_size, sizeof(buffer)}) {
+    uint64_t result64 = 0;
+    EXPECT_EQ(pw_varint_Decode64(buffer, size, &result64), expected_size);
+    EXPECT_EQ(result64, value);
+
+    uint32_t result32 = 0;
+    if (expected_size <= kMaxVarint32SizeBytes) {
+      EXPECT_EQ(pw_varint_Decode32(buffer, size, &result32), expected_size);
+      EXPECT_EQ(result32, static_cast<uint32_t>(value));
+    } else {
+      EXPECT_EQ(pw_varint_Decode32(buffer, size, &result32), 0u);
+    }
+  }
+}
+
+TEST(Varint, EncodeDecodeMatchesGenericForAllSizes) {
+  for (unsigned bits = 0; bits <= 64; ++bits) {
+    const uint64_t max = bits == 64 ? std::numeric_limits<uint64_t>::max()
+                                    : (uint64_t{1} << bits) - 1;
+    for (uint64_t value : {max, max & 0x5555555555555555u, max >> 1}) {
+      EncodeDecodeMatchesGeneric(value, std::byte{0x00});
+      EncodeDecodeMatchesGeneric(value, std::byte{0xff});
+    }
+  }
+}
+
+void EncodeDecodeMatchesGenericFuzz(uint64_t value) {
+  EncodeDecodeMatchesGeneric(value, std::byte{0x80});
+}
+
+FUZZ_TEST(Varint, EncodeDecodeMatchesGenericFuzz);
+
+TEST(Varint, DecodeUnterminated) {
+  std::byte buffer[kMaxVarint64SizeBytes + 8];
+  std::memset(buffer, 0xff, sizeof(buffer));
+  uint64_t result64;
+  uint32_t result32;
+  for (size_t size = 0; size <= sizeof(buffer); ++size) {
+    EXPECT_EQ(pw_varint_Decode64(buffer, size, &result64), 0u);
+    EXPECT_EQ(pw_varint_Decode32(buffer, size, &result32), 0u);
+  }
+
+  // A 32-bit varint terminated after 8 bytes is too long.
+  buffer[7] = std::byte{0x01};
+  EXPECT_EQ(pw_varint_Decode32(buffer, sizeof(buffer), &result32), 0u);
+  EXPECT_EQ(pw_varint_Decode64(buffer, sizeof(buffer), &result64), 8u);
+}
+
 constexpr uint64_t CalculateMaxValueInBytes(size_t bytes) {
   uint64_t value = 0;
   for (size_t i = 0; i < bytes; ++i) {